@@ -0,0 +1,126 @@
+//
+// rresamp_crcf_example.c
+//
+// Demonstration of rational-rate resampler object whereby an input
+// signal is resampled at a rational rate P/Q (e.g. 147/160 for a
+// 48 kHz to 44.1 kHz audio conversion). The resampler consumes Q
+// input samples and produces exactly P output samples per block.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <complex.h>
+#include <math.h>
+#include <getopt.h>
+
+#include "liquid.h"
+
+#define OUTPUT_FILENAME "rresamp_crcf_example.m"
+
+// print usage/help message
+void usage()
+{
+    printf("Usage: %s [OPTION]\n", __FILE__);
+    printf("  h     : print help\n");
+    printf("  P     : interpolation rate,              default: 5\n");
+    printf("  Q     : decimation rate,                 default: 3\n");
+    printf("  m     : filter semi-length (delay),      default: 12\n");
+    printf("  w     : filter bandwidth,                default: 0.45\n");
+    printf("  s     : filter stop-band attenuation,    default: 60 dB\n");
+}
+
+int main(int argc, char*argv[])
+{
+    // options
+    unsigned int P  = 5;        // output rate (interpolation factor)
+    unsigned int Q  = 3;        // input rate (decimation factor)
+    unsigned int m  = 12;       // resampling filter semi-length (filter delay)
+    float        bw = 0.45f;    // resampling filter bandwidth
+    float        As = 60.0f;    // resampling filter stop-band attenuation [dB]
+
+    int dopt;
+    while ((dopt = getopt(argc,argv,"hP:Q:m:w:s:")) != EOF) {
+        switch (dopt) {
+        case 'h':   usage();                return 0;
+        case 'P':   P    = atoi(optarg);    break;
+        case 'Q':   Q    = atoi(optarg);    break;
+        case 'm':   m    = atoi(optarg);    break;
+        case 'w':   bw   = atof(optarg);    break;
+        case 's':   As   = atof(optarg);    break;
+        default:
+            exit(1);
+        }
+    }
+
+    // validate input
+    if (P == 0 || P > 1000) {
+        fprintf(stderr,"error: %s, input rate P must be in [1,1000]\n", argv[0]);
+        exit(1);
+    } else if (Q == 0 || Q > 1000) {
+        fprintf(stderr,"error: %s, output rate Q must be in [1,1000]\n", argv[0]);
+        exit(1);
+    }
+
+    // create resampler object
+    rresamp_crcf q = rresamp_crcf_create(P,Q,m,bw,As);
+    rresamp_crcf_print(q);
+
+    // reduced rates
+    P = rresamp_crcf_get_P(q);
+    Q = rresamp_crcf_get_Q(q);
+
+    // number of blocks to run, allowing for filter delay
+    unsigned int num_blocks = (2*m + 40) / Q + 4;
+    unsigned int nx = num_blocks * Q;
+    unsigned int ny = num_blocks * P;
+
+    // generate input signal: windowed pulse
+    float complex * x = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * y = (float complex*) malloc(ny*sizeof(float complex));
+    unsigned int i;
+    unsigned int w_len = 40;
+    for (i=0; i<nx; i++) {
+        x[i] = i < w_len ? 0.1f*hamming(i,w_len)*cexpf(_Complex_I*0.07f*i) : 0.0f;
+    }
+
+    // run resampler on all blocks at once
+    rresamp_crcf_execute_block(q, x, num_blocks, y);
+
+    // clean up allocated objects
+    rresamp_crcf_destroy(q);
+
+    // 
+    // export results
+    //
+    FILE * fid = fopen(OUTPUT_FILENAME,"w");
+    fprintf(fid,"%% %s: auto-generated file\n",OUTPUT_FILENAME);
+    fprintf(fid,"clear all;\n");
+    fprintf(fid,"close all;\n");
+    fprintf(fid,"P  = %u;\n", P);
+    fprintf(fid,"Q  = %u;\n", Q);
+    fprintf(fid,"m  = %u;\n", m);
+    fprintf(fid,"nx = %u;\n", nx);
+    fprintf(fid,"ny = %u;\n", ny);
+    fprintf(fid,"x = zeros(1,nx);\n");
+    for (i=0; i<nx; i++)
+        fprintf(fid,"x(%3u) = %12.4e + j*%12.4e;\n", i+1, crealf(x[i]), cimagf(x[i]));
+    fprintf(fid,"y = zeros(1,ny);\n");
+    for (i=0; i<ny; i++)
+        fprintf(fid,"y(%3u) = %12.4e + j*%12.4e;\n", i+1, crealf(y[i]), cimagf(y[i]));
+
+    // time-domain plot, compensating for filter delay
+    fprintf(fid,"tx = [0:(nx-1)];\n");
+    fprintf(fid,"ty = [0:(ny-1)]*Q/P - m;\n");
+    fprintf(fid,"figure;\n");
+    fprintf(fid,"plot(tx,real(x),'-s',ty,real(y),'-x');\n");
+    fprintf(fid,"xlabel('input sample index');\n");
+    fprintf(fid,"legend('input','output');\n");
+    fprintf(fid,"grid on;\n");
+    fclose(fid);
+    printf("results written to %s\n", OUTPUT_FILENAME);
+
+    free(x);
+    free(y);
+    printf("done.\n");
+    return 0;
+}
@@ -22,6 +22,8 @@
 #ifndef __LIQUID_H__
 #define __LIQUID_H__
 
+#include <stdint.h>
+
 #ifdef __cplusplus
 extern "C" {
 #   define LIQUID_USE_COMPLEX_H 0
@@ -211,6 +213,9 @@ void cvsd_decode8(cvsd _q, unsigned char _data, float * _audio);
 typedef struct CBUFFER(_s) * CBUFFER();                         \
                                                                 \
 /* create circular buffer object of a particular size       */  \
+/* when configured with --enable-mirror, large buffers use  */  \
+/* mirrored memory, which is shared with (not copied to)    */  \
+/* child processes after fork()                             */  \
 CBUFFER() CBUFFER(_create)(unsigned int _max_size);             \
                                                                 \
 /* create circular buffer object of a particular size and   */  \
@@ -219,6 +224,15 @@ CBUFFER() CBUFFER(_create)(unsigned int _max_size);             \
 CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,          \
                                unsigned int _max_read);         \
                                                                 \
+/* create circular buffer object over memory provided by    */  \
+/* the caller (not copied, not freed on destroy)            */  \
+/*  _v        : memory [size: _max_size + _max_read - 1 x 1]*/  \
+/*  _max_size : maximum number of elements in buffer        */  \
+/*  _max_read : maximum number of elements read at once     */  \
+CBUFFER() CBUFFER(_create_external)(T *          _v,            \
+                                    unsigned int _max_size,     \
+                                    unsigned int _max_read);    \
+                                                                \
 /* destroy cbuffer object, freeing all internal memory      */  \
 void CBUFFER(_destroy)(CBUFFER() _q);                           \
                                                                 \
@@ -260,6 +274,20 @@ void CBUFFER(_write)(CBUFFER()    _q,                           \
                      T *          _v,                           \
                      unsigned int _n);                          \
                                                                 \
+/* reserve contiguous region for writing samples in place   */  \
+/*  _q  : circular buffer object                            */  \
+/*  _v  : output pointer to writable region                 */  \
+/*  _n  : number of samples that may be written at _v       */  \
+void CBUFFER(_write_reserve)(CBUFFER()      _q,                 \
+                             T **           _v,                 \
+                             unsigned int * _n);                \
+                                                                \
+/* commit samples written to region from _write_reserve()   */  \
+/*  _q  : circular buffer object                            */  \
+/*  _n  : number of samples written                         */  \
+void CBUFFER(_write_commit)(CBUFFER()    _q,                    \
+                            unsigned int _n);                   \
+                                                                \
 /* remove and return a single element from the buffer       */  \
 /*  _q  : circular buffer object                            */  \
 /*  _v  : pointer to sample output                          */  \
@@ -284,6 +312,116 @@ void CBUFFER(_release)(CBUFFER()    _q,                         \
 LIQUID_CBUFFER_DEFINE_API(CBUFFER_MANGLE_FLOAT,  float)
 LIQUID_CBUFFER_DEFINE_API(CBUFFER_MANGLE_CFLOAT, liquid_float_complex)
 
+// single-producer/single-consumer (lock-free) circular buffer
+#define SPSCBUFFER_MANGLE_FLOAT(name)  LIQUID_CONCAT(spscbufferf,  name)
+#define SPSCBUFFER_MANGLE_CFLOAT(name) LIQUID_CONCAT(spscbuffercf, name)
+
+// watermark events
+typedef enum {
+    LIQUID_SPSCBUFFER_LOW_WATERMARK=0,  // buffer drained to low watermark
+    LIQUID_SPSCBUFFER_HIGH_WATERMARK,   // buffer filled to high watermark
+} liquid_spscbuffer_event;
+
+// watermark notification callback
+//  _userdata   : user-defined data pointer
+//  _event      : watermark event
+//  _size       : number of elements in buffer at event
+typedef void (*liquid_spscbuffer_callback)(void *                  _userdata,
+                                           liquid_spscbuffer_event _event,
+                                           unsigned int            _size);
+
+// large macro
+//   SPSCBUFFER : name-mangling macro
+//   T          : data type
+#define LIQUID_SPSCBUFFER_DEFINE_API(SPSCBUFFER,T)              \
+typedef struct SPSCBUFFER(_s) * SPSCBUFFER();                   \
+                                                                \
+/* create buffer shared by exactly one producer thread and  */  \
+/* one consumer thread; no locks are taken on the data path */  \
+/*  _max_size  : maximum number of elements in buffer       */  \
+SPSCBUFFER() SPSCBUFFER(_create)(unsigned int _max_size);       \
+                                                                \
+/* destroy buffer object, freeing all internal memory       */  \
+void SPSCBUFFER(_destroy)(SPSCBUFFER() _q);                     \
+                                                                \
+/* print buffer object properties                           */  \
+void SPSCBUFFER(_print)(SPSCBUFFER() _q);                       \
+                                                                \
+/* reset buffer to empty (not thread-safe)                  */  \
+void SPSCBUFFER(_reset)(SPSCBUFFER() _q);                       \
+                                                                \
+/* set watermark notification (not thread-safe); callback   */  \
+/* is invoked by the producer when a commit fills buffer to */  \
+/* at least _high, and by the consumer when a release drains*/  \
+/* it to at most _low                                       */  \
+/*  _q          : buffer object                             */  \
+/*  _low        : low watermark, 0 to disable               */  \
+/*  _high       : high watermark, 0 to disable              */  \
+/*  _callback   : notification function                     */  \
+/*  _userdata   : user-defined data passed to callback      */  \
+void SPSCBUFFER(_set_watermarks)(                               \
+            SPSCBUFFER()               _q,                      \
+            unsigned int               _low,                    \
+            unsigned int               _high,                   \
+            liquid_spscbuffer_callback _callback,               \
+            void *                     _userdata);              \
+                                                                \
+/* get the number of elements currently in the buffer       */  \
+unsigned int SPSCBUFFER(_size)(SPSCBUFFER() _q);                \
+                                                                \
+/* get the maximum number of elements the buffer can hold   */  \
+unsigned int SPSCBUFFER(_max_size)(SPSCBUFFER() _q);            \
+                                                                \
+/* get the number of elements that may be written           */  \
+unsigned int SPSCBUFFER(_space_available)(SPSCBUFFER() _q);     \
+                                                                \
+/* reserve contiguous region for writing (producer), return */  \
+/* number of elements that may be written at *_v            */  \
+unsigned int SPSCBUFFER(_write_reserve)(SPSCBUFFER() _q,        \
+                                        T **         _v);       \
+                                                                \
+/* commit _n elements written to reserved region (producer) */  \
+void SPSCBUFFER(_write_commit)(SPSCBUFFER() _q,                 \
+                               unsigned int _n);                \
+                                                                \
+/* write up to _n elements without blocking (producer),     */  \
+/* returning number of elements written                     */  \
+unsigned int SPSCBUFFER(_write)(SPSCBUFFER() _q,                \
+                                T *          _v,                \
+                                unsigned int _n);               \
+                                                                \
+/* wait until at least _n elements may be written (producer)*/  \
+/*  _timeout_ms : timeout [ms]; 0 to poll, < 0 for no limit */  \
+/*  returns 1 if space is available, 0 on timeout           */  \
+int SPSCBUFFER(_wait_writable)(SPSCBUFFER() _q,                 \
+                               unsigned int _n,                 \
+                               int          _timeout_ms);       \
+                                                                \
+/* reserve contiguous region for reading (consumer), return */  \
+/* number of elements that may be read at *_v               */  \
+unsigned int SPSCBUFFER(_read_reserve)(SPSCBUFFER() _q,         \
+                                       T **         _v);        \
+                                                                \
+/* release _n elements read from reserved region (consumer) */  \
+void SPSCBUFFER(_read_release)(SPSCBUFFER() _q,                 \
+                               unsigned int _n);                \
+                                                                \
+/* read up to _n elements without blocking (consumer),      */  \
+/* returning number of elements read                        */  \
+unsigned int SPSCBUFFER(_read)(SPSCBUFFER() _q,                 \
+                               T *          _v,                 \
+                               unsigned int _n);                \
+                                                                \
+/* wait until at least _n elements may be read (consumer)   */  \
+/*  _timeout_ms : timeout [ms]; 0 to poll, < 0 for no limit */  \
+/*  returns 1 if data are available, 0 on timeout           */  \
+int SPSCBUFFER(_wait_readable)(SPSCBUFFER() _q,                 \
+                               unsigned int _n,                 \
+                               int          _timeout_ms);       \
+
+LIQUID_SPSCBUFFER_DEFINE_API(SPSCBUFFER_MANGLE_FLOAT,  float)
+LIQUID_SPSCBUFFER_DEFINE_API(SPSCBUFFER_MANGLE_CFLOAT, liquid_float_complex)
+
 
 
 // Windowing functions
@@ -298,6 +436,9 @@ LIQUID_CBUFFER_DEFINE_API(CBUFFER_MANGLE_CFLOAT, liquid_float_complex)
 typedef struct WINDOW(_s) * WINDOW();                           \
                                                                 \
 /* create window buffer object of length _n                 */  \
+/* when configured with --enable-mirror, large windows use  */  \
+/* mirrored memory, which is shared with (not copied to)    */  \
+/* child processes after fork()                             */  \
 WINDOW() WINDOW(_create)(unsigned int _n);                      \
                                                                 \
 /* recreate window buffer object with new length            */  \
@@ -1535,6 +1676,11 @@ void firdespm_destroy(firdespm _q);
 // print firdespm object internals
 void firdespm_print(firdespm _q);
 
+// set number of threads used to evaluate the error function on
+// the dense grid (requires pthreads; ignored otherwise)
+void firdespm_set_num_threads(firdespm     _q,
+                              unsigned int _num_threads);
+
 // execute filter design, storing result in _h
 void firdespm_execute(firdespm _q, float * _h);
 
@@ -1551,6 +1697,45 @@ void liquid_firdes_kaiser(unsigned int _n,
                           float _mu,
                           float *_h);
 
+// Filter design cache: designs from liquid_firdes_kaiser() and
+// liquid_firdes_prototype() are memoized by type and parameters and
+// shared as reference-counted read-only arrays; the cache is
+// thread-safe when built with pthreads. Each returned array remains
+// valid until passed to liquid_firdes_cache_release(), even if the
+// cache is cleared meanwhile. The total size of stored designs is
+// bounded (see liquid_firdes_cache_set_max_bytes()).
+//  (see liquid_firdes_kaiser for parameters; length: _n)
+const float * liquid_firdes_cache_kaiser(unsigned int _n,
+                                         float        _fc,
+                                         float        _As,
+                                         float        _mu);
+
+// get shared (root-)Nyquist prototype design from cache
+//  (see liquid_firdes_prototype for parameters; length: 2*_k*_m+1)
+const float * liquid_firdes_cache_prototype(liquid_firfilt_type _type,
+                                            unsigned int        _k,
+                                            unsigned int        _m,
+                                            float               _beta,
+                                            float               _dt);
+
+// release array returned by liquid_firdes_cache_kaiser() or
+// liquid_firdes_cache_prototype()
+void liquid_firdes_cache_release(const float * _h);
+
+// get number of designs currently held in cache
+unsigned int liquid_firdes_cache_get_num_entries();
+
+// get total size of coefficients currently held in cache [bytes]
+unsigned int liquid_firdes_cache_get_num_bytes();
+
+// set maximum total size of coefficients held in cache [bytes]
+// (default: 1 MiB); 0 disables caching
+void liquid_firdes_cache_set_max_bytes(unsigned int _max_bytes);
+
+// remove all designs from cache, releasing their memory once no
+// longer referenced
+void liquid_firdes_cache_clear();
+
 // Design FIR doppler filter
 //  _n      : filter length
 //  _fd     : normalized doppler frequency (0 < _fd < 0.5)
@@ -1624,6 +1809,136 @@ float iir_group_delay(float * _b,
                       unsigned int _na,
                       float _fc);
 
+// Compute group delay for an FIR filter on uniform frequency grid
+// _f0 + k*_df, k < _n
+//  _h      : filter coefficients array [size: _h_len x 1]
+//  _h_len  : filter length
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _gd     : output group delay [size: _n x 1]
+void fir_group_delay_grid(float *      _h,
+                          unsigned int _h_len,
+                          float        _f0,
+                          float        _df,
+                          unsigned int _n,
+                          float *      _gd);
+
+// Compute group delay for an IIR filter on uniform frequency grid
+//  _b      : filter numerator coefficients [size: _nb x 1]
+//  _nb     : filter numerator length
+//  _a      : filter denominator coefficients [size: _na x 1]
+//  _na     : filter denominator length
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _gd     : output group delay [size: _n x 1]
+void iir_group_delay_grid(float *      _b,
+                          unsigned int _nb,
+                          float *      _a,
+                          unsigned int _na,
+                          float        _f0,
+                          float        _df,
+                          unsigned int _n,
+                          float *      _gd);
+
+// Compute group delay for an IIR filter in second-order sections
+// form on uniform frequency grid
+//  _B      : numerator coefficients [size: _nsos x 3]
+//  _A      : denominator coefficients [size: _nsos x 3]
+//  _nsos   : number of second-order sections
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _gd     : output group delay [size: _n x 1]
+void iir_group_delay_sos_grid(float *      _B,
+                              float *      _A,
+                              unsigned int _nsos,
+                              float        _f0,
+                              float        _df,
+                              unsigned int _n,
+                              float *      _gd);
+
+// Compute complex frequency response of FIR filter,
+// H(f) = sum_i h[i] exp(j 2 pi f i)
+//  _h      : filter coefficients [size: _h_len x 1]
+//  _h_len  : filter length
+//  _fc     : frequency at which response is evaluated
+//  _H      : output frequency response
+void liquid_freqrespf(float *                _h,
+                      unsigned int           _h_len,
+                      float                  _fc,
+                      liquid_float_complex * _H);
+
+// Compute complex frequency response of FIR filter with complex
+// coefficients
+void liquid_freqrespcf(liquid_float_complex * _h,
+                       unsigned int           _h_len,
+                       float                  _fc,
+                       liquid_float_complex * _H);
+
+// Compute complex frequency response of FIR filter on uniform
+// frequency grid _f0 + k*_df, k < _n. A grid of consecutive DFT
+// bins (_df = 1/M) is computed with a single zero-padded FFT, other
+// grids (e.g. zoom into a sub-band) with a chirp-z transform.
+//  _h      : filter coefficients [size: _h_len x 1]
+//  _h_len  : filter length
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _H      : output frequency response [size: _n x 1]
+void liquid_freqrespf_grid(float *                _h,
+                           unsigned int           _h_len,
+                           float                  _f0,
+                           float                  _df,
+                           unsigned int           _n,
+                           liquid_float_complex * _H);
+
+// Compute complex frequency response of FIR filter with complex
+// coefficients on uniform frequency grid
+void liquid_freqrespcf_grid(liquid_float_complex * _h,
+                            unsigned int           _h_len,
+                            float                  _f0,
+                            float                  _df,
+                            unsigned int           _n,
+                            liquid_float_complex * _H);
+
+// Compute complex frequency response of IIR filter in transfer
+// function form on uniform frequency grid
+//  _b      : numerator coefficients [size: _nb x 1]
+//  _nb     : numerator length
+//  _a      : denominator coefficients [size: _na x 1]
+//  _na     : denominator length
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _H      : output frequency response [size: _n x 1]
+void liquid_freqrespf_iir_grid(float *                _b,
+                               unsigned int           _nb,
+                               float *                _a,
+                               unsigned int           _na,
+                               float                  _f0,
+                               float                  _df,
+                               unsigned int           _n,
+                               liquid_float_complex * _H);
+
+// Compute complex frequency response of IIR filter in second-order
+// sections form on uniform frequency grid
+//  _B      : numerator coefficients [size: _nsos x 3]
+//  _A      : denominator coefficients [size: _nsos x 3]
+//  _nsos   : number of second-order sections
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _H      : output frequency response [size: _n x 1]
+void liquid_freqrespf_sos_grid(float *                _B,
+                               float *                _A,
+                               unsigned int           _nsos,
+                               float                  _f0,
+                               float                  _df,
+                               unsigned int           _n,
+                               liquid_float_complex * _H);
+
 
 // liquid_filter_autocorr()
 //
@@ -1957,6 +2272,32 @@ void AUTOCORR(_execute_block)(AUTOCORR()   _q,                  \
                                                                 \
 /* return sum of squares of buffered samples                */  \
 float AUTOCORR(_get_energy)(AUTOCORR() _q);                     \
+                                                                \
+/* create multi-lag auto-correlator, computing windowed     */  \
+/* auto-correlation at every lag in [0,_num_lags) with      */  \
+/* running sums updated as samples enter and leave the      */  \
+/* window; single-lag methods operate on lag _num_lags-1    */  \
+/*  _window_size    : size of the correlator window         */  \
+/*  _num_lags       : number of lags                        */  \
+AUTOCORR() AUTOCORR(_create_multilag)(                          \
+                unsigned int _window_size,                      \
+                unsigned int _num_lags);                        \
+                                                                \
+/* get number of lags in multi-lag mode (zero if disabled)  */  \
+unsigned int AUTOCORR(_get_num_lags)(AUTOCORR() _q);            \
+                                                                \
+/* compute auto-correlation at all lags from running sums   */  \
+/*  _q      :   multi-lag auto-correlation object           */  \
+/*  _rxx    :   output array [size: num_lags x 1]           */  \
+void AUTOCORR(_execute_lags)(AUTOCORR() _q,                     \
+                             TO *       _rxx);                  \
+                                                                \
+/* compute auto-correlation at all lags in batch from       */  \
+/* buffered history using FFT-based cross-correlation       */  \
+/*  _q      :   multi-lag auto-correlation object           */  \
+/*  _rxx    :   output array [size: num_lags x 1]           */  \
+void AUTOCORR(_execute_lags_fft)(AUTOCORR() _q,                 \
+                                 TO *       _rxx);              \
 
 LIQUID_AUTOCORR_DEFINE_API(AUTOCORR_MANGLE_CCCF,
                            liquid_float_complex,
@@ -2072,6 +2413,31 @@ void FIRFILT(_freqresponse)(FIRFILT()              _q,          \
 /*  _fc     : frequency to evaluate                         */  \
 float FIRFILT(_groupdelay)(FIRFILT() _q,                        \
                            float     _fc);                      \
+                                                                \
+/* compute complex frequency response of filter object on */    \
+/* uniform grid of frequencies _f0 + k*_df, k < _n        */    \
+/*  _q      : filter object                               */    \
+/*  _f0     : first grid frequency                        */    \
+/*  _df     : grid frequency spacing                      */    \
+/*  _n      : number of grid points                       */    \
+/*  _H      : output frequency response [size: _n x 1]    */    \
+void FIRFILT(_freqresponse_grid)(FIRFILT()              _q,     \
+                                 float                  _f0,    \
+                                 float                  _df,    \
+                                 unsigned int           _n,     \
+                                 liquid_float_complex * _H);    \
+                                                                \
+/* compute group delay of filter object on uniform grid   */    \
+/*  _q      : filter object                               */    \
+/*  _f0     : first grid frequency                        */    \
+/*  _df     : grid frequency spacing                      */    \
+/*  _n      : number of grid points                       */    \
+/*  _gd     : output group delay [size: _n x 1]           */    \
+void FIRFILT(_groupdelay_grid)(FIRFILT()    _q,                 \
+                               float        _f0,                \
+                               float        _df,                \
+                               unsigned int _n,                 \
+                               float *      _gd);               \
 
 LIQUID_FIRFILT_DEFINE_API(FIRFILT_MANGLE_RRRF,
                           float,
@@ -2088,6 +2454,102 @@ LIQUID_FIRFILT_DEFINE_API(FIRFILT_MANGLE_CCCF,
                           liquid_float_complex,
                           liquid_float_complex)
 
+//
+// Multi-channel finite impulse response filter: runs the same
+// filter over a number of synchronized streams; the internal
+// buffer holds one frame (one sample from each channel) per
+// time step so that the dot product vectorizes across channels
+//
+#define FIRFILTMC_MANGLE_RRRF(name) LIQUID_CONCAT(firfiltmc_rrrf,name)
+#define FIRFILTMC_MANGLE_CRCF(name) LIQUID_CONCAT(firfiltmc_crcf,name)
+#define FIRFILTMC_MANGLE_CCCF(name) LIQUID_CONCAT(firfiltmc_cccf,name)
+
+// Macro:
+//   FIRFILTMC  : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_FIRFILTMC_DEFINE_API(FIRFILTMC,TO,TC,TI)         \
+typedef struct FIRFILTMC(_s) * FIRFILTMC();                     \
+                                                                \
+/* create multi-channel filter from external coefficients   */  \
+/*  _num_channels : number of channels, _num_channels > 0   */  \
+/*  _h            : filter coefficients [size: _n x 1]      */  \
+/*  _n            : filter length, _n > 0                   */  \
+FIRFILTMC() FIRFILTMC(_create)(unsigned int _num_channels,      \
+                               TC *         _h,                 \
+                               unsigned int _n);                \
+                                                                \
+/* destroy filter object and free all internal memory       */  \
+void FIRFILTMC(_destroy)(FIRFILTMC() _q);                       \
+                                                                \
+/* reset filter object's internal buffer                    */  \
+void FIRFILTMC(_reset)(FIRFILTMC() _q);                         \
+                                                                \
+/* print filter object information                          */  \
+void FIRFILTMC(_print)(FIRFILTMC() _q);                         \
+                                                                \
+/* set output scaling for filter                            */  \
+void FIRFILTMC(_set_scale)(FIRFILTMC() _q,                      \
+                           TC          _scale);                 \
+                                                                \
+/* get number of channels                                   */  \
+unsigned int FIRFILTMC(_get_num_channels)(FIRFILTMC() _q);      \
+                                                                \
+/* get length of filter                                     */  \
+unsigned int FIRFILTMC(_get_length)(FIRFILTMC() _q);            \
+                                                                \
+/* push one frame (one sample per channel) into buffer      */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input frame [size: num_channels x 1]          */  \
+void FIRFILTMC(_push)(FIRFILTMC() _q,                           \
+                      TI *        _x);                          \
+                                                                \
+/* execute the filter on internal buffer for all channels   */  \
+/*  _q      : filter object                                 */  \
+/*  _y      : output frame [size: num_channels x 1]         */  \
+void FIRFILTMC(_execute)(FIRFILTMC() _q,                        \
+                         TO *        _y);                       \
+                                                                \
+/* execute the filter on a block of interleaved samples     */  \
+/* (sample i of channel c at index i*num_channels + c); the */  \
+/* input and output buffers may be the same                 */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input array [size: _n*num_channels x 1]       */  \
+/*  _n      : number of samples per channel                 */  \
+/*  _y      : output array [size: _n*num_channels x 1]      */  \
+void FIRFILTMC(_execute_block)(FIRFILTMC()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
+                                                                \
+/* execute the filter on a block of planar samples (sample  */  \
+/* i of channel c at index c*_n + i); the input and output  */  \
+/* buffers may be the same                                  */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input array [size: num_channels*_n x 1]       */  \
+/*  _n      : number of samples per channel                 */  \
+/*  _y      : output array [size: num_channels*_n x 1]      */  \
+void FIRFILTMC(_execute_block_planar)(FIRFILTMC()  _q,          \
+                                      TI *         _x,          \
+                                      unsigned int _n,          \
+                                      TO *         _y);         \
+
+LIQUID_FIRFILTMC_DEFINE_API(FIRFILTMC_MANGLE_RRRF,
+                            float,
+                            float,
+                            float)
+
+LIQUID_FIRFILTMC_DEFINE_API(FIRFILTMC_MANGLE_CRCF,
+                            liquid_float_complex,
+                            float,
+                            liquid_float_complex)
+
+LIQUID_FIRFILTMC_DEFINE_API(FIRFILTMC_MANGLE_CCCF,
+                            liquid_float_complex,
+                            liquid_float_complex,
+                            liquid_float_complex)
+
 //
 // FIR Hilbert transform
 //  2:1 real-to-complex decimator
@@ -2100,6 +2562,9 @@ LIQUID_FIRFILT_DEFINE_API(FIRFILT_MANGLE_CCCF,
 // NOTES:
 //   Although firhilb is a placeholder for both decimation and
 //   interpolation, separate objects should be used for each task.
+//   Block methods of long filters (m >= 80) run the quadrature
+//   branch in the frequency domain (overlap-save) and produce the
+//   same output as the sample-by-sample methods.
 #define LIQUID_FIRHILB_DEFINE_API(FIRHILB,T,TC)                 \
 typedef struct FIRHILB(_s) * FIRHILB();                         \
                                                                 \
@@ -2134,6 +2599,28 @@ void FIRHILB(_c2r_execute)(FIRHILB() _q,                        \
                            TC        _x,                        \
                            T *       _y);                       \
                                                                 \
+/* execute Hilbert transform (real to complex) on a block */    \
+/* of samples                                             */    \
+/*  _q      :   Hilbert transform object                  */    \
+/*  _x      :   real-valued input array [size: _n x 1]    */    \
+/*  _n      :   number of input samples                   */    \
+/*  _y      :   complex-valued output array [size: _n x 1]*/    \
+void FIRHILB(_r2c_execute_block)(FIRHILB()    _q,               \
+                                 T *          _x,               \
+                                 unsigned int _n,               \
+                                 TC *         _y);              \
+                                                                \
+/* execute Hilbert transform (complex to real) on a block */    \
+/* of samples                                             */    \
+/*  _q      :   Hilbert transform object                  */    \
+/*  _x      :   complex-valued input array [size: _n x 1] */    \
+/*  _n      :   number of input samples                   */    \
+/*  _y      :   real-valued output array [size: _n x 1]   */    \
+void FIRHILB(_c2r_execute_block)(FIRHILB()    _q,               \
+                                 TC *         _x,               \
+                                 unsigned int _n,               \
+                                 T *          _y);              \
+                                                                \
 /* execute Hilbert transform decimator (real to complex)    */  \
 /*  _q      :   Hilbert transform object                    */  \
 /*  _x      :   real-valued input array [size: 2 x 1]       */  \
@@ -2345,6 +2832,18 @@ void IIRFILT(_execute_block)(IIRFILT()    _q,                   \
                              unsigned int _n,                   \
                              TO *         _y);                  \
                                                                 \
+/* enable block state-space mode for _execute_block(); each */  \
+/* block of outputs is computed from the state of each      */  \
+/* section without sample-to-sample recursion. The filter   */  \
+/* must be realized as second-order sections (or be of at   */  \
+/* most second order).                                      */  \
+/*  _q              : filter object                         */  \
+/*  _block_len      : block length, 0 to disable            */  \
+/*  _double_state   : keep state in double precision?       */  \
+void IIRFILT(_set_block_mode)(IIRFILT()    _q,                  \
+                              unsigned int _block_len,          \
+                              int          _double_state);      \
+                                                                \
 /* return iirfilt object's filter length (order + 1)        */  \
 unsigned int IIRFILT(_get_length)(IIRFILT() _q);                \
                                                                 \
@@ -2360,6 +2859,31 @@ void IIRFILT(_freqresponse)(IIRFILT()              _q,          \
 /*  _q      : filter object                                 */  \
 /*  _fc     : frequency to evaluate                         */  \
 float IIRFILT(_groupdelay)(IIRFILT() _q, float _fc);            \
+                                                                \
+/* compute complex frequency response of filter object on */    \
+/* uniform grid of frequencies _f0 + k*_df, k < _n        */    \
+/*  _q      : filter object                               */    \
+/*  _f0     : first grid frequency                        */    \
+/*  _df     : grid frequency spacing                      */    \
+/*  _n      : number of grid points                       */    \
+/*  _H      : output frequency response [size: _n x 1]    */    \
+void IIRFILT(_freqresponse_grid)(IIRFILT()              _q,     \
+                                 float                  _f0,    \
+                                 float                  _df,    \
+                                 unsigned int           _n,     \
+                                 liquid_float_complex * _H);    \
+                                                                \
+/* compute group delay of filter object on uniform grid   */    \
+/*  _q      : filter object                               */    \
+/*  _f0     : first grid frequency                        */    \
+/*  _df     : grid frequency spacing                      */    \
+/*  _n      : number of grid points                       */    \
+/*  _gd     : output group delay [size: _n x 1]           */    \
+void IIRFILT(_groupdelay_grid)(IIRFILT()    _q,                 \
+                               float        _f0,                \
+                               float        _df,                \
+                               unsigned int _n,                 \
+                               float *      _gd);               \
 
 LIQUID_IIRFILT_DEFINE_API(IIRFILT_MANGLE_RRRF,
                           float,
@@ -2376,6 +2900,265 @@ LIQUID_IIRFILT_DEFINE_API(IIRFILT_MANGLE_CCCF,
                           liquid_float_complex,
                           liquid_float_complex)
 
+//
+// Multi-channel infinite impulse response filter: runs the same
+// cascade of second-order sections over a number of synchronized
+// streams with the state of each section stored across channels
+//
+#define IIRFILTMC_MANGLE_RRRF(name) LIQUID_CONCAT(iirfiltmc_rrrf,name)
+#define IIRFILTMC_MANGLE_CRCF(name) LIQUID_CONCAT(iirfiltmc_crcf,name)
+#define IIRFILTMC_MANGLE_CCCF(name) LIQUID_CONCAT(iirfiltmc_cccf,name)
+
+// Macro:
+//   IIRFILTMC  : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_IIRFILTMC_DEFINE_API(IIRFILTMC,TO,TC,TI)         \
+typedef struct IIRFILTMC(_s) * IIRFILTMC();                     \
+                                                                \
+/* create multi-channel filter using second-order sections  */  \
+/*  _num_channels : number of channels, _num_channels > 0   */  \
+/*  _B      : feed-forward coefficients [size: _nsos x 3]   */  \
+/*  _A      : feed-back coefficients    [size: _nsos x 3]   */  \
+/*  _nsos   : number of second-order sections, _nsos > 0    */  \
+IIRFILTMC() IIRFILTMC(_create_sos)(unsigned int _num_channels,  \
+                                   TC *         _B,             \
+                                   TC *         _A,             \
+                                   unsigned int _nsos);         \
+                                                                \
+/* create multi-channel filter from design template; the    */  \
+/* filter is always realized as second-order sections       */  \
+/*  _num_channels : number of channels, _num_channels > 0   */  \
+/*  _ftype  : filter type (e.g. LIQUID_IIRDES_BUTTER)       */  \
+/*  _btype  : band type (e.g. LIQUID_IIRDES_BANDPASS)       */  \
+/*  _order  : filter order                                  */  \
+/*  _fc     : low-pass prototype cut-off frequency          */  \
+/*  _f0     : center frequency (band-pass, band-stop)       */  \
+/*  _Ap     : pass-band ripple in dB                        */  \
+/*  _As     : stop-band ripple in dB                        */  \
+IIRFILTMC() IIRFILTMC(_create_prototype)(                       \
+            unsigned int             _num_channels,             \
+            liquid_iirdes_filtertype _ftype,                    \
+            liquid_iirdes_bandtype   _btype,                    \
+            unsigned int             _order,                    \
+            float _fc,                                          \
+            float _f0,                                          \
+            float _Ap,                                          \
+            float _As);                                         \
+                                                                \
+/* create multi-channel DC-blocking filter                  */  \
+IIRFILTMC() IIRFILTMC(_create_dc_blocker)(                      \
+            unsigned int _num_channels,                         \
+            float        _alpha);                               \
+                                                                \
+/* destroy filter object and free all internal memory       */  \
+void IIRFILTMC(_destroy)(IIRFILTMC() _q);                       \
+                                                                \
+/* reset filter object's internal state                     */  \
+void IIRFILTMC(_reset)(IIRFILTMC() _q);                         \
+                                                                \
+/* print filter object information                          */  \
+void IIRFILTMC(_print)(IIRFILTMC() _q);                         \
+                                                                \
+/* get number of channels                                   */  \
+unsigned int IIRFILTMC(_get_num_channels)(IIRFILTMC() _q);      \
+                                                                \
+/* get number of second-order sections                      */  \
+unsigned int IIRFILTMC(_get_num_sections)(IIRFILTMC() _q);      \
+                                                                \
+/* execute the filter on one frame (one sample per channel) */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input frame  [size: num_channels x 1]         */  \
+/*  _y      : output frame [size: num_channels x 1]         */  \
+void IIRFILTMC(_execute)(IIRFILTMC() _q,                        \
+                         TI *        _x,                        \
+                         TO *        _y);                       \
+                                                                \
+/* execute the filter on a block of interleaved samples     */  \
+/* (sample i of channel c at index i*num_channels + c); the */  \
+/* input and output buffers may be the same                 */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input array [size: _n*num_channels x 1]       */  \
+/*  _n      : number of samples per channel                 */  \
+/*  _y      : output array [size: _n*num_channels x 1]      */  \
+void IIRFILTMC(_execute_block)(IIRFILTMC()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
+                                                                \
+/* execute the filter on a block of planar samples (sample  */  \
+/* i of channel c at index c*_n + i); the input and output  */  \
+/* buffers may be the same                                  */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input array [size: num_channels*_n x 1]       */  \
+/*  _n      : number of samples per channel                 */  \
+/*  _y      : output array [size: num_channels*_n x 1]      */  \
+void IIRFILTMC(_execute_block_planar)(IIRFILTMC()  _q,          \
+                                      TI *         _x,          \
+                                      unsigned int _n,          \
+                                      TO *         _y);         \
+
+LIQUID_IIRFILTMC_DEFINE_API(IIRFILTMC_MANGLE_RRRF,
+                            float,
+                            float,
+                            float)
+
+LIQUID_IIRFILTMC_DEFINE_API(IIRFILTMC_MANGLE_CRCF,
+                            liquid_float_complex,
+                            float,
+                            liquid_float_complex)
+
+LIQUID_IIRFILTMC_DEFINE_API(IIRFILTMC_MANGLE_CCCF,
+                            liquid_float_complex,
+                            liquid_float_complex,
+                            liquid_float_complex)
+
+//
+// Multi-channel Q15 fixed-point infinite impulse response filter
+// (cascade of second-order sections on signed 16-bit samples;
+// interleaved cs16 I/Q streams are filtered as two channels)
+//
+typedef struct iirfiltq15_s * iirfiltq15;
+
+// create Q15 filter from second-order sections, as designed by
+// liquid_iirdes() with LIQUID_IIRDES_SOS; sections are scaled
+// automatically to unity peak cumulative gain
+//  _num_channels : number of channels, _num_channels > 0
+//  _B      : feed-forward coefficients [size: _nsos x 3]
+//  _A      : feed-back coefficients    [size: _nsos x 3]
+//  _nsos   : number of second-order sections, _nsos > 0
+iirfiltq15 iirfiltq15_create_sos(unsigned int _num_channels,
+                                 float *      _B,
+                                 float *      _A,
+                                 unsigned int _nsos);
+
+// create Q15 filter from design template (see iirfiltmc)
+iirfiltq15 iirfiltq15_create_prototype(unsigned int             _num_channels,
+                                       liquid_iirdes_filtertype _ftype,
+                                       liquid_iirdes_bandtype   _btype,
+                                       unsigned int             _order,
+                                       float                    _fc,
+                                       float                    _f0,
+                                       float                    _Ap,
+                                       float                    _As);
+
+// create Q15 DC-blocking filter with first-order error feedback
+iirfiltq15 iirfiltq15_create_dc_blocker(unsigned int _num_channels,
+                                        float        _alpha);
+
+// destroy filter object and free all internal memory
+void iirfiltq15_destroy(iirfiltq15 _q);
+
+// reset filter object's internal state
+void iirfiltq15_reset(iirfiltq15 _q);
+
+// print filter object information
+void iirfiltq15_print(iirfiltq15 _q);
+
+// set order of rounding error feedback (noise shaping) in each
+// section: 0 (none, default), 1 (first-order) or 2 (second-order)
+void iirfiltq15_set_error_feedback(iirfiltq15   _q,
+                                   unsigned int _order);
+
+// get number of channels
+unsigned int iirfiltq15_get_num_channels(iirfiltq15 _q);
+
+// get number of second-order sections
+unsigned int iirfiltq15_get_num_sections(iirfiltq15 _q);
+
+// execute the filter on one frame (one sample per channel)
+//  _q      : filter object
+//  _x      : input frame  [size: num_channels x 1]
+//  _y      : output frame [size: num_channels x 1]
+void iirfiltq15_execute(iirfiltq15 _q,
+                        int16_t *  _x,
+                        int16_t *  _y);
+
+// execute the filter on a block of interleaved samples (sample i
+// of channel c at index i*num_channels + c); the input and output
+// buffers may be the same
+//  _q      : filter object
+//  _x      : input array [size: _n*num_channels x 1]
+//  _n      : number of samples per channel
+//  _y      : output array [size: _n*num_channels x 1]
+void iirfiltq15_execute_block(iirfiltq15   _q,
+                              int16_t *    _x,
+                              unsigned int _n,
+                              int16_t *    _y);
+
+
+//
+// Shared FIR coefficient bank
+//
+#define FIRBANK_MANGLE_RRRF(name) LIQUID_CONCAT(firbank_rrrf,name)
+#define FIRBANK_MANGLE_CRCF(name) LIQUID_CONCAT(firbank_crcf,name)
+#define FIRBANK_MANGLE_CCCF(name) LIQUID_CONCAT(firbank_cccf,name)
+
+// Macro:
+//   FIRBANK : name-mangling macro
+//   TO      : output data type
+//   TC      : coefficients data type
+//   TI      : input data type
+#define LIQUID_FIRBANK_DEFINE_API(FIRBANK,TO,TC,TI)             \
+                                                                \
+/* Read-only, reference-counted bank of FIR sub-filters     */  \
+/* (polyphase partition of a prototype) which can be        */  \
+/* shared among many filter instances                       */  \
+typedef struct FIRBANK(_s) * FIRBANK();                         \
+                                                                \
+/* create bank from polyphase partition of prototype;       */  \
+/* sub-filter i holds taps _h[i + n*_M]                     */  \
+/*  _M      : number of sub-filters                         */  \
+/*  _h      : prototype coefficients [size: _h_len x 1]     */  \
+/*  _h_len  : prototype filter length                       */  \
+FIRBANK() FIRBANK(_create)(unsigned int _M,                     \
+                           TC *         _h,                     \
+                           unsigned int _h_len);                \
+                                                                \
+/* add reference to bank, returning the bank itself         */  \
+FIRBANK() FIRBANK(_retain)(FIRBANK() _q);                       \
+                                                                \
+/* release reference to bank, freeing with last reference   */  \
+void FIRBANK(_destroy)(FIRBANK() _q);                           \
+                                                                \
+/* print bank object                                        */  \
+void FIRBANK(_print)(FIRBANK() _q);                             \
+                                                                \
+/* get number of sub-filters                                */  \
+unsigned int FIRBANK(_get_num_filters)(FIRBANK() _q);           \
+                                                                \
+/* get length of each sub-filter                            */  \
+unsigned int FIRBANK(_get_sub_len)(FIRBANK() _q);               \
+                                                                \
+/* get number of references held to bank                    */  \
+unsigned int FIRBANK(_get_num_refs)(FIRBANK() _q);              \
+                                                                \
+/* run sub-filter on input buffer                           */  \
+/*  _q      : bank object                                   */  \
+/*  _i      : sub-filter index                              */  \
+/*  _x      : input buffer, oldest sample first             */  \
+/*  _y      : output sample pointer                         */  \
+void FIRBANK(_execute)(FIRBANK()    _q,                         \
+                       unsigned int _i,                         \
+                       TI *         _x,                         \
+                       TO *         _y);                        \
+
+LIQUID_FIRBANK_DEFINE_API(FIRBANK_MANGLE_RRRF,
+                          float,
+                          float,
+                          float)
+
+LIQUID_FIRBANK_DEFINE_API(FIRBANK_MANGLE_CRCF,
+                          liquid_float_complex,
+                          float,
+                          liquid_float_complex)
+
+LIQUID_FIRBANK_DEFINE_API(FIRBANK_MANGLE_CCCF,
+                          liquid_float_complex,
+                          liquid_float_complex,
+                          liquid_float_complex)
+
 
 //
 // FIR Polyphase filter bank
@@ -2386,10 +3169,11 @@ LIQUID_IIRFILT_DEFINE_API(IIRFILT_MANGLE_CCCF,
 
 // Macro:
 //   FIRPFB : name-mangling macro
+//   FIRBANK: coefficient bank name-mangling macro
 //   TO     : output data type
 //   TC     : coefficients data type
 //   TI     : input data type
-#define LIQUID_FIRPFB_DEFINE_API(FIRPFB,TO,TC,TI)               \
+#define LIQUID_FIRPFB_DEFINE_API(FIRPFB,FIRBANK,TO,TC,TI)       \
                                                                 \
 typedef struct FIRPFB(_s) * FIRPFB();                           \
                                                                 \
@@ -2435,6 +3219,17 @@ FIRPFB() FIRPFB(_create_drnyquist)(int          _type,          \
                                    unsigned int _m,             \
                                    float        _beta);         \
                                                                 \
+/* create firpfb from shared coefficient bank, adding a     */  \
+/* reference to the bank                                    */  \
+FIRPFB() FIRPFB(_create_bank)(FIRBANK() _bank);                 \
+                                                                \
+/* create firpfb sharing coefficients of existing object;   */  \
+/* scale is copied, internal state is reset                 */  \
+FIRPFB() FIRPFB(_create_shared)(FIRPFB() _q);                   \
+                                                                \
+/* get coefficient bank (reference owned by object)         */  \
+FIRBANK() FIRPFB(_get_bank)(FIRPFB() _q);                       \
+                                                                \
 /* re-create filterbank object                              */  \
 /*  _q      : original firpfb object                        */  \
 /*  _M      : number of filters in the bank                 */  \
@@ -2470,16 +3265,19 @@ void FIRPFB(_execute)(FIRPFB()     _q,                          \
                       TO *         _y);                         \
 
 LIQUID_FIRPFB_DEFINE_API(FIRPFB_MANGLE_RRRF,
+                         FIRBANK_MANGLE_RRRF,
                          float,
                          float,
                          float)
 
 LIQUID_FIRPFB_DEFINE_API(FIRPFB_MANGLE_CRCF,
+                         FIRBANK_MANGLE_CRCF,
                          liquid_float_complex,
                          float,
                          liquid_float_complex)
 
 LIQUID_FIRPFB_DEFINE_API(FIRPFB_MANGLE_CCCF,
+                         FIRBANK_MANGLE_CCCF,
                          liquid_float_complex,
                          liquid_float_complex,
                          liquid_float_complex)
@@ -2525,6 +3323,10 @@ FIRINTERP() FIRINTERP(_create_prototype)(int          _type,    \
                                          float        _beta,    \
                                          float        _dt);     \
                                                                 \
+/* create interpolator sharing coefficients of existing     */  \
+/* object; internal state is reset                          */  \
+FIRINTERP() FIRINTERP(_create_shared)(FIRINTERP() _q);          \
+                                                                \
 /* destroy firinterp object, freeing all internal memory    */  \
 void FIRINTERP(_destroy)(FIRINTERP() _q);                       \
                                                                 \
@@ -2692,6 +3494,10 @@ FIRDECIM() FIRDECIM(_create_prototype)(int          _type,      \
                                        float        _beta,      \
                                        float        _dt);       \
                                                                 \
+/* create decimator sharing coefficients of existing        */  \
+/* object; internal state is reset                          */  \
+FIRDECIM() FIRDECIM(_create_shared)(FIRDECIM() _q);             \
+                                                                \
 /* destroy decimator object                                 */  \
 void FIRDECIM(_destroy)(FIRDECIM() _q);                         \
                                                                 \
@@ -2734,6 +3540,76 @@ LIQUID_FIRDECIM_DEFINE_API(FIRDECIM_MANGLE_CCCF,
                            liquid_float_complex,
                            liquid_float_complex)
 
+// firdecimmc : multi-channel finite impulse response decimator
+#define FIRDECIMMC_MANGLE_RRRF(name) LIQUID_CONCAT(firdecimmc_rrrf,name)
+#define FIRDECIMMC_MANGLE_CRCF(name) LIQUID_CONCAT(firdecimmc_crcf,name)
+#define FIRDECIMMC_MANGLE_CCCF(name) LIQUID_CONCAT(firdecimmc_cccf,name)
+
+#define LIQUID_FIRDECIMMC_DEFINE_API(FIRDECIMMC,TO,TC,TI)       \
+typedef struct FIRDECIMMC(_s) * FIRDECIMMC();                   \
+                                                                \
+/* create multi-channel decimator from external coefficients*/  \
+/*  _num_channels : number of channels, _num_channels > 0   */  \
+/*  _M            : decimation factor                       */  \
+/*  _h            : filter coefficients [size: _h_len x 1]  */  \
+/*  _h_len        : filter coefficients length              */  \
+FIRDECIMMC() FIRDECIMMC(_create)(unsigned int _num_channels,    \
+                                 unsigned int _M,               \
+                                 TC *         _h,               \
+                                 unsigned int _h_len);          \
+                                                                \
+/* destroy decimator object                                 */  \
+void FIRDECIMMC(_destroy)(FIRDECIMMC() _q);                     \
+                                                                \
+/* print decimator object propreties to stdout              */  \
+void FIRDECIMMC(_print)(FIRDECIMMC() _q);                       \
+                                                                \
+/* reset decimator object internal state                    */  \
+void FIRDECIMMC(_clear)(FIRDECIMMC() _q);                       \
+                                                                \
+/* execute decimator on _M interleaved input frames         */  \
+/*  _q      : decimator object                              */  \
+/*  _x      : input samples [size: _M*num_channels x 1]     */  \
+/*  _y      : output frame [size: num_channels x 1]         */  \
+void FIRDECIMMC(_execute)(FIRDECIMMC() _q,                      \
+                          TI *         _x,                      \
+                          TO *         _y);                     \
+                                                                \
+/* execute decimator on block of interleaved samples        */  \
+/*  _q      : decimator object                              */  \
+/*  _x      : input array [size: _n*_M*num_channels x 1]    */  \
+/*  _n      : number of _output_ samples per channel        */  \
+/*  _y      : output array [size: _n*num_channels x 1]      */  \
+void FIRDECIMMC(_execute_block)(FIRDECIMMC() _q,                \
+                                TI *         _x,                \
+                                unsigned int _n,                \
+                                TO *         _y);               \
+                                                                \
+/* execute decimator on block of planar samples             */  \
+/*  _q      : decimator object                              */  \
+/*  _x      : input array [size: num_channels*_n*_M x 1]    */  \
+/*  _n      : number of _output_ samples per channel        */  \
+/*  _y      : output array [size: num_channels*_n x 1]      */  \
+void FIRDECIMMC(_execute_block_planar)(FIRDECIMMC() _q,         \
+                                       TI *         _x,         \
+                                       unsigned int _n,         \
+                                       TO *         _y);        \
+
+LIQUID_FIRDECIMMC_DEFINE_API(FIRDECIMMC_MANGLE_RRRF,
+                             float,
+                             float,
+                             float)
+
+LIQUID_FIRDECIMMC_DEFINE_API(FIRDECIMMC_MANGLE_CRCF,
+                             liquid_float_complex,
+                             float,
+                             liquid_float_complex)
+
+LIQUID_FIRDECIMMC_DEFINE_API(FIRDECIMMC_MANGLE_CCCF,
+                             liquid_float_complex,
+                             liquid_float_complex,
+                             liquid_float_complex)
+
 
 // iirdecim : infinite impulse response decimator
 #define IIRDECIM_MANGLE_RRRF(name)  LIQUID_CONCAT(iirdecim_rrrf,name)
@@ -2911,6 +3787,26 @@ void RESAMP2(_decim_execute)(RESAMP2() _q,                      \
 void RESAMP2(_interp_execute)(RESAMP2() _q,                     \
                               TI        _x,                     \
                               TO *      _y);                    \
+                                                                \
+/* execute resamp2 as half-band decimator on block         */  \
+/*  _q      :   resamp2 object                              */  \
+/*  _x      :   input array  [size: 2*_n x 1]               */  \
+/*  _n      :   number of output samples                    */  \
+/*  _y      :   output array [size: _n x 1]                 */  \
+void RESAMP2(_decim_execute_block)(RESAMP2()    _q,             \
+                                   TI *         _x,             \
+                                   unsigned int _n,             \
+                                   TO *         _y);            \
+                                                                \
+/* execute resamp2 as half-band interpolator on block       */  \
+/*  _q      :   resamp2 object                              */  \
+/*  _x      :   input array  [size: _n x 1]                 */  \
+/*  _n      :   number of input samples                     */  \
+/*  _y      :   output array [size: 2*_n x 1]               */  \
+void RESAMP2(_interp_execute_block)(RESAMP2()    _q,            \
+                                    TI *         _x,            \
+                                    unsigned int _n,            \
+                                    TO *         _y);           \
 
 LIQUID_RESAMP2_DEFINE_API(RESAMP2_MANGLE_RRRF,
                           float,
@@ -3014,6 +3910,94 @@ LIQUID_RESAMP_DEFINE_API(RESAMP_MANGLE_CCCF,
                          liquid_float_complex)
 
 
+// 
+// Rational-rate resampler
+//
+#define RRESAMP_MANGLE_RRRF(name)   LIQUID_CONCAT(rresamp_rrrf,name)
+#define RRESAMP_MANGLE_CRCF(name)   LIQUID_CONCAT(rresamp_crcf,name)
+#define RRESAMP_MANGLE_CCCF(name)   LIQUID_CONCAT(rresamp_cccf,name)
+
+#define LIQUID_RRESAMP_DEFINE_API(RRESAMP,TO,TC,TI)             \
+typedef struct RRESAMP(_s) * RRESAMP();                         \
+                                                                \
+/* create rational-rate resampler object with rate P/Q; the */  \
+/* rate is reduced internally by the greatest common        */  \
+/* divisor of P and Q                                       */  \
+/*  _P      : interpolation factor (output block size)      */  \
+/*  _Q      : decimation factor (input block size)          */  \
+/*  _m      : filter semi-length (delay) in input samples   */  \
+/*  _bw     : filter bandwidth relative to the lower of the */  \
+/*            input/output sample rates, 0 < _bw < 0.5      */  \
+/*  _As     : filter stop-band attenuation [dB]             */  \
+RRESAMP() RRESAMP(_create)(unsigned int _P,                     \
+                           unsigned int _Q,                     \
+                           unsigned int _m,                     \
+                           float        _bw,                    \
+                           float        _As);                   \
+                                                                \
+/* create rational-rate resampler object with default       */  \
+/* filter parameters (m=12, bw=0.45, As=60 dB)              */  \
+/*  _P      : interpolation factor                          */  \
+/*  _Q      : decimation factor                             */  \
+RRESAMP() RRESAMP(_create_default)(unsigned int _P,             \
+                                   unsigned int _Q);            \
+                                                                \
+/* destroy rational-rate resampler object                   */  \
+void RRESAMP(_destroy)(RRESAMP() _q);                           \
+                                                                \
+/* print rresamp object internals to stdout                 */  \
+void RRESAMP(_print)(RRESAMP() _q);                             \
+                                                                \
+/* reset rresamp object internal state                      */  \
+void RRESAMP(_reset)(RRESAMP() _q);                             \
+                                                                \
+/* get resampler delay (input samples)                      */  \
+unsigned int RRESAMP(_get_delay)(RRESAMP() _q);                 \
+                                                                \
+/* get (reduced) interpolation factor P (output block size) */  \
+unsigned int RRESAMP(_get_P)(RRESAMP() _q);                     \
+                                                                \
+/* get (reduced) decimation factor Q (input block size)     */  \
+unsigned int RRESAMP(_get_Q)(RRESAMP() _q);                     \
+                                                                \
+/* get resampling rate, P/Q                                 */  \
+float RRESAMP(_get_rate)(RRESAMP() _q);                         \
+                                                                \
+/* execute rational-rate resampler on a single block of Q   */  \
+/* input samples, producing exactly P output samples        */  \
+/*  _q      : rresamp object                                */  \
+/*  _x      : input sample array  [size: Q x 1]             */  \
+/*  _y      : output sample array [size: P x 1]             */  \
+void RRESAMP(_execute)(RRESAMP() _q,                            \
+                       TI *      _x,                            \
+                       TO *      _y);                           \
+                                                                \
+/* execute rational-rate resampler on a number of blocks    */  \
+/*  _q      : rresamp object                                */  \
+/*  _x      : input sample array  [size: Q*_n x 1]          */  \
+/*  _n      : number of blocks                              */  \
+/*  _y      : output sample array [size: P*_n x 1]          */  \
+void RRESAMP(_execute_block)(RRESAMP()    _q,                   \
+                             TI *         _x,                   \
+                             unsigned int _n,                   \
+                             TO *         _y);                  \
+
+LIQUID_RRESAMP_DEFINE_API(RRESAMP_MANGLE_RRRF,
+                          float,
+                          float,
+                          float)
+
+LIQUID_RRESAMP_DEFINE_API(RRESAMP_MANGLE_CRCF,
+                          liquid_float_complex,
+                          float,
+                          liquid_float_complex)
+
+LIQUID_RRESAMP_DEFINE_API(RRESAMP_MANGLE_CCCF,
+                          liquid_float_complex,
+                          liquid_float_complex,
+                          liquid_float_complex)
+
+
 // 
 // Multi-stage half-band resampler
 //
@@ -3064,6 +4048,18 @@ float MSRESAMP2(_get_delay)(MSRESAMP2() _q);                    \
 void MSRESAMP2(_execute)(MSRESAMP2() _q,                        \
                          TI *        _x,                        \
                          TO *        _y);                       \
+                                                                \
+/* execute multi-stage resampler on block of frames         */  \
+/*  _q      : msresamp object                               */  \
+/*  _x      : input array; _n samples (interpolator) or     */  \
+/*            _n*2^_num_stages samples (decimator)          */  \
+/*  _n      : number of frames                              */  \
+/*  _y      : output array; _n*2^_num_stages samples        */  \
+/*            (interpolator) or _n samples (decimator)      */  \
+void MSRESAMP2(_execute_block)(MSRESAMP2()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
 
 LIQUID_MSRESAMP2_DEFINE_API(MSRESAMP2_MANGLE_RRRF,
                             float,
@@ -3081,6 +4077,81 @@ LIQUID_MSRESAMP2_DEFINE_API(MSRESAMP2_MANGLE_CCCF,
                             liquid_float_complex)
 
 
+// 
+// Multi-stage decimator: chain of half-band decimators followed
+// by a final decimating FIR filter, processed in blocks
+//
+#define MSDECIM_MANGLE_RRRF(name) LIQUID_CONCAT(msdecim_rrrf,name)
+#define MSDECIM_MANGLE_CRCF(name) LIQUID_CONCAT(msdecim_crcf,name)
+#define MSDECIM_MANGLE_CCCF(name) LIQUID_CONCAT(msdecim_cccf,name)
+
+#define LIQUID_MSDECIM_DEFINE_API(MSDECIM,TO,TC,TI)             \
+typedef struct MSDECIM(_s) * MSDECIM();                         \
+                                                                \
+/* create multi-stage decimator, M = 2^_num_stages * _D     */  \
+/*  _num_stages : number of half-band stages (<= 16)        */  \
+/*  _fc         : pass-band edge relative to half-band      */  \
+/*                chain output rate, 0 < _fc < 0.5          */  \
+/*  _As         : half-band stop-band attenuation [dB]      */  \
+/*  _D          : final decimation rate, _D > 0             */  \
+/*  _h          : final filter coefficients [size: _h_len]  */  \
+/*  _h_len      : final filter length, _h_len > 0           */  \
+MSDECIM() MSDECIM(_create)(unsigned int _num_stages,            \
+                           float        _fc,                    \
+                           float        _As,                    \
+                           unsigned int _D,                     \
+                           TC *         _h,                     \
+                           unsigned int _h_len);                \
+                                                                \
+/* destroy multi-stage decimator                            */  \
+void MSDECIM(_destroy)(MSDECIM() _q);                           \
+                                                                \
+/* print object internals to stdout                         */  \
+void MSDECIM(_print)(MSDECIM() _q);                             \
+                                                                \
+/* reset object internal state                              */  \
+void MSDECIM(_reset)(MSDECIM() _q);                             \
+                                                                \
+/* get total decimation rate, M                             */  \
+unsigned int MSDECIM(_get_decim_rate)(MSDECIM() _q);            \
+                                                                \
+/* get total group delay of cascade [input samples]         */  \
+float MSDECIM(_get_delay)(MSDECIM() _q);                        \
+                                                                \
+/* execute decimator on M input samples                     */  \
+/*  _q      : decimator object                              */  \
+/*  _x      : input array [size: M x 1]                     */  \
+/*  _y      : output sample pointer                         */  \
+void MSDECIM(_execute)(MSDECIM() _q,                            \
+                       TI *      _x,                            \
+                       TO *      _y);                           \
+                                                                \
+/* execute decimator on block of input samples              */  \
+/*  _q      : decimator object                              */  \
+/*  _x      : input array [size: _n*M x 1]                  */  \
+/*  _n      : number of output samples                      */  \
+/*  _y      : output array [size: _n x 1]                   */  \
+void MSDECIM(_execute_block)(MSDECIM()    _q,                   \
+                             TI *         _x,                   \
+                             unsigned int _n,                   \
+                             TO *         _y);                  \
+
+LIQUID_MSDECIM_DEFINE_API(MSDECIM_MANGLE_RRRF,
+                          float,
+                          float,
+                          float)
+
+LIQUID_MSDECIM_DEFINE_API(MSDECIM_MANGLE_CRCF,
+                          liquid_float_complex,
+                          float,
+                          liquid_float_complex)
+
+LIQUID_MSDECIM_DEFINE_API(MSDECIM_MANGLE_CCCF,
+                          liquid_float_complex,
+                          liquid_float_complex,
+                          liquid_float_complex)
+
+
 // 
 // Multi-stage arbitrary resampler
 //
@@ -3180,6 +4251,10 @@ SYMSYNC() SYMSYNC(_create_kaiser)(unsigned int _k,              \
                                   float        _beta,           \
                                   unsigned int _M);             \
                                                                 \
+/* create symsync sharing coefficients of existing          */  \
+/* object; internal state is reset                          */  \
+SYMSYNC() SYMSYNC(_create_shared)(SYMSYNC() _q);                \
+                                                                \
 /* destroy symsync object, freeing all internal memory      */  \
 void SYMSYNC(_destroy)(SYMSYNC() _q);                           \
                                                                 \
@@ -3285,6 +4360,24 @@ void FIRFARROW(_set_delay)(FIRFARROW() _q,                      \
 void FIRFARROW(_execute)(FIRFARROW() _q,                        \
                          TO *        _y);                       \
                                                                 \
+/* execute firfarrow using the Farrow structure: Q+1 fixed */  \
+/* sub-filters combined with Horner's rule on the delay;    */  \
+/* use when the delay changes on every output sample        */  \
+/*  _q      : firfarrow object                              */  \
+/*  _mu     : fractional sample delay                       */  \
+/*  _y      : output sample pointer                         */  \
+void FIRFARROW(_execute_farrow)(FIRFARROW() _q,                 \
+                                float       _mu,                \
+                                TO *        _y);                \
+                                                                \
+/* enable quantized delay coefficient cache; taps are       */  \
+/* computed for _n delays uniformly spaced in [-1,1] and    */  \
+/* _set_delay() selects the nearest                         */  \
+/*  _q      : firfarrow object                              */  \
+/*  _n      : number of cached delays (0 to disable)        */  \
+void FIRFARROW(_set_delay_cache)(FIRFARROW()  _q,               \
+                                 unsigned int _n);              \
+                                                                \
 /* compute firfarrow filter on block of samples; the input  */  \
 /* and output arrays may have the same pointer              */  \
 /*  _q      : firfarrow object                              */  \
@@ -4646,6 +5739,10 @@ unsigned int liquid_primitive_root_prime(unsigned int _n);
 // Euler's totient function
 unsigned int liquid_totient(unsigned int _n);
 
+// compute greatest common divisor of _p and _q
+unsigned int liquid_gcd(unsigned int _p,
+                        unsigned int _q);
+
 
 //
 // MODULE : matrix
@@ -5726,6 +6823,31 @@ void FIRPFBCH(_synthesizer_execute)(FIRPFBCH() _q,              \
 void FIRPFBCH(_analyzer_execute)(FIRPFBCH() _q,                 \
                                  TI *       _x,                 \
                                  TO *       _y);                \
+                                                                \
+/* enable channel; filterbank state is shared by all        */  \
+/* channels so no reset is needed                           */  \
+/*  _q      : filterbank channelizer object                 */  \
+/*  _k      : channel index, _k < num_channels              */  \
+void FIRPFBCH(_enable_channel)(FIRPFBCH()   _q,                 \
+                               unsigned int _k);                \
+                                                                \
+/* disable channel; analyzer output for the channel is      */  \
+/* set to zero, synthesizer input is ignored                */  \
+/*  _q      : filterbank channelizer object                 */  \
+/*  _k      : channel index, _k < num_channels              */  \
+void FIRPFBCH(_disable_channel)(FIRPFBCH()   _q,                \
+                                unsigned int _k);               \
+                                                                \
+/* enable all channels (default)                            */  \
+void FIRPFBCH(_enable_all)(FIRPFBCH() _q);                      \
+                                                                \
+/* disable all channels                                     */  \
+void FIRPFBCH(_disable_all)(FIRPFBCH() _q);                     \
+                                                                \
+/* get number of enabled channels; when only a few are      */  \
+/* enabled they are computed directly instead of with       */  \
+/* the full transform                                       */  \
+unsigned int FIRPFBCH(_get_num_active)(FIRPFBCH() _q);
 
 
 LIQUID_FIRPFBCH_DEFINE_API(FIRPFBCH_MANGLE_CRCF,
@@ -5791,6 +6913,17 @@ void FIRPFBCH2(_print)(FIRPFBCH2() _q);                         \
 void FIRPFBCH2(_execute)(FIRPFBCH2() _q,                        \
                          TI *        _x,                        \
                          TO *        _y);                       \
+                                                                \
+/* execute filterbank channelizer on a block of hops        */  \
+/* LIQUID_ANALYZER:     input: _n*M/2, output: _n*M         */  \
+/* LIQUID_SYNTHESIZER:  input: _n*M,   output: _n*M/2       */  \
+/*  _x      :   channelizer input                           */  \
+/*  _n      :   number of hops                              */  \
+/*  _y      :   channelizer output                          */  \
+void FIRPFBCH2(_execute_block)(FIRPFBCH2()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
 
 
 LIQUID_FIRPFBCH2_DEFINE_API(FIRPFBCH2_MANGLE_CRCF,
@@ -5799,6 +6932,161 @@ LIQUID_FIRPFBCH2_DEFINE_API(FIRPFBCH2_MANGLE_CRCF,
                             liquid_float_complex)
 
 
+//
+// Multi-threaded firpfbch2 analyzer, dispatching each channel's
+// output to a callback run from a pool of worker threads
+//
+
+// channel output callback
+//  _channel    :   channel index
+//  _y          :   channel output samples, [size: _n x 1]
+//  _n          :   number of samples
+//  _userdata   :   user-defined data
+typedef void (*firpfbch2mt_callback)(unsigned int           _channel,
+                                     liquid_float_complex * _y,
+                                     unsigned int           _n,
+                                     void *                 _userdata);
+
+typedef struct firpfbch2mt_crcf_s * firpfbch2mt_crcf;
+
+// create multi-threaded analysis channelizer using Kaiser prototype
+//  _M              :   number of channels (must be even)
+//  _m              :   prototype filter semi-length, length=2*M*m+1
+//  _As             :   filter stop-band attenuation [dB]
+//  _num_workers    :   number of worker threads, 0 to run callbacks
+//                      in the caller's thread
+//  _queue_len      :   per-channel queue length [samples]
+firpfbch2mt_crcf firpfbch2mt_crcf_create(unsigned int _M,
+                                         unsigned int _m,
+                                         float        _As,
+                                         unsigned int _num_workers,
+                                         unsigned int _queue_len);
+
+// destroy object, stopping worker threads once all queued samples
+// have been processed
+void firpfbch2mt_crcf_destroy(firpfbch2mt_crcf _q);
+
+// reset analyzer, waiting for all queued samples to be processed
+void firpfbch2mt_crcf_reset(firpfbch2mt_crcf _q);
+
+// print object internals
+void firpfbch2mt_crcf_print(firpfbch2mt_crcf _q);
+
+// get number of worker threads
+unsigned int firpfbch2mt_crcf_get_num_workers(firpfbch2mt_crcf _q);
+
+// set callback for channel output; a NULL callback disables the
+// channel (default)
+//  _q          :   channelizer object
+//  _k          :   channel index, _k < M
+//  _callback   :   callback function
+//  _userdata   :   user-defined data passed to callback
+void firpfbch2mt_crcf_set_callback(firpfbch2mt_crcf     _q,
+                                   unsigned int         _k,
+                                   firpfbch2mt_callback _callback,
+                                   void *               _userdata);
+
+// assign channel to worker thread (default: _k % num_workers);
+// callbacks for a channel are always run in order from its worker
+//  _q          :   channelizer object
+//  _k          :   channel index, _k < M
+//  _worker     :   worker index, _worker < num_workers
+void firpfbch2mt_crcf_set_worker(firpfbch2mt_crcf _q,
+                                 unsigned int     _k,
+                                 unsigned int     _worker);
+
+// pin worker thread to processor, -1 for any (default); returns
+// 0 on success, -1 if thread affinity is not supported
+//  _q          :   channelizer object
+//  _worker     :   worker index, _worker < num_workers
+//  _cpu        :   processor index
+int firpfbch2mt_crcf_set_worker_cpu(firpfbch2mt_crcf _q,
+                                    unsigned int     _worker,
+                                    int              _cpu);
+
+// run analyzer on block of input, dispatching each enabled channel's
+// output to its callback; blocks while any channel queue is full
+//  _q          :   channelizer object
+//  _x          :   input samples, [size: _n*M/2 x 1]
+//  _n          :   number of hops
+void firpfbch2mt_crcf_execute(firpfbch2mt_crcf       _q,
+                              liquid_float_complex * _x,
+                              unsigned int           _n);
+
+// wait until all queued samples have been processed
+void firpfbch2mt_crcf_flush(firpfbch2mt_crcf _q);
+
+
+//
+// Finite impulse response polyphase filterbank channelizer
+// with output rate Fs / P (rational oversampling M/P)
+//
+
+#define FIRPFBCHR_MANGLE_CRCF(name) LIQUID_CONCAT(firpfbchr_crcf,name)
+
+// Macro:
+//   FIRPFBCHR  : name-mangling macro
+//   TO         : output data type
+//   TC         : coefficients data type
+//   TI         : input data type
+#define LIQUID_FIRPFBCHR_DEFINE_API(FIRPFBCHR,TO,TC,TI)         \
+typedef struct FIRPFBCHR(_s) * FIRPFBCHR();                     \
+                                                                \
+/* create firpfbchr object                                  */  \
+/*  _type   :   channelizer type (e.g. LIQUID_ANALYZER)     */  \
+/*  _M      :   number of channels                          */  \
+/*  _P      :   hop size (output decimation), 0 < P <= M    */  \
+/*  _m      :   prototype filter semi-lenth, length=2*M*m   */  \
+/*  _h      :   prototype filter coefficients, DC gain M    */  \
+FIRPFBCHR() FIRPFBCHR(_create)(int          _type,              \
+                               unsigned int _M,                 \
+                               unsigned int _P,                 \
+                               unsigned int _m,                 \
+                               TC *         _h);                \
+                                                                \
+/* create firpfbchr object using Kaiser window prototype    */  \
+/*  _type   :   channelizer type (e.g. LIQUID_ANALYZER)     */  \
+/*  _M      :   number of channels                          */  \
+/*  _P      :   hop size (output decimation), 0 < P <= M    */  \
+/*  _m      :   prototype filter semi-lenth, length=2*M*m+1 */  \
+/*  _As     :   filter stop-band attenuation [dB]           */  \
+FIRPFBCHR() FIRPFBCHR(_create_kaiser)(int          _type,       \
+                                      unsigned int _M,          \
+                                      unsigned int _P,          \
+                                      unsigned int _m,          \
+                                      float        _As);        \
+                                                                \
+/* destroy firpfbchr object, freeing internal memory        */  \
+void FIRPFBCHR(_destroy)(FIRPFBCHR() _q);                       \
+                                                                \
+/* reset firpfbchr object internals                         */  \
+void FIRPFBCHR(_reset)(FIRPFBCHR() _q);                         \
+                                                                \
+/* print firpfbchr object internals                         */  \
+void FIRPFBCHR(_print)(FIRPFBCHR() _q);                         \
+                                                                \
+/* get number of channels                                   */  \
+unsigned int FIRPFBCHR(_get_M)(FIRPFBCHR() _q);                 \
+                                                                \
+/* get hop size                                             */  \
+unsigned int FIRPFBCHR(_get_P)(FIRPFBCHR() _q);                 \
+                                                                \
+/* execute filterbank channelizer                           */  \
+/* LIQUID_ANALYZER:     input: P, output: M                 */  \
+/* LIQUID_SYNTHESIZER:  input: M, output: P                 */  \
+/*  _x      :   channelizer input                           */  \
+/*  _y      :   channelizer output                          */  \
+void FIRPFBCHR(_execute)(FIRPFBCHR() _q,                        \
+                         TI *        _x,                        \
+                         TO *        _y);                       \
+
+
+LIQUID_FIRPFBCHR_DEFINE_API(FIRPFBCHR_MANGLE_CRCF,
+                            liquid_float_complex,
+                            float,
+                            liquid_float_complex)
+
+
 
 #define OFDMFRAME_SCTYPE_NULL   0
 #define OFDMFRAME_SCTYPE_PILOT  1
@@ -36,6 +36,7 @@
 #include "config.h"
 
 #include <complex.h>
+#include <stddef.h>
 #include "liquid.h"
 
 #if defined HAVE_FEC_H && defined HAVE_LIBFEC
@@ -68,6 +69,38 @@
 // MODULE : buffer
 //
 
+// assumed cache line size [bytes] for separating data shared
+// between threads
+#define LIQUID_CACHE_LINE_SIZE          (64)
+
+// minimum buffer size [bytes] for which window, cbuffer and spscbuffer
+// objects use mirrored (double-mapped) memory when available
+#define LIQUID_BUFFER_MIRROR_MIN_SIZE   (4096)
+
+// window and cbuffer objects use heap memory unless configured with
+// --enable-mirror: mirrored memory is a shared mapping, so unlike heap
+// memory it is not copied on write in child processes after fork()
+#ifdef LIQUID_BUFFER_MIRROR
+#  define LIQUID_BUFFER_MIRROR_ENABLED  1
+#else
+#  define LIQUID_BUFFER_MIRROR_ENABLED  0
+#endif
+
+// round size up to a whole number of pages, as required by
+// liquid_mirror_alloc()
+size_t liquid_mirror_size(size_t _size);
+
+// allocate mirrored memory; returns pointer p such that p[i] and
+// p[i+_size] refer to the same byte for 0 <= i < _size, or NULL if
+// mirrored memory is unavailable or _size is not a multiple of the
+// system page size
+void * liquid_mirror_alloc(size_t _size);
+
+// free mirrored memory
+//  _p      : pointer returned by liquid_mirror_alloc()
+//  _size   : size passed to liquid_mirror_alloc()
+void liquid_mirror_free(void * _p,
+                        size_t _size);
 
 //
 // MODULE : dotprod
@@ -724,6 +757,13 @@ FFT(_execute_t) FFT(_execute_dft_16);                           \
 /* additional methods */                                        \
 unsigned int FFT(_estimate_mixed_radix)(unsigned int _nfft);    \
                                                                 \
+/* execute complex plan on _n consecutive input arrays, */      \
+/* writing _n consecutive output arrays, each nfft long  */     \
+void FFT(_execute_many)(FFT(plan)    _q,                        \
+                        TC *         _x,                        \
+                        TC *         _y,                        \
+                        unsigned int _n);                       \
+                                                                \
 /* discrete cosine transform (DCT) prototypes */                \
 void FFT(_execute_REDFT00)(FFT(plan) _q);   /* DCT-I   */       \
 void FFT(_execute_REDFT10)(FFT(plan) _q);   /* DCT-II  */       \
@@ -765,6 +805,15 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #   define FFT_DIR_FORWARD      FFTW_FORWARD
 #   define FFT_DIR_BACKWARD     FFTW_BACKWARD
 #   define FFT_METHOD           FFTW_ESTIMATE
+// plans used with FFT_EXECUTE_MANY run on caller buffers of arbitrary
+// alignment and so must not assume SIMD alignment
+#   define FFT_METHOD_MANY      (FFTW_ESTIMATE | FFTW_UNALIGNED)
+#   define FFT_EXECUTE_MANY(P,NFFT,X,Y,N)                       \
+    do {                                                        \
+        unsigned int _k;                                        \
+        for (_k=0; _k<(N); _k++)                                \
+            fftwf_execute_dft(P, (X)+_k*(NFFT), (Y)+_k*(NFFT)); \
+    } while (0)
 #else
 #   define FFT_PLAN             fftplan
 #   define FFT_CREATE_PLAN      fft_create_plan
@@ -773,6 +822,8 @@ LIQUID_FFT_DEFINE_INTERNAL_API(LIQUID_FFT_MANGLE_FLOAT, float, liquid_float_comp
 #   define FFT_DIR_FORWARD      LIQUID_FFT_FORWARD
 #   define FFT_DIR_BACKWARD     LIQUID_FFT_BACKWARD
 #   define FFT_METHOD           0
+#   define FFT_METHOD_MANY      0
+#   define FFT_EXECUTE_MANY(P,NFFT,X,Y,N) fft_execute_many(P,X,Y,N)
 #endif
 
 
@@ -901,9 +952,83 @@ LIQUID_IIRFILTSOS_DEFINE_INTERNAL_API(IIRFILTSOS_MANGLE_CCCF,
                                       liquid_float_complex,
                                       liquid_float_complex)
 
+// 
+// iirfiltss : block state-space realization of a cascade of
+//             second-order sections (used by iirfilt block mode)
+//
+#define IIRFILTSS_MANGLE_RRRF(name)  LIQUID_CONCAT(iirfiltss_rrrf,name)
+#define IIRFILTSS_MANGLE_CRCF(name)  LIQUID_CONCAT(iirfiltss_crcf,name)
+#define IIRFILTSS_MANGLE_CCCF(name)  LIQUID_CONCAT(iirfiltss_cccf,name)
+
+#define LIQUID_IIRFILTSS_DEFINE_INTERNAL_API(IIRFILTSS,TO,TC,TI)    \
+typedef struct IIRFILTSS(_s) * IIRFILTSS();                     \
+                                                                \
+/* create block state-space filter from sections            */  \
+/*  _B      : feed-forward coefficients [size: _nsos x 3]   */  \
+/*  _A      : feed-back coefficients    [size: _nsos x 3]   */  \
+/*  _nsos   : number of second-order sections               */  \
+/*  _L      : block length                                  */  \
+/*  _double_state : keep state in double precision?         */  \
+IIRFILTSS() IIRFILTSS(_create)(TC *         _B,                 \
+                               TC *         _A,                 \
+                               unsigned int _nsos,              \
+                               unsigned int _L,                 \
+                               int          _double_state);     \
+                                                                \
+/* destroy object, freeing all internal memory              */  \
+void IIRFILTSS(_destroy)(IIRFILTSS() _q);                       \
+                                                                \
+/* reset internal state                                     */  \
+void IIRFILTSS(_reset)(IIRFILTSS() _q);                         \
+                                                                \
+/* set/get state as direct-form II buffers                  */  \
+/*  _v      : {w[n-1], w[n-2]} per section [size: _nsos x 2]*/  \
+void IIRFILTSS(_set_state)(IIRFILTSS() _q, TO * _v);            \
+void IIRFILTSS(_get_state)(IIRFILTSS() _q, TO * _v);            \
+                                                                \
+/* execute filter on block of samples                       */  \
+/*  _q      : filter object                                 */  \
+/*  _x      : input array [size: _n x 1]                    */  \
+/*  _n      : number of input, output samples               */  \
+/*  _y      : output array [size: _n x 1]                   */  \
+void IIRFILTSS(_execute_block)(IIRFILTSS()  _q,                 \
+                               TI *         _x,                 \
+                               unsigned int _n,                 \
+                               TO *         _y);                \
+
+LIQUID_IIRFILTSS_DEFINE_INTERNAL_API(IIRFILTSS_MANGLE_RRRF,
+                                     float,
+                                     float,
+                                     float)
+
+LIQUID_IIRFILTSS_DEFINE_INTERNAL_API(IIRFILTSS_MANGLE_CRCF,
+                                     liquid_float_complex,
+                                     float,
+                                     liquid_float_complex)
+
+LIQUID_IIRFILTSS_DEFINE_INTERNAL_API(IIRFILTSS_MANGLE_CCCF,
+                                     liquid_float_complex,
+                                     liquid_float_complex,
+                                     liquid_float_complex)
+
 
 // firdes : finite impulse response filter design
 
+// Design FIR using kaiser window, bypassing design cache
+void liquid_firdes_kaiser_internal(unsigned int _n,
+                                   float        _fc,
+                                   float        _As,
+                                   float        _mu,
+                                   float *      _h);
+
+// Design (root-)Nyquist filter from prototype, bypassing design cache
+void liquid_firdes_prototype_internal(liquid_firfilt_type _type,
+                                      unsigned int        _k,
+                                      unsigned int        _m,
+                                      float               _beta,
+                                      float               _dt,
+                                      float *             _h);
+
 // Find approximate bandwidth adjustment factor rho based on
 // filter delay and desired excess bandwdith factor.
 //
@@ -988,9 +1113,21 @@ void liquid_firdes_farcsech_freqresponse(unsigned int _k,
 
 
 
-// initialize the frequency grid on the disjoint bounded set
+// initialize the frequency grid on the disjoint bounded set,
+// (re-)allocating grid arrays for the current grid density
 void firdespm_init_grid(firdespm _q);
 
+// run Remez exchange algorithm on current grid
+void firdespm_iterate(firdespm     _q,
+                      unsigned int _max_iterations);
+
+// set extremal indices to grid points nearest to frequencies _fext
+void firdespm_map_iext(firdespm _q,
+                       double * _fext);
+
+// compute barycentric weights on the extremal set
+void firdespm_compute_weights(firdespm _q);
+
 // compute interpolating polynomial
 void firdespm_compute_interp(firdespm _q);
 
@@ -998,6 +1135,11 @@ void firdespm_compute_interp(firdespm _q);
 // output), desired response, and weights
 void firdespm_compute_error(firdespm _q);
 
+// compute error signal on grid points [_i0, _i1)
+void firdespm_compute_error_range(firdespm     _q,
+                                  unsigned int _i0,
+                                  unsigned int _i1);
+
 // search error curve for _r+1 extremal indices
 void firdespm_iext_search(firdespm _q);
 
@@ -1462,6 +1604,10 @@ extern const float complex modem_arb256opt[256];
 // MODULE : multichannel
 //
 
+// firpfbch computes enabled channels directly rather than with the
+// full transform while num_active < FIRPFBCH_SPARSE_RATIO*log2(M)
+#define FIRPFBCH_SPARSE_RATIO   (0.75f)
+
 // ofdm frame (common)
 
 // generate short sequence symbols
@@ -1496,12 +1642,25 @@ void ofdmframesync_cpcorrelate(ofdmframesync _q);
 void ofdmframesync_findrxypeak(ofdmframesync _q);
 void ofdmframesync_rxpayload(ofdmframesync _q);
 
+// number of input samples up to and including the next one on which
+// the current state's timer expires
+unsigned int ofdmframesync_get_block_len(ofdmframesync _q);
+
 void ofdmframesync_execute_seekplcp(ofdmframesync _q);
 void ofdmframesync_execute_S0a(ofdmframesync _q);
 void ofdmframesync_execute_S0b(ofdmframesync _q);
 void ofdmframesync_execute_S1( ofdmframesync _q);
 void ofdmframesync_execute_rxsymbols(ofdmframesync _q);
 
+// receive whole payload symbols directly from the input while aligned
+// to a symbol boundary, returning the number of samples consumed
+unsigned int ofdmframesync_execute_rxsymbols_block(ofdmframesync   _q,
+                                                   float complex * _x,
+                                                   unsigned int    _n);
+
+// demodulate payload symbol in transform input and invoke callback
+void ofdmframesync_rxsymbols_demod(ofdmframesync _q);
+
 void ofdmframesync_S0_metrics(ofdmframesync _q,
                               float complex * _G,
                               float complex * _s_hat);
@@ -1537,6 +1696,12 @@ void ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
 // recover symbol, correcting for gain, pilot phase, etc.
 void ofdmframesync_rxsymbol(ofdmframesync _q);
 
+// generate complex phase ramp: y[i] = exp(j*(theta + i*dtheta))
+void ofdmframesync_gen_ramp(float complex * _y,
+                            unsigned int    _n,
+                            float           _theta,
+                            float           _dtheta);
+
 // 
 // MODULE : nco (numerically-controlled oscillator)
 //
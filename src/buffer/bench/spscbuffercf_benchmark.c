@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define SPSCBUFFERCF_BENCH_API(N, W, R)     \
+(   struct rusage *     _start,             \
+    struct rusage *     _finish,            \
+    unsigned long int * _num_iterations)    \
+{ spscbuffercf_bench(_start, _finish, _num_iterations, N, W, R); }
+
+// Helper function to keep code base small; mirrors cbuffercf_bench()
+// but exercises the lock-free producer and consumer paths from a
+// single thread
+void spscbuffercf_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _n,
+                        unsigned int        _write_size,
+                        unsigned int        _read_size)
+{
+    // validate input
+    if (_n < 2) {
+        fprintf(stderr,"error: spscbuffercf_bench(), number of elements must be at least 2\n");
+        exit(1);
+    } else if (_write_size > _n-1) {
+        fprintf(stderr,"error: spscbuffercf_bench(), write size must be in (0,n)\n");
+        exit(1);
+    } else if (_read_size > _n-1) {
+        fprintf(stderr,"error: spscbuffercf_bench(), read size must be in (0,n)\n");
+        exit(1);
+    }
+
+    // normalize number of iterations
+    *_num_iterations *= _n;
+
+    // create object
+    spscbuffercf q = spscbuffercf_create(_n);
+
+    // arrays for writing and reading
+    float complex v[_write_size];
+    float complex r[_read_size];
+    unsigned int i;
+    for (i=0; i<_write_size; i++)
+        v[i] = 0.0f;
+
+    // accumulate total number of elements
+    unsigned long int num_total_elements = 0;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    while (num_total_elements < *_num_iterations) {
+        // write elements to buffer if space is available
+        if (spscbuffercf_space_available(q) > _write_size)
+            spscbuffercf_write(q, v, _write_size);
+
+        // read up to '_read_size' elements
+        num_total_elements += spscbuffercf_read(q, r, _read_size);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    // total number of iterations equal to to total number of elements
+    // that have passed through the buffer
+    *_num_iterations = num_total_elements;
+
+    // clean up allocated memory
+    spscbuffercf_destroy(q);
+}
+
+// 
+void benchmark_spscbuffercf_n16     SPSCBUFFERCF_BENCH_API(  16,  12,  11);
+void benchmark_spscbuffercf_n64     SPSCBUFFERCF_BENCH_API(  64,  48,  47);
+void benchmark_spscbuffercf_n256    SPSCBUFFERCF_BENCH_API( 256, 192, 191);
+void benchmark_spscbuffercf_n1024   SPSCBUFFERCF_BENCH_API(1024, 768, 767);
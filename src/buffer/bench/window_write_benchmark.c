@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define WINDOW_WRITE_BENCH_API(N,B)     \
+(   struct rusage *_start,              \
+    struct rusage *_finish,             \
+    unsigned long int *_num_iterations) \
+{ window_write_bench(_start, _finish, _num_iterations, N, B); }
+
+// Helper function to keep code base small
+//  _n          : window length
+//  _block_len  : number of samples per write
+void window_write_bench(struct rusage *_start,
+                        struct rusage *_finish,
+                        unsigned long int *_num_iterations,
+                        unsigned int _n,
+                        unsigned int _block_len)
+{
+    // normalize number of iterations
+    *_num_iterations = (*_num_iterations * 32) / _block_len;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // initialize window and input block
+    windowcf w = windowcf_create(_n);
+    float complex x[_block_len];
+    unsigned long int i;
+    for (i=0; i<_block_len; i++)
+        x[i] = 1.0f;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        windowcf_write(w, x, _block_len);
+    getrusage(RUSAGE_SELF, _finish);
+
+    // one trial per sample
+    *_num_iterations *= _block_len;
+
+    windowcf_destroy(w);
+}
+
+// 
+void benchmark_windowcf_write_n64_b16     WINDOW_WRITE_BENCH_API(  64,  16)
+void benchmark_windowcf_write_n256_b64    WINDOW_WRITE_BENCH_API( 256,  64)
+void benchmark_windowcf_write_n1024_b80   WINDOW_WRITE_BENCH_API(1024,  80)
+void benchmark_windowcf_write_n1024_b512  WINDOW_WRITE_BENCH_API(1024, 512)
+void benchmark_windowcf_write_n4096_b1024 WINDOW_WRITE_BENCH_API(4096,1024)
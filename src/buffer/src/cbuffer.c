@@ -46,6 +46,16 @@ struct CBUFFER(_s) {
 
     // number of elements allocated in memory
     unsigned int num_allocated;
+
+    // index modulus: max_size or, if memory is mirrored (see
+    // liquid_mirror_alloc()), the number of elements in one mapping
+    unsigned int ring_size;
+
+    // memory is mirrored at v + ring_size; no linearization needed
+    int mirrored;
+
+    // memory is provided by the caller and is not freed on destroy
+    int external;
     
     // number of elements currently in buffer
     unsigned int num_elements;
@@ -82,9 +92,65 @@ CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,
 
     // internal memory allocation
     q->num_allocated = q->max_size + q->max_read - 1;
+    q->ring_size     = q->max_size;
+
+    // allocate internal memory array on the heap or, if configured
+    // with --enable-mirror, in mirrored memory for large buffers (ring
+    // rounded up to a whole number of pages)
+    q->v = NULL;
+    if (LIQUID_BUFFER_MIRROR_ENABLED && q->max_read > 1 &&
+        q->max_size*sizeof(T) >= LIQUID_BUFFER_MIRROR_MIN_SIZE)
+    {
+        size_t num_bytes = liquid_mirror_size(q->max_size*sizeof(T));
+        if ((num_bytes % sizeof(T)) == 0 && q->max_read <= num_bytes / sizeof(T))
+            q->v = (T*) liquid_mirror_alloc(num_bytes);
+        if (q->v != NULL) {
+            q->ring_size     = num_bytes / sizeof(T);
+            q->num_allocated = 2*q->ring_size;
+        }
+    }
+    q->mirrored = q->v != NULL;
+    if (!q->mirrored)
+        q->v = (T*) malloc((q->num_allocated)*sizeof(T));
+    q->external = 0;
+
+    // reset object
+    CBUFFER(_clear)(q);
+
+    // return main object
+    return q;
+}
+
+// create circular buffer object over memory provided by the caller
+// (e.g. hugepages or a driver DMA region); the memory is neither
+// copied nor freed by the object and must outlive it
+//  _v          : memory array [size: _max_size + _max_read - 1 x 1]
+//  _max_size   : maximum number of elements in buffer
+//  _max_read   : maximum number of elements read at once
+CBUFFER() CBUFFER(_create_external)(T *          _v,
+                                    unsigned int _max_size,
+                                    unsigned int _max_read)
+{
+    // validate input
+    if (_v == NULL) {
+        fprintf(stderr,"error: cbuffer%s_create_external(), memory array cannot be NULL\n", EXTENSION);
+        exit(1);
+    } else if (_max_size == 0 || _max_read == 0) {
+        fprintf(stderr,"error: cbuffer%s_create_external(), buffer and read sizes must be greater than zero\n", EXTENSION);
+        exit(1);
+    }
+
+    // create main object
+    CBUFFER() q = (CBUFFER()) malloc(sizeof(struct CBUFFER(_s)));
 
-    // allocate internal memory array
-    q->v = (T*) malloc((q->num_allocated)*sizeof(T));
+    // set internal properties
+    q->max_size      = _max_size;
+    q->max_read      = _max_read;
+    q->num_allocated = q->max_size + q->max_read - 1;
+    q->ring_size     = q->max_size;
+    q->v             = _v;
+    q->mirrored      = 0;
+    q->external      = 1;
 
     // reset object
     CBUFFER(_clear)(q);
@@ -96,8 +162,11 @@ CBUFFER() CBUFFER(_create_max)(unsigned int _max_size,
 // destroy cbuffer object, freeing all internal memory
 void CBUFFER(_destroy)(CBUFFER() _q)
 {
-    // free internal memory
-    free(_q->v);
+    // free internal memory (external memory belongs to the caller)
+    if (_q->mirrored)
+        liquid_mirror_free(_q->v, _q->ring_size*sizeof(T));
+    else if (!_q->external)
+        free(_q->v);
 
     // free main object
     free(_q);
@@ -115,7 +184,7 @@ void CBUFFER(_print)(CBUFFER() _q)
     unsigned int i;
     for (i=0; i<_q->num_elements; i++) {
         printf("%u", i);
-        BUFFER_PRINT_LINE(_q,(_q->read_index+i)%(_q->max_size))
+        BUFFER_PRINT_LINE(_q,(_q->read_index+i)%(_q->ring_size))
         printf("\n");
     }
 }
@@ -130,7 +199,7 @@ void CBUFFER(_debug_print)(CBUFFER() _q)
             _q->num_elements);
 
     unsigned int i;
-    for (i=0; i<_q->max_size; i++) {
+    for (i=0; i<_q->ring_size; i++) {
         // print read index pointer
         if (i==_q->read_index)
             printf("<r>");
@@ -150,7 +219,7 @@ void CBUFFER(_debug_print)(CBUFFER() _q)
     printf("----------------------------------\n");
 
     // print excess buffer memory
-    for (i=_q->max_size; i<_q->num_allocated; i++) {
+    for (i=_q->ring_size; i<_q->num_allocated; i++) {
         printf("      ");
         BUFFER_PRINT_LINE(_q,i)
         printf("\n");
@@ -213,7 +282,7 @@ void CBUFFER(_push)(CBUFFER() _q,
     _q->v[_q->write_index] = _v;
 
     // update write index
-    _q->write_index = (_q->write_index+1) % _q->max_size;
+    _q->write_index = (_q->write_index+1) % _q->ring_size;
 
     // increment number of elements
     _q->num_elements++;
@@ -235,7 +304,7 @@ void CBUFFER(_write)(CBUFFER()    _q,
 
     _q->num_elements += _n;
     // space available at end of buffer
-    unsigned int k = _q->max_size - _q->write_index;
+    unsigned int k = _q->ring_size - _q->write_index;
     //printf("n : %u, k : %u\n", _n, k);
 
     // check for condition where we need to wrap around
@@ -245,8 +314,44 @@ void CBUFFER(_write)(CBUFFER()    _q,
         _q->write_index = _n - k;
     } else {
         memmove(_q->v + _q->write_index, _v, _n*sizeof(T));
-        _q->write_index += _n;
+        _q->write_index = (_q->write_index + _n) % _q->ring_size;
+    }
+}
+
+// reserve contiguous region of the buffer for writing in place, e.g.
+// by a driver filling the buffer directly; complete the write with
+// CBUFFER(_write_commit)()
+//  _q  : circular buffer object
+//  _v  : output pointer to start of writable region
+//  _n  : number of elements that may be written at _v
+void CBUFFER(_write_reserve)(CBUFFER()      _q,
+                             T **           _v,
+                             unsigned int * _n)
+{
+    unsigned int space = _q->max_size - _q->num_elements;
+
+    // mirrored memory is contiguous across the end of the ring
+    unsigned int k = _q->ring_size - _q->write_index;
+    *_v = _q->v + _q->write_index;
+    *_n = (_q->mirrored || space < k) ? space : k;
+}
+
+// commit elements written into region from CBUFFER(_write_reserve)()
+//  _q  : circular buffer object
+//  _n  : number of elements written
+void CBUFFER(_write_commit)(CBUFFER()    _q,
+                            unsigned int _n)
+{
+    // ensure elements fit in the reserved region
+    unsigned int space = _q->max_size - _q->num_elements;
+    unsigned int k     = _q->ring_size - _q->write_index;
+    if (_n > space || (!_q->mirrored && _n > k)) {
+        printf("warning: cbuffer%s_write_commit(), cannot commit more elements than were reserved\n", EXTENSION);
+        return;
     }
+
+    _q->num_elements += _n;
+    _q->write_index = (_q->write_index + _n) % _q->ring_size;
 }
 
 // remove and return a single element from the buffer
@@ -267,7 +372,7 @@ void CBUFFER(_pop)(CBUFFER()    _q,
         *_v = _q->v[ _q->read_index ];
 
     // increment read index
-    _q->read_index = (_q->read_index + 1) % _q->max_size;
+    _q->read_index = (_q->read_index + 1) % _q->ring_size;
 
     // decrement number of elements in the buffer
     _q->num_elements--;
@@ -292,7 +397,7 @@ void CBUFFER(_read)(CBUFFER()      _q,
         _num_requested = _q->max_read;
 
     // linearize tail end of buffer if necessary
-    if (_num_requested > (_q->max_size - _q->read_index))
+    if (!_q->mirrored && _num_requested > (_q->max_size - _q->read_index))
         CBUFFER(_linearize)(_q);
     
     // set output pointer appropriately
@@ -310,7 +415,7 @@ void CBUFFER(_release)(CBUFFER()    _q,
         return;
     }
 
-    _q->read_index = (_q->read_index + _n) % _q->max_size;
+    _q->read_index = (_q->read_index + _n) % _q->ring_size;
     _q->num_elements -= _n;
 }
 
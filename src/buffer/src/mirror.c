@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// mirror.c
+//
+// Double-mapped ("mirrored") ring memory: the same physical pages are
+// mapped twice, back to back, so that any run of up to _size bytes
+// starting within the first mapping is contiguous in virtual memory.
+// Ring buffers placed in such memory never need to copy to present a
+// linear view across the wrap. Where the system does not provide the
+// required facilities, allocation fails and callers fall back to
+// ordinary heap memory.
+//
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_SYS_MMAN_H && HAVE_MEMFD_CREATE && HAVE_UNISTD_H
+#  include <sys/mman.h>
+#  include <unistd.h>
+#  define LIQUID_MIRROR_SUPPORTED 1
+#else
+#  define LIQUID_MIRROR_SUPPORTED 0
+#endif
+
+// round size up to a whole number of pages, as required by
+// liquid_mirror_alloc()
+size_t liquid_mirror_size(size_t _size)
+{
+#if LIQUID_MIRROR_SUPPORTED
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (page_size > 0)
+        return ((_size + (size_t)page_size - 1) / (size_t)page_size) * (size_t)page_size;
+#endif
+    return _size;
+}
+
+// allocate mirrored memory; returns pointer p such that p[i] and
+// p[i+_size] refer to the same byte for 0 <= i < _size, or NULL if
+// mirrored memory is unavailable or _size is not a multiple of the
+// system page size
+void * liquid_mirror_alloc(size_t _size)
+{
+#if LIQUID_MIRROR_SUPPORTED
+    long page_size = sysconf(_SC_PAGESIZE);
+    if (_size == 0 || page_size <= 0 || (_size % (size_t)page_size) != 0)
+        return NULL;
+
+    // anonymous in-memory file backing both mappings
+    int fd = memfd_create("liquid-mirror", MFD_CLOEXEC);
+    if (fd < 0)
+        return NULL;
+    if (ftruncate(fd, (off_t)_size) != 0) {
+        close(fd);
+        return NULL;
+    }
+
+    // reserve contiguous address range, then map file twice over it
+    unsigned char * p = (unsigned char*) mmap(NULL, 2*_size, PROT_NONE,
+                                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+        close(fd);
+        return NULL;
+    }
+    if (mmap(p,       _size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED ||
+        mmap(p+_size, _size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+    {
+        munmap(p, 2*_size);
+        close(fd);
+        return NULL;
+    }
+
+    // mappings hold their own reference to the file
+    close(fd);
+    return p;
+#else
+    return NULL;
+#endif
+}
+
+// free mirrored memory
+//  _p      : pointer returned by liquid_mirror_alloc()
+//  _size   : size passed to liquid_mirror_alloc()
+void liquid_mirror_free(void * _p,
+                        size_t _size)
+{
+#if LIQUID_MIRROR_SUPPORTED
+    if (_p != NULL)
+        munmap(_p, 2*_size);
+#endif
+}
+
@@ -0,0 +1,499 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// single-producer/single-consumer circular buffer
+//
+// Lock-free ring for moving samples between exactly two threads (e.g.
+// from an SDR driver thread into a processing thread). The producer
+// owns the write counter and the consumer owns the read counter; each
+// counter lives on its own cache line alongside the owner's copy of
+// the other side's counter, refreshed once per reservation, so that
+// the two threads contend for a line only when a reservation or
+// commit actually needs the other's progress. Counters run freely
+// and the ring length is a power of two, so that counter overflow is
+// benign.
+// Large rings are placed in mirrored memory (see liquid_mirror_alloc())
+// which lets every reservation span the full available region.
+//
+// A mutex and condition variables are used only to put a waiting
+// thread to sleep; the data path never takes a lock.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_STDATOMIC_H
+#  include <stdatomic.h>
+#  define SPSCBUFFER_INDEX              atomic_uint
+#  define SPSCBUFFER_LOAD_ACQUIRE(P)    atomic_load_explicit(P, memory_order_acquire)
+#  define SPSCBUFFER_LOAD_RELAXED(P)    atomic_load_explicit(P, memory_order_relaxed)
+#  define SPSCBUFFER_STORE_RELEASE(P,V) atomic_store_explicit(P, V, memory_order_release)
+#  define SPSCBUFFER_FENCE()            atomic_thread_fence(memory_order_seq_cst)
+#else
+#  define SPSCBUFFER_INDEX              volatile unsigned int
+#  define SPSCBUFFER_LOAD_ACQUIRE(P)    (__sync_synchronize(), *(P))
+#  define SPSCBUFFER_LOAD_RELAXED(P)    (*(P))
+#  define SPSCBUFFER_STORE_RELEASE(P,V) do { __sync_synchronize(); *(P) = (V); } while (0)
+#  define SPSCBUFFER_FENCE()            __sync_synchronize()
+#endif
+
+#if HAVE_LIBPTHREAD && HAVE_PTHREAD_H
+#  include <pthread.h>
+#  include <errno.h>
+#  include <sys/time.h>
+#  define SPSCBUFFER_THREADS 1
+#else
+#  define SPSCBUFFER_THREADS 0
+#endif
+
+struct SPSCBUFFER(_s) {
+    T * v;                          // ring memory
+    unsigned int max_size;          // maximum number of elements in buffer
+    unsigned int ring_size;         // ring length, power of two >= max_size
+    unsigned int mask;              // ring_size - 1
+    int mirrored;                   // ring is mirrored at v + ring_size
+
+    // watermark notification
+    unsigned int low;               // low watermark (consumer side)
+    unsigned int high;              // high watermark (producer side)
+    liquid_spscbuffer_callback callback;
+    void * userdata;
+
+#if SPSCBUFFER_THREADS
+    pthread_mutex_t lock;           // lock for sleeping only
+    pthread_cond_t  readable;       // signalled when data are committed
+    pthread_cond_t  writable;       // signalled when data are released
+#endif
+    SPSCBUFFER_INDEX num_waiting;   // number of threads asleep
+
+    // producer cache line
+    char pad0[LIQUID_CACHE_LINE_SIZE];
+    SPSCBUFFER_INDEX head;          // total number of elements written
+    unsigned int tail_cache;        // producer's copy of tail
+
+    // consumer cache line
+    char pad1[LIQUID_CACHE_LINE_SIZE];
+    SPSCBUFFER_INDEX tail;          // total number of elements read
+    unsigned int head_cache;        // consumer's copy of head
+    char pad2[LIQUID_CACHE_LINE_SIZE];
+};
+
+// wake any sleeping thread after progress has been published
+void SPSCBUFFER(_wake)(SPSCBUFFER() _q);
+
+// sleep until predicate holds or timeout elapses
+//  _q          : buffer object
+//  _readable   : wait for data (1) or space (0)
+//  _n          : number of elements
+//  _timeout_ms : timeout [ms], negative to wait forever
+int SPSCBUFFER(_wait)(SPSCBUFFER() _q,
+                      int          _readable,
+                      unsigned int _n,
+                      int          _timeout_ms);
+
+// create single-producer/single-consumer buffer
+//  _max_size   : maximum number of elements in buffer
+SPSCBUFFER() SPSCBUFFER(_create)(unsigned int _max_size)
+{
+    // validate input
+    if (_max_size == 0) {
+        fprintf(stderr,"error: spscbuffer%s_create(), buffer size must be greater than zero\n", EXTENSION);
+        exit(1);
+    } else if (_max_size > (1u << 30)) {
+        fprintf(stderr,"error: spscbuffer%s_create(), buffer size too large\n", EXTENSION);
+        exit(1);
+    }
+
+    // create main object
+    SPSCBUFFER() q = (SPSCBUFFER()) malloc(sizeof(struct SPSCBUFFER(_s)));
+    q->max_size  = _max_size;
+    q->ring_size = 1;
+    while (q->ring_size < q->max_size)
+        q->ring_size <<= 1;
+    q->mask = q->ring_size - 1;
+
+    // allocate ring, mirrored if large enough and available
+    q->v = NULL;
+    if (q->ring_size*sizeof(T) >= LIQUID_BUFFER_MIRROR_MIN_SIZE)
+        q->v = (T*) liquid_mirror_alloc(q->ring_size*sizeof(T));
+    q->mirrored = q->v != NULL;
+    if (!q->mirrored)
+        q->v = (T*) malloc(q->ring_size*sizeof(T));
+
+    // no watermarks
+    q->low      = 0;
+    q->high     = 0;
+    q->callback = NULL;
+    q->userdata = NULL;
+
+#if SPSCBUFFER_THREADS
+    pthread_mutex_init(&q->lock, NULL);
+    pthread_cond_init(&q->readable, NULL);
+    pthread_cond_init(&q->writable, NULL);
+#endif
+
+    SPSCBUFFER(_reset)(q);
+    return q;
+}
+
+// destroy buffer object, freeing all internal memory
+void SPSCBUFFER(_destroy)(SPSCBUFFER() _q)
+{
+#if SPSCBUFFER_THREADS
+    pthread_mutex_destroy(&_q->lock);
+    pthread_cond_destroy(&_q->readable);
+    pthread_cond_destroy(&_q->writable);
+#endif
+    if (_q->mirrored)
+        liquid_mirror_free(_q->v, _q->ring_size*sizeof(T));
+    else
+        free(_q->v);
+    free(_q);
+}
+
+// print buffer object properties
+void SPSCBUFFER(_print)(SPSCBUFFER() _q)
+{
+    printf("spscbuffer%s [max size: %u, elements: %u, ring: %u%s]\n",
+            EXTENSION,
+            _q->max_size,
+            SPSCBUFFER(_size)(_q),
+            _q->ring_size,
+            _q->mirrored ? ", mirrored" : "");
+}
+
+// reset buffer to empty; not thread-safe, call only while neither
+// producer nor consumer is active
+void SPSCBUFFER(_reset)(SPSCBUFFER() _q)
+{
+    SPSCBUFFER_STORE_RELEASE(&_q->head, 0);
+    SPSCBUFFER_STORE_RELEASE(&_q->tail, 0);
+    SPSCBUFFER_STORE_RELEASE(&_q->num_waiting, 0);
+    _q->tail_cache = 0;
+    _q->head_cache = 0;
+}
+
+// set watermark notification; the callback is invoked from the
+// producer thread when a commit raises the number of elements in the
+// buffer to at least _high, and from the consumer thread when a
+// release lowers it to at most _low; not thread-safe, call only
+// while neither producer nor consumer is active
+//  _q          : buffer object
+//  _low        : low watermark, 0 to disable
+//  _high       : high watermark, 0 to disable
+//  _callback   : notification function
+//  _userdata   : user-defined data passed to callback
+void SPSCBUFFER(_set_watermarks)(SPSCBUFFER()               _q,
+                                 unsigned int               _low,
+                                 unsigned int               _high,
+                                 liquid_spscbuffer_callback _callback,
+                                 void *                     _userdata)
+{
+    if (_high > _q->max_size) {
+        fprintf(stderr,"error: spscbuffer%s_set_watermarks(), high watermark exceeds buffer size\n", EXTENSION);
+        exit(1);
+    }
+    _q->low      = _low;
+    _q->high     = _high;
+    _q->callback = _callback;
+    _q->userdata = _userdata;
+}
+
+// get the number of elements currently in the buffer
+unsigned int SPSCBUFFER(_size)(SPSCBUFFER() _q)
+{
+    unsigned int tail = SPSCBUFFER_LOAD_ACQUIRE(&_q->tail);
+    unsigned int head = SPSCBUFFER_LOAD_ACQUIRE(&_q->head);
+    return head - tail;
+}
+
+// get the maximum number of elements the buffer can hold
+unsigned int SPSCBUFFER(_max_size)(SPSCBUFFER() _q)
+{
+    return _q->max_size;
+}
+
+// get the number of elements that may be written
+unsigned int SPSCBUFFER(_space_available)(SPSCBUFFER() _q)
+{
+    return _q->max_size - SPSCBUFFER(_size)(_q);
+}
+
+//
+// producer methods
+//
+
+// reserve contiguous region for writing (producer only)
+//  _q      : buffer object
+//  _v      : output pointer to writable region
+//  _return : number of elements that may be written at _v
+unsigned int SPSCBUFFER(_write_reserve)(SPSCBUFFER() _q,
+                                        T **         _v)
+{
+    unsigned int head = SPSCBUFFER_LOAD_RELAXED(&_q->head);
+
+    _q->tail_cache = SPSCBUFFER_LOAD_ACQUIRE(&_q->tail);
+    unsigned int space = _q->max_size - (head - _q->tail_cache);
+
+    // without mirroring the region ends at the end of the ring
+    unsigned int index = head & _q->mask;
+    if (!_q->mirrored && space > _q->ring_size - index)
+        space = _q->ring_size - index;
+
+    *_v = _q->v + index;
+    return space;
+}
+
+// commit elements written to reserved region (producer only)
+//  _q      : buffer object
+//  _n      : number of elements written
+void SPSCBUFFER(_write_commit)(SPSCBUFFER() _q,
+                               unsigned int _n)
+{
+    unsigned int head = SPSCBUFFER_LOAD_RELAXED(&_q->head);
+    if (_n > _q->max_size - (head - _q->tail_cache)) {
+        _q->tail_cache = SPSCBUFFER_LOAD_ACQUIRE(&_q->tail);
+        if (_n > _q->max_size - (head - _q->tail_cache)) {
+            fprintf(stderr,"warning: spscbuffer%s_write_commit(), cannot commit more elements than space available\n", EXTENSION);
+            return;
+        }
+    }
+
+    // publish elements
+    SPSCBUFFER_STORE_RELEASE(&_q->head, head + _n);
+    SPSCBUFFER(_wake)(_q);
+
+    // high watermark
+    if (_q->high > 0 && _q->callback != NULL) {
+        unsigned int size = head - SPSCBUFFER_LOAD_ACQUIRE(&_q->tail);
+        if (size < _q->high && size + _n >= _q->high)
+            _q->callback(_q->userdata, LIQUID_SPSCBUFFER_HIGH_WATERMARK, size + _n);
+    }
+}
+
+// write elements without blocking (producer only)
+//  _q      : buffer object
+//  _v      : input array [size: _n x 1]
+//  _n      : number of elements to write
+//  _return : number of elements written
+unsigned int SPSCBUFFER(_write)(SPSCBUFFER() _q,
+                                T *          _v,
+                                unsigned int _n)
+{
+    unsigned int num_written = 0;
+    T * w;
+    unsigned int k;
+    // at most two regions (across the end of the ring)
+    while (num_written < _n && (k = SPSCBUFFER(_write_reserve)(_q, &w)) > 0) {
+        if (k > _n - num_written)
+            k = _n - num_written;
+        memmove(w, _v + num_written, k*sizeof(T));
+        SPSCBUFFER(_write_commit)(_q, k);
+        num_written += k;
+    }
+    return num_written;
+}
+
+// wait until at least _n elements may be written (producer only)
+//  _q          : buffer object
+//  _n          : number of elements (clipped to buffer size)
+//  _timeout_ms : timeout [ms]; 0 to poll, negative to wait forever
+//  _return     : 1 if space is available, 0 on timeout
+int SPSCBUFFER(_wait_writable)(SPSCBUFFER() _q,
+                               unsigned int _n,
+                               int          _timeout_ms)
+{
+    return SPSCBUFFER(_wait)(_q, 0, _n, _timeout_ms);
+}
+
+//
+// consumer methods
+//
+
+// reserve contiguous region for reading (consumer only)
+//  _q      : buffer object
+//  _v      : output pointer to readable region
+//  _return : number of elements that may be read at _v
+unsigned int SPSCBUFFER(_read_reserve)(SPSCBUFFER() _q,
+                                       T **         _v)
+{
+    unsigned int tail = SPSCBUFFER_LOAD_RELAXED(&_q->tail);
+
+    _q->head_cache = SPSCBUFFER_LOAD_ACQUIRE(&_q->head);
+    unsigned int size = _q->head_cache - tail;
+
+    // without mirroring the region ends at the end of the ring
+    unsigned int index = tail & _q->mask;
+    if (!_q->mirrored && size > _q->ring_size - index)
+        size = _q->ring_size - index;
+
+    *_v = _q->v + index;
+    return size;
+}
+
+// release elements read from reserved region (consumer only)
+//  _q      : buffer object
+//  _n      : number of elements read
+void SPSCBUFFER(_read_release)(SPSCBUFFER() _q,
+                               unsigned int _n)
+{
+    unsigned int tail = SPSCBUFFER_LOAD_RELAXED(&_q->tail);
+    if (_n > _q->head_cache - tail) {
+        _q->head_cache = SPSCBUFFER_LOAD_ACQUIRE(&_q->head);
+        if (_n > _q->head_cache - tail) {
+            fprintf(stderr,"warning: spscbuffer%s_read_release(), cannot release more elements than are in buffer\n", EXTENSION);
+            return;
+        }
+    }
+
+    // return space to producer
+    SPSCBUFFER_STORE_RELEASE(&_q->tail, tail + _n);
+    SPSCBUFFER(_wake)(_q);
+
+    // low watermark
+    if (_q->low > 0 && _q->callback != NULL) {
+        unsigned int size = SPSCBUFFER_LOAD_ACQUIRE(&_q->head) - tail;
+        if (size > _q->low && size - _n <= _q->low)
+            _q->callback(_q->userdata, LIQUID_SPSCBUFFER_LOW_WATERMARK, size - _n);
+    }
+}
+
+// read elements without blocking (consumer only)
+//  _q      : buffer object
+//  _v      : output array [size: _n x 1]
+//  _n      : maximum number of elements to read
+//  _return : number of elements read
+unsigned int SPSCBUFFER(_read)(SPSCBUFFER() _q,
+                               T *          _v,
+                               unsigned int _n)
+{
+    unsigned int num_read = 0;
+    T * r;
+    unsigned int k;
+    // at most two regions (across the end of the ring)
+    while (num_read < _n && (k = SPSCBUFFER(_read_reserve)(_q, &r)) > 0) {
+        if (k > _n - num_read)
+            k = _n - num_read;
+        memmove(_v + num_read, r, k*sizeof(T));
+        SPSCBUFFER(_read_release)(_q, k);
+        num_read += k;
+    }
+    return num_read;
+}
+
+// wait until at least _n elements may be read (consumer only)
+//  _q          : buffer object
+//  _n          : number of elements (clipped to buffer size)
+//  _timeout_ms : timeout [ms]; 0 to poll, negative to wait forever
+//  _return     : 1 if data are available, 0 on timeout
+int SPSCBUFFER(_wait_readable)(SPSCBUFFER() _q,
+                               unsigned int _n,
+                               int          _timeout_ms)
+{
+    return SPSCBUFFER(_wait)(_q, 1, _n, _timeout_ms);
+}
+
+//
+// internal methods
+//
+
+// wake any sleeping thread after progress has been published
+void SPSCBUFFER(_wake)(SPSCBUFFER() _q)
+{
+#if SPSCBUFFER_THREADS
+    // order publication of index before checking for sleepers; pairs
+    // with the increment of num_waiting in SPSCBUFFER(_wait)
+    SPSCBUFFER_FENCE();
+    if (SPSCBUFFER_LOAD_RELAXED(&_q->num_waiting) == 0)
+        return;
+    pthread_mutex_lock(&_q->lock);
+    pthread_cond_broadcast(&_q->readable);
+    pthread_cond_broadcast(&_q->writable);
+    pthread_mutex_unlock(&_q->lock);
+#endif
+}
+
+// sleep until predicate holds or timeout elapses
+int SPSCBUFFER(_wait)(SPSCBUFFER() _q,
+                      int          _readable,
+                      unsigned int _n,
+                      int          _timeout_ms)
+{
+    if (_n > _q->max_size)
+        _n = _q->max_size;
+
+#define SPSCBUFFER_READY() (_readable ? SPSCBUFFER(_size)(_q) >= _n :  \
+                                        SPSCBUFFER(_space_available)(_q) >= _n)
+
+    // fast path: no lock
+    if (SPSCBUFFER_READY())
+        return 1;
+    if (_timeout_ms == 0)
+        return 0;
+
+#if SPSCBUFFER_THREADS
+    // absolute deadline
+    struct timespec deadline;
+    if (_timeout_ms > 0) {
+        struct timeval now;
+        gettimeofday(&now, NULL);
+        unsigned long int ns = (unsigned long int)now.tv_usec*1000UL +
+                               (unsigned long int)(_timeout_ms % 1000)*1000000UL;
+        deadline.tv_sec  = now.tv_sec + _timeout_ms/1000 + ns/1000000000UL;
+        deadline.tv_nsec = ns % 1000000000UL;
+    }
+
+    pthread_cond_t * cond = _readable ? &_q->readable : &_q->writable;
+    pthread_mutex_lock(&_q->lock);
+#if HAVE_STDATOMIC_H
+    atomic_fetch_add(&_q->num_waiting, 1);
+#else
+    __sync_fetch_and_add(&_q->num_waiting, 1);
+#endif
+    SPSCBUFFER_FENCE();
+    int ready;
+    while ( !(ready = SPSCBUFFER_READY()) ) {
+        if (_timeout_ms < 0)
+            pthread_cond_wait(cond, &_q->lock);
+        else if (pthread_cond_timedwait(cond, &_q->lock, &deadline) == ETIMEDOUT) {
+            ready = SPSCBUFFER_READY();
+            break;
+        }
+    }
+#if HAVE_STDATOMIC_H
+    atomic_fetch_sub(&_q->num_waiting, 1);
+#else
+    __sync_fetch_and_sub(&_q->num_waiting, 1);
+#endif
+    pthread_mutex_unlock(&_q->lock);
+    return ready;
+#else
+    // no threads: the other side cannot make progress while we wait
+    return 0;
+#endif
+#undef SPSCBUFFER_READY
+}
+
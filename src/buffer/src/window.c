@@ -39,6 +39,9 @@ struct WINDOW(_s) {
     unsigned int num_allocated; // number of elements allocated
                                 // in memory
     unsigned int read_index;
+    int mirrored;               // memory is mirrored at v + n (see
+                                // liquid_mirror_alloc()), no copying
+                                // is needed when the index wraps
 };
 
 // create window buffer object of length _n
@@ -63,8 +66,14 @@ WINDOW() WINDOW(_create)(unsigned int _n)
     // number of elements to allocate to memory
     q->num_allocated = q->n + q->len - 1;
 
-    // allocte memory
-    q->v = (T*) malloc((q->num_allocated)*sizeof(T));
+    // allocate memory on the heap or, if configured with
+    // --enable-mirror, in mirrored memory for large windows
+    q->v = NULL;
+    if (LIQUID_BUFFER_MIRROR_ENABLED && q->len*sizeof(T) >= LIQUID_BUFFER_MIRROR_MIN_SIZE)
+        q->v = (T*) liquid_mirror_alloc(q->n*sizeof(T));
+    q->mirrored = q->v != NULL;
+    if (!q->mirrored)
+        q->v = (T*) malloc((q->num_allocated)*sizeof(T));
     q->read_index = 0;
 
     // clear window
@@ -114,7 +123,10 @@ WINDOW() WINDOW(_recreate)(WINDOW() _q, unsigned int _n)
 void WINDOW(_destroy)(WINDOW() _q)
 {
     // free internal memory array
-    free(_q->v);
+    if (_q->mirrored)
+        liquid_mirror_free(_q->v, _q->n*sizeof(T));
+    else
+        free(_q->v);
 
     // free main object memory
     free(_q);
@@ -163,8 +175,8 @@ void WINDOW(_clear)(WINDOW() _q)
     // reset read index
     _q->read_index = 0;
 
-    // clear all allocated memory
-    memset(_q->v, 0, (_q->num_allocated)*sizeof(T));
+    // clear all allocated memory (mirrored memory is cleared once)
+    memset(_q->v, 0, (_q->mirrored ? _q->n : _q->num_allocated)*sizeof(T));
 }
 
 // read window buffer contents
@@ -206,7 +218,7 @@ void WINDOW(_push)(WINDOW() _q, T _v)
     _q->read_index &= _q->mask;
 
     // if pointer wraps around, copy excess memory
-    if (_q->read_index == 0)
+    if (_q->read_index == 0 && !_q->mirrored)
         memmove(_q->v, _q->v + _q->n, (_q->len-1)*sizeof(T));
 
     // append value to end of buffer
@@ -221,9 +233,29 @@ void WINDOW(_write)(WINDOW()     _q,
                     T *          _v,
                     unsigned int _n)
 {
-    // TODO make this more efficient
-    unsigned int i;
-    for (i=0; i<_n; i++)
-        WINDOW(_push)(_q, _v[i]);
+    // only the most recent 'len' values survive; place them at the
+    // start of memory and reset the read index
+    if (_n >= _q->len) {
+        _q->read_index = 0;
+        memmove(_q->v, _v + _n - _q->len, _q->len*sizeof(T));
+        return;
+    }
+
+    // new read index, wrapping at most once
+    unsigned int read_index = _q->read_index + _n;
+    if (read_index >= _q->n) {
+        read_index -= _q->n;
+
+        // retain the newest 'len-_n' values of the old window, which
+        // start exactly 'n' elements past the new read index (mirrored
+        // memory already holds them there)
+        if (!_q->mirrored)
+            memcpy(_q->v + read_index, _q->v + read_index + _q->n,
+                   (_q->len - _n)*sizeof(T));
+    }
+    _q->read_index = read_index;
+
+    // append values to end of buffer
+    memmove(_q->v + read_index + _q->len - _n, _v, _n*sizeof(T));
 }
 
@@ -291,4 +291,128 @@ void autotest_cbufferf_flow()
     cbufferf_destroy(q);
 }
 
+// test flow through buffers of a given size with pseudo-random
+// transfer lengths, checking that values are read back in order
+//  _max_size       : maximum number of elements in buffer
+//  _max_read       : maximum number of elements to read
+//  _num_elements   : total number of elements for run
+void cbufferf_test_flow(unsigned int _max_size,
+                        unsigned int _max_read,
+                        unsigned int _num_elements)
+{
+    cbufferf q = cbufferf_create_max(_max_size, _max_read);
+    float write_buffer[_max_size];
+
+    unsigned int i;
+    unsigned int write_id = 0;  // running total number of values written
+    unsigned int read_id  = 0;  // running total number of values read
+    unsigned int seed     = 1;  // transfer sizes (leaves rand() untouched)
+    int success = 1;
+    while (read_id < _num_elements && success) {
+        seed = 1103515245*seed + 12345;
+
+        // write some values
+        unsigned int num_space = cbufferf_space_available(q);
+        if (num_space > 0) {
+            unsigned int num_to_write = ((seed >> 8) % num_space) + 1;
+            for (i=0; i<num_to_write; i++)
+                write_buffer[i] = (float)(write_id++);
+            cbufferf_write(q, write_buffer, num_to_write);
+        }
+
+        // read some values, spanning the end of the ring over time
+        float * r;
+        unsigned int num_read;
+        cbufferf_read(q, ((seed >> 20) % cbufferf_size(q)) + 1, &r, &num_read);
+        for (i=0; i<num_read; i++) {
+            if (r[i] != (float)read_id)
+                success = 0;
+            read_id++;
+        }
+        cbufferf_release(q, num_read);
+    }
+    CONTEND_EXPRESSION(success == 1);
+
+    cbufferf_destroy(q);
+}
+
+// buffers of at least one page use mirrored memory when enabled
+void autotest_cbufferf_flow_page()  { cbufferf_test_flow(1024, 1000,  20000); }
+void autotest_cbufferf_flow_large() { cbufferf_test_flow(3000, 2500, 100000); }
+
+
+// test general flow writing in place with reserve/commit
+//  _max_size       : maximum number of elements in buffer
+//  _max_read       : maximum number of elements to read
+//  _num_elements   : total number of elements for run
+//  _external       : create buffer over caller-provided memory?
+void cbufferf_test_reserve(unsigned int _max_size,
+                           unsigned int _max_read,
+                           unsigned int _num_elements,
+                           int          _external)
+{
+    // create new circular buffer
+    float * mem = NULL;
+    cbufferf q;
+    if (_external) {
+        mem = (float*) malloc((_max_size + _max_read - 1)*sizeof(float));
+        q = cbufferf_create_external(mem, _max_size, _max_read);
+    } else {
+        q = cbufferf_create_max(_max_size, _max_read);
+    }
+
+    unsigned int i;
+    unsigned int write_id = 0;  // running total number of values written
+    unsigned int read_id  = 0;  // running total number of values read
+    unsigned int seed     = 1;  // transfer sizes (leaves rand() untouched)
+    int success = 1;
+    while (read_id < _num_elements && success) {
+        seed = 1103515245*seed + 12345;
+        // write some values in place
+        float * w;
+        unsigned int num_reserved;
+        cbufferf_write_reserve(q, &w, &num_reserved);
+        if (num_reserved > cbufferf_space_available(q))
+            success = 0;
+        if (num_reserved > 0) {
+            unsigned int num_to_write = ((seed >> 8) % num_reserved) + 1;
+            for (i=0; i<num_to_write; i++)
+                w[i] = (float)(write_id++);
+            cbufferf_write_commit(q, num_to_write);
+        }
+
+        // read some values
+        unsigned int num_available = cbufferf_size(q);
+        if (num_available == 0)
+            continue;
+        float * r;
+        unsigned int num_read;
+        cbufferf_read(q, ((seed >> 20) % num_available) + 1, &r, &num_read);
+        if (_external && (r < mem || r + num_read > mem + _max_size + _max_read - 1))
+            success = 0;
+        for (i=0; i<num_read; i++) {
+            if (r[i] != (float)read_id)
+                success = 0;
+            read_id++;
+        }
+        cbufferf_release(q, num_read);
+    }
+    CONTEND_EXPRESSION(success == 1);
+
+    // committing more than was reserved is rejected
+    cbufferf_clear(q);
+    float * w;
+    unsigned int num_reserved;
+    cbufferf_write_reserve(q, &w, &num_reserved);
+    cbufferf_write_commit(q, _max_size + 1);
+    CONTEND_EQUALITY(cbufferf_size(q), 0);
+
+    // destroy object, leaving external memory to the caller
+    cbufferf_destroy(q);
+    if (_external)
+        free(mem);
+}
 
+void autotest_cbufferf_reserve()          { cbufferf_test_reserve(  48,   17,   1200, 0); }
+void autotest_cbufferf_reserve_large()    { cbufferf_test_reserve(3000, 2500, 100000, 0); }
+void autotest_cbufferf_reserve_external() { cbufferf_test_reserve(  48,   17,   1200, 1); }
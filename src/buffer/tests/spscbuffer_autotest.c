@@ -0,0 +1,190 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// single-producer/single-consumer buffer autotest
+//
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.internal.h"
+
+#if HAVE_LIBPTHREAD && HAVE_PTHREAD_H
+#  include <pthread.h>
+#endif
+
+// reserve/commit across the end of the ring
+void autotest_spscbufferf()
+{
+    unsigned int i;
+    float v[12];
+    for (i=0; i<12; i++)
+        v[i] = (float)i;
+
+    // ring length rounds up to 16
+    spscbufferf q = spscbufferf_create(10);
+    CONTEND_EQUALITY( spscbufferf_max_size(q),        10 );
+    CONTEND_EQUALITY( spscbufferf_size(q),             0 );
+    CONTEND_EQUALITY( spscbufferf_space_available(q), 10 );
+
+    // write and read back 7 elements
+    CONTEND_EQUALITY( spscbufferf_write(q, v, 7), 7 );
+    float r[12];
+    CONTEND_EQUALITY( spscbufferf_read(q, r, 12), 7 );
+    CONTEND_SAME_DATA( r, v, 7*sizeof(float) );
+
+    // writes are clipped to buffer size
+    CONTEND_EQUALITY( spscbufferf_write(q, v, 12), 10 );
+    CONTEND_EQUALITY( spscbufferf_space_available(q), 0 );
+
+    // reservation is contiguous up to the end of the ring (or the full
+    // readable region if mirrored)
+    float * p;
+    unsigned int n = spscbufferf_read_reserve(q, &p);
+    CONTEND_GREATER_THAN( n, 0 );
+    CONTEND_LESS_THAN( n, 11 );
+    CONTEND_SAME_DATA( p, v, n*sizeof(float) );
+    spscbufferf_read_release(q, n);
+    if (n < 10) {
+        // remainder lies at the start of the ring
+        unsigned int n2 = spscbufferf_read_reserve(q, &p);
+        CONTEND_EQUALITY( n + n2, 10 );
+        CONTEND_SAME_DATA( p, &v[n], n2*sizeof(float) );
+        spscbufferf_read_release(q, n2);
+    }
+    CONTEND_EQUALITY( spscbufferf_size(q), 0 );
+
+    // zero-copy write
+    n = spscbufferf_write_reserve(q, &p);
+    CONTEND_GREATER_THAN( n, 0 );
+    for (i=0; i<n && i<3; i++)
+        p[i] = 100.0f + i;
+    spscbufferf_write_commit(q, 3);
+    CONTEND_EQUALITY( spscbufferf_read(q, r, 3), 3 );
+    CONTEND_EQUALITY( r[0], 100.0f );
+    CONTEND_EQUALITY( r[2], 102.0f );
+
+    // non-blocking waits
+    CONTEND_EQUALITY( spscbufferf_wait_readable(q, 1, 0),  0 );
+    CONTEND_EQUALITY( spscbufferf_wait_writable(q, 10, 0), 1 );
+    CONTEND_EQUALITY( spscbufferf_wait_readable(q, 1, 5),  0 );
+
+    spscbufferf_destroy(q);
+}
+
+// watermark callback: count events
+static void spscbuffer_test_callback(void *                  _userdata,
+                                     liquid_spscbuffer_event _event,
+                                     unsigned int            _size)
+{
+    unsigned int * count = (unsigned int*) _userdata;
+    count[_event == LIQUID_SPSCBUFFER_HIGH_WATERMARK ? 1 : 0]++;
+}
+
+void autotest_spscbufferf_watermarks()
+{
+    float v[32];
+    memset(v, 0, sizeof(v));
+    unsigned int count[2] = {0,0};  // low, high
+
+    spscbufferf q = spscbufferf_create(32);
+    spscbufferf_set_watermarks(q, 4, 24, spscbuffer_test_callback, count);
+
+    // fill to just under high watermark, then cross it
+    spscbufferf_write(q, v, 20);
+    CONTEND_EQUALITY( count[1], 0 );
+    spscbufferf_write(q, v, 8);
+    CONTEND_EQUALITY( count[1], 1 );
+
+    // remaining above high watermark does not trigger again
+    spscbufferf_write(q, v, 2);
+    CONTEND_EQUALITY( count[1], 1 );
+
+    // drain across low watermark
+    spscbufferf_read(q, v, 20);
+    CONTEND_EQUALITY( count[0], 0 );
+    spscbufferf_read(q, v, 8);
+    CONTEND_EQUALITY( count[0], 1 );
+    spscbufferf_read(q, v, 2);
+    CONTEND_EQUALITY( count[0], 1 );
+
+    // second cycle triggers again
+    spscbufferf_write(q, v, 30);
+    spscbufferf_read(q, v, 30);
+    CONTEND_EQUALITY( count[1], 2 );
+    CONTEND_EQUALITY( count[0], 2 );
+
+    spscbufferf_destroy(q);
+}
+
+#if HAVE_LIBPTHREAD && HAVE_PTHREAD_H
+#define SPSCBUFFER_TEST_NUM_SAMPLES (200000)
+
+// producer thread: write a ramp using zero-copy reservations
+static void * spscbuffer_test_producer(void * _arg)
+{
+    spscbuffercf q = (spscbuffercf) _arg;
+    unsigned int i = 0;
+    while (i < SPSCBUFFER_TEST_NUM_SAMPLES) {
+        spscbuffercf_wait_writable(q, 1, -1);
+        float complex * p;
+        unsigned int n = spscbuffercf_write_reserve(q, &p);
+        unsigned int k;
+        for (k=0; k<n && i<SPSCBUFFER_TEST_NUM_SAMPLES; k++, i++)
+            p[k] = (float)i - _Complex_I*(float)(i & 0xff);
+        spscbuffercf_write_commit(q, k);
+    }
+    return NULL;
+}
+#endif
+
+// two threads: every sample arrives exactly once and in order
+void autotest_spscbuffercf_threads()
+{
+#if HAVE_LIBPTHREAD && HAVE_PTHREAD_H
+    spscbuffercf q = spscbuffercf_create(1000);
+    pthread_t thread;
+    pthread_create(&thread, NULL, spscbuffer_test_producer, (void*)q);
+
+    unsigned int i = 0;
+    unsigned int num_errors = 0;
+    float complex r[97];
+    while (i < SPSCBUFFER_TEST_NUM_SAMPLES) {
+        if (!spscbuffercf_wait_readable(q, 1, 1000))
+            break;
+        unsigned int n = spscbuffercf_read(q, r, 97);
+        unsigned int k;
+        for (k=0; k<n; k++, i++)
+            num_errors += r[k] != (float)i - _Complex_I*(float)(i & 0xff);
+    }
+    pthread_join(thread, NULL);
+
+    CONTEND_EQUALITY( i,          SPSCBUFFER_TEST_NUM_SAMPLES );
+    CONTEND_EQUALITY( num_errors, 0 );
+    CONTEND_EQUALITY( spscbuffercf_size(q), 0 );
+    spscbuffercf_destroy(q);
+#else
+    AUTOTEST_WARN("spscbuffercf_threads: pthreads not available");
+#endif
+}
+
@@ -141,3 +141,85 @@ void autotest_windowf()
     printf("done.\n");
 }
 
+//
+// AUTOTEST: large windows use mirrored memory when enabled; verify
+//           contents across many wraps of the read index
+//
+void autotest_windowf_large()
+{
+    unsigned int n = 1500;          // window length
+    unsigned int num_pushes = 7000; // total number of samples pushed
+
+    windowf w = windowf_create(n);
+
+    unsigned int i, k;
+    float * r;
+    int success = 1;
+    for (i=0; i<num_pushes; i++) {
+        windowf_push(w, (float)(i+1));
+
+        // check window periodically: sample k holds value pushed
+        // n-1-k samples ago (zero if not yet pushed)
+        if ( (i % 97) != 0 && i != num_pushes-1 )
+            continue;
+        windowf_read(w, &r);
+        for (k=0; k<n; k++) {
+            float v = (i+1+k >= n) ? (float)(i+2+k-n) : 0.0f;
+            if (r[k] != v)
+                success = 0;
+        }
+    }
+    CONTEND_EXPRESSION(success == 1);
+
+    // clear and ensure window is empty
+    windowf_clear(w);
+    windowf_read(w, &r);
+    for (k=0; k<n; k++)
+        CONTEND_EQUALITY(r[k], 0.0f);
+
+    windowf_destroy(w);
+}
+
+//
+// AUTOTEST: block writes of arbitrary size should leave the window in
+//           the same state as pushing one sample at a time
+//
+void windowf_test_write(unsigned int _n)
+{
+    windowf w0 = windowf_create(_n);    // push one sample at a time
+    windowf w1 = windowf_create(_n);    // write blocks
+
+    // block sizes cycle through short, long, and window-length blocks
+    unsigned int block_len[] = {1, 3, _n-1, 7, _n, 2*_n+5, 0, 13, _n/2};
+    unsigned int num_blocks = sizeof(block_len)/sizeof(unsigned int);
+
+    float x[2*_n+13];
+    unsigned int i, j, k;
+    unsigned int t = 0;
+    int success = 1;
+    for (i=0; i<4*num_blocks; i++) {
+        unsigned int b = block_len[i % num_blocks];
+        for (j=0; j<b; j++)
+            x[j] = (float)(++t);
+
+        for (j=0; j<b; j++)
+            windowf_push(w0, x[j]);
+        windowf_write(w1, x, b);
+
+        // compare window contents
+        float * r0, * r1;
+        windowf_read(w0, &r0);
+        windowf_read(w1, &r1);
+        for (k=0; k<_n; k++)
+            success &= r0[k] == r1[k];
+    }
+    CONTEND_EXPRESSION(success == 1);
+
+    windowf_destroy(w0);
+    windowf_destroy(w1);
+}
+
+void autotest_windowf_write_n2()    { windowf_test_write(   2); }
+void autotest_windowf_write_n13()   { windowf_test_write(  13); }
+void autotest_windowf_write_n64()   { windowf_test_write(  64); }
+void autotest_windowf_write_n1500() { windowf_test_write(1500); }
@@ -288,6 +288,34 @@ void FFT(_execute)(FFT(plan) _q)
     _q->execute(_q);
 }
 
+// execute complex plan on _n consecutive input arrays, writing _n
+// consecutive output arrays, each of length nfft; avoids copying
+// batches of transforms through the plan's own buffers
+//  _q      :   fft plan (complex transform)
+//  _x      :   input arrays [size: _n*nfft x 1]
+//  _y      :   output arrays [size: _n*nfft x 1]
+//  _n      :   number of transforms
+void FFT(_execute_many)(FFT(plan)    _q,
+                        TC *         _x,
+                        TC *         _y,
+                        unsigned int _n)
+{
+    // retain plan buffers
+    TC * x = _q->x;
+    TC * y = _q->y;
+
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        _q->x = _x + i*_q->nfft;
+        _q->y = _y + i*_q->nfft;
+        _q->execute(_q);
+    }
+
+    // restore plan buffers
+    _q->x = x;
+    _q->y = y;
+}
+
 // perform n-point FFT allocating plan internally
 //  _nfft   :   fft size
 //  _x      :   input array [size: _nfft x 1]
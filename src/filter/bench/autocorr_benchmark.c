@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+//  _num_lags   : number of lags
+//  _mode       : 0: one single-lag object per lag
+//                1: multi-lag running sums
+//                2: multi-lag batch transform (evaluated every _window_size samples)
+void autocorr_cccf_lags_bench(struct rusage *     _start,
+                              struct rusage *     _finish,
+                              unsigned long int * _num_iterations,
+                              unsigned int        _num_lags,
+                              int                 _mode)
+{
+    unsigned int window_size = 64;
+
+    // normalize number of trials
+    *_num_iterations *= 4;
+    *_num_iterations /= _num_lags;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned long int i;
+    unsigned int d;
+    autocorr_cccf q = autocorr_cccf_create_multilag(window_size, _num_lags);
+    autocorr_cccf r[_num_lags];
+    for (d=0; d<_num_lags; d++)
+        r[d] = autocorr_cccf_create(window_size, d);
+    float complex rxx[_num_lags];
+    float complex x[64];
+    for (i=0; i<64; i++)
+        x[i] = cexpf(_Complex_I*0.1f*i*i);
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    switch (_mode) {
+    case 0:
+        for (i=0; i<(*_num_iterations); i++) {
+            for (d=0; d<_num_lags; d++) {
+                autocorr_cccf_push(r[d], x[i&63]);
+                autocorr_cccf_execute(r[d], &rxx[d]);
+            }
+        }
+        break;
+    case 1:
+        for (i=0; i<(*_num_iterations); i++) {
+            autocorr_cccf_push(q, x[i&63]);
+            autocorr_cccf_execute_lags(q, rxx);
+        }
+        break;
+    default:
+        for (i=0; i<(*_num_iterations); i++) {
+            autocorr_cccf_push(q, x[i&63]);
+            if ((i % window_size) == 0)
+                autocorr_cccf_execute_lags_fft(q, rxx);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    autocorr_cccf_destroy(q);
+    for (d=0; d<_num_lags; d++)
+        autocorr_cccf_destroy(r[d]);
+}
+
+#define AUTOCORR_LAGS_BENCHMARK_API(L,MODE) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ autocorr_cccf_lags_bench(_start, _finish, _num_iterations, L, MODE); }
+
+void benchmark_autocorr_cccf_single_l16     AUTOCORR_LAGS_BENCHMARK_API(16, 0)
+void benchmark_autocorr_cccf_single_l64     AUTOCORR_LAGS_BENCHMARK_API(64, 0)
+void benchmark_autocorr_cccf_multilag_l16   AUTOCORR_LAGS_BENCHMARK_API(16, 1)
+void benchmark_autocorr_cccf_multilag_l64   AUTOCORR_LAGS_BENCHMARK_API(64, 1)
+void benchmark_autocorr_cccf_fft_l16        AUTOCORR_LAGS_BENCHMARK_API(16, 2)
+void benchmark_autocorr_cccf_fft_l64        AUTOCORR_LAGS_BENCHMARK_API(64, 2)
+
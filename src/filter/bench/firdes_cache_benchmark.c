@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; each trial creates and
+// destroys a root-Nyquist interpolator
+void firdes_cache_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        int                 _cached)
+{
+    // scale number of iterations by cost of full design
+    *_num_iterations /= _cached ? 200 : 20000;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned long int i;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        // force re-design when not using cache
+        if (!_cached)
+            liquid_firdes_cache_clear();
+
+        firinterp_crcf q = firinterp_crcf_create_prototype(LIQUID_FIRFILT_RKAISER,4,12,0.25f,0);
+        firinterp_crcf_destroy(q);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+}
+
+#define FIRDES_CACHE_BENCHMARK_API(C)       \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ firdes_cache_bench(_start, _finish, _num_iterations, C); }
+
+//
+// BENCHMARKS
+//
+void benchmark_firdes_cache_rkaiser_design  FIRDES_CACHE_BENCHMARK_API(0)
+void benchmark_firdes_cache_rkaiser_cached  FIRDES_CACHE_BENCHMARK_API(1)
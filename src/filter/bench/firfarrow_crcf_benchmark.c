@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include <math.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; the delay is changed on
+// every output sample
+//  _mode   : 0 : evaluate taps (set_delay, execute)
+//            1 : Farrow structure (execute_farrow)
+//            2 : quantized coefficient cache (set_delay, execute)
+void firfarrow_crcf_bench(struct rusage *     _start,
+                          struct rusage *     _finish,
+                          unsigned long int * _num_iterations,
+                          unsigned int        _h_len,
+                          unsigned int        _Q,
+                          int                 _mode)
+{
+    // adjust number of iterations
+    *_num_iterations *= 20;
+    *_num_iterations /= _h_len;
+    *_num_iterations += 1;
+
+    // create object
+    firfarrow_crcf q = firfarrow_crcf_create(_h_len, _Q, 0.45f, 60.0f);
+    if (_mode == 2)
+        firfarrow_crcf_set_delay_cache(q, 256);
+
+    // generate input and delay sequence
+    unsigned long int i;
+    float complex x[64];
+    float mu[64];
+    for (i=0; i<64; i++) {
+        x[i]  = randnf() + _Complex_I*randnf();
+        mu[i] = 0.9f*sinf(0.1f*i);
+    }
+    float complex y;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        firfarrow_crcf_push(q, x[i&63]);
+        if (_mode == 1) {
+            firfarrow_crcf_execute_farrow(q, mu[i&63], &y);
+        } else {
+            firfarrow_crcf_set_delay(q, mu[i&63]);
+            firfarrow_crcf_execute(q, &y);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    firfarrow_crcf_destroy(q);
+}
+
+#define FIRFARROW_CRCF_BENCHMARK_API(H,Q,M) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ firfarrow_crcf_bench(_start, _finish, _num_iterations, H, Q, M); }
+
+void benchmark_firfarrow_crcf_h32_Q5_eval   FIRFARROW_CRCF_BENCHMARK_API(32, 5, 0)
+void benchmark_firfarrow_crcf_h32_Q5_farrow FIRFARROW_CRCF_BENCHMARK_API(32, 5, 1)
+void benchmark_firfarrow_crcf_h32_Q5_cache  FIRFARROW_CRCF_BENCHMARK_API(32, 5, 2)
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; each trial is one
+// output sample per channel
+void firfiltmc_crcf_bench(struct rusage *     _start,
+                          struct rusage *     _finish,
+                          unsigned long int * _num_iterations,
+                          unsigned int        _num_channels,
+                          unsigned int        _n)
+{
+    // adjust number of iterations
+    *_num_iterations *= 100;
+    *_num_iterations /= (unsigned int)(_n*_num_channels);
+    *_num_iterations += 1;
+
+    // generate coefficients
+    float h[_n];
+    unsigned long int i;
+    for (i=0; i<_n; i++)
+        h[i] = randnf();
+
+    // create filter object
+    firfiltmc_crcf q = firfiltmc_crcf_create(_num_channels, h, _n);
+
+    // generate input frame
+    float complex x[_num_channels];
+    for (i=0; i<_num_channels; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // output frame
+    float complex y[_num_channels];
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        firfiltmc_crcf_push(q, x);
+        firfiltmc_crcf_execute(q, y);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _num_channels;
+
+    firfiltmc_crcf_destroy(q);
+}
+
+#define FIRFILTMC_CRCF_BENCHMARK_API(C,N)   \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ firfiltmc_crcf_bench(_start, _finish, _num_iterations, C, N); }
+
+void benchmark_firfiltmc_crcf_c16_h4    FIRFILTMC_CRCF_BENCHMARK_API(16,  4)
+void benchmark_firfiltmc_crcf_c16_h16   FIRFILTMC_CRCF_BENCHMARK_API(16, 16)
+void benchmark_firfiltmc_crcf_c64_h4    FIRFILTMC_CRCF_BENCHMARK_API(64,  4)
+void benchmark_firfiltmc_crcf_c64_h16   FIRFILTMC_CRCF_BENCHMARK_API(64, 16)
+void benchmark_firfiltmc_crcf_c64_h64   FIRFILTMC_CRCF_BENCHMARK_API(64, 64)
+
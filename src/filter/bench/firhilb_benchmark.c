@@ -66,3 +66,45 @@ void benchmark_firhilbf_decim_m5    FIRHILB_DECIM_BENCHMARK_API(5)  // m=5
 void benchmark_firhilbf_decim_m9    FIRHILB_DECIM_BENCHMARK_API(9)  // m=9
 void benchmark_firhilbf_decim_m13   FIRHILB_DECIM_BENCHMARK_API(13) // m=13
 
+
+// Helper function to keep code base small
+void firhilbf_r2c_block_bench(
+    struct rusage *_start,
+    struct rusage *_finish,
+    unsigned long int *_num_iterations,
+    unsigned int _m)
+{
+    // normalize number of trials
+    *_num_iterations /= 64;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // create hilber transform object
+    firhilbf q = firhilbf_create(_m,60.0f);
+
+    unsigned int n = 8192;
+    float x[n];
+    float complex y[n];
+    unsigned long int i;
+    for (i=0; i<n; i++)
+        x[i] = (i % 3) == 0 ? 1.0f : -0.5f;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        firhilbf_r2c_execute_block(q,x,n,y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    firhilbf_destroy(q);
+}
+
+#define FIRHILB_R2C_BLOCK_BENCHMARK_API(M)  \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ firhilbf_r2c_block_bench(_start, _finish, _num_iterations, M); }
+
+void benchmark_firhilbf_r2c_block_m13   FIRHILB_R2C_BLOCK_BENCHMARK_API(13)  // m=13
+void benchmark_firhilbf_r2c_block_m51   FIRHILB_R2C_BLOCK_BENCHMARK_API(51)  // m=51
+void benchmark_firhilbf_r2c_block_m101  FIRHILB_R2C_BLOCK_BENCHMARK_API(101) // m=101
+void benchmark_firhilbf_r2c_block_m201  FIRHILB_R2C_BLOCK_BENCHMARK_API(201) // m=201
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include <math.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; each trial evaluates
+// the frequency response of a length-257 filter on _n frequencies
+//  _mode   :   0 (one frequency at a time), 1 (DFT grid), 2 (chirp-z)
+void freqresponse_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _n,
+                        int                 _mode)
+{
+    // normalize number of iterations
+    *_num_iterations /= _mode == 0 ? 10*_n : _n / 16;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned int h_len = 257;
+    float h[h_len];
+    liquid_firdes_kaiser(h_len, 0.1f, 60.0f, 0.0f, h);
+    float complex H[_n];
+
+    unsigned long int i;
+    unsigned int k;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        switch (_mode) {
+        case 0:
+            for (k=0; k<_n; k++)
+                liquid_freqrespf(h, h_len, -0.5f + (float)k/(float)_n, &H[k]);
+            break;
+        case 1:
+            liquid_freqrespf_grid(h, h_len, -0.5f, 1.0f/(float)_n, _n, H);
+            break;
+        default:
+            liquid_freqrespf_grid(h, h_len, 0.05f, 0.1f/(float)_n, _n, H);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _n;
+}
+
+#define FREQRESPONSE_BENCHMARK_API(N,MODE)  \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ freqresponse_bench(_start, _finish, _num_iterations, N, MODE); }
+
+//
+// BENCHMARKS
+//
+void benchmark_freqresponse_point_n4096   FREQRESPONSE_BENCHMARK_API(4096,  0)
+void benchmark_freqresponse_grid_n4096    FREQRESPONSE_BENCHMARK_API(4096,  1)
+void benchmark_freqresponse_grid_n65536   FREQRESPONSE_BENCHMARK_API(65536, 1)
+void benchmark_freqresponse_czt_n4096     FREQRESPONSE_BENCHMARK_API(4096,  2)
@@ -125,3 +125,58 @@ void benchmark_irfilt_crcf_dcblock(struct rusage *     _start,
     iirfilt_crcf_destroy(q);
 }
 
+
+// Helper function for block execution; _block_len of 0 uses the
+// sample-by-sample recursion
+void iirfilt_crcf_bench_block(struct rusage *     _start,
+                              struct rusage *     _finish,
+                              unsigned long int * _num_iterations,
+                              unsigned int        _order,
+                              unsigned int        _block_len,
+                              int                 _double_state)
+{
+    unsigned long int i;
+    unsigned int n = 256;   // samples per call
+
+    // scale number of iterations (trials)
+    *_num_iterations *= 800;
+    *_num_iterations /= (unsigned int)(93 + 53.3*_order)*n;
+    *_num_iterations += 1;
+
+    // create filter object from prototype
+    iirfilt_crcf q = iirfilt_crcf_create_prototype(LIQUID_IIRDES_ELLIP,
+                                                   LIQUID_IIRDES_LOWPASS,
+                                                   LIQUID_IIRDES_SOS,
+                                                   _order,
+                                                   0.2f, 0.0f, 0.1f, 60.0f);
+    if (_block_len > 0)
+        iirfilt_crcf_set_block_mode(q, _block_len, _double_state);
+
+    // initialize input/output
+    float complex x[n];
+    float complex y[n];
+    for (i=0; i<n; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        iirfilt_crcf_execute_block(q, x, n, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    // destroy filter object
+    iirfilt_crcf_destroy(q);
+}
+
+#define IIRFILT_CRCF_BLOCK_BENCHMARK_API(N,L,D) \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ iirfilt_crcf_bench_block(_start, _finish, _num_iterations, N, L, D); }
+
+// benchmark block execution: recursion vs. block state-space mode
+void benchmark_iirfilt_crcf_block_8         IIRFILT_CRCF_BLOCK_BENCHMARK_API(8,  0, 0)
+void benchmark_iirfilt_crcf_block_8_L8      IIRFILT_CRCF_BLOCK_BENCHMARK_API(8,  8, 0)
+void benchmark_iirfilt_crcf_block_8_L16     IIRFILT_CRCF_BLOCK_BENCHMARK_API(8, 16, 0)
+void benchmark_iirfilt_crcf_block_8_L8d     IIRFILT_CRCF_BLOCK_BENCHMARK_API(8,  8, 1)
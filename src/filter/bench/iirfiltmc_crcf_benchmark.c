@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; each trial is one
+// output sample per channel
+void iirfiltmc_crcf_bench(struct rusage *     _start,
+                          struct rusage *     _finish,
+                          unsigned long int * _num_iterations,
+                          unsigned int        _num_channels,
+                          unsigned int        _order)
+{
+    // adjust number of iterations
+    *_num_iterations *= 100;
+    *_num_iterations /= (unsigned int)(_order*_num_channels);
+    *_num_iterations += 1;
+
+    // create filter object
+    iirfiltmc_crcf q = iirfiltmc_crcf_create_prototype(_num_channels,
+            LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS,
+            _order, 0.1f, 0.0f, 1.0f, 60.0f);
+
+    // generate input frame
+    float complex x[_num_channels];
+    unsigned long int i;
+    for (i=0; i<_num_channels; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // output frame
+    float complex y[_num_channels];
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        iirfiltmc_crcf_execute(q, x, y);
+        iirfiltmc_crcf_execute(q, x, y);
+        iirfiltmc_crcf_execute(q, x, y);
+        iirfiltmc_crcf_execute(q, x, y);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4*_num_channels;
+
+    iirfiltmc_crcf_destroy(q);
+}
+
+#define IIRFILTMC_CRCF_BENCHMARK_API(C,N)   \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ iirfiltmc_crcf_bench(_start, _finish, _num_iterations, C, N); }
+
+void benchmark_iirfiltmc_crcf_c4_n2     IIRFILTMC_CRCF_BENCHMARK_API( 4, 2)
+void benchmark_iirfiltmc_crcf_c8_n2     IIRFILTMC_CRCF_BENCHMARK_API( 8, 2)
+void benchmark_iirfiltmc_crcf_c16_n2    IIRFILTMC_CRCF_BENCHMARK_API(16, 2)
+void benchmark_iirfiltmc_crcf_c16_n8    IIRFILTMC_CRCF_BENCHMARK_API(16, 8)
+void benchmark_iirfiltmc_crcf_c64_n8    IIRFILTMC_CRCF_BENCHMARK_API(64, 8)
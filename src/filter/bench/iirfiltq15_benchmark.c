@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small
+//  _order          : filter order
+//  _num_channels   : number of channels
+//  _fixed          : run Q15 filter (1) or floating-point filter (0)
+void iirfiltq15_bench(struct rusage *     _start,
+                      struct rusage *     _finish,
+                      unsigned long int * _num_iterations,
+                      unsigned int        _order,
+                      unsigned int        _num_channels,
+                      int                 _fixed)
+{
+    // normalize number of iterations
+    *_num_iterations *= 4;
+    *_num_iterations /= _order*_num_channels;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    unsigned int n = 64;
+    int16_t xq[n*_num_channels];
+    float   xf[n*_num_channels];
+    unsigned long int i;
+    for (i=0; i<n*_num_channels; i++) {
+        xq[i] = (int16_t)((rand() % 16384) - 8192);
+        xf[i] = (float)xq[i];
+    }
+
+    iirfiltq15 q = iirfiltq15_create_prototype(_num_channels,
+            LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS, _order, 0.1f, 0.0f, 1.0f, 60.0f);
+    iirfiltmc_rrrf f = iirfiltmc_rrrf_create_prototype(_num_channels,
+            LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS, _order, 0.1f, 0.0f, 1.0f, 60.0f);
+    iirfiltq15_set_error_feedback(q, 1);
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    if (_fixed) {
+        for (i=0; i<(*_num_iterations); i+=n)
+            iirfiltq15_execute_block(q, xq, n, xq);
+    } else {
+        for (i=0; i<(*_num_iterations); i+=n)
+            iirfiltmc_rrrf_execute_block(f, xf, n, xf);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+
+    iirfiltq15_destroy(q);
+    iirfiltmc_rrrf_destroy(f);
+}
+
+#define IIRFILTQ15_BENCHMARK_API(ORDER,C,FIXED) \
+(   struct rusage *_start,                      \
+    struct rusage *_finish,                     \
+    unsigned long int *_num_iterations)         \
+{ iirfiltq15_bench(_start, _finish, _num_iterations, ORDER, C, FIXED); }
+
+void benchmark_iirfiltq15_n4_c2         IIRFILTQ15_BENCHMARK_API(4, 2, 1)
+void benchmark_iirfiltq15_n4_c8         IIRFILTQ15_BENCHMARK_API(4, 8, 1)
+void benchmark_iirfiltq15_n8_c2         IIRFILTQ15_BENCHMARK_API(8, 2, 1)
+void benchmark_iirfiltq15_float_n4_c2   IIRFILTQ15_BENCHMARK_API(4, 2, 0)
+void benchmark_iirfiltq15_float_n4_c8   IIRFILTQ15_BENCHMARK_API(4, 8, 0)
+void benchmark_iirfiltq15_float_n8_c2   IIRFILTQ15_BENCHMARK_API(8, 2, 0)
+
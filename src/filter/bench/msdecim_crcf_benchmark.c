@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include <stdlib.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; each trial is one input
+// sample. The fused cascade (msdecim) is compared against composing
+// msresamp2 and firdecim by hand with equivalent parameters.
+void msdecim_crcf_bench(struct rusage *     _start,
+                        struct rusage *     _finish,
+                        unsigned long int * _num_iterations,
+                        unsigned int        _num_stages,
+                        unsigned int        _D,
+                        int                 _fused)
+{
+    unsigned int M = (1 << _num_stages) * _D;
+    unsigned int n = 4096 / M + 1;      // outputs per call
+    unsigned int nx = n*M;
+
+    // adjust number of iterations
+    *_num_iterations /= nx;
+    *_num_iterations += 1;
+
+    // final filter
+    unsigned int h_len = 12*_D + 1;
+    float h[h_len];
+    liquid_firdes_kaiser(h_len, 0.4f/(float)_D, 60.0f, 0.0f, h);
+
+    // create objects
+    msdecim_crcf   q  = msdecim_crcf_create(_num_stages, 0.4f, 60.0f, _D, h, h_len);
+    msresamp2_crcf q2 = msresamp2_crcf_create(LIQUID_RESAMP_DECIM, _num_stages, 0.4f, 0.0f, 60.0f);
+    firdecim_crcf  qd = firdecim_crcf_create(_D, h, h_len);
+
+    // generate input
+    float complex * x = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * t = (float complex*) malloc(n*_D*sizeof(float complex));
+    float complex y[n];
+    unsigned long int i;
+    unsigned int k;
+    for (i=0; i<nx; i++)
+        x[i] = randnf() + _Complex_I*randnf();
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        if (_fused) {
+            msdecim_crcf_execute_block(q, x, n, y);
+        } else {
+            for (k=0; k<n*_D; k++)
+                msresamp2_crcf_execute(q2, &x[k<<_num_stages], &t[k]);
+            firdecim_crcf_execute_block(qd, t, n, y);
+        }
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= nx;
+
+    msdecim_crcf_destroy(q);
+    msresamp2_crcf_destroy(q2);
+    firdecim_crcf_destroy(qd);
+    free(x);
+    free(t);
+}
+
+#define MSDECIM_CRCF_BENCHMARK_API(S,D,F)   \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ msdecim_crcf_bench(_start, _finish, _num_iterations, S, D, F); }
+
+void benchmark_msdecim_crcf_M64             MSDECIM_CRCF_BENCHMARK_API( 6, 1, 1)
+void benchmark_msdecim_crcf_M64_composed    MSDECIM_CRCF_BENCHMARK_API( 6, 1, 0)
+void benchmark_msdecim_crcf_M192            MSDECIM_CRCF_BENCHMARK_API( 6, 3, 1)
+void benchmark_msdecim_crcf_M192_composed   MSDECIM_CRCF_BENCHMARK_API( 6, 3, 0)
+void benchmark_msdecim_crcf_M1024           MSDECIM_CRCF_BENCHMARK_API(10, 1, 1)
+void benchmark_msdecim_crcf_M1024_composed  MSDECIM_CRCF_BENCHMARK_API(10, 1, 0)
@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+// Helper function to keep code base small; each trial is one
+// full-rate sample (decimator input or interpolator output)
+void msresamp2_crcf_bench(struct rusage *     _start,
+                          struct rusage *     _finish,
+                          unsigned long int * _num_iterations,
+                          int                 _type,
+                          unsigned int        _num_stages,
+                          int                 _block)
+{
+    unsigned long int i;
+    unsigned int M = 1 << _num_stages;
+    unsigned int num_frames = _block ? 2048 / M : 1;
+    unsigned int n = num_frames * M;
+
+    msresamp2_crcf q = msresamp2_crcf_create(_type, _num_stages, 0.4f, 0.0f, 60.0f);
+
+    float complex x[n];
+    float complex y[n];
+    for (i=0; i<n; i++)
+        x[i] = (i % 2) ? 1.0f : -1.0f;
+
+    // scale iterations so each call processes n full-rate samples
+    *_num_iterations /= n;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        msresamp2_crcf_execute_block(q, x, num_frames, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= n;
+
+    msresamp2_crcf_destroy(q);
+}
+
+#define MSRESAMP2_CRCF_BENCHMARK_API(T,S,B) \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ msresamp2_crcf_bench(_start, _finish, _num_iterations, T, S, B); }
+
+//
+// BENCHMARKS
+//
+void benchmark_msresamp2_crcf_decim_s2         MSRESAMP2_CRCF_BENCHMARK_API(LIQUID_RESAMP_DECIM,  2, 0)
+void benchmark_msresamp2_crcf_decim_s8         MSRESAMP2_CRCF_BENCHMARK_API(LIQUID_RESAMP_DECIM,  8, 0)
+void benchmark_msresamp2_crcf_decim_block_s2   MSRESAMP2_CRCF_BENCHMARK_API(LIQUID_RESAMP_DECIM,  2, 1)
+void benchmark_msresamp2_crcf_decim_block_s8   MSRESAMP2_CRCF_BENCHMARK_API(LIQUID_RESAMP_DECIM,  8, 1)
+void benchmark_msresamp2_crcf_interp_s8        MSRESAMP2_CRCF_BENCHMARK_API(LIQUID_RESAMP_INTERP, 8, 0)
+void benchmark_msresamp2_crcf_interp_block_s8  MSRESAMP2_CRCF_BENCHMARK_API(LIQUID_RESAMP_INTERP, 8, 1)
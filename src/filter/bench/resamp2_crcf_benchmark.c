@@ -25,7 +25,9 @@
 
 typedef enum {
     RESAMP2_DECIM,
-    RESAMP2_INTERP
+    RESAMP2_INTERP,
+    RESAMP2_DECIM_BLOCK,
+    RESAMP2_INTERP_BLOCK
 } resamp2_type;
 
 // Helper function to keep code base small
@@ -48,6 +50,13 @@ void resamp2_crcf_bench(struct rusage *_start,
     float complex x[] = {1.0f, -1.0f};
     float complex y[] = {1.0f, -1.0f};
 
+    // block buffers
+    unsigned int block_len = 64;
+    float complex xb[2*block_len];
+    float complex yb[2*block_len];
+    for (i=0; i<2*block_len; i++)
+        xb[i] = (i % 2) ? 1.0f : -1.0f;
+
     // start trials
     getrusage(RUSAGE_SELF, _start);
     if (_type == RESAMP2_DECIM) {
@@ -59,7 +68,7 @@ void resamp2_crcf_bench(struct rusage *_start,
             resamp2_crcf_decim_execute(q,x,y);
             resamp2_crcf_decim_execute(q,x,y);
         }
-    } else {
+    } else if (_type == RESAMP2_INTERP) {
 
         // run interpolator
         for (i=0; i<(*_num_iterations); i++) {
@@ -68,6 +77,17 @@ void resamp2_crcf_bench(struct rusage *_start,
             resamp2_crcf_interp_execute(q,x[0],y);
             resamp2_crcf_interp_execute(q,x[0],y);
         }
+    } else {
+        // run block decimator/interpolator; each trial is one
+        // decimator output or interpolator input
+        *_num_iterations = (*_num_iterations * 4) / block_len;
+        for (i=0; i<(*_num_iterations); i++) {
+            if (_type == RESAMP2_DECIM_BLOCK)
+                resamp2_crcf_decim_execute_block(q,xb,block_len,yb);
+            else
+                resamp2_crcf_interp_execute_block(q,xb,block_len,yb);
+        }
+        *_num_iterations *= block_len / 4;
     }
     getrusage(RUSAGE_SELF, _finish);
     *_num_iterations *= 4;
@@ -97,3 +117,10 @@ void benchmark_resamp2_crcf_interp_m4   RESAMP2_CRCF_BENCHMARK_API( 4,RESAMP2_IN
 void benchmark_resamp2_crcf_interp_m8   RESAMP2_CRCF_BENCHMARK_API( 8,RESAMP2_INTERP) // n=33
 void benchmark_resamp2_crcf_interp_m16  RESAMP2_CRCF_BENCHMARK_API(16,RESAMP2_INTERP) // n=65
 
+// 
+// Block decimators/interpolators
+//
+void benchmark_resamp2_crcf_decim_block_m4   RESAMP2_CRCF_BENCHMARK_API( 4,RESAMP2_DECIM_BLOCK)  // n=17
+void benchmark_resamp2_crcf_decim_block_m16  RESAMP2_CRCF_BENCHMARK_API(16,RESAMP2_DECIM_BLOCK)  // n=65
+void benchmark_resamp2_crcf_interp_block_m4  RESAMP2_CRCF_BENCHMARK_API( 4,RESAMP2_INTERP_BLOCK) // n=17
+void benchmark_resamp2_crcf_interp_block_m16 RESAMP2_CRCF_BENCHMARK_API(16,RESAMP2_INTERP_BLOCK) // n=65
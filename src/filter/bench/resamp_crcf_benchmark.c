@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <math.h>
 #include <sys/resource.h>
 #include "liquid.h"
 
@@ -72,3 +73,50 @@ void benchmark_resamp_crcf_m32   RESAMP_CRCF_BENCHMARK_API(32)
 void benchmark_resamp_crcf_m64   RESAMP_CRCF_BENCHMARK_API(64)
 void benchmark_resamp_crcf_m128  RESAMP_CRCF_BENCHMARK_API(128)
 
+
+// Helper function to keep code base small
+void resamp_crcf_block_bench(struct rusage *     _start,
+                             struct rusage *     _finish,
+                             unsigned long int * _num_iterations,
+                             float               _r)
+{
+    unsigned long int i;
+    float bw = 0.35f;       // filter bandwidth
+    float As = 60.0f;       // stop-band attenuation [dB]
+    unsigned int npfb = 32; // number of polyphase filters
+    unsigned int m = 12;    // filter semi-length
+
+    resamp_crcf q = resamp_crcf_create(_r,m,bw,As,npfb);
+
+    // input/output buffers
+    unsigned int nx = 1024;
+    float complex x[nx];
+    float complex y[(unsigned int)ceilf(2*_r*nx) + 4];
+    for (i=0; i<nx; i++)
+        x[i] = 1.0f + 0.1f*_Complex_I*(float)(i % 7);
+
+    unsigned int num_written;
+    unsigned long int num_blocks = *_num_iterations / nx + 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<num_blocks; i++)
+        resamp_crcf_execute_block(q, x, nx, y, &num_written);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations = num_blocks * nx;
+
+    resamp_crcf_destroy(q);
+}
+
+#define RESAMP_CRCF_BLOCK_BENCHMARK_API(R)  \
+(   struct rusage *_start,                  \
+    struct rusage *_finish,                 \
+    unsigned long int *_num_iterations)     \
+{ resamp_crcf_block_bench(_start, _finish, _num_iterations, R); }
+
+//
+// Resampler block benchmark prototypes
+//
+void benchmark_resamp_crcf_block_r0p7   RESAMP_CRCF_BLOCK_BENCHMARK_API(0.7071f)
+void benchmark_resamp_crcf_block_r1p3   RESAMP_CRCF_BLOCK_BENCHMARK_API(1.3333f)
+void benchmark_resamp_crcf_block_r3p1   RESAMP_CRCF_BLOCK_BENCHMARK_API(3.1416f)
@@ -38,6 +38,13 @@
 //  DOTPROD()       dotprod macro
 //  PRINTVAL()      print macro
 
+// conjugate of input sample
+#if TI_COMPLEX
+#  define AUTOCORR_CONJ(X)  conjf(X)
+#else
+#  define AUTOCORR_CONJ(X)  (X)
+#endif
+
 struct AUTOCORR(_s) {
     unsigned int window_size;
     unsigned int delay;
@@ -48,8 +55,34 @@ struct AUTOCORR(_s) {
     float * we2;        // energy buffer
     float e2_sum;       // running sum of energy
     unsigned int ie2;   // read index
+
+    // multi-lag mode (lags 0..num_lags-1), see AUTOCORR(_create_multilag)
+    unsigned int num_lags;      // number of lags, zero if disabled
+    WINDOW() wh;                // input history [size: window_size+num_lags]
+    TO * rxx;                   // running sum for each lag [size: num_lags]
+    unsigned int resync_len;    // samples between exact re-computation
+    unsigned int resync_count;  // samples since last re-computation
+
+    // batch mode transforms
+    unsigned int nfft;          // transform size
+    float complex * fa;         // window samples (time, freq)
+    float complex * fh;         // history samples (time, freq)
+    float complex * fr;         // correlation output
+#ifdef LIQUID_FFTOVERRIDE
+    fftplan fft_a;              // forward transform of window
+    fftplan fft_h;              // forward transform of history
+    fftplan ifft;               // inverse transform
+#else
+    FFT_PLAN fft_a;             // forward transform of window
+    FFT_PLAN fft_h;             // forward transform of history
+    FFT_PLAN ifft;              // inverse transform
+#endif
 };
 
+// re-compute running lag sums directly from history buffer, removing
+// accumulated round-off error
+void AUTOCORR(_resync)(AUTOCORR() _q);
+
 // create auto-correlator object                            
 //  _window_size    : size of the correlator window         
 //  _delay          : correlator delay [samples]            
@@ -70,6 +103,9 @@ AUTOCORR() AUTOCORR(_create)(unsigned int _window_size,
     // allocate array for squared energy buffer
     q->we2 = (float*) malloc( (q->window_size)*sizeof(float) );
 
+    // multi-lag mode disabled
+    q->num_lags = 0;
+
     // clear object
     AUTOCORR(_reset)(q);
 
@@ -77,6 +113,54 @@ AUTOCORR() AUTOCORR(_create)(unsigned int _window_size,
     return q;
 }
 
+// create multi-lag auto-correlator object, computing windowed
+// auto-correlation at every lag in [0,_num_lags) with running sums
+// updated as each sample enters and leaves the window; the
+// single-lag methods operate on lag _num_lags-1
+//  _window_size    : size of the correlator window
+//  _num_lags       : number of lags
+AUTOCORR() AUTOCORR(_create_multilag)(unsigned int _window_size,
+                                      unsigned int _num_lags)
+{
+    // validate input
+    if (_window_size == 0) {
+        fprintf(stderr,"error: autocorr_%s_create_multilag(), window size must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_num_lags == 0) {
+        fprintf(stderr,"error: autocorr_%s_create_multilag(), number of lags must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create single-lag object at largest lag
+    AUTOCORR() q = AUTOCORR(_create)(_window_size, _num_lags-1);
+
+    // set up running sums; re-compute exactly at a rate which
+    // keeps amortized cost well below that of the updates
+    q->num_lags   = _num_lags;
+    q->wh         = WINDOW(_create)(q->window_size + q->num_lags);
+    q->rxx        = (TO*) malloc(q->num_lags*sizeof(TO));
+    q->resync_len = 16*q->window_size > 4096 ? 16*q->window_size : 4096;
+
+    // set up transforms for batch mode; transform size must hold
+    // history without circular wrap at any lag
+    q->nfft = 1 << liquid_nextpow2(q->window_size + q->num_lags);
+    q->fa   = (float complex*) malloc(q->nfft*sizeof(float complex));
+    q->fh   = (float complex*) malloc(q->nfft*sizeof(float complex));
+    q->fr   = (float complex*) malloc(q->nfft*sizeof(float complex));
+#ifdef LIQUID_FFTOVERRIDE
+    q->fft_a = fft_create_plan(q->nfft, q->fa, q->fa, LIQUID_FFT_FORWARD,  0);
+    q->fft_h = fft_create_plan(q->nfft, q->fh, q->fh, LIQUID_FFT_FORWARD,  0);
+    q->ifft  = fft_create_plan(q->nfft, q->fa, q->fr, LIQUID_FFT_BACKWARD, 0);
+#else
+    q->fft_a = FFT_CREATE_PLAN(q->nfft, q->fa, q->fa, FFT_DIR_FORWARD,  FFT_METHOD);
+    q->fft_h = FFT_CREATE_PLAN(q->nfft, q->fh, q->fh, FFT_DIR_FORWARD,  FFT_METHOD);
+    q->ifft  = FFT_CREATE_PLAN(q->nfft, q->fa, q->fr, FFT_DIR_BACKWARD, FFT_METHOD);
+#endif
+
+    AUTOCORR(_reset)(q);
+    return q;
+}
+
 // destroy auto-correlator object, freeing internal memory
 void AUTOCORR(_destroy)(AUTOCORR() _q)
 {
@@ -87,6 +171,24 @@ void AUTOCORR(_destroy)(AUTOCORR() _q)
     // free array for squared energy buffer
     free(_q->we2);
 
+    // destroy multi-lag objects
+    if (_q->num_lags > 0) {
+        WINDOW(_destroy)(_q->wh);
+        free(_q->rxx);
+#ifdef LIQUID_FFTOVERRIDE
+        fft_destroy_plan(_q->fft_a);
+        fft_destroy_plan(_q->fft_h);
+        fft_destroy_plan(_q->ifft);
+#else
+        FFT_DESTROY_PLAN(_q->fft_a);
+        FFT_DESTROY_PLAN(_q->fft_h);
+        FFT_DESTROY_PLAN(_q->ifft);
+#endif
+        free(_q->fa);
+        free(_q->fh);
+        free(_q->fr);
+    }
+
     // free main object memory
     free(_q);
 }
@@ -104,12 +206,23 @@ void AUTOCORR(_reset)(AUTOCORR() _q)
     for (i=0; i<_q->window_size; i++)
         _q->we2[i] = 0.0;
     _q->ie2 = 0;    // reset read index to zero
+
+    // reset multi-lag running sums
+    if (_q->num_lags > 0) {
+        WINDOW(_clear)(_q->wh);
+        for (i=0; i<_q->num_lags; i++)
+            _q->rxx[i] = 0;
+        _q->resync_count = 0;
+    }
 }
 
 // print auto-correlator parameters to stdout
 void AUTOCORR(_print)(AUTOCORR() _q)
 {
-    printf("autocorr [%u window, %u delay]\n", _q->window_size, _q->delay);
+    if (_q->num_lags > 0)
+        printf("autocorr [%u window, %u lags]\n", _q->window_size, _q->num_lags);
+    else
+        printf("autocorr [%u window, %u delay]\n", _q->window_size, _q->delay);
 }
 
 // push sample into auto-correlator object
@@ -125,6 +238,29 @@ void AUTOCORR(_push)(AUTOCORR() _q, TI _x)
     _q->e2_sum += e2;
     _q->we2[ _q->ie2 ] = e2;
     _q->ie2 = (_q->ie2+1) % _q->window_size;
+
+    if (_q->num_lags == 0)
+        return;
+
+    // update running lag sums: add product of entering sample
+    // x[n] with x[n-d], remove product of leaving sample x[n-W]
+    // with x[n-W-d]
+    TI * r;
+    WINDOW(_push)(_q->wh, _x);
+    WINDOW(_read)(_q->wh, &r);
+    unsigned int W = _q->window_size;
+    unsigned int L = _q->num_lags;
+    TI x_in  = r[W+L-1];
+    TI x_out = r[L-1];
+    unsigned int d;
+    for (d=0; d<L; d++)
+        _q->rxx[d] += x_in  * AUTOCORR_CONJ(r[W+L-1-d])
+                    - x_out * AUTOCORR_CONJ(r[L-1-d]);
+
+    // periodically re-compute sums exactly
+    _q->resync_count++;
+    if (_q->resync_count == _q->resync_len)
+        AUTOCORR(_resync)(_q);
 }
 
 // compute auto-correlation output
@@ -171,3 +307,91 @@ float AUTOCORR(_get_energy)(AUTOCORR() _q)
     return _q->e2_sum;
 }
 
+// get number of lags in multi-lag mode (zero if disabled)
+unsigned int AUTOCORR(_get_num_lags)(AUTOCORR() _q)
+{
+    return _q->num_lags;
+}
+
+// compute auto-correlation at all lags from running sums
+//  _q      :   multi-lag auto-correlation object
+//  _rxx    :   output array, lag d at index d [size: num_lags x 1]
+void AUTOCORR(_execute_lags)(AUTOCORR() _q,
+                             TO *       _rxx)
+{
+    if (_q->num_lags == 0) {
+        fprintf(stderr,"error: autocorr_%s_execute_lags(), object not in multi-lag mode\n", EXTENSION_FULL);
+        exit(1);
+    }
+    memmove(_rxx, _q->rxx, _q->num_lags*sizeof(TO));
+}
+
+// compute auto-correlation at all lags in batch from buffered
+// history using a single pair of forward transforms and an inverse
+//  _q      :   multi-lag auto-correlation object
+//  _rxx    :   output array, lag d at index d [size: num_lags x 1]
+void AUTOCORR(_execute_lags_fft)(AUTOCORR() _q,
+                                 TO *       _rxx)
+{
+    if (_q->num_lags == 0) {
+        fprintf(stderr,"error: autocorr_%s_execute_lags_fft(), object not in multi-lag mode\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // history h[t], t < W+L, newest last; window samples are h[t]
+    // for t >= L and rxx[d] = sum_{t>=L} h[t] conj(h[t-d])
+    TI * r;
+    WINDOW(_read)(_q->wh, &r);
+    unsigned int W = _q->window_size;
+    unsigned int L = _q->num_lags;
+    unsigned int i;
+    for (i=0; i<_q->nfft; i++) {
+        TI v = i < W+L ? r[i] : 0;
+        _q->fh[i] = v;
+        _q->fa[i] = i >= L ? v : 0;
+    }
+#ifdef LIQUID_FFTOVERRIDE
+    fft_execute(_q->fft_a);
+    fft_execute(_q->fft_h);
+#else
+    FFT_EXECUTE(_q->fft_a);
+    FFT_EXECUTE(_q->fft_h);
+#endif
+
+    // cross-correlation: inverse transform of A conj(H)
+    float g = 1.0f / (float)(_q->nfft);
+    for (i=0; i<_q->nfft; i++)
+        _q->fa[i] *= conjf(_q->fh[i]) * g;
+#ifdef LIQUID_FFTOVERRIDE
+    fft_execute(_q->ifft);
+#else
+    FFT_EXECUTE(_q->ifft);
+#endif
+
+    for (i=0; i<L; i++) {
+#if TO_COMPLEX
+        _rxx[i] = _q->fr[i];
+#else
+        _rxx[i] = crealf(_q->fr[i]);
+#endif
+    }
+}
+
+// re-compute running lag sums directly from history buffer, removing
+// accumulated round-off error
+void AUTOCORR(_resync)(AUTOCORR() _q)
+{
+    TI * r;
+    WINDOW(_read)(_q->wh, &r);
+    unsigned int W = _q->window_size;
+    unsigned int L = _q->num_lags;
+    unsigned int d, t;
+    for (d=0; d<L; d++) {
+        TO sum = 0;
+        for (t=L; t<W+L; t++)
+            sum += r[t] * AUTOCORR_CONJ(r[t-d]);
+        _q->rxx[d] = sum;
+    }
+    _q->resync_count = 0;
+}
+
@@ -33,18 +33,25 @@
 // 
 #define AUTOCORR(name)      LIQUID_CONCAT(autocorr_cccf,name)
 #define FFTFILT(name)       LIQUID_CONCAT(fftfilt_cccf,name)
+#define FIRBANK(name)       LIQUID_CONCAT(firbank_cccf,name)
 #define FIRDECIM(name)      LIQUID_CONCAT(firdecim_cccf,name)
+#define FIRDECIMMC(name)    LIQUID_CONCAT(firdecimmc_cccf,name)
 #define FIRFILT(name)       LIQUID_CONCAT(firfilt_cccf,name)
+#define FIRFILTMC(name)     LIQUID_CONCAT(firfiltmc_cccf,name)
 #define FIRINTERP(name)     LIQUID_CONCAT(firinterp_cccf,name)
 #define FIRPFB(name)        LIQUID_CONCAT(firpfb_cccf,name)
 #define IIRDECIM(name)      LIQUID_CONCAT(iirdecim_cccf,name)
 #define IIRFILT(name)       LIQUID_CONCAT(iirfilt_cccf,name)
+#define IIRFILTMC(name)     LIQUID_CONCAT(iirfiltmc_cccf,name)
 #define IIRFILTSOS(name)    LIQUID_CONCAT(iirfiltsos_cccf,name)
+#define IIRFILTSS(name)     LIQUID_CONCAT(iirfiltss_cccf,name)
 #define IIRINTERP(name)     LIQUID_CONCAT(iirinterp_cccf,name)
 #define NCO(name)           LIQUID_CONCAT(nco_crcf,name)
+#define MSDECIM(name)       LIQUID_CONCAT(msdecim_cccf,name)
 #define MSRESAMP(name)      LIQUID_CONCAT(msresamp_cccf,name)
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_cccf,name)
 #define RESAMP(name)        LIQUID_CONCAT(resamp_cccf,name)
+#define RRESAMP(name)       LIQUID_CONCAT(rresamp_cccf,name)
 #define RESAMP2(name)       LIQUID_CONCAT(resamp2_cccf,name)
 //#define SYMSYNC(name)       LIQUID_CONCAT(symsync_cccf,name)
 
@@ -67,17 +74,24 @@
 // source files
 #include "autocorr.c"
 #include "fftfilt.c"
+#include "firbank.c"
 #include "firdecim.c"
 #include "firfilt.c"
+#include "firfiltmc.c"
+#include "firdecimmc.c"
 #include "firinterp.c"
 #include "firpfb.c"
 #include "iirdecim.c"
 #include "iirfilt.c"
+#include "iirfiltmc.c"
 #include "iirfiltsos.c"
+#include "iirfiltss.c"
 #include "iirinterp.c"
 //#include "qmfb.c"
+#include "msdecim.c"
 #include "msresamp.c"
 #include "msresamp2.c"
 #include "resamp.c"
+#include "rresamp.c"
 #include "resamp2.c"
 //#include "symsync.c"
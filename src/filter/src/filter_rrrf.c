@@ -33,19 +33,26 @@
 // 
 #define AUTOCORR(name)      LIQUID_CONCAT(autocorr_rrrf,name)
 #define FFTFILT(name)       LIQUID_CONCAT(fftfilt_rrrf,name)
+#define FIRBANK(name)       LIQUID_CONCAT(firbank_rrrf,name)
 #define FIRDECIM(name)      LIQUID_CONCAT(firdecim_rrrf,name)
+#define FIRDECIMMC(name)    LIQUID_CONCAT(firdecimmc_rrrf,name)
 #define FIRFARROW(name)     LIQUID_CONCAT(firfarrow_rrrf,name)
 #define FIRFILT(name)       LIQUID_CONCAT(firfilt_rrrf,name)
+#define FIRFILTMC(name)     LIQUID_CONCAT(firfiltmc_rrrf,name)
 #define FIRINTERP(name)     LIQUID_CONCAT(firinterp_rrrf,name)
 #define FIRHILB(name)       LIQUID_CONCAT(firhilbf,name)
 #define FIRPFB(name)        LIQUID_CONCAT(firpfb_rrrf,name)
 #define IIRDECIM(name)      LIQUID_CONCAT(iirdecim_rrrf,name)
 #define IIRFILT(name)       LIQUID_CONCAT(iirfilt_rrrf,name)
+#define IIRFILTMC(name)     LIQUID_CONCAT(iirfiltmc_rrrf,name)
 #define IIRFILTSOS(name)    LIQUID_CONCAT(iirfiltsos_rrrf,name)
+#define IIRFILTSS(name)     LIQUID_CONCAT(iirfiltss_rrrf,name)
 #define IIRINTERP(name)     LIQUID_CONCAT(iirinterp_rrrf,name)
+#define MSDECIM(name)       LIQUID_CONCAT(msdecim_rrrf,name)
 #define MSRESAMP(name)      LIQUID_CONCAT(msresamp_rrrf,name)
 #define MSRESAMP2(name)     LIQUID_CONCAT(msresamp2_rrrf,name)
 #define RESAMP(name)        LIQUID_CONCAT(resamp_rrrf,name)
+#define RRESAMP(name)       LIQUID_CONCAT(rresamp_rrrf,name)
 #define RESAMP2(name)       LIQUID_CONCAT(resamp2_rrrf,name)
 #define SYMSYNC(name)       LIQUID_CONCAT(symsync_rrrf,name)
 
@@ -68,18 +75,25 @@
 // source files
 #include "autocorr.c"
 #include "fftfilt.c"
+#include "firbank.c"
 #include "firdecim.c"
 #include "firfarrow.c"
 #include "firfilt.c"
+#include "firfiltmc.c"
+#include "firdecimmc.c"
 #include "firinterp.c"
 #include "firhilb.c"
 #include "firpfb.c"
 #include "iirdecim.c"
 #include "iirfilt.c"
+#include "iirfiltmc.c"
 #include "iirfiltsos.c"
+#include "iirfiltss.c"
 #include "iirinterp.c"
+#include "msdecim.c"
 #include "msresamp.c"
 #include "msresamp2.c"
 #include "resamp.c"
+#include "rresamp.c"
 #include "resamp2.c"
 #include "symsync.c"
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Shared, read-only bank of FIR sub-filters
+//
+// A bank holds the polyphase partition of a prototype filter as dot
+// product objects, whose coefficients are stored in the aligned,
+// architecture-specific layout chosen by DOTPROD(). Banks are
+// reference counted so that many filter instances (firpfb, firinterp,
+// firdecim, symsync) can share one copy of the coefficients while
+// keeping only their window/state private.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if HAVE_LIBPTHREAD && HAVE_PTHREAD_H
+#  include <pthread.h>
+#  define FIRBANK_THREADS 1
+#else
+#  define FIRBANK_THREADS 0
+#endif
+
+struct FIRBANK(_s) {
+    unsigned int num_filters;   // number of sub-filters
+    unsigned int h_sub_len;     // length of each sub-filter
+    DOTPROD() *  dp;            // sub-filter dot product objects
+    unsigned int num_refs;      // number of references to object
+#if FIRBANK_THREADS
+    pthread_mutex_t lock;       // reference count lock
+#endif
+};
+
+// create bank from polyphase partition of prototype coefficients;
+// sub-filter i holds taps _h[i + n*_M] for n in [0,_h_len/_M)
+//  _M      : number of sub-filters
+//  _h      : prototype coefficients [size: _h_len x 1]
+//  _h_len  : prototype filter length
+FIRBANK() FIRBANK(_create)(unsigned int _M,
+                           TC *         _h,
+                           unsigned int _h_len)
+{
+    // validate input
+    if (_M == 0) {
+        fprintf(stderr,"error: firbank_%s_create(), number of sub-filters must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_h_len < _M) {
+        fprintf(stderr,"error: firbank_%s_create(), filter length must be at least number of sub-filters\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    FIRBANK() q = (FIRBANK()) malloc(sizeof(struct FIRBANK(_s)));
+    q->num_filters = _M;
+    q->h_sub_len   = _h_len / _M;
+    q->num_refs    = 1;
+#if FIRBANK_THREADS
+    pthread_mutex_init(&q->lock, NULL);
+#endif
+
+    // create dot product object for each sub-filter, loading
+    // coefficients in reverse order
+    q->dp = (DOTPROD()*) malloc(q->num_filters*sizeof(DOTPROD()));
+    TC h_sub[q->h_sub_len];
+    unsigned int i, n;
+    for (i=0; i<q->num_filters; i++) {
+        for (n=0; n<q->h_sub_len; n++)
+            h_sub[q->h_sub_len-n-1] = _h[i + n*q->num_filters];
+        q->dp[i] = DOTPROD(_create)(h_sub, q->h_sub_len);
+    }
+    return q;
+}
+
+// add reference to bank, returning the bank itself
+FIRBANK() FIRBANK(_retain)(FIRBANK() _q)
+{
+#if FIRBANK_THREADS
+    pthread_mutex_lock(&_q->lock);
+#endif
+    _q->num_refs++;
+#if FIRBANK_THREADS
+    pthread_mutex_unlock(&_q->lock);
+#endif
+    return _q;
+}
+
+// release reference to bank, freeing memory with last reference
+void FIRBANK(_destroy)(FIRBANK() _q)
+{
+#if FIRBANK_THREADS
+    pthread_mutex_lock(&_q->lock);
+#endif
+    unsigned int num_refs = --_q->num_refs;
+#if FIRBANK_THREADS
+    pthread_mutex_unlock(&_q->lock);
+#endif
+    if (num_refs > 0)
+        return;
+
+    unsigned int i;
+    for (i=0; i<_q->num_filters; i++)
+        DOTPROD(_destroy)(_q->dp[i]);
+    free(_q->dp);
+#if FIRBANK_THREADS
+    pthread_mutex_destroy(&_q->lock);
+#endif
+    free(_q);
+}
+
+// print bank object
+void FIRBANK(_print)(FIRBANK() _q)
+{
+    printf("firbank_%s: %u sub-filters of length %u, %u reference%s\n",
+            EXTENSION_FULL, _q->num_filters, _q->h_sub_len,
+            _q->num_refs, _q->num_refs == 1 ? "" : "s");
+}
+
+// get number of sub-filters
+unsigned int FIRBANK(_get_num_filters)(FIRBANK() _q)
+{
+    return _q->num_filters;
+}
+
+// get length of each sub-filter
+unsigned int FIRBANK(_get_sub_len)(FIRBANK() _q)
+{
+    return _q->h_sub_len;
+}
+
+// get number of references held to bank
+unsigned int FIRBANK(_get_num_refs)(FIRBANK() _q)
+{
+#if FIRBANK_THREADS
+    pthread_mutex_lock(&_q->lock);
+#endif
+    unsigned int num_refs = _q->num_refs;
+#if FIRBANK_THREADS
+    pthread_mutex_unlock(&_q->lock);
+#endif
+    return num_refs;
+}
+
+// run sub-filter on input buffer
+//  _q      : bank object
+//  _i      : sub-filter index, _i < num_filters
+//  _x      : input buffer, oldest sample first [size: h_sub_len x 1]
+//  _y      : output sample pointer
+void FIRBANK(_execute)(FIRBANK()    _q,
+                       unsigned int _i,
+                       TI *         _x,
+                       TO *         _y)
+{
+    DOTPROD(_execute)(_q->dp[_i], _x, _y);
+}
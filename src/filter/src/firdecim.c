@@ -32,12 +32,11 @@
 
 // decimator structure
 struct FIRDECIM(_s) {
-    TC * h;             // coefficients array
     unsigned int h_len; // number of coefficients
     unsigned int M;     // decimation factor
 
     WINDOW() w;         // buffer
-    DOTPROD() dp;       // vector dot product
+    FIRBANK() bank;     // shared coefficients (single sub-filter)
 };
 
 // create decimator object
@@ -61,19 +60,12 @@ FIRDECIM() FIRDECIM(_create)(unsigned int _M,
     q->h_len = _h_len;
     q->M     = _M;
 
-    // allocate memory for coefficients
-    q->h = (TC*) malloc((q->h_len)*sizeof(TC));
-
-    // load filter in reverse order
-    unsigned int i;
-    for (i=0; i<q->h_len; i++)
-        q->h[i] = _h[_h_len-i-1];
-
     // create window (internal buffer)
     q->w = WINDOW(_create)(q->h_len);
 
-    // create dot product object
-    q->dp = DOTPROD(_create)(q->h, q->h_len);
+    // create coefficient bank with a single sub-filter (loads
+    // filter in reverse order)
+    q->bank = FIRBANK(_create)(1, _h, _h_len);
 
     // reset filter state (clear buffer)
     FIRDECIM(_clear)(q);
@@ -159,12 +151,24 @@ FIRDECIM() FIRDECIM(_create_prototype)(int          _type,
     return FIRDECIM(_create)(_M, hc, h_len);
 }
 
+// create decimator sharing coefficients of existing object;
+// internal state is reset
+FIRDECIM() FIRDECIM(_create_shared)(FIRDECIM() _q)
+{
+    FIRDECIM() q = (FIRDECIM()) malloc(sizeof(struct FIRDECIM(_s)));
+    q->h_len = _q->h_len;
+    q->M     = _q->M;
+    q->w     = WINDOW(_create)(q->h_len);
+    q->bank  = FIRBANK(_retain)(_q->bank);
+    FIRDECIM(_clear)(q);
+    return q;
+}
+
 // destroy decimator object
 void FIRDECIM(_destroy)(FIRDECIM() _q)
 {
     WINDOW(_destroy)(_q->w);
-    DOTPROD(_destroy)(_q->dp);
-    free(_q->h);
+    FIRBANK(_destroy)(_q->bank);
     free(_q);
 }
 
@@ -200,7 +204,7 @@ void FIRDECIM(_execute)(FIRDECIM() _q,
             WINDOW(_read)(_q->w, &r);
 
             // execute dot product
-            DOTPROD(_execute)(_q->dp, r, _y);
+            FIRBANK(_execute)(_q->bank, 0, r, _y);
         }
     }
 }
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// firdecimmc.c
+//
+// multi-channel finite impulse response decimator; each output frame
+// is computed from the shared frame buffer of a multi-channel filter
+// with only the retained outputs evaluated
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// decimator structure
+struct FIRDECIMMC(_s) {
+    unsigned int M;             // decimation factor
+    unsigned int num_channels;  // number of channels
+    FIRFILTMC() f;              // multi-channel filter
+
+    // scratch frames used for planar input/output
+    TI * x_frame;               // input frame  [size: num_channels x 1]
+    TO * y_frame;               // output frame [size: num_channels x 1]
+};
+
+// create multi-channel decimator object
+//  _num_channels : number of channels, _num_channels > 0
+//  _M            : decimation factor
+//  _h            : filter coefficients [size: _h_len x 1]
+//  _h_len        : filter coefficients length
+FIRDECIMMC() FIRDECIMMC(_create)(unsigned int _num_channels,
+                                 unsigned int _M,
+                                 TC *         _h,
+                                 unsigned int _h_len)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: firdecimmc_%s_create(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_h_len == 0) {
+        fprintf(stderr,"error: firdecimmc_%s_create(), filter length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_M == 0) {
+        fprintf(stderr,"error: firdecimmc_%s_create(), decimation factor must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    FIRDECIMMC() q = (FIRDECIMMC()) malloc(sizeof(struct FIRDECIMMC(_s)));
+    q->M            = _M;
+    q->num_channels = _num_channels;
+
+    // create multi-channel filter
+    q->f = FIRFILTMC(_create)(q->num_channels, _h, _h_len);
+
+    // allocate scratch frames
+    q->x_frame = (TI *) malloc(q->num_channels*sizeof(TI));
+    q->y_frame = (TO *) malloc(q->num_channels*sizeof(TO));
+
+    // reset filter state (clear buffer)
+    FIRDECIMMC(_clear)(q);
+    return q;
+}
+
+// destroy decimator object
+void FIRDECIMMC(_destroy)(FIRDECIMMC() _q)
+{
+    FIRFILTMC(_destroy)(_q->f);
+    free(_q->x_frame);
+    free(_q->y_frame);
+    free(_q);
+}
+
+// print decimator object internals
+void FIRDECIMMC(_print)(FIRDECIMMC() _q)
+{
+    printf("firdecimmc_%s [%u channels, M=%u] :\n",
+            EXTENSION_FULL, _q->num_channels, _q->M);
+    FIRFILTMC(_print)(_q->f);
+}
+
+// clear decimator object
+void FIRDECIMMC(_clear)(FIRDECIMMC() _q)
+{
+    FIRFILTMC(_reset)(_q->f);
+}
+
+// execute decimator on _M interleaved input frames
+//  _q      :   decimator object
+//  _x      :   input samples [size: _M*num_channels x 1]
+//  _y      :   output frame [size: num_channels x 1]
+void FIRDECIMMC(_execute)(FIRDECIMMC() _q,
+                          TI *         _x,
+                          TO *         _y)
+{
+    unsigned int i;
+    unsigned int C = _q->num_channels;
+
+    // push first frame and compute output (same alignment as firdecim)
+    FIRFILTMC(_push)(_q->f, _x);
+    FIRFILTMC(_execute)(_q->f, _y);
+
+    // push remaining frames without computing outputs
+    for (i=1; i<_q->M; i++)
+        FIRFILTMC(_push)(_q->f, &_x[i*C]);
+}
+
+// execute decimator on block of interleaved samples
+//  _q      : decimator object
+//  _x      : input array [size: _n*_M*num_channels x 1]
+//  _n      : number of _output_ samples per channel
+//  _y      : output array [size: _n*num_channels x 1]
+void FIRDECIMMC(_execute_block)(FIRDECIMMC() _q,
+                                TI *         _x,
+                                unsigned int _n,
+                                TO *         _y)
+{
+    unsigned int i;
+    unsigned int C = _q->num_channels;
+    for (i=0; i<_n; i++)
+        FIRDECIMMC(_execute)(_q, &_x[i*_q->M*C], &_y[i*C]);
+}
+
+// execute decimator on block of planar samples
+//  _q      : decimator object
+//  _x      : input array [size: num_channels*_n*_M x 1]
+//  _n      : number of _output_ samples per channel
+//  _y      : output array [size: num_channels*_n x 1]
+void FIRDECIMMC(_execute_block_planar)(FIRDECIMMC() _q,
+                                       TI *         _x,
+                                       unsigned int _n,
+                                       TO *         _y)
+{
+    unsigned int i, j, c;
+    unsigned int C  = _q->num_channels;
+    unsigned int nx = _n * _q->M;   // input samples per channel
+    for (i=0; i<_n; i++) {
+        for (j=0; j<_q->M; j++) {
+            // gather input frame and push into buffer
+            for (c=0; c<C; c++)
+                _q->x_frame[c] = _x[c*nx + i*_q->M + j];
+            FIRFILTMC(_push)(_q->f, _q->x_frame);
+
+            // compute output after first frame
+            if (j==0)
+                FIRFILTMC(_execute)(_q->f, _q->y_frame);
+        }
+
+        // scatter output frame
+        for (c=0; c<C; c++)
+            _y[c*_n + i] = _q->y_frame[c];
+    }
+}
+
@@ -246,6 +246,19 @@ void liquid_firdes_kaiser(unsigned int _n,
                           float _As,
                           float _mu,
                           float *_h)
+{
+    // copy shared design from cache, designing on first use
+    const float * hc = liquid_firdes_cache_kaiser(_n, _fc, _As, _mu);
+    memmove(_h, hc, _n*sizeof(float));
+    liquid_firdes_cache_release(hc);
+}
+
+// Design FIR using kaiser window (without design cache)
+void liquid_firdes_kaiser_internal(unsigned int _n,
+                                   float        _fc,
+                                   float        _As,
+                                   float        _mu,
+                                   float *      _h)
 {
     // validate inputs
     if (_mu < -0.5f || _mu > 0.5f) {
@@ -293,6 +306,20 @@ void liquid_firdes_prototype(liquid_firfilt_type _type,
                              float               _beta,
                              float               _dt,
                              float *             _h)
+{
+    // copy shared design from cache, designing on first use
+    const float * hc = liquid_firdes_cache_prototype(_type, _k, _m, _beta, _dt);
+    memmove(_h, hc, (2*_k*_m+1)*sizeof(float));
+    liquid_firdes_cache_release(hc);
+}
+
+// Design (root-)Nyquist filter from prototype (without design cache)
+void liquid_firdes_prototype_internal(liquid_firfilt_type _type,
+                                      unsigned int        _k,
+                                      unsigned int        _m,
+                                      float               _beta,
+                                      float               _dt,
+                                      float *             _h)
 {
     // compute filter parameters
     unsigned int h_len = 2*_k*_m + 1;   // length
@@ -315,7 +342,7 @@ void liquid_firdes_prototype(liquid_firfilt_type _type,
     // Nyquist filter prototypes
 
     case LIQUID_FIRFILT_KAISER:
-        liquid_firdes_kaiser(h_len, fc, As, _dt, _h);
+        liquid_firdes_kaiser_internal(h_len, fc, As, _dt, _h);
         break;
     case LIQUID_FIRFILT_PM:
         // WARNING: input timing offset is ignored here
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Memoized filter design cache
+//
+// Prototype designs (e.g. liquid_firdes_rkaiser) can be expensive and
+// objects such as symsync and firinterp re-run them on every create.
+// Designs are stored once, keyed by design type and parameters, and
+// handed out as shared read-only arrays so that subsequent designs
+// reduce to a copy. Each array is reference counted: it stays valid
+// until released by its holder, even if the cache is cleared in the
+// meantime. The cache is protected by a mutex when pthreads are
+// available; the design itself runs outside of the lock. The total
+// size of stored taps is bounded; once the bound is reached new
+// designs are returned unshared and freed on release.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_LIBPTHREAD && HAVE_PTHREAD_H
+#  include <pthread.h>
+#  define LIQUID_FIRDES_CACHE_LOCK()    pthread_mutex_lock(&liquid_firdes_cache_mutex)
+#  define LIQUID_FIRDES_CACHE_UNLOCK()  pthread_mutex_unlock(&liquid_firdes_cache_mutex)
+static pthread_mutex_t liquid_firdes_cache_mutex = PTHREAD_MUTEX_INITIALIZER;
+#else
+#  define LIQUID_FIRDES_CACHE_LOCK()
+#  define LIQUID_FIRDES_CACHE_UNLOCK()
+#endif
+
+// number of hash buckets (power of two)
+#define LIQUID_FIRDES_CACHE_NUM_BUCKETS (64)
+
+// default maximum total size of cached coefficients [bytes]
+#define LIQUID_FIRDES_CACHE_MAX_BYTES   (1<<20)
+
+// design kinds
+#define LIQUID_FIRDES_CACHE_KAISER      (0)
+#define LIQUID_FIRDES_CACHE_PROTOTYPE   (1)
+
+// design key; all fields are 32 bits wide so keys compare with memcmp
+struct liquid_firdes_cache_key_s {
+    unsigned int kind;      // design kind (kaiser, prototype)
+    unsigned int type;      // prototype filter type
+    unsigned int n;         // filter length (kaiser) or samples/symbol
+    unsigned int m;         // symbol delay (prototype)
+    float        p0;        // cut-off frequency (kaiser) or excess bandwidth
+    float        p1;        // stop-band attenuation (kaiser) or fractional delay
+    float        p2;        // fractional sample offset (kaiser)
+};
+
+// design entry; the coefficients follow the header so that the entry
+// can be recovered from the array handed out
+struct liquid_firdes_cache_entry_s {
+    struct liquid_firdes_cache_key_s     key;
+    unsigned int                         h_len;
+    unsigned int                         num_refs;  // outstanding references
+    int                                  stored;    // entry is held by the cache
+    struct liquid_firdes_cache_entry_s * next;
+    float                                h[];
+};
+
+static struct liquid_firdes_cache_entry_s * liquid_firdes_cache_buckets[LIQUID_FIRDES_CACHE_NUM_BUCKETS];
+static unsigned int liquid_firdes_cache_num_entries = 0;
+static unsigned int liquid_firdes_cache_num_bytes   = 0;
+static unsigned int liquid_firdes_cache_max_bytes   = LIQUID_FIRDES_CACHE_MAX_BYTES;
+
+// hash key (FNV-1a over key bytes)
+unsigned int liquid_firdes_cache_hash(struct liquid_firdes_cache_key_s * _key)
+{
+    unsigned char * p = (unsigned char*) _key;
+    unsigned int h = 2166136261u;
+    unsigned int i;
+    for (i=0; i<sizeof(struct liquid_firdes_cache_key_s); i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h & (LIQUID_FIRDES_CACHE_NUM_BUCKETS-1);
+}
+
+// find entry in bucket (cache must be locked)
+struct liquid_firdes_cache_entry_s * liquid_firdes_cache_find(struct liquid_firdes_cache_key_s * _key,
+                                                              unsigned int                       _bucket)
+{
+    struct liquid_firdes_cache_entry_s * e = liquid_firdes_cache_buckets[_bucket];
+    while (e != NULL) {
+        if (memcmp(&e->key, _key, sizeof(struct liquid_firdes_cache_key_s)) == 0)
+            return e;
+        e = e->next;
+    }
+    return NULL;
+}
+
+// remove all entries from the table, freeing those without outstanding
+// references (cache must be locked)
+void liquid_firdes_cache_flush()
+{
+    unsigned int i;
+    for (i=0; i<LIQUID_FIRDES_CACHE_NUM_BUCKETS; i++) {
+        struct liquid_firdes_cache_entry_s * e = liquid_firdes_cache_buckets[i];
+        while (e != NULL) {
+            struct liquid_firdes_cache_entry_s * next = e->next;
+            e->stored = 0;
+            e->next   = NULL;
+            if (e->num_refs == 0)
+                free(e);
+            e = next;
+        }
+        liquid_firdes_cache_buckets[i] = NULL;
+    }
+    liquid_firdes_cache_num_entries = 0;
+    liquid_firdes_cache_num_bytes   = 0;
+}
+
+// look up design, running it and storing the result on a miss
+//  _key    : design key
+//  _h_len  : filter length
+//  returns shared coefficient array; release with liquid_firdes_cache_release()
+const float * liquid_firdes_cache_lookup(struct liquid_firdes_cache_key_s * _key,
+                                         unsigned int                       _h_len)
+{
+    unsigned int bucket = liquid_firdes_cache_hash(_key);
+
+    // reference existing design
+    LIQUID_FIRDES_CACHE_LOCK();
+    struct liquid_firdes_cache_entry_s * e = liquid_firdes_cache_find(_key, bucket);
+    if (e != NULL)
+        e->num_refs++;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+    if (e != NULL)
+        return e->h;
+
+    // run design without holding the lock
+    unsigned int num_bytes = _h_len*sizeof(float);
+    e = (struct liquid_firdes_cache_entry_s*) malloc(sizeof(struct liquid_firdes_cache_entry_s) + num_bytes);
+    e->key      = *_key;
+    e->h_len    = _h_len;
+    e->num_refs = 1;
+    e->stored   = 0;
+    e->next     = NULL;
+    switch (_key->kind) {
+    case LIQUID_FIRDES_CACHE_KAISER:
+        liquid_firdes_kaiser_internal(_key->n, _key->p0, _key->p1, _key->p2, e->h);
+        break;
+    case LIQUID_FIRDES_CACHE_PROTOTYPE:
+        liquid_firdes_prototype_internal((liquid_firfilt_type)_key->type,
+                                         _key->n, _key->m, _key->p0, _key->p1, e->h);
+        break;
+    default:
+        fprintf(stderr,"error: liquid_firdes_cache_lookup(), invalid design kind\n");
+        exit(1);
+    }
+
+    // store design unless the cache is full; if another thread has
+    // stored the same design meanwhile, share that one instead
+    LIQUID_FIRDES_CACHE_LOCK();
+    struct liquid_firdes_cache_entry_s * d = liquid_firdes_cache_find(_key, bucket);
+    if (d != NULL) {
+        d->num_refs++;
+        free(e);
+        e = d;
+    } else if (liquid_firdes_cache_num_bytes + num_bytes <= liquid_firdes_cache_max_bytes) {
+        e->stored = 1;
+        e->next   = liquid_firdes_cache_buckets[bucket];
+        liquid_firdes_cache_buckets[bucket] = e;
+        liquid_firdes_cache_num_entries++;
+        liquid_firdes_cache_num_bytes += num_bytes;
+    }
+    LIQUID_FIRDES_CACHE_UNLOCK();
+    return e->h;
+}
+
+// get shared Kaiser-windowed low-pass design (see liquid_firdes_kaiser)
+const float * liquid_firdes_cache_kaiser(unsigned int _n,
+                                         float        _fc,
+                                         float        _As,
+                                         float        _mu)
+{
+    struct liquid_firdes_cache_key_s key;
+    memset(&key, 0, sizeof(key));
+    key.kind = LIQUID_FIRDES_CACHE_KAISER;
+    key.n    = _n;
+    key.p0   = _fc;
+    key.p1   = _As;
+    key.p2   = _mu;
+    return liquid_firdes_cache_lookup(&key, _n);
+}
+
+// get shared (root-)Nyquist prototype design (see liquid_firdes_prototype)
+const float * liquid_firdes_cache_prototype(liquid_firfilt_type _type,
+                                            unsigned int        _k,
+                                            unsigned int        _m,
+                                            float               _beta,
+                                            float               _dt)
+{
+    struct liquid_firdes_cache_key_s key;
+    memset(&key, 0, sizeof(key));
+    key.kind = LIQUID_FIRDES_CACHE_PROTOTYPE;
+    key.type = (unsigned int)_type;
+    key.n    = _k;
+    key.m    = _m;
+    key.p0   = _beta;
+    key.p1   = _dt;
+    return liquid_firdes_cache_lookup(&key, 2*_k*_m+1);
+}
+
+// release array returned by liquid_firdes_cache_kaiser() or
+// liquid_firdes_cache_prototype()
+void liquid_firdes_cache_release(const float * _h)
+{
+    struct liquid_firdes_cache_entry_s * e = (struct liquid_firdes_cache_entry_s*)
+        ((unsigned char*)_h - offsetof(struct liquid_firdes_cache_entry_s, h));
+
+    LIQUID_FIRDES_CACHE_LOCK();
+    if (e->num_refs == 0) {
+        LIQUID_FIRDES_CACHE_UNLOCK();
+        fprintf(stderr,"error: liquid_firdes_cache_release(), array already released\n");
+        exit(1);
+    }
+    e->num_refs--;
+    int discard = e->num_refs == 0 && !e->stored;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+
+    if (discard)
+        free(e);
+}
+
+// get number of designs currently held in cache
+unsigned int liquid_firdes_cache_get_num_entries()
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    unsigned int n = liquid_firdes_cache_num_entries;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+    return n;
+}
+
+// get total size of coefficients currently held in cache [bytes]
+unsigned int liquid_firdes_cache_get_num_bytes()
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    unsigned int n = liquid_firdes_cache_num_bytes;
+    LIQUID_FIRDES_CACHE_UNLOCK();
+    return n;
+}
+
+// set maximum total size of coefficients held in cache [bytes], 0 to
+// disable caching; designs are dropped if the cache exceeds the new size
+void liquid_firdes_cache_set_max_bytes(unsigned int _max_bytes)
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    liquid_firdes_cache_max_bytes = _max_bytes;
+    if (liquid_firdes_cache_num_bytes > _max_bytes)
+        liquid_firdes_cache_flush();
+    LIQUID_FIRDES_CACHE_UNLOCK();
+}
+
+// remove all designs from cache, releasing their memory; arrays still
+// referenced are freed when released
+void liquid_firdes_cache_clear()
+{
+    LIQUID_FIRDES_CACHE_LOCK();
+    liquid_firdes_cache_flush();
+    LIQUID_FIRDES_CACHE_UNLOCK();
+}
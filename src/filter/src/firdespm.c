@@ -55,6 +55,24 @@
 
 #include "liquid.internal.h"
 
+#if HAVE_LIBPTHREAD && HAVE_PTHREAD_H
+#  include <pthread.h>
+#  define LIQUID_FIRDESPM_THREADS   1
+#else
+#  define LIQUID_FIRDESPM_THREADS   0
+#endif
+
+// final grid density (points per extremal frequency)
+#define LIQUID_FIRDESPM_GRID_DENSITY        (20)
+
+// adaptive grid: filters with at least this many approximating
+// functions first converge on a coarse grid, then refine
+#define LIQUID_FIRDESPM_COARSE_MIN_R        (64)
+#define LIQUID_FIRDESPM_COARSE_DENSITY      (4)
+
+// minimum number of grid points evaluated by each thread
+#define LIQUID_FIRDESPM_MIN_POINTS_THREAD   (4096)
+
 #define LIQUID_FIRDESPM_DEBUG       0
 #define LIQUID_FIRDESPM_DEBUG_PRINT 0
 
@@ -88,15 +106,19 @@ struct firdespm_s {
     double * D;                 // desired response
     double * W;                 // weight
     double * E;                 // error
+    double * X;                 // grid Chebyshev points : cos(2*pi*F)
 
     double * x;                 // Chebyshev points : cos(2*pi*f)
     double * alpha;             // Lagrange interpolating polynomial
     double * c;                 // interpolants
     double rho;                 // extremal weighted error
+    double rho_prev;            // extremal weighted error, previous iteration
 
     unsigned int * iext;        // indices of extrema
     unsigned int num_exchanges; // number of changes in extrema
 
+    unsigned int num_threads;   // threads for error evaluation
+
 #if LIQUID_FIRDESPM_DEBUG
     FILE * fid;
 #endif
@@ -220,23 +242,15 @@ firdespm firdespm_create(unsigned int _h_len,
             q->weights[i]   = _weights[i];
     }
 
-    // estimate grid size
-    // TODO : adjust grid density based on expected value for rho
-    q->grid_density = 20;
-    q->grid_size = 0;
-    double df = 0.5/(q->grid_density*q->r); // frequency step
-    for (i=0; i<q->num_bands; i++) {
-        double f0 = q->bands[2*i+0];         // lower band edge
-        double f1 = q->bands[2*i+1];         // upper band edge
-        q->grid_size += (unsigned int)( (f1-f0)/df + 1.0 );
-    }
-
     // create the grid
-    q->F = (double*) malloc(q->grid_size*sizeof(double));
-    q->D = (double*) malloc(q->grid_size*sizeof(double));
-    q->W = (double*) malloc(q->grid_size*sizeof(double));
-    q->E = (double*) malloc(q->grid_size*sizeof(double));
+    q->grid_density = LIQUID_FIRDESPM_GRID_DENSITY;
+    q->F = NULL;
+    q->D = NULL;
+    q->W = NULL;
+    q->E = NULL;
+    q->X = NULL;
     firdespm_init_grid(q);
+    q->num_threads = 1;
     // TODO : fix grid, weights according to filter type
 
     // return object
@@ -261,6 +275,7 @@ void firdespm_destroy(firdespm _q)
     free(_q->D);
     free(_q->W);
     free(_q->E);
+    free(_q->X);
 
     // free band description elements
     free(_q->bands);
@@ -298,6 +313,14 @@ void firdespm_print(firdespm _q)
     printf("\n");
 }
 
+// set number of threads used to evaluate the error function on
+// the dense grid; ignored if threads are unavailable
+void firdespm_set_num_threads(firdespm     _q,
+                              unsigned int _num_threads)
+{
+    _q->num_threads = _num_threads < 1 ? 1 : _num_threads;
+}
+
 // execute filter design, storing result in _h
 void firdespm_execute(firdespm _q, float * _h)
 {
@@ -305,17 +328,51 @@ void firdespm_execute(firdespm _q, float * _h)
 
     // initial guess of extremal frequencies evenly spaced on F
     // TODO : guarantee at least one extremal frequency lies in each band
-    for (i=0; i<_q->r+1; i++) {
-        _q->iext[i] = (i * (_q->grid_size-1)) / _q->r;
+    unsigned int max_iterations = 40;
+    if (_q->r >= LIQUID_FIRDESPM_COARSE_MIN_R) {
+        // adaptive grid: converge on a coarse grid first, ...
+        _q->grid_density = LIQUID_FIRDESPM_COARSE_DENSITY;
+        firdespm_init_grid(_q);
+        for (i=0; i<_q->r+1; i++)
+            _q->iext[i] = (i * (_q->grid_size-1)) / _q->r;
+        firdespm_iterate(_q, max_iterations);
+
+        // ... then move extremal frequencies to the final grid where
+        // only a few more exchanges are necessary
+        double fext[_q->r+1];
+        for (i=0; i<_q->r+1; i++)
+            fext[i] = _q->F[_q->iext[i]];
+        _q->grid_density = LIQUID_FIRDESPM_GRID_DENSITY;
+        firdespm_init_grid(_q);
+        firdespm_map_iext(_q, fext);
+    } else {
+        for (i=0; i<_q->r+1; i++) {
+            _q->iext[i] = (i * (_q->grid_size-1)) / _q->r;
 #if LIQUID_FIRDESPM_DEBUG_PRINT
-        printf("iext_guess[%3u] = %u\n", i, _q->iext[i]);
+            printf("iext_guess[%3u] = %u\n", i, _q->iext[i]);
 #endif
+        }
     }
 
     // iterate over the Remez exchange algorithm
+    firdespm_iterate(_q, max_iterations);
+
+    // compute filter taps
+    firdespm_compute_taps(_q, _h);
+}
+
+// 
+// internal methods
+//
+
+// run Remez exchange algorithm on current grid from current
+// extremal frequency estimate
+void firdespm_iterate(firdespm     _q,
+                      unsigned int _max_iterations)
+{
     unsigned int p;
-    unsigned int max_iterations = 40;
-    for (p=0; p<max_iterations; p++) {
+    _q->rho_prev = 0.0;
+    for (p=0; p<_max_iterations; p++) {
         // compute interpolator
         firdespm_compute_interp(_q);
 
@@ -332,15 +389,29 @@ void firdespm_execute(firdespm _q, float * _h)
 #if LIQUID_FIRDESPM_DEBUG_PRINT
     printf("search complete in %u iterations\n", p);
 #endif
-
-    // compute filter taps
-    firdespm_compute_taps(_q, _h);
 }
 
-
-// 
-// internal methods
-//
+// set extremal indices to grid points nearest to frequencies _fext,
+// keeping indices strictly increasing
+void firdespm_map_iext(firdespm _q,
+                       double * _fext)
+{
+    unsigned int i;
+    unsigned int j = 0;
+    for (i=0; i<_q->r+1; i++) {
+        // grid is non-decreasing in frequency
+        while (j+1 < _q->grid_size &&
+               fabs(_q->F[j+1] - _fext[i]) <= fabs(_q->F[j] - _fext[i]))
+            j++;
+
+        unsigned int k = j;
+        if (i > 0 && k <= _q->iext[i-1])
+            k = _q->iext[i-1] + 1;
+        if (k > _q->grid_size - (_q->r+1-i))
+            k = _q->grid_size - (_q->r+1-i);
+        _q->iext[i] = k;
+    }
+}
 
 // initialize the frequency grid on the disjoint bounded set
 void firdespm_init_grid(firdespm _q)
@@ -349,6 +420,19 @@ void firdespm_init_grid(firdespm _q)
 
     // frequency step size
     double df = 0.5/(_q->grid_density*_q->r);
+
+    // estimate grid size and (re-)allocate grid arrays
+    unsigned int grid_size = 0;
+    for (i=0; i<_q->num_bands; i++) {
+        double f0 = _q->bands[2*i+0];         // lower band edge
+        double f1 = _q->bands[2*i+1];         // upper band edge
+        grid_size += (unsigned int)( (f1-f0)/df + 1.0 );
+    }
+    _q->F = (double*) realloc(_q->F, grid_size*sizeof(double));
+    _q->D = (double*) realloc(_q->D, grid_size*sizeof(double));
+    _q->W = (double*) realloc(_q->W, grid_size*sizeof(double));
+    _q->E = (double*) realloc(_q->E, grid_size*sizeof(double));
+    _q->X = (double*) realloc(_q->X, grid_size*sizeof(double));
 #if LIQUID_FIRDESPM_DEBUG_PRINT
     printf("df : %12.8f\n", df);
 #endif
@@ -423,6 +507,10 @@ void firdespm_init_grid(firdespm _q)
     }
     _q->grid_size = n;
 
+    // Chebyshev points on the grid do not change between iterations
+    for (i=0; i<_q->grid_size; i++)
+        _q->X[i] = cos(2*M_PI*_q->F[i]);
+
     // take care of special symmetry conditions here
     if (_q->btype == LIQUID_FIRDESPM_BANDPASS) {
         if (_q->s == 0) {
@@ -467,7 +555,7 @@ void firdespm_compute_interp(firdespm _q)
     //printf("\n");
 
     // compute Lagrange interpolating polynomial
-    poly_fit_lagrange_barycentric(_q->x,_q->r+1,_q->alpha);
+    firdespm_compute_weights(_q);
 #if LIQUID_FIRDESPM_DEBUG_PRINT
     for (i=0; i<_q->r+1; i++)
         printf("a[%3u] = %12.8f\n", i, _q->alpha[i]);
@@ -497,22 +585,133 @@ void firdespm_compute_interp(firdespm _q)
 
 }
 
-void firdespm_compute_error(firdespm _q)
+// compute barycentric weights for Lagrange interpolation on the
+// extremal set. Each product is scaled by a factor of two per term
+// and kept as a mantissa/exponent pair so that it neither overflows
+// nor underflows for long filters.
+void firdespm_compute_weights(firdespm _q)
 {
-    unsigned int i;
+    unsigned int n = _q->r + 1;
+    int e[n];
+    unsigned int j, k;
+    for (j=0; j<n; j++) {
+        double m = 1.0;
+        int    ej = 0;
+        for (k=0; k<n; k++) {
+            if (k == j)
+                continue;
+            m *= 2.0*(_q->x[j] - _q->x[k]);
+
+            // renormalize periodically
+            if ((k & 0x1f) == 0x1f) {
+                int ek;
+                m = frexp(m, &ek);
+                ej += ek;
+            }
+        }
+        int ek;
+        m = frexp(m, &ek);
+        _q->alpha[j] = 1.0 / m;
+        e[j] = ej + ek;
+    }
 
-    double xf;
-    double H;
-    for (i=0; i<_q->grid_size; i++) {
-        // compute actual response
-        xf = cos(2*M_PI*_q->F[i]);
-        H = poly_val_lagrange_barycentric(_q->x,_q->c,_q->alpha,xf,_q->r+1);
+    // normalize by alpha[0]
+    double a0 = _q->alpha[0];
+    for (j=0; j<n; j++)
+        _q->alpha[j] = ldexp(_q->alpha[j] / a0, e[0] - e[j]);
+}
+
+// compute error on grid points [_i0, _i1)
+void firdespm_compute_error_range(firdespm     _q,
+                                  unsigned int _i0,
+                                  unsigned int _i1)
+{
+    unsigned int n = _q->r + 1;
+    unsigned int i, j;
+
+    // exact fit tolerance (same as poly_val_lagrange_barycentric)
+    double tol = 1e-6;
+
+    for (i=_i0; i<_i1; i++) {
+        // compute actual response with barycentric Lagrange
+        // interpolation; one division per extremal point
+        double xf = _q->X[i];
+        double t0 = 0.0;    // numerator sum
+        double t1 = 0.0;    // denominator sum
+        double H;
+        for (j=0; j<n; j++) {
+            double g = xf - _q->x[j];
+            if (fabs(g) < tol)
+                break;
+            double d = _q->alpha[j] / g;
+            t0 += d * _q->c[j];
+            t1 += d;
+        }
+        H = j < n ? _q->c[j] : t0 / t1;
 
         // compute error
         _q->E[i] = _q->W[i] * (_q->D[i] - H);
     }
 }
 
+#if LIQUID_FIRDESPM_THREADS
+// thread arguments for error evaluation
+struct firdespm_thread_s {
+    firdespm     q;
+    unsigned int i0;
+    unsigned int i1;
+};
+
+void * firdespm_compute_error_thread(void * _arg)
+{
+    struct firdespm_thread_s * t = (struct firdespm_thread_s*) _arg;
+    firdespm_compute_error_range(t->q, t->i0, t->i1);
+    return NULL;
+}
+#endif
+
+// compute error signal from actual response (interpolator
+// output), desired response, and weights
+void firdespm_compute_error(firdespm _q)
+{
+#if LIQUID_FIRDESPM_THREADS
+    // split grid among threads, each with a minimum number of points
+    unsigned int num_threads = _q->num_threads;
+    unsigned int max_threads = _q->grid_size / LIQUID_FIRDESPM_MIN_POINTS_THREAD;
+    if (num_threads > max_threads)
+        num_threads = max_threads;
+
+    if (num_threads > 1) {
+        pthread_t                threads[num_threads];
+        struct firdespm_thread_s args[num_threads];
+        unsigned int i;
+        for (i=0; i<num_threads; i++) {
+            args[i].q  = _q;
+            args[i].i0 = ( i   *_q->grid_size) / num_threads;
+            args[i].i1 = ((i+1)*_q->grid_size) / num_threads;
+        }
+
+        // run first portion on calling thread
+        unsigned int num_started = 1;
+        for (i=1; i<num_threads; i++) {
+            if (pthread_create(&threads[i], NULL, firdespm_compute_error_thread, &args[i]) != 0)
+                break;
+            num_started++;
+        }
+        // evaluate portions of threads which could not be started
+        unsigned int k;
+        for (k=num_started; k<num_threads; k++)
+            firdespm_compute_error_range(_q, args[k].i0, args[k].i1);
+
+        firdespm_compute_error_range(_q, args[0].i0, args[0].i1);
+        for (i=1; i<num_started; i++)
+            pthread_join(threads[i], NULL);
+        return;
+    }
+#endif
+    firdespm_compute_error_range(_q, 0, _q->grid_size);
+}
+
 // search error curve for r+1 extremal indices
 // TODO : return number of values which have changed (exit criteria)
 void firdespm_iext_search(firdespm _q)
@@ -670,6 +869,15 @@ int firdespm_is_search_complete(firdespm _q)
     unsigned int i;
     double tol = 1e-3f;
 
+    // once the grid resolution is reached, exchanges can cycle among
+    // neighboring grid points without improving the extremal error
+    double tol_rho = 1e-5;
+    int stalled = _q->rho_prev != 0.0 &&
+                  fabs(fabs(_q->rho) - fabs(_q->rho_prev)) < tol_rho*fabs(_q->rho);
+    _q->rho_prev = _q->rho;
+    if (stalled)
+        return 1;
+
     double e=0.0;
     double emin=0.0;
     double emax=0.0;
@@ -724,12 +932,23 @@ void firdespm_compute_taps(firdespm _q, float * _h)
     // TODO : flesh out computation for other filter types
     unsigned int j;
     if (_q->btype == LIQUID_FIRDESPM_BANDPASS) {
-        // odd filter length, even symmetry
+        // odd filter length, even symmetry; the argument of each cosine
+        // is an integer multiple of pi/h_len, so use a look-up table
+        unsigned int nt = 2*_q->h_len;
+        double ct[nt];
+        for (i=0; i<nt; i++)
+            ct[i] = cos(M_PI*(double)i/(double)(_q->h_len));
         for (i=0; i<_q->h_len; i++) {
             double v = G[0];
-            double f = ((double)i - (double)(p-1) + 0.5*(1-_q->s)) / (double)(_q->h_len);
-            for (j=1; j<_q->r; j++)
-                v += 2.0 * G[j] * cos(2*M_PI*f*j);
+            // 2*f*h_len = 2*i - 2*(p-1) + (1-s), reduced modulo nt
+            long int k = 2*(long int)i - 2*(long int)(p-1) + (1-(long int)_q->s);
+            unsigned int kp = (unsigned int)( ((k % (long int)nt) + nt) % nt );
+            unsigned int t = 0;
+            for (j=1; j<_q->r; j++) {
+                t += kp;
+                if (t >= nt) t -= nt;
+                v += 2.0 * G[j] * ct[t];
+            }
             _h[i] = v / (double)(_q->h_len);
         }
     } else if (_q->btype != LIQUID_FIRDESPM_BANDPASS && _q->s==1) {
@@ -25,6 +25,19 @@
 //
 // Finite impulse response Farrow filter
 //
+// Each filter tap is represented as a polynomial in the fractional
+// delay mu. Two alternatives to re-evaluating all h_len polynomials
+// on every delay change are provided:
+//
+//  * FIRFARROW(_execute_farrow) runs the classic Farrow structure:
+//    the input is filtered through Q+1 fixed sub-filters (one per
+//    polynomial coefficient) and their outputs are combined with
+//    Horner's rule on mu, costing only O(Q) per change in delay.
+//
+//  * FIRFARROW(_set_delay_cache) pre-computes the taps on a uniform
+//    grid of delays; FIRFARROW(_set_delay) then quantizes mu to the
+//    nearest grid point and selects the cached taps.
+//
 
 #include <stdio.h>
 #include <string.h>
@@ -43,7 +56,8 @@
 //  PRINTVAL()      print macro
 
 struct FIRFARROW(_s) {
-    TC * h;             // filter coefficients
+    TC * h;             // filter coefficients (h_buf or cache row)
+    TC * h_buf;         // filter coefficients buffer
     unsigned int h_len; // filter length
     float fc;           // filter cutoff
     float As;           // stop-band attenuation [dB]
@@ -53,6 +67,15 @@ struct FIRFARROW(_s) {
     float * P;          // polynomail coefficients matrix [ h_len x Q+1 ]
     float gamma;        // inverse of DC response (normalization factor)
 
+    // Farrow structure: sub-filter j holds coefficient j of each
+    // tap polynomial (scaled by gamma)
+    DOTPROD() * dp;     // sub-filters [size: Q+1 x 1]
+    TO * v_sub;         // sub-filter outputs [size: Q+1 x 1]
+
+    // quantized delay coefficient cache
+    TC * cache;         // cached taps [size: cache_len x h_len]
+    unsigned int cache_len; // number of delay values, 0 if disabled
+
 #if FIRFARROW_USE_DOTPROD
     WINDOW() w;
 #else
@@ -93,7 +116,12 @@ FIRFARROW() FIRFARROW(_create)(unsigned int _h_len,
     q->fc    = _fc;     // filter cutoff frequency
 
     // allocate memory for filter coefficients
-    q->h = (TC *) malloc((q->h_len)*sizeof(TC));
+    q->h_buf = (TC *) malloc((q->h_len)*sizeof(TC));
+    q->h     = q->h_buf;
+
+    // coefficient cache is disabled by default
+    q->cache     = NULL;
+    q->cache_len = 0;
 
 #if FIRFARROW_USE_DOTPROD
     q->w = WINDOW(_create)(q->h_len);
@@ -110,6 +138,17 @@ FIRFARROW() FIRFARROW(_create)(unsigned int _h_len,
     // generate polynomials
     FIRFARROW(_genpoly)(q);
 
+    // create Farrow sub-filters from polynomial coefficients
+    q->dp    = (DOTPROD()*) malloc((q->Q+1)*sizeof(DOTPROD()));
+    q->v_sub = (TO *)        malloc((q->Q+1)*sizeof(TO));
+    TC c[q->h_len];
+    unsigned int i, j;
+    for (j=0; j<=q->Q; j++) {
+        for (i=0; i<q->h_len; i++)
+            c[i] = q->P[i*(q->Q+1) + j] * q->gamma;
+        q->dp[j] = DOTPROD(_create)(c, q->h_len);
+    }
+
     // set nominal delay of 0
     FIRFARROW(_set_delay)(q,0.0f);
 
@@ -125,8 +164,16 @@ void FIRFARROW(_destroy)(FIRFARROW() _q)
 #else
     free(_q->v);
 #endif
-    free(_q->h);    // free the filter coefficients array
-    free(_q->P);    // free the polynomial matrix
+    free(_q->h_buf);    // free the filter coefficients array
+    free(_q->P);        // free the polynomial matrix
+    free(_q->cache);    // free the coefficient cache
+
+    // destroy Farrow sub-filters
+    unsigned int j;
+    for (j=0; j<=_q->Q; j++)
+        DOTPROD(_destroy)(_q->dp[j]);
+    free(_q->dp);
+    free(_q->v_sub);
 
     // free main object
     free(_q);
@@ -195,11 +242,23 @@ void FIRFARROW(_set_delay)(FIRFARROW() _q,
         fprintf(stderr,"warning: firfarrow_%s_set_delay(), delay out of range\n", EXTENSION_FULL);
     }
 
+    // use cached taps at nearest quantized delay
+    if (_q->cache_len > 0) {
+        float m = roundf(0.5f*(_mu + 1.0f)*(float)(_q->cache_len-1));
+        unsigned int k = m < 0.0f ? 0 : (unsigned int) m;
+        k = k >= _q->cache_len ? _q->cache_len-1 : k;
+        _q->mu = -1.0f + 2.0f*(float)k/(float)(_q->cache_len-1);
+        _q->h  = _q->cache + k*_q->h_len;
+        return;
+    }
+
+    _q->mu = _mu;
+    _q->h  = _q->h_buf;
     unsigned int i, n=0;
     for (i=0; i<_q->h_len; i++) {
         // compute filter tap from polynomial using negative
         // value for _mu
-        _q->h[i] = POLY(_val)(_q->P+n, _q->Q, -_mu);
+        _q->h[i] = POLY(_val)(_q->P+n, _q->Q+1, -_mu);
 
         // normalize filter by inverse of DC response
         _q->h[i] *= _q->gamma;
@@ -229,6 +288,75 @@ void FIRFARROW(_execute)(FIRFARROW() _q,
 #endif
 }
 
+// execute firfarrow using the Farrow structure: the internal buffer
+// is filtered by each of the Q+1 fixed sub-filters and the outputs
+// are combined with Horner's rule on the fractional delay; the
+// coefficients set with FIRFARROW(_set_delay) are not used
+//  _q      : firfarrow object
+//  _mu     : fractional sample delay
+//  _y      : output sample pointer
+void FIRFARROW(_execute_farrow)(FIRFARROW() _q,
+                                float       _mu,
+                                TO *        _y)
+{
+    // compute sub-filter outputs
+    unsigned int j;
+#if FIRFARROW_USE_DOTPROD
+    TI *r;
+    WINDOW(_read)(_q->w, &r);
+#else
+    TI r[_q->h_len];
+    for (j=0; j<_q->h_len; j++)
+        r[j] = _q->v[ (j+_q->v_index)%(_q->h_len) ];
+#endif
+    for (j=0; j<=_q->Q; j++)
+        DOTPROD(_execute)(_q->dp[j], r, &_q->v_sub[j]);
+
+    // combine using Horner's rule; taps are polynomials in -mu (see
+    // FIRFARROW(_set_delay))
+    TO y = _q->v_sub[_q->Q];
+    for (j=_q->Q; j>0; j--)
+        y = y*(-_mu) + _q->v_sub[j-1];
+    *_y = y;
+}
+
+// enable quantized delay coefficient cache: taps are computed once
+// for _n delay values uniformly spaced in [-1,1], and subsequent
+// calls to FIRFARROW(_set_delay) select the taps nearest to the
+// requested delay rather than evaluating the tap polynomials
+//  _q      : firfarrow object
+//  _n      : number of cached delay values (0 to disable, else > 1)
+void FIRFARROW(_set_delay_cache)(FIRFARROW() _q,
+                                 unsigned int _n)
+{
+    // validate input
+    if (_n == 1) {
+        fprintf(stderr,"error: firfarrow_%s_set_delay_cache(), cache must have at least 2 entries\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // disable existing cache, returning to evaluated taps
+    float mu = _q->mu;
+    free(_q->cache);
+    _q->cache     = NULL;
+    _q->cache_len = 0;
+
+    if (_n > 0) {
+        // evaluate taps on grid
+        TC * cache = (TC *) malloc(_n*(_q->h_len)*sizeof(TC));
+        unsigned int k;
+        for (k=0; k<_n; k++) {
+            FIRFARROW(_set_delay)(_q, -1.0f + 2.0f*(float)k/(float)(_n-1));
+            memmove(cache + k*_q->h_len, _q->h_buf, (_q->h_len)*sizeof(TC));
+        }
+        _q->cache     = cache;
+        _q->cache_len = _n;
+    }
+
+    // restore delay
+    FIRFARROW(_set_delay)(_q, mu);
+}
+
 // compute firfarrow filter on block of samples; the input
 // and output arrays may have the same pointer
 //  _q      : firfarrow object
@@ -314,7 +442,7 @@ void FIRFARROW(_genpoly)(FIRFARROW() _q)
     float x, mu, h0, h1;
     float mu_vect[_q->Q+1];
     float hp_vect[_q->Q+1];
-    float p[_q->Q];
+    float p[_q->Q+1];
     float beta = kaiser_beta_As(_q->As);
     for (i=0; i<_q->h_len; i++) {
 #if FIRFARROW_DEBUG
@@ -403,3 +403,50 @@ float FIRFILT(_groupdelay)(FIRFILT() _q,
     return fir_group_delay(h, n, _fc);
 }
 
+// compute complex frequency response on uniform frequency grid
+//  _q      :   filter object
+//  _f0     :   first grid frequency
+//  _df     :   grid frequency spacing
+//  _n      :   number of grid points
+//  _H      :   output frequency response [size: _n x 1]
+void FIRFILT(_freqresponse_grid)(FIRFILT()       _q,
+                                 float           _f0,
+                                 float           _df,
+                                 unsigned int    _n,
+                                 float complex * _H)
+{
+    // copy coefficients to complex array
+    float complex h[_q->h_len];
+    unsigned int i;
+    for (i=0; i<_q->h_len; i++)
+        h[i] = _q->h[i];
+
+    liquid_freqrespcf_grid(h, _q->h_len, _f0, _df, _n, _H);
+
+    // apply scaling
+    for (i=0; i<_n; i++)
+        _H[i] *= _q->scale;
+}
+
+// compute group delay in samples on uniform frequency grid
+//  _q      :   filter object
+//  _f0     :   first grid frequency
+//  _df     :   grid frequency spacing
+//  _n      :   number of grid points
+//  _gd     :   output group delay [size: _n x 1]
+void FIRFILT(_groupdelay_grid)(FIRFILT()    _q,
+                               float        _f0,
+                               float        _df,
+                               unsigned int _n,
+                               float *      _gd)
+{
+    // copy coefficients to be in correct order
+    float h[_q->h_len];
+    unsigned int i;
+    unsigned int n = _q->h_len;
+    for (i=0; i<n; i++)
+        h[i] = crealf(_q->h[n-i-1]);
+
+    fir_group_delay_grid(h, n, _f0, _df, _n, _gd);
+}
+
@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// firfiltmc.c
+//
+// multi-channel finite impulse response filter
+//
+// The same filter is applied to a number of synchronized channels.
+// Rather than keeping a separate window for each channel, the
+// internal buffer is organized by frame (one sample from every
+// channel, contiguous in memory) such that the inner loop of the dot
+// product runs across channels with unit stride. This turns even
+// filters with very few taps into full-width vector operations and
+// keeps a single copy of the coefficients.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct FIRFILTMC(_s) {
+    TC * h;                     // filter coefficients array (reversed)
+    unsigned int h_len;         // filter length
+    unsigned int num_channels;  // number of channels
+
+    // frame buffer (window of h_len frames, num_channels wide)
+    T * v;                      // allocated array pointer
+    unsigned int n;             // number of frames before wrapping, 2^m
+    unsigned int mask;          // n-1
+    unsigned int read_index;    // index of oldest frame in window
+
+    // scratch frames used for planar input/output
+    TI * x_frame;               // input frame  [size: num_channels x 1]
+    TO * y_frame;               // output frame [size: num_channels x 1]
+
+    TC scale;                   // output scaling factor
+};
+
+// create multi-channel filter from external coefficients
+//  _num_channels : number of channels, _num_channels > 0
+//  _h            : filter coefficients [size: _n x 1]
+//  _n            : filter length, _n > 0
+FIRFILTMC() FIRFILTMC(_create)(unsigned int _num_channels,
+                               TC *         _h,
+                               unsigned int _n)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: firfiltmc_%s_create(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_n == 0) {
+        fprintf(stderr,"error: firfiltmc_%s_create(), filter length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create filter object and initialize
+    FIRFILTMC() q = (FIRFILTMC()) malloc(sizeof(struct FIRFILTMC(_s)));
+    q->h_len        = _n;
+    q->num_channels = _num_channels;
+
+    // load filter in reverse order
+    q->h = (TC *) malloc((q->h_len)*sizeof(TC));
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        q->h[i] = _h[_n-i-1];
+
+    // allocate frame buffer; as with the window object, extra memory
+    // is allocated so that the buffer only needs to be shifted once
+    // every n pushes
+    q->n    = 1 << liquid_msb_index(q->h_len);
+    q->mask = q->n - 1;
+    q->v    = (T *) malloc((q->n + q->h_len - 1)*q->num_channels*sizeof(T));
+
+    // allocate scratch frames
+    q->x_frame = (TI *) malloc(q->num_channels*sizeof(TI));
+    q->y_frame = (TO *) malloc(q->num_channels*sizeof(TO));
+
+    // set default scaling
+    q->scale = 1;
+
+    // reset filter state (clear buffer)
+    FIRFILTMC(_reset)(q);
+    return q;
+}
+
+// destroy filter object and free all internal memory
+void FIRFILTMC(_destroy)(FIRFILTMC() _q)
+{
+    free(_q->h);
+    free(_q->v);
+    free(_q->x_frame);
+    free(_q->y_frame);
+    free(_q);
+}
+
+// reset internal state of filter object
+void FIRFILTMC(_reset)(FIRFILTMC() _q)
+{
+    _q->read_index = 0;
+    memset(_q->v, 0, (_q->n + _q->h_len - 1)*_q->num_channels*sizeof(T));
+}
+
+// print filter object internals (taps, buffer)
+void FIRFILTMC(_print)(FIRFILTMC() _q)
+{
+    printf("firfiltmc_%s: [%u channels, %u taps]\n",
+            EXTENSION_FULL, _q->num_channels, _q->h_len);
+    unsigned int i;
+    unsigned int n = _q->h_len;
+    for (i=0; i<n; i++) {
+        printf("  h(%3u) = ", i+1);
+        PRINTVAL_TC(_q->h[n-i-1],%12.8f);
+        printf(";\n");
+    }
+}
+
+// set output scaling for filter
+void FIRFILTMC(_set_scale)(FIRFILTMC() _q,
+                           TC          _scale)
+{
+    _q->scale = _scale;
+}
+
+// get number of channels
+unsigned int FIRFILTMC(_get_num_channels)(FIRFILTMC() _q)
+{
+    return _q->num_channels;
+}
+
+// get length of filter
+unsigned int FIRFILTMC(_get_length)(FIRFILTMC() _q)
+{
+    return _q->h_len;
+}
+
+// push one frame (one sample per channel) into buffer
+//  _q      : filter object
+//  _x      : input frame [size: num_channels x 1]
+void FIRFILTMC(_push)(FIRFILTMC() _q,
+                      TI *        _x)
+{
+    unsigned int C = _q->num_channels;
+
+    // increment index, wrapping around pointer
+    _q->read_index = (_q->read_index + 1) & _q->mask;
+
+    // if pointer wraps around, copy excess memory
+    if (_q->read_index == 0)
+        memmove(_q->v, _q->v + _q->n*C, (_q->h_len-1)*C*sizeof(T));
+
+    // append frame to end of buffer
+    memcpy(_q->v + (_q->read_index + _q->h_len - 1)*C, _x, C*sizeof(T));
+}
+
+// execute the filter on internal buffer for all channels
+//  _q      : filter object
+//  _y      : output frame [size: num_channels x 1]
+void FIRFILTMC(_execute)(FIRFILTMC() _q,
+                         TO *        _y)
+{
+#if TC_COMPLEX == 0
+    // real coefficients: operate on the underlying real-valued arrays
+    // so that complex samples do not break vectorization
+    typedef float TE;
+    unsigned int C = _q->num_channels * (TI_COMPLEX ? 2 : 1);
+#else
+    typedef T TE;
+    unsigned int C = _q->num_channels;
+#endif
+    TE * y = (TE*) _y;
+    TE * r = (TE*) (_q->v + _q->read_index*_q->num_channels);
+    unsigned int c, k;
+
+    // t = 4*(floor(C/4))
+    unsigned int t = (C>>2)<<2;
+
+    // compute outputs in groups of 4 channels, running over all taps
+    // with the accumulators held in registers; each group of 4
+    // adjacent channels is a single vector operation
+    for (c=0; c<t; c+=4) {
+        TE * p = r + c;
+        TE y0 = 0, y1 = 0, y2 = 0, y3 = 0;
+        for (k=0; k<_q->h_len; k++) {
+            TC hk = _q->h[k];
+            y0 += hk * p[0];
+            y1 += hk * p[1];
+            y2 += hk * p[2];
+            y3 += hk * p[3];
+            p += C;
+        }
+        y[c  ] = y0;
+        y[c+1] = y1;
+        y[c+2] = y2;
+        y[c+3] = y3;
+    }
+
+    // clean up remaining
+    for ( ; c<C; c++) {
+        TE * p = r + c;
+        TE v = 0;
+        for (k=0; k<_q->h_len; k++)
+            v += _q->h[k] * p[k*C];
+        y[c] = v;
+    }
+
+    // apply scaling factor
+    if (_q->scale != 1) {
+        for (c=0; c<C; c++)
+            y[c] *= _q->scale;
+    }
+}
+
+// execute the filter on a block of interleaved samples; the input
+// and output buffers may be the same
+//  _q      : filter object
+//  _x      : input array [size: _n*num_channels x 1]
+//  _n      : number of samples per channel
+//  _y      : output array [size: _n*num_channels x 1]
+void FIRFILTMC(_execute_block)(FIRFILTMC()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    unsigned int i;
+    unsigned int C = _q->num_channels;
+    for (i=0; i<_n; i++) {
+        // push frame into buffer
+        FIRFILTMC(_push)(_q, &_x[i*C]);
+
+        // compute output frame
+        FIRFILTMC(_execute)(_q, &_y[i*C]);
+    }
+}
+
+// execute the filter on a block of planar samples; the input and
+// output buffers may be the same
+//  _q      : filter object
+//  _x      : input array [size: num_channels*_n x 1]
+//  _n      : number of samples per channel
+//  _y      : output array [size: num_channels*_n x 1]
+void FIRFILTMC(_execute_block_planar)(FIRFILTMC()  _q,
+                                      TI *         _x,
+                                      unsigned int _n,
+                                      TO *         _y)
+{
+    unsigned int i, c;
+    unsigned int C = _q->num_channels;
+    for (i=0; i<_n; i++) {
+        // gather input frame
+        for (c=0; c<C; c++)
+            _q->x_frame[c] = _x[c*_n + i];
+
+        // push frame into buffer and compute output frame
+        FIRFILTMC(_push)(_q, _q->x_frame);
+        FIRFILTMC(_execute)(_q, _q->y_frame);
+
+        // scatter output frame
+        for (c=0; c<C; c++)
+            _y[c*_n + i] = _q->y_frame[c];
+    }
+}
+
@@ -31,6 +31,10 @@
 #include <stdlib.h>
 #include <math.h>
 
+// minimum quadrature filter length (2*m) for which block methods
+// run the frequency-domain (overlap-save) filter
+#define FIRHILB_FFT_MIN_LEN     (160)
+
 // defined:
 //  FIRHILB()       name-mangling macro
 //  T               coefficients type
@@ -59,8 +63,62 @@ struct FIRHILB(_s) {
 
     // regular real-to-complex/complex-to-real operation
     unsigned int toggle;
+
+    // frequency-domain (overlap-save) filter for block methods,
+    // used only when hq_len >= FIRHILB_FFT_MIN_LEN
+    unsigned int nfft;      // transform size (zero if disabled)
+    unsigned int fft_blen;  // outputs per transform segment
+    unsigned int fft_cap;   // maximum samples per branch per pass
+    T complex * time_buf;   // time-domain buffer [size: nfft x 1]
+    T complex * freq_buf;   // freq-domain buffer [size: nfft x 1]
+    T complex * H;          // transform of filter [size: nfft x 1]
+    T * buf0;               // branch buffer [size: hq_len+fft_cap x 1]
+    T * buf1;               // branch buffer [size: hq_len+fft_cap x 1]
+    T * y0;                 // branch output [size: fft_cap x 1]
+    T * y1;                 // branch output [size: fft_cap x 1]
+#ifdef LIQUID_FFTOVERRIDE
+    fftplan fft;            // forward transform
+    fftplan ifft;           // inverse transform
+#else
+    FFT_PLAN fft;           // forward transform
+    FFT_PLAN ifft;          // inverse transform
+#endif
 };
 
+// run quadrature filter on two real-valued sequences in the
+// frequency domain using overlap-save; the sequences are packed
+// into the real and imaginary parts of a single transform
+//  _q      :   firhilb object
+//  _xa     :   first input with hq_len-1 history samples preceding
+//              [size: hq_len-1+_na x 1]
+//  _na     :   number of outputs of first sequence
+//  _ya     :   first output, _ya[i] = sum_j hq[j] _xa[i+j]
+//  _xb     :   second input [size: hq_len-1+_nb x 1]
+//  _nb     :   number of outputs of second sequence
+//  _yb     :   second output, _yb[i] = sum_j hq[j] _xb[i+j]
+void FIRHILB(_fft_filter)(FIRHILB()    _q,
+                          T *          _xa,
+                          unsigned int _na,
+                          T *          _ya,
+                          T *          _xb,
+                          unsigned int _nb,
+                          T *          _yb);
+
+// compute new length-_n segment of polyphase branches for block
+// methods, preloading each with its window's history
+//  _q      :   firhilb object
+//  _w      :   branch window object
+//  _buf    :   branch buffer [size: hq_len+_n x 1]
+//  _x      :   input samples with stride
+//  _stride :   input stride
+//  _n      :   number of new samples
+void FIRHILB(_load_branch)(FIRHILB()    _q,
+                           WINDOW()     _w,
+                           T *          _buf,
+                           T *          _x,
+                           unsigned int _stride,
+                           unsigned int _n);
+
 // create firhilb object
 //  _m      :   filter semi-length (delay: 2*m+1)
 //  _As     :   stop-band attenuation [dB]
@@ -112,6 +170,39 @@ FIRHILB() FIRHILB(_create)(unsigned int _m,
     // create internal dot product object
     q->dpq = DOTPROD(_create)(q->hq, q->hq_len);
 
+    // set up frequency-domain filter for long filters
+    q->nfft = 0;
+    if (q->hq_len >= FIRHILB_FFT_MIN_LEN) {
+        q->nfft     = 1 << liquid_nextpow2(6*q->hq_len);
+        q->fft_blen = q->nfft - q->hq_len + 1;
+        q->fft_cap  = 2*q->fft_blen;
+        q->time_buf = (T complex *) malloc(q->nfft*sizeof(T complex));
+        q->freq_buf = (T complex *) malloc(q->nfft*sizeof(T complex));
+        q->H        = (T complex *) malloc(q->nfft*sizeof(T complex));
+        q->buf0     = (T *) malloc((q->hq_len + q->fft_cap)*sizeof(T));
+        q->buf1     = (T *) malloc((q->hq_len + q->fft_cap)*sizeof(T));
+        q->y0       = (T *) malloc(q->fft_cap*sizeof(T));
+        q->y1       = (T *) malloc(q->fft_cap*sizeof(T));
+#ifdef LIQUID_FFTOVERRIDE
+        q->fft  = fft_create_plan(q->nfft, q->time_buf, q->freq_buf, LIQUID_FFT_FORWARD,  0);
+        q->ifft = fft_create_plan(q->nfft, q->freq_buf, q->time_buf, LIQUID_FFT_BACKWARD, 0);
+#else
+        q->fft  = FFT_CREATE_PLAN(q->nfft, q->time_buf, q->freq_buf, FFT_DIR_FORWARD,  FFT_METHOD);
+        q->ifft = FFT_CREATE_PLAN(q->nfft, q->freq_buf, q->time_buf, FFT_DIR_BACKWARD, FFT_METHOD);
+#endif
+
+        // transform of quadrature filter (time-reversed dot product
+        // coefficients), normalized by transform size
+        for (i=0; i<q->nfft; i++)
+            q->time_buf[i] = i < q->hq_len ? q->hq[q->hq_len-i-1] / (float)(q->nfft) : 0.0f;
+#ifdef LIQUID_FFTOVERRIDE
+        fft_execute(q->fft);
+#else
+        FFT_EXECUTE(q->fft);
+#endif
+        memmove(q->H, q->freq_buf, q->nfft*sizeof(T complex));
+    }
+
     // reset internal state and return object
     FIRHILB(_reset)(q);
     return q;
@@ -127,6 +218,24 @@ void FIRHILB(_destroy)(FIRHILB() _q)
     // destroy internal dot product object
     DOTPROD(_destroy)(_q->dpq);
 
+    // destroy frequency-domain filter
+    if (_q->nfft > 0) {
+#ifdef LIQUID_FFTOVERRIDE
+        fft_destroy_plan(_q->fft);
+        fft_destroy_plan(_q->ifft);
+#else
+        FFT_DESTROY_PLAN(_q->fft);
+        FFT_DESTROY_PLAN(_q->ifft);
+#endif
+        free(_q->time_buf);
+        free(_q->freq_buf);
+        free(_q->H);
+        free(_q->buf0);
+        free(_q->buf1);
+        free(_q->y0);
+        free(_q->y1);
+    }
+
     // free coefficients arrays
     free(_q->h);
     free(_q->hc);
@@ -221,6 +330,89 @@ void FIRHILB(_c2r_execute)(FIRHILB() _q,
     *_y = crealf(_x);
 }
 
+// execute Hilbert transform (real to complex) on a block of samples;
+// output is identical to running FIRHILB(_r2c_execute) on each sample
+//  _q      :   firhilb object
+//  _x      :   real-valued input array [size: _n x 1]
+//  _n      :   number of input samples
+//  _y      :   complex-valued output array [size: _n x 1]
+void FIRHILB(_r2c_execute_block)(FIRHILB()    _q,
+                                 T *          _x,
+                                 unsigned int _n,
+                                 T complex *  _y)
+{
+    unsigned int i;
+
+    // run time-domain filter for short filters or blocks
+    if (_q->nfft == 0 || _n < 2*_q->hq_len) {
+        for (i=0; i<_n; i++)
+            FIRHILB(_r2c_execute)(_q, _x[i], &_y[i]);
+        return;
+    }
+
+    // Process pairs of samples: sample 2i enters branch 'a' (the
+    // branch that receives the next sample) and its quadrature
+    // component is the filtered output of branch 'b' one sample
+    // earlier; sample 2i+1 enters branch 'b' and filters branch 'a'.
+    while (_n > 0) {
+        WINDOW() wa = _q->toggle == 0 ? _q->w0 : _q->w1;
+        WINDOW() wb = _q->toggle == 0 ? _q->w1 : _q->w0;
+        unsigned int num_pairs = _n/2 < _q->fft_cap ? _n/2 : _q->fft_cap;
+        if (num_pairs == 0) {
+            FIRHILB(_r2c_execute)(_q, _x[0], &_y[0]);
+            break;
+        }
+        unsigned int nb = num_pairs;    // samples into branch 'b'
+        unsigned int na = num_pairs;    // samples into branch 'a'
+
+        // load branches and run quadrature filter on each
+        FIRHILB(_load_branch)(_q, wa, _q->buf0, _x,   2, na);
+        FIRHILB(_load_branch)(_q, wb, _q->buf1, _x+1, 2, nb);
+        FIRHILB(_fft_filter)(_q, _q->buf0+1, na, _q->y0,
+                                 _q->buf1+1, nb, _q->y1);
+
+        // combine delayed in-phase and filtered quadrature components:
+        // branch 'b' output at index i-1 is read from its history
+        // when i is zero
+        T yq;
+        for (i=0; i<num_pairs; i++) {
+            if (i == 0) {
+                T * r;
+                WINDOW(_read)(wb, &r);
+                DOTPROD(_execute)(_q->dpq, r, &yq);
+            } else {
+                yq = _q->y1[i-1];
+            }
+            _y[2*i  ] = _q->buf0[_q->m + i] + _Complex_I*yq;
+            _y[2*i+1] = _q->buf1[_q->m + i] + _Complex_I*_q->y0[i];
+        }
+
+        // retain branch history in windows
+        unsigned int nw = na < _q->hq_len ? na : _q->hq_len;
+        WINDOW(_write)(wa, _q->buf0 + _q->hq_len + na - nw, nw);
+        WINDOW(_write)(wb, _q->buf1 + _q->hq_len + nb - nw, nw);
+
+        _x += 2*num_pairs;
+        _y += 2*num_pairs;
+        _n -= 2*num_pairs;
+    }
+}
+
+// execute Hilbert transform (complex to real) on a block of samples
+//  _q      :   firhilb object
+//  _x      :   complex-valued input array [size: _n x 1]
+//  _n      :   number of input samples
+//  _y      :   real-valued output array [size: _n x 1]
+void FIRHILB(_c2r_execute_block)(FIRHILB()    _q,
+                                 T complex *  _x,
+                                 unsigned int _n,
+                                 T *          _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        FIRHILB(_c2r_execute)(_q, _x[i], &_y[i]);
+}
+
 // execute Hilbert transform decimator (real to complex)
 //  _q      :   firhilb object
 //  _x      :   real-valued input array [size: 2 x 1]
@@ -258,8 +450,36 @@ void FIRHILB(_decim_execute_block)(FIRHILB()    _q,
 {
     unsigned int i;
 
-    for (i=0; i<_n; i++)
-        FIRHILB(_decim_execute)(_q, &_x[2*i], &_y[i]);
+    // run time-domain filter for short filters or blocks
+    if (_q->nfft == 0 || _n < _q->hq_len) {
+        for (i=0; i<_n; i++)
+            FIRHILB(_decim_execute)(_q, &_x[2*i], &_y[i]);
+        return;
+    }
+
+    // even samples are filtered (quadrature), odd samples are
+    // delayed (in-phase)
+    while (_n > 0) {
+        unsigned int n = _n < _q->fft_cap ? _n : _q->fft_cap;
+
+        FIRHILB(_load_branch)(_q, _q->w1, _q->buf1, _x,   2, n);
+        FIRHILB(_load_branch)(_q, _q->w0, _q->buf0, _x+1, 2, n);
+        // split branch in two halves to fill both parts of transform
+        unsigned int n1 = (n+1)/2;
+        FIRHILB(_fft_filter)(_q, _q->buf1+1,    n1,   _q->y1,
+                                 _q->buf1+1+n1, n-n1, _q->y1+n1);
+        for (i=0; i<n; i++)
+            _y[i] = _q->buf0[_q->m + i] + _Complex_I*_q->y1[i];
+
+        // retain branch history in windows
+        unsigned int nw = n < _q->hq_len ? n : _q->hq_len;
+        WINDOW(_write)(_q->w0, _q->buf0 + _q->hq_len + n - nw, nw);
+        WINDOW(_write)(_q->w1, _q->buf1 + _q->hq_len + n - nw, nw);
+
+        _x += 2*n;
+        _y += n;
+        _n -= n;
+    }
 }
 
 // execute Hilbert transform interpolator (complex to real)
@@ -296,6 +516,132 @@ void FIRHILB(_interp_execute_block)(FIRHILB()    _q,
 {
     unsigned int i;
 
+    // run time-domain filter for short filters or blocks
+    if (_q->nfft == 0 || _n < _q->hq_len) {
+        for (i=0; i<_n; i++)
+            FIRHILB(_interp_execute)(_q, _x[i], &_y[2*i]);
+        return;
+    }
+
+    // imaginary components are delayed, real components filtered
+    T * xr = (T*)_x;    // interleaved real/imaginary input
+    while (_n > 0) {
+        unsigned int n = _n < _q->fft_cap ? _n : _q->fft_cap;
+
+        FIRHILB(_load_branch)(_q, _q->w0, _q->buf0, xr+1, 2, n);
+        FIRHILB(_load_branch)(_q, _q->w1, _q->buf1, xr,   2, n);
+        // split branch in two halves to fill both parts of transform
+        unsigned int n1 = (n+1)/2;
+        FIRHILB(_fft_filter)(_q, _q->buf1+1,    n1,   _q->y1,
+                                 _q->buf1+1+n1, n-n1, _q->y1+n1);
+        for (i=0; i<n; i++) {
+            _y[2*i  ] = _q->buf0[_q->m + i];
+            _y[2*i+1] = _q->y1[i];
+        }
+
+        // retain branch history in windows
+        unsigned int nw = n < _q->hq_len ? n : _q->hq_len;
+        WINDOW(_write)(_q->w0, _q->buf0 + _q->hq_len + n - nw, nw);
+        WINDOW(_write)(_q->w1, _q->buf1 + _q->hq_len + n - nw, nw);
+
+        xr += 2*n;
+        _y += 2*n;
+        _n -= n;
+    }
+}
+
+// 
+// internal methods
+//
+
+// compute new length-_n segment of polyphase branches for block
+// methods, preloading each with its window's history
+//  _q      :   firhilb object
+//  _w      :   branch window object
+//  _buf    :   branch buffer [size: hq_len+_n x 1]
+//  _x      :   input samples with stride
+//  _stride :   input stride
+//  _n      :   number of new samples
+void FIRHILB(_load_branch)(FIRHILB()    _q,
+                           WINDOW()     _w,
+                           T *          _buf,
+                           T *          _x,
+                           unsigned int _stride,
+                           unsigned int _n)
+{
+    T * r;
+    WINDOW(_read)(_w, &r);
+    memmove(_buf, r, _q->hq_len*sizeof(T));
+
+    unsigned int i;
     for (i=0; i<_n; i++)
-        FIRHILB(_interp_execute)(_q, _x[i], &_y[2*i]);
+        _buf[_q->hq_len + i] = _x[i*_stride];
+}
+
+// run quadrature filter on two real-valued sequences in the
+// frequency domain using overlap-save; the sequences are packed
+// into the real and imaginary parts of a single transform
+//  _q      :   firhilb object
+//  _xa     :   first input with hq_len-1 history samples preceding
+//              [size: hq_len-1+_na x 1]
+//  _na     :   number of outputs of first sequence
+//  _ya     :   first output, _ya[i] = sum_j hq[j] _xa[i+j]
+//  _xb     :   second input [size: hq_len-1+_nb x 1]
+//  _nb     :   number of outputs of second sequence
+//  _yb     :   second output, _yb[i] = sum_j hq[j] _xb[i+j]
+void FIRHILB(_fft_filter)(FIRHILB()    _q,
+                          T *          _xa,
+                          unsigned int _na,
+                          T *          _ya,
+                          T *          _xb,
+                          unsigned int _nb,
+                          T *          _yb)
+{
+    unsigned int L    = _q->hq_len;     // filter length
+    unsigned int B    = _q->fft_blen;   // outputs per segment
+    unsigned int xa_len = L - 1 + _na;  // available input lengths
+    unsigned int xb_len = L - 1 + _nb;
+    unsigned int n = _na > _nb ? _na : _nb;
+    unsigned int i, k;
+
+    for (k=0; k<n; k+=B) {
+        // pack segments starting at k into interleaved real and
+        // imaginary parts, zero-padding past end of input
+        T * t = (T*) _q->time_buf;
+        unsigned int la = xa_len > k ? xa_len - k : 0;
+        unsigned int lb = xb_len > k ? xb_len - k : 0;
+        if (la > _q->nfft) la = _q->nfft;
+        if (lb > _q->nfft) lb = _q->nfft;
+        for (i=0;  i<la;       i++) t[2*i  ] = _xa[k + i];
+        for (i=la; i<_q->nfft; i++) t[2*i  ] = 0.0f;
+        for (i=0;  i<lb;       i++) t[2*i+1] = _xb[k + i];
+        for (i=lb; i<_q->nfft; i++) t[2*i+1] = 0.0f;
+
+#ifdef LIQUID_FFTOVERRIDE
+        fft_execute(_q->fft);
+#else
+        FFT_EXECUTE(_q->fft);
+#endif
+        // multiply by filter response (explicit real arithmetic
+        // avoids library calls for complex multiplication)
+        T * f = (T*) _q->freq_buf;
+        T * h = (T*) _q->H;
+        for (i=0; i<_q->nfft; i++) {
+            T re = f[2*i]*h[2*i  ] - f[2*i+1]*h[2*i+1];
+            T im = f[2*i]*h[2*i+1] + f[2*i+1]*h[2*i  ];
+            f[2*i  ] = re;
+            f[2*i+1] = im;
+        }
+#ifdef LIQUID_FFTOVERRIDE
+        fft_execute(_q->ifft);
+#else
+        FFT_EXECUTE(_q->ifft);
+#endif
+
+        // discard circular-wrap portion and unpack segments
+        for (i=0; i<B && k+i<_na; i++)
+            _ya[k+i] = crealf(_q->time_buf[L-1+i]);
+        for (i=0; i<B && k+i<_nb; i++)
+            _yb[k+i] = cimagf(_q->time_buf[L-1+i]);
+    }
 }
@@ -29,7 +29,6 @@
 #include <string.h>
 
 struct FIRINTERP(_s) {
-    TC * h;                 // prototype filter coefficients
     unsigned int h_len;     // prototype filter length
     unsigned int h_sub_len; // sub-filter length
     unsigned int M;         // interpolation factor
@@ -65,15 +64,15 @@ FIRINTERP() FIRINTERP(_create)(unsigned int _M,
 
     // compute effective filter length (pad end of prototype with zeros)
     q->h_len = q->M * q->h_sub_len;
-    q->h = (TC*) malloc((q->h_len)*sizeof(TC));
+    TC h[q->h_len];
 
     // load filter coefficients in regular order, padding end with zeros
     unsigned int i;
     for (i=0; i<q->h_len; i++)
-        q->h[i] = i < _h_len ? _h[i] : 0.0f;
+        h[i] = i < _h_len ? _h[i] : 0.0f;
 
     // create polyphase filterbank
-    q->filterbank = FIRPFB(_create)(q->M, q->h, q->h_len);
+    q->filterbank = FIRPFB(_create)(q->M, h, q->h_len);
 
     // return interpolator object
     return q;
@@ -157,11 +156,22 @@ FIRINTERP() FIRINTERP(_create_prototype)(int          _type,
     return FIRINTERP(_create)(_k, hc, h_len);
 }
 
+// create interpolator sharing coefficients of existing object;
+// internal state is reset
+FIRINTERP() FIRINTERP(_create_shared)(FIRINTERP() _q)
+{
+    FIRINTERP() q = (FIRINTERP()) malloc(sizeof(struct FIRINTERP(_s)));
+    q->M          = _q->M;
+    q->h_len      = _q->h_len;
+    q->h_sub_len  = _q->h_sub_len;
+    q->filterbank = FIRPFB(_create_shared)(_q->filterbank);
+    return q;
+}
+
 // destroy interpolator object
 void FIRINTERP(_destroy)(FIRINTERP() _q)
 {
     FIRPFB(_destroy)(_q->filterbank);
-    free(_q->h);
     free(_q);
 }
 
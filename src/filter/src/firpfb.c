@@ -29,13 +29,12 @@
 #include <stdlib.h>
 
 struct FIRPFB(_s) {
-    TC * h;                     // filter coefficients array
     unsigned int h_len;         // total number of filter coefficients
     unsigned int h_sub_len;     // sub-sampled filter length
     unsigned int num_filters;   // number of filters
 
     WINDOW() w;                 // window buffer
-    DOTPROD() * dp;             // array of vector dot product objects
+    FIRBANK() bank;             // shared bank of sub-filters
     TC scale;                   // output scaling factor
 };
 
@@ -58,33 +57,30 @@ FIRPFB() FIRPFB(_create)(unsigned int _M,
         exit(1);
     }
 
-    // create main filter object
-    FIRPFB() q = (FIRPFB()) malloc(sizeof(struct FIRPFB(_s)));
+    // generate bank of sub-sampled filters, each realized as a
+    // dotprod object
+    FIRBANK() bank = FIRBANK(_create)(_M, _h, _h_len);
 
-    // set user-defined parameters
-    q->num_filters = _M;
-    q->h_len       = _h_len;
-
-    // each filter is realized as a dotprod object
-    q->dp = (DOTPROD()*) malloc((q->num_filters)*sizeof(DOTPROD()));
-
-    // generate bank of sub-samped filters
-    // length of each sub-sampled filter
-    unsigned int h_sub_len = _h_len / q->num_filters;
-    TC h_sub[h_sub_len];
-    unsigned int i, n;
-    for (i=0; i<q->num_filters; i++) {
-        for (n=0; n<h_sub_len; n++) {
-            // load filter in reverse order
-            h_sub[h_sub_len-n-1] = _h[i + n*(q->num_filters)];
-        }
+    // create main filter object (adds reference to bank) and
+    // release the local reference
+    FIRPFB() q = FIRPFB(_create_bank)(bank);
+    FIRBANK(_destroy)(bank);
+    return q;
+}
 
-        // create dot product object
-        q->dp[i] = DOTPROD(_create)(h_sub,h_sub_len);
-    }
+// create firpfb from shared coefficient bank, adding a reference
+// to the bank
+//  _bank   : coefficient bank
+FIRPFB() FIRPFB(_create_bank)(FIRBANK() _bank)
+{
+    // create main filter object
+    FIRPFB() q = (FIRPFB()) malloc(sizeof(struct FIRPFB(_s)));
 
-    // save sub-sampled filter length
-    q->h_sub_len = h_sub_len;
+    // set parameters from bank
+    q->bank        = FIRBANK(_retain)(_bank);
+    q->num_filters = FIRBANK(_get_num_filters)(_bank);
+    q->h_sub_len   = FIRBANK(_get_sub_len)(_bank);
+    q->h_len       = q->num_filters * q->h_sub_len;
 
     // create window buffer
     q->w = WINDOW(_create)(q->h_sub_len);
@@ -97,6 +93,21 @@ FIRPFB() FIRPFB(_create)(unsigned int _M,
     return q;
 }
 
+// create firpfb sharing coefficients of existing object; scale is
+// copied, internal state is reset
+FIRPFB() FIRPFB(_create_shared)(FIRPFB() _q)
+{
+    FIRPFB() q = FIRPFB(_create_bank)(_q->bank);
+    q->scale = _q->scale;
+    return q;
+}
+
+// get coefficient bank (reference owned by object)
+FIRBANK() FIRPFB(_get_bank)(FIRPFB() _q)
+{
+    return _q->bank;
+}
+
 // create firpfb from external coefficients
 //  _M      : number of filters in the bank
 //  _m      : filter semi-length [samples]
@@ -251,34 +262,24 @@ FIRPFB() FIRPFB(_recreate)(FIRPFB()     _q,
                            unsigned int _h_len)
 {
     // check to see if filter length has changed
-    if (_h_len != _q->h_len || _M != _q->num_filters) {
+    if (_h_len/_M != _q->h_sub_len || _M != _q->num_filters) {
         // filter length has changed: recreate entire filter
         FIRPFB(_destroy)(_q);
         _q = FIRPFB(_create)(_M,_h,_h_len);
         return _q;
     }
 
-    // re-create each dotprod object
-    TC h_sub[_q->h_sub_len];
-    unsigned int i, n;
-    for (i=0; i<_q->num_filters; i++) {
-        for (n=0; n<_q->h_sub_len; n++) {
-            // load filter in reverse order
-            h_sub[_q->h_sub_len-n-1] = _h[i + n*(_q->num_filters)];
-        }
-
-        _q->dp[i] = DOTPROD(_recreate)(_q->dp[i],h_sub,_q->h_sub_len);
-    }
+    // replace coefficient bank; the old bank may still be shared
+    // with other objects and so cannot be modified in place
+    FIRBANK(_destroy)(_q->bank);
+    _q->bank = FIRBANK(_create)(_M, _h, _h_len);
     return _q;
 }
 
 // destroy firpfb object, freeing all internal memory
 void FIRPFB(_destroy)(FIRPFB() _q)
 {
-    unsigned int i;
-    for (i=0; i<_q->num_filters; i++)
-        DOTPROD(_destroy)(_q->dp[i]);
-    free(_q->dp);
+    FIRBANK(_destroy)(_q->bank);
     WINDOW(_destroy)(_q->w);
     free(_q);
 }
@@ -338,7 +339,7 @@ void FIRPFB(_execute)(FIRPFB()     _q,
     WINDOW(_read)(_q->w, &r);
 
     // execute dot product
-    DOTPROD(_execute)(_q->dp[_i], r, _y);
+    FIRBANK(_execute)(_q->bank, _i, r, _y);
 
     // apply scaling factor
     *_y *= _q->scale;
@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// Frequency response evaluation
+//
+// Filter responses follow the sign convention of the filter objects'
+// _freqresponse() methods, viz. H(f) = sum_i h[i] exp(j 2 pi f i).
+// Grid methods evaluate a uniform grid f_k = _f0 + k*_df and choose
+// between direct evaluation (short filters), a single zero-padded
+// (or time-aliased) FFT when the grid is a contiguous run of DFT
+// bins, i.e. _df = 1/M, and a chirp-z transform otherwise.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// filters at most this long are evaluated directly on the grid
+#define LIQUID_FREQRESP_DIRECT_LEN  (8)
+
+// exp(j 2 pi _phi), reducing phase in double precision to avoid loss
+// of accuracy for large arguments
+static float complex liquid_freqresp_cexpj(double _phi)
+{
+    double t = 2*M_PI*(_phi - floor(_phi));
+    return cosf((float)t) + _Complex_I*sinf((float)t);
+}
+
+// compute complex frequency response of FIR filter at a single frequency
+//  _h      :   filter coefficients [size: _h_len x 1]
+//  _h_len  :   filter length
+//  _fc     :   frequency at which to evaluate response
+//  _H      :   output frequency response
+void liquid_freqrespf(float *         _h,
+                      unsigned int    _h_len,
+                      float           _fc,
+                      float complex * _H)
+{
+    unsigned int i;
+    float complex H = 0.0f;
+    for (i=0; i<_h_len; i++)
+        H += _h[i] * cexpf(_Complex_I*2*M_PI*_fc*i);
+    *_H = H;
+}
+
+// compute complex frequency response of FIR filter with complex
+// coefficients at a single frequency
+void liquid_freqrespcf(float complex * _h,
+                       unsigned int    _h_len,
+                       float           _fc,
+                       float complex * _H)
+{
+    unsigned int i;
+    float complex H = 0.0f;
+    for (i=0; i<_h_len; i++)
+        H += _h[i] * cexpf(_Complex_I*2*M_PI*_fc*i);
+    *_H = H;
+}
+
+// compute complex frequency response of FIR filter with complex
+// coefficients on uniform frequency grid
+//  _h      :   filter coefficients [size: _h_len x 1]
+//  _h_len  :   filter length
+//  _f0     :   first grid frequency
+//  _df     :   grid frequency spacing
+//  _n      :   number of grid points
+//  _H      :   output frequency response [size: _n x 1]
+void liquid_freqrespcf_grid(float complex * _h,
+                            unsigned int    _h_len,
+                            float           _f0,
+                            float           _df,
+                            unsigned int    _n,
+                            float complex * _H)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: liquid_freqrespcf_grid(), filter length must be greater than zero\n");
+        exit(1);
+    }
+    if (_n == 0)
+        return;
+
+    unsigned int i, k;
+
+    // short filters: evaluate directly using Horner's method
+    if (_h_len <= LIQUID_FREQRESP_DIRECT_LEN || _n == 1) {
+        for (k=0; k<_n; k++) {
+            float complex z = liquid_freqresp_cexpj((double)_f0 + (double)k*_df);
+            float complex H = _h[_h_len-1];
+            for (i=_h_len-1; i>0; i--)
+                H = H*z + _h[i-1];
+            _H[k] = H;
+        }
+        return;
+    }
+
+    // check if grid is contiguous run of bins of an M-point DFT
+    double       Mf = _df != 0.0f ? 1.0 / fabs((double)_df) : 0.0;
+    unsigned int M  = (unsigned int) (Mf + 0.5);
+    int is_dft_grid = _df > 0.0f && M > 0 && fabs(Mf - M) < 1e-6*Mf &&
+                      M <= 4*(_n > _h_len ? _n : _h_len);
+
+    if (is_dft_grid) {
+        // modulate coefficients by _f0 and fold into M-point buffer
+        // (time aliasing is exact on DFT bins)
+        float complex * x = (float complex*) malloc(M*sizeof(float complex));
+        float complex * X = (float complex*) malloc(M*sizeof(float complex));
+        memset(x, 0, M*sizeof(float complex));
+        for (i=0; i<_h_len; i++)
+            x[i % M] += _h[i] * liquid_freqresp_cexpj((double)_f0*i);
+
+        // positive-exponent transform
+        fft_run(M, x, X, LIQUID_FFT_BACKWARD, 0);
+        for (k=0; k<_n; k++)
+            _H[k] = X[k % M];
+
+        free(x);
+        free(X);
+        return;
+    }
+
+    // chirp-z transform: with i*k = (i^2 + k^2 - (k-i)^2)/2,
+    //   H[k] = exp(j pi df k^2) sum_i a[i] b[k-i]
+    //   a[i] = h[i] exp(j 2 pi (f0 i + df i^2/2))
+    //   b[m] = exp(-j pi df m^2)
+    unsigned int L = 1 << liquid_nextpow2(_h_len + _n - 1);
+    float complex * a = (float complex*) malloc(L*sizeof(float complex));
+    float complex * b = (float complex*) malloc(L*sizeof(float complex));
+    float complex * A = (float complex*) malloc(L*sizeof(float complex));
+    float complex * B = (float complex*) malloc(L*sizeof(float complex));
+    memset(a, 0, L*sizeof(float complex));
+    memset(b, 0, L*sizeof(float complex));
+    double df = _df;
+    for (i=0; i<_h_len; i++)
+        a[i] = _h[i] * liquid_freqresp_cexpj((double)_f0*i + 0.5*df*i*i);
+    for (k=0; k<_n; k++)
+        b[k] = liquid_freqresp_cexpj(-0.5*df*k*k);
+    for (i=1; i<_h_len; i++)
+        b[L-i] = liquid_freqresp_cexpj(-0.5*df*i*i);
+
+    // circular convolution by FFT
+    fft_run(L, a, A, LIQUID_FFT_FORWARD, 0);
+    fft_run(L, b, B, LIQUID_FFT_FORWARD, 0);
+    for (i=0; i<L; i++)
+        A[i] *= B[i] / (float)L;
+    fft_run(L, A, a, LIQUID_FFT_BACKWARD, 0);
+
+    for (k=0; k<_n; k++)
+        _H[k] = a[k] * liquid_freqresp_cexpj(0.5*df*k*k);
+
+    free(a);
+    free(b);
+    free(A);
+    free(B);
+}
+
+// compute complex frequency response of FIR filter on uniform
+// frequency grid
+//  _h      :   filter coefficients [size: _h_len x 1]
+//  _h_len  :   filter length
+//  _f0     :   first grid frequency
+//  _df     :   grid frequency spacing
+//  _n      :   number of grid points
+//  _H      :   output frequency response [size: _n x 1]
+void liquid_freqrespf_grid(float *         _h,
+                           unsigned int    _h_len,
+                           float           _f0,
+                           float           _df,
+                           unsigned int    _n,
+                           float complex * _H)
+{
+    float complex * hc = (float complex*) malloc(_h_len*sizeof(float complex));
+    unsigned int i;
+    for (i=0; i<_h_len; i++)
+        hc[i] = _h[i];
+    liquid_freqrespcf_grid(hc, _h_len, _f0, _df, _n, _H);
+    free(hc);
+}
+
+// compute complex frequency response of IIR filter in transfer
+// function form on uniform frequency grid
+//  _b      :   numerator coefficients [size: _nb x 1]
+//  _nb     :   numerator length
+//  _a      :   denominator coefficients [size: _na x 1]
+//  _na     :   denominator length
+//  _f0     :   first grid frequency
+//  _df     :   grid frequency spacing
+//  _n      :   number of grid points
+//  _H      :   output frequency response [size: _n x 1]
+void liquid_freqrespf_iir_grid(float *         _b,
+                               unsigned int    _nb,
+                               float *         _a,
+                               unsigned int    _na,
+                               float           _f0,
+                               float           _df,
+                               unsigned int    _n,
+                               float complex * _H)
+{
+    float complex * Ha = (float complex*) malloc(_n*sizeof(float complex));
+    liquid_freqrespf_grid(_b, _nb, _f0, _df, _n, _H);
+    liquid_freqrespf_grid(_a, _na, _f0, _df, _n, Ha);
+    unsigned int k;
+    for (k=0; k<_n; k++)
+        _H[k] /= Ha[k];
+    free(Ha);
+}
+
+// compute complex frequency response of IIR filter in second-order
+// sections form on uniform frequency grid
+//  _B      :   numerator coefficients [size: _nsos x 3]
+//  _A      :   denominator coefficients [size: _nsos x 3]
+//  _nsos   :   number of second-order sections
+//  _f0     :   first grid frequency
+//  _df     :   grid frequency spacing
+//  _n      :   number of grid points
+//  _H      :   output frequency response [size: _n x 1]
+void liquid_freqrespf_sos_grid(float *         _B,
+                               float *         _A,
+                               unsigned int    _nsos,
+                               float           _f0,
+                               float           _df,
+                               unsigned int    _n,
+                               float complex * _H)
+{
+    unsigned int i, k;
+    for (k=0; k<_n; k++)
+        _H[k] = 1.0f;
+
+    for (k=0; k<_n; k++) {
+        float complex z  = liquid_freqresp_cexpj((double)_f0 + (double)k*_df);
+        float complex z2 = z*z;
+        for (i=0; i<_nsos; i++) {
+            float complex Hb = _B[3*i+0] + _B[3*i+1]*z + _B[3*i+2]*z2;
+            float complex Ha = _A[3*i+0] + _A[3*i+1]*z + _A[3*i+2]*z2;
+            _H[k] *= Hb / Ha;
+        }
+    }
+}
@@ -116,3 +116,124 @@ float iir_group_delay(float * _b,
     return crealf(t0/t1) - (_na - 1);
 }
 
+
+// Compute group delay for a FIR filter on uniform frequency grid
+//  _h      : filter coefficients array [size: _h_len x 1]
+//  _h_len  : filter length
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _gd     : output group delay [size: _n x 1]
+void fir_group_delay_grid(float *      _h,
+                          unsigned int _h_len,
+                          float        _f0,
+                          float        _df,
+                          unsigned int _n,
+                          float *      _gd)
+{
+    // validate input
+    if (_h_len == 0) {
+        fprintf(stderr,"error: fir_group_delay_grid(), length must be greater than zero\n");
+        exit(1);
+    }
+
+    // group delay is real{ DFT{ i h[i] } / DFT{ h[i] } }
+    float hi[_h_len];
+    unsigned int i;
+    for (i=0; i<_h_len; i++)
+        hi[i] = _h[i] * i;
+
+    float complex * t0 = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * t1 = (float complex*) malloc(_n*sizeof(float complex));
+    liquid_freqrespf_grid(hi, _h_len, _f0, _df, _n, t0);
+    liquid_freqrespf_grid(_h, _h_len, _f0, _df, _n, t1);
+    for (i=0; i<_n; i++)
+        _gd[i] = crealf(t0[i]/t1[i]);
+    free(t0);
+    free(t1);
+}
+
+// Compute group delay for an IIR filter on uniform frequency grid
+//  _b      : filter coefficients array (numerator), [size: _nb x 1]
+//  _nb     : filter length (numerator)
+//  _a      : filter coefficients array (denominator), [size: _na x 1]
+//  _na     : filter length (denominator)
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _gd     : output group delay [size: _n x 1]
+void iir_group_delay_grid(float *      _b,
+                          unsigned int _nb,
+                          float *      _a,
+                          unsigned int _na,
+                          float        _f0,
+                          float        _df,
+                          unsigned int _n,
+                          float *      _gd)
+{
+    // validate input
+    if (_nb == 0) {
+        fprintf(stderr,"error: iir_group_delay_grid(), numerator length must be greater than zero\n");
+        exit(1);
+    } else if (_na == 0) {
+        fprintf(stderr,"error: iir_group_delay_grid(), denominator length must be greater than zero\n");
+        exit(1);
+    }
+
+    // compute c = conv(b,fliplr(a)) and i*c
+    unsigned int nc = _na + _nb - 1;
+    float c[nc];
+    float ci[nc];
+    unsigned int i,j;
+    for (i=0; i<nc; i++)
+        c[i] = 0.0;
+    for (i=0; i<_na; i++) {
+        for (j=0; j<_nb; j++)
+            c[i+j] += _a[_na-i-1]*_b[j];
+    }
+    for (i=0; i<nc; i++)
+        ci[i] = c[i] * i;
+
+    float complex * t0 = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * t1 = (float complex*) malloc(_n*sizeof(float complex));
+    liquid_freqrespf_grid(ci, nc, _f0, _df, _n, t0);
+    liquid_freqrespf_grid(c,  nc, _f0, _df, _n, t1);
+
+    // prevent divide-by-zero (check magnitude for tolerance range)
+    float tol = 1e-5f;
+    for (i=0; i<_n; i++)
+        _gd[i] = cabsf(t1[i]) < tol ? 0.0f : crealf(t0[i]/t1[i]) - (_na - 1);
+    free(t0);
+    free(t1);
+}
+
+// Compute group delay for an IIR filter in second-order sections
+// form on uniform frequency grid
+//  _B      : numerator coefficients [size: _nsos x 3]
+//  _A      : denominator coefficients [size: _nsos x 3]
+//  _nsos   : number of second-order sections
+//  _f0     : first grid frequency
+//  _df     : grid frequency spacing
+//  _n      : number of grid points
+//  _gd     : output group delay [size: _n x 1]
+void iir_group_delay_sos_grid(float *      _B,
+                              float *      _A,
+                              unsigned int _nsos,
+                              float        _f0,
+                              float        _df,
+                              unsigned int _n,
+                              float *      _gd)
+{
+    float * gd = (float*) malloc(_n*sizeof(float));
+    unsigned int i, k;
+    for (k=0; k<_n; k++)
+        _gd[k] = 0.0f;
+
+    // accumulate group delay from each section
+    for (i=0; i<_nsos; i++) {
+        iir_group_delay_grid(&_B[3*i], 3, &_A[3*i], 3, _f0, _df, _n, gd);
+        for (k=0; k<_n; k++)
+            _gd[k] += gd[k];
+    }
+    free(gd);
+}
@@ -69,6 +69,10 @@ struct IIRFILT(_s) {
     // second-order sections 
     IIRFILTSOS() * qsos;    // second-order sections filters
     unsigned int nsos;      // number of second-order sections
+
+    // block state-space mode (see IIRFILT(_set_block_mode))
+    IIRFILTSS() qss;        // block filter, NULL if disabled
+    int ss_valid;           // block filter state is current?
 };
 
 // create iirfilt (infinite impulse response filter) object
@@ -96,6 +100,8 @@ IIRFILT() IIRFILT(_create)(TC *         _b,
     q->na = _na;
     q->n = (q->na > q->nb) ? q->na : q->nb;
     q->type = IIRFILT_TYPE_NORM;
+    q->qss  = NULL;
+    q->ss_valid = 0;
 
     // allocate memory for numerator, denominator
     q->a = (TC *) malloc((q->na)*sizeof(TC));
@@ -160,6 +166,8 @@ IIRFILT() IIRFILT(_create_sos)(TC *         _B,
     IIRFILT() q = (IIRFILT()) malloc(sizeof(struct IIRFILT(_s)));
     q->type = IIRFILT_TYPE_SOS;
     q->nsos = _nsos;
+    q->qss  = NULL;
+    q->ss_valid = 0;
     q->qsos = (IIRFILTSOS()*) malloc( (q->nsos)*sizeof(IIRFILTSOS()) );
     q->n = _nsos * 2;
 
@@ -430,6 +438,9 @@ void IIRFILT(_destroy)(IIRFILT() _q)
         free(_q->v);
     }
 
+    if (_q->qss != NULL)
+        IIRFILTSS(_destroy)(_q->qss);
+
     free(_q);
 }
 
@@ -478,6 +489,12 @@ void IIRFILT(_reset)(IIRFILT() _q)
         for (i=0; i<_q->n; i++)
             _q->v[i] = 0;
     }
+
+    // block filter state is zero as well
+    if (_q->qss != NULL) {
+        IIRFILTSS(_reset)(_q->qss);
+        _q->ss_valid = 1;
+    }
 }
 
 // execute normal iir filter using traditional numerator/denominator
@@ -550,12 +567,51 @@ void IIRFILT(_execute)(IIRFILT() _q,
                        TI        _x,
                        TO *      _y)
 {
+    // sample-by-sample execution invalidates block filter state
+    _q->ss_valid = 0;
+
     if (_q->type == IIRFILT_TYPE_NORM)
         IIRFILT(_execute_norm)(_q,_x,_y);
     else
         IIRFILT(_execute_sos)(_q,_x,_y);
 }
 
+// copy direct-form II state {w[n-1], w[n-2]} into block filter
+void IIRFILT(_load_block_state)(IIRFILT() _q)
+{
+    unsigned int nsos = _q->type == IIRFILT_TYPE_SOS ? _q->nsos : 1;
+    TO v[2*nsos];
+    unsigned int i;
+    if (_q->type == IIRFILT_TYPE_SOS) {
+        for (i=0; i<nsos; i++) {
+            v[2*i  ] = _q->qsos[i]->v[0];
+            v[2*i+1] = _q->qsos[i]->v[1];
+        }
+    } else {
+        v[0] = _q->n > 0 ? _q->v[0] : 0;
+        v[1] = _q->n > 1 ? _q->v[1] : 0;
+    }
+    IIRFILTSS(_set_state)(_q->qss, v);
+}
+
+// copy block filter state back into direct-form II buffers
+void IIRFILT(_store_block_state)(IIRFILT() _q)
+{
+    unsigned int nsos = _q->type == IIRFILT_TYPE_SOS ? _q->nsos : 1;
+    TO v[2*nsos];
+    IIRFILTSS(_get_state)(_q->qss, v);
+    unsigned int i;
+    if (_q->type == IIRFILT_TYPE_SOS) {
+        for (i=0; i<nsos; i++) {
+            _q->qsos[i]->v[0] = v[2*i  ];
+            _q->qsos[i]->v[1] = v[2*i+1];
+        }
+    } else {
+        if (_q->n > 0) _q->v[0] = v[0];
+        if (_q->n > 1) _q->v[1] = v[1];
+    }
+}
+
 // execute the filter on a block of input samples; the
 // input and output buffers may be the same
 //  _q      : filter object
@@ -567,12 +623,66 @@ void IIRFILT(_execute_block)(IIRFILT()    _q,
                              unsigned int _n,
                              TO *         _y)
 {
+    if (_q->qss != NULL) {
+        // block state-space mode: the block filter keeps its own
+        // (possibly double-precision) state which is synchronized
+        // with the direct-form II buffers only when necessary
+        if (!_q->ss_valid)
+            IIRFILT(_load_block_state)(_q);
+        IIRFILTSS(_execute_block)(_q->qss, _x, _n, _y);
+        IIRFILT(_store_block_state)(_q);
+        _q->ss_valid = 1;
+        return;
+    }
+
     unsigned int i;
     for (i=0; i<_n; i++)
         // compute output sample
         IIRFILT(_execute)(_q, _x[i], &_y[i]);
 }
 
+// enable block state-space mode for IIRFILT(_execute_block); each
+// block of _block_len outputs per section is computed from the
+// section state with no sample-to-sample recursion. Only filters
+// realized as second-order sections (or normal-form filters of at
+// most second order) are supported.
+//  _q              : filter object
+//  _block_len      : block length, 0 to disable block mode
+//  _double_state   : keep block state in double precision?
+void IIRFILT(_set_block_mode)(IIRFILT()    _q,
+                              unsigned int _block_len,
+                              int          _double_state)
+{
+    // disable existing mode, keeping state in direct-form buffers
+    if (_q->qss != NULL) {
+        if (_q->ss_valid)
+            IIRFILT(_store_block_state)(_q);
+        IIRFILTSS(_destroy)(_q->qss);
+        _q->qss = NULL;
+    }
+
+    if (_block_len == 0)
+        return;
+
+    if (_q->type == IIRFILT_TYPE_SOS) {
+        _q->qss = IIRFILTSS(_create)(_q->b, _q->a, _q->nsos, _block_len, _double_state);
+    } else if (_q->n <= 3) {
+        // pad normal-form filter to a single second-order section
+        TC b[3] = {0,0,0};
+        TC a[3] = {0,0,0};
+        unsigned int i;
+        for (i=0; i<_q->nb; i++) b[i] = _q->b[i];
+        for (i=0; i<_q->na; i++) a[i] = _q->a[i];
+        _q->qss = IIRFILTSS(_create)(b, a, 1, _block_len, _double_state);
+    } else {
+        fprintf(stderr,"error: iirfilt_%s_set_block_mode(), filter must be realized as second-order sections\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // pick up current state
+    IIRFILT(_load_block_state)(_q);
+    _q->ss_valid = 1;
+}
 
 // get filter length (order + 1)
 unsigned int IIRFILT(_get_length)(IIRFILT() _q)
@@ -654,3 +764,81 @@ float IIRFILT(_groupdelay)(IIRFILT() _q,
     return groupdelay;
 }
 
+// compute complex frequency response on uniform frequency grid
+//  _q      :   filter object
+//  _f0     :   first grid frequency
+//  _df     :   grid frequency spacing
+//  _n      :   number of grid points
+//  _H      :   output frequency response [size: _n x 1]
+void IIRFILT(_freqresponse_grid)(IIRFILT()       _q,
+                                 float           _f0,
+                                 float           _df,
+                                 unsigned int    _n,
+                                 float complex * _H)
+{
+    unsigned int i, k;
+    float complex * Ha = (float complex*) malloc(_n*sizeof(float complex));
+    float complex * Hb = (float complex*) malloc(_n*sizeof(float complex));
+
+    if (_q->type == IIRFILT_TYPE_NORM) {
+        // copy coefficients to complex arrays
+        float complex b[_q->nb];
+        float complex a[_q->na];
+        for (i=0; i<_q->nb; i++) b[i] = _q->b[i];
+        for (i=0; i<_q->na; i++) a[i] = _q->a[i];
+
+        liquid_freqrespcf_grid(b, _q->nb, _f0, _df, _n, Hb);
+        liquid_freqrespcf_grid(a, _q->na, _f0, _df, _n, Ha);
+        for (k=0; k<_n; k++)
+            _H[k] = Hb[k] / Ha[k];
+    } else {
+        for (k=0; k<_n; k++)
+            _H[k] = 1.0f;
+
+        // accumulate response of each second-order section
+        for (i=0; i<_q->nsos; i++) {
+            float complex b[3] = {_q->b[3*i+0], _q->b[3*i+1], _q->b[3*i+2]};
+            float complex a[3] = {_q->a[3*i+0], _q->a[3*i+1], _q->a[3*i+2]};
+            liquid_freqrespcf_grid(b, 3, _f0, _df, _n, Hb);
+            liquid_freqrespcf_grid(a, 3, _f0, _df, _n, Ha);
+            for (k=0; k<_n; k++)
+                _H[k] *= Hb[k] / Ha[k];
+        }
+    }
+
+    free(Ha);
+    free(Hb);
+}
+
+// compute group delay in samples on uniform frequency grid
+//  _q      :   filter object
+//  _f0     :   first grid frequency
+//  _df     :   grid frequency spacing
+//  _n      :   number of grid points
+//  _gd     :   output group delay [size: _n x 1]
+void IIRFILT(_groupdelay_grid)(IIRFILT()    _q,
+                               float        _f0,
+                               float        _df,
+                               unsigned int _n,
+                               float *      _gd)
+{
+    unsigned int i;
+    if (_q->type == IIRFILT_TYPE_NORM) {
+        // compute group delay from regular transfer function form
+        float b[_q->nb];
+        float a[_q->na];
+        for (i=0; i<_q->nb; i++) b[i] = crealf(_q->b[i]);
+        for (i=0; i<_q->na; i++) a[i] = crealf(_q->a[i]);
+        iir_group_delay_grid(b, _q->nb, a, _q->na, _f0, _df, _n, _gd);
+    } else {
+        // accumulate group delay from second-order sections
+        float B[3*_q->nsos];
+        float A[3*_q->nsos];
+        for (i=0; i<3*_q->nsos; i++) {
+            B[i] = crealf(_q->b[i]);
+            A[i] = crealf(_q->a[i]);
+        }
+        iir_group_delay_sos_grid(B, A, _q->nsos, _f0, _df, _n, _gd);
+    }
+}
+
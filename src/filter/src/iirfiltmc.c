@@ -0,0 +1,317 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// iirfiltmc.c
+//
+// multi-channel infinite impulse response filter
+//
+// The same cascade of second-order sections is applied to a number
+// of synchronized channels (e.g. DC blocking or de-emphasis over a
+// bank of receivers). The recursion of an IIR filter serializes each
+// stream in time, so rather than vectorizing within a channel the
+// internal state of each section is stored by channel with unit
+// stride and every section is evaluated across all channels at once.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+struct IIRFILTMC(_s) {
+    unsigned int num_channels;  // number of channels
+    unsigned int nsos;          // number of second-order sections
+
+    // normalized coefficients, [nsos x 3] each; a[3*i] = 1
+    TC * b;                     // feed-forward coefficients
+    TC * a;                     // feed-back coefficients
+
+    // direct-form II state, [nsos x 2 x num_channels]: for section
+    // i, v[(2*i)*C + c] is w[n-1] and v[(2*i+1)*C + c] is w[n-2]
+    // for channel c
+    T * v;
+
+    // scratch frames used for planar input/output
+    TI * x_frame;               // input frame  [size: num_channels x 1]
+    TO * y_frame;               // output frame [size: num_channels x 1]
+};
+
+// create multi-channel filter using second-order sections
+//  _num_channels : number of channels, _num_channels > 0
+//  _B            : feed-forward coefficients [size: _nsos x 3]
+//  _A            : feed-back coefficients    [size: _nsos x 3]
+//  _nsos         : number of second-order sections, _nsos > 0
+IIRFILTMC() IIRFILTMC(_create_sos)(unsigned int _num_channels,
+                                   TC *         _B,
+                                   TC *         _A,
+                                   unsigned int _nsos)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: iirfiltmc_%s_create_sos(), number of channels must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_nsos == 0) {
+        fprintf(stderr,"error: iirfiltmc_%s_create_sos(), filter must have at least one section\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create filter object and initialize
+    IIRFILTMC() q = (IIRFILTMC()) malloc(sizeof(struct IIRFILTMC(_s)));
+    q->num_channels = _num_channels;
+    q->nsos         = _nsos;
+
+    // copy coefficients, normalizing each section by a0
+    q->b = (TC *) malloc(3*q->nsos*sizeof(TC));
+    q->a = (TC *) malloc(3*q->nsos*sizeof(TC));
+    unsigned int i, k;
+    for (i=0; i<q->nsos; i++) {
+        TC a0 = _A[3*i];
+        if (a0 == 0) {
+            fprintf(stderr,"error: iirfiltmc_%s_create_sos(), a[0] of section %u must not be zero\n", EXTENSION_FULL, i);
+            exit(1);
+        }
+        for (k=0; k<3; k++) {
+            q->b[3*i+k] = _B[3*i+k] / a0;
+            q->a[3*i+k] = _A[3*i+k] / a0;
+        }
+    }
+
+    // allocate state and scratch frames
+    q->v       = (T *)  malloc(2*q->nsos*q->num_channels*sizeof(T));
+    q->x_frame = (TI *) malloc(q->num_channels*sizeof(TI));
+    q->y_frame = (TO *) malloc(q->num_channels*sizeof(TO));
+
+    // reset filter state
+    IIRFILTMC(_reset)(q);
+    return q;
+}
+
+// create multi-channel filter from design template
+//  _num_channels : number of channels, _num_channels > 0
+//  _ftype        : filter type (e.g. LIQUID_IIRDES_BUTTER)
+//  _btype        : band type (e.g. LIQUID_IIRDES_BANDPASS)
+//  _order        : filter order
+//  _fc           : low-pass prototype cut-off frequency
+//  _f0           : center frequency (band-pass, band-stop)
+//  _Ap           : pass-band ripple in dB
+//  _As           : stop-band ripple in dB
+IIRFILTMC() IIRFILTMC(_create_prototype)(unsigned int             _num_channels,
+                                         liquid_iirdes_filtertype _ftype,
+                                         liquid_iirdes_bandtype   _btype,
+                                         unsigned int             _order,
+                                         float                    _fc,
+                                         float                    _f0,
+                                         float                    _Ap,
+                                         float                    _As)
+{
+    // derived values : compute number of sections (see iirfilt.c)
+    unsigned int N = _order;
+    if (_btype == LIQUID_IIRDES_BANDPASS ||
+        _btype == LIQUID_IIRDES_BANDSTOP)
+    {
+        N *= 2;
+    }
+    unsigned int r = N%2;       // odd/even order
+    unsigned int L = (N-r)/2;   // filter semi-length
+    unsigned int nsos = L+r;
+
+    // design filter as second-order sections
+    float B[3*nsos];
+    float A[3*nsos];
+    liquid_iirdes(_ftype, _btype, LIQUID_IIRDES_SOS, _order, _fc, _f0, _Ap, _As, B, A);
+
+    // move coefficients to type-specific arrays
+    TC Bc[3*nsos];
+    TC Ac[3*nsos];
+    unsigned int i;
+    for (i=0; i<3*nsos; i++) {
+        Bc[i] = B[i];
+        Ac[i] = A[i];
+    }
+
+    return IIRFILTMC(_create_sos)(_num_channels, Bc, Ac, nsos);
+}
+
+// create multi-channel DC-blocking filter (single first-order
+// section, see iirfilt_xxxt_create_dc_blocker())
+//  _num_channels : number of channels, _num_channels > 0
+//  _alpha        : normalized filter bandwidth
+IIRFILTMC() IIRFILTMC(_create_dc_blocker)(unsigned int _num_channels,
+                                          float        _alpha)
+{
+    TC B[3] = {(TC)1.0f, (TC)(-1.0f),          0};
+    TC A[3] = {(TC)1.0f, (TC)(-1.0f + _alpha), 0};
+    return IIRFILTMC(_create_sos)(_num_channels, B, A, 1);
+}
+
+// destroy filter object and free all internal memory
+void IIRFILTMC(_destroy)(IIRFILTMC() _q)
+{
+    free(_q->b);
+    free(_q->a);
+    free(_q->v);
+    free(_q->x_frame);
+    free(_q->y_frame);
+    free(_q);
+}
+
+// reset internal state of filter object
+void IIRFILTMC(_reset)(IIRFILTMC() _q)
+{
+    memset(_q->v, 0, 2*_q->nsos*_q->num_channels*sizeof(T));
+}
+
+// print filter object internals
+void IIRFILTMC(_print)(IIRFILTMC() _q)
+{
+    printf("iirfiltmc_%s: [%u channels, %u sections]\n",
+            EXTENSION_FULL, _q->num_channels, _q->nsos);
+    unsigned int i, k;
+    for (i=0; i<_q->nsos; i++) {
+        printf("  b[%2u] = ", i);
+        for (k=0; k<3; k++) { PRINTVAL_TC(_q->b[3*i+k],%12.8f); printf(","); }
+        printf("\n");
+        printf("  a[%2u] = ", i);
+        for (k=0; k<3; k++) { PRINTVAL_TC(_q->a[3*i+k],%12.8f); printf(","); }
+        printf("\n");
+    }
+}
+
+// get number of channels
+unsigned int IIRFILTMC(_get_num_channels)(IIRFILTMC() _q)
+{
+    return _q->num_channels;
+}
+
+// get number of second-order sections
+unsigned int IIRFILTMC(_get_num_sections)(IIRFILTMC() _q)
+{
+    return _q->nsos;
+}
+
+// execute the filter on one frame (one sample per channel); the
+// input and output frames may be the same
+//  _q      : filter object
+//  _x      : input frame  [size: num_channels x 1]
+//  _y      : output frame [size: num_channels x 1]
+void IIRFILTMC(_execute)(IIRFILTMC() _q,
+                         TI *        _x,
+                         TO *        _y)
+{
+#if TC_COMPLEX == 0
+    // real coefficients: the real and imaginary parts of a complex
+    // channel are independent recursions, and each state row (w[n-1]
+    // or w[n-2] of one section) stores them interleaved, so a row is
+    // processed as 2*num_channels real-valued lanes
+    typedef float TE;
+    unsigned int C = _q->num_channels * (TI_COMPLEX ? 2 : 1);
+#else
+    typedef T TE;
+    unsigned int C = _q->num_channels;
+#endif
+    TE * y = (TE*) _y;
+    unsigned int i, c;
+
+    // the cascade is evaluated in place on the output frame
+    if (_y != _x)
+        memmove(_y, _x, _q->num_channels*sizeof(TO));
+
+    // t = 4*(floor(C/4))
+    unsigned int t = (C>>2)<<2;
+
+    for (i=0; i<_q->nsos; i++) {
+        TC b0 = _q->b[3*i+0], b1 = _q->b[3*i+1], b2 = _q->b[3*i+2];
+        TC a1 = _q->a[3*i+1], a2 = _q->a[3*i+2];
+        TE * v1 = (TE*) _q->v + (2*i  )*C;   // w[n-1]
+        TE * v2 = (TE*) _q->v + (2*i+1)*C;   // w[n-2]
+
+        // run section across channels in groups of 4
+        for (c=0; c<t; c+=4) {
+            TE w0 = y[c  ] - a1*v1[c  ] - a2*v2[c  ];
+            TE w1 = y[c+1] - a1*v1[c+1] - a2*v2[c+1];
+            TE w2 = y[c+2] - a1*v1[c+2] - a2*v2[c+2];
+            TE w3 = y[c+3] - a1*v1[c+3] - a2*v2[c+3];
+
+            y[c  ] = b0*w0 + b1*v1[c  ] + b2*v2[c  ];
+            y[c+1] = b0*w1 + b1*v1[c+1] + b2*v2[c+1];
+            y[c+2] = b0*w2 + b1*v1[c+2] + b2*v2[c+2];
+            y[c+3] = b0*w3 + b1*v1[c+3] + b2*v2[c+3];
+
+            v2[c  ] = v1[c  ]; v1[c  ] = w0;
+            v2[c+1] = v1[c+1]; v1[c+1] = w1;
+            v2[c+2] = v1[c+2]; v1[c+2] = w2;
+            v2[c+3] = v1[c+3]; v1[c+3] = w3;
+        }
+
+        // clean up remaining
+        for ( ; c<C; c++) {
+            TE w = y[c] - a1*v1[c] - a2*v2[c];
+            y[c] = b0*w + b1*v1[c] + b2*v2[c];
+            v2[c] = v1[c];
+            v1[c] = w;
+        }
+    }
+}
+
+// execute the filter on a block of interleaved samples; the input
+// and output buffers may be the same
+//  _q      : filter object
+//  _x      : input array [size: _n*num_channels x 1]
+//  _n      : number of samples per channel
+//  _y      : output array [size: _n*num_channels x 1]
+void IIRFILTMC(_execute_block)(IIRFILTMC()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    unsigned int i;
+    unsigned int C = _q->num_channels;
+    for (i=0; i<_n; i++)
+        IIRFILTMC(_execute)(_q, &_x[i*C], &_y[i*C]);
+}
+
+// execute the filter on a block of planar samples; the input and
+// output buffers may be the same
+//  _q      : filter object
+//  _x      : input array [size: num_channels*_n x 1]
+//  _n      : number of samples per channel
+//  _y      : output array [size: num_channels*_n x 1]
+void IIRFILTMC(_execute_block_planar)(IIRFILTMC()  _q,
+                                      TI *         _x,
+                                      unsigned int _n,
+                                      TO *         _y)
+{
+    unsigned int i, c;
+    unsigned int C = _q->num_channels;
+    for (i=0; i<_n; i++) {
+        // gather input frame
+        for (c=0; c<C; c++)
+            _q->x_frame[c] = _x[c*_n + i];
+
+        // compute output frame
+        IIRFILTMC(_execute)(_q, _q->x_frame, _q->y_frame);
+
+        // scatter output frame
+        for (c=0; c<C; c++)
+            _y[c*_n + i] = _q->y_frame[c];
+    }
+}
@@ -0,0 +1,436 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// iirfiltq15.c
+//
+// multi-channel Q15 fixed-point infinite impulse response filter
+//
+// Samples are signed 16-bit integers (e.g. interleaved cs16 I/Q as two
+// channels) and the filter is realized as a cascade of direct-form I
+// second-order sections. Feed-back coefficients are stored in Q2.14;
+// feed-forward coefficients are scaled per section so that the
+// cumulative peak gain after each section is unity (L-infinity
+// scaling) and stored with their own binary point. The gain removed by
+// scaling is restored at the output. Each section accumulates in 32
+// bits with 14 fractional bits, relying on two's-complement wrap-around
+// for intermediate sums, and may optionally feed its rounding error
+// back into the next accumulation (error-spectrum shaping), which moves
+// quantization noise away from DC where poles sit close to the unit
+// circle (DC blockers, de-emphasis).
+//
+// As with iirfiltmc, the state of each section is stored by channel
+// with unit stride. Blocks are processed one section at a time, in
+// place, with groups of up to four channels run in lock step so that
+// their independent recursions overlap.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "liquid.internal.h"
+
+// accumulator and feed-back coefficient fractional bits
+#define IIRFILTQ15_FRAC         (14)
+
+// feed-forward coefficient magnitude limit, keeping the sum of three
+// products with 16-bit samples within 32 bits
+#define IIRFILTQ15_B_MAX        (16383)
+
+// maximum feed-forward coefficient fractional bits
+#define IIRFILTQ15_B_FRAC_MAX   (28)
+
+// number of frequency points used for section scaling
+#define IIRFILTQ15_SCALE_NFFT   (1024)
+
+struct iirfiltq15_s {
+    unsigned int num_channels;  // number of channels
+    unsigned int nsos;          // number of second-order sections
+    unsigned int ef_order;      // error feedback order (0, 1, 2)
+
+    // quantized coefficients, [nsos x 3] each
+    int16_t * b;                // feed-forward coefficients
+    int16_t * a;                // feed-back coefficients (Q2.14), a[3*i] unused
+    unsigned int * b_frac;      // feed-forward fractional bits per section
+
+    // output gain restoring section scaling, y*g_mant >> g_shift
+    int32_t g_mant;
+    unsigned int g_shift;
+
+    // direct-form I state, [nsos x 4 x num_channels]: for section
+    // i, rows are x[n-1], x[n-2], y[n-1], y[n-2]
+    int32_t * v;
+
+    // rounding error, [nsos x 2 x num_channels]: e[n-1], e[n-2]
+    int32_t * e;
+};
+
+// saturate value to signed 16-bit range
+static inline int32_t iirfiltq15_sat16(int32_t _v)
+{
+    if      (_v >  32767) return  32767;
+    else if (_v < -32768) return -32768;
+    return (int32_t)_v;
+}
+
+// create Q15 multi-channel filter using second-order sections, as
+// designed by liquid_iirdes() with LIQUID_IIRDES_SOS
+//  _num_channels : number of channels, _num_channels > 0
+//  _B            : feed-forward coefficients [size: _nsos x 3]
+//  _A            : feed-back coefficients    [size: _nsos x 3]
+//  _nsos         : number of second-order sections, _nsos > 0
+iirfiltq15 iirfiltq15_create_sos(unsigned int _num_channels,
+                                 float *      _B,
+                                 float *      _A,
+                                 unsigned int _nsos)
+{
+    // validate input
+    if (_num_channels == 0) {
+        fprintf(stderr,"error: iirfiltq15_create_sos(), number of channels must be greater than zero\n");
+        exit(1);
+    } else if (_nsos == 0) {
+        fprintf(stderr,"error: iirfiltq15_create_sos(), filter must have at least one section\n");
+        exit(1);
+    }
+
+    // create filter object and initialize
+    iirfiltq15 q = (iirfiltq15) malloc(sizeof(struct iirfiltq15_s));
+    q->num_channels = _num_channels;
+    q->nsos         = _nsos;
+    q->ef_order     = 0;
+
+    // normalize sections by a0
+    unsigned int i, k;
+    float b[3*_nsos];
+    float a[3*_nsos];
+    for (i=0; i<_nsos; i++) {
+        float a0 = _A[3*i];
+        if (a0 == 0.0f) {
+            fprintf(stderr,"error: iirfiltq15_create_sos(), a[0] of section %u must not be zero\n", i);
+            exit(1);
+        }
+        for (k=0; k<3; k++) {
+            b[3*i+k] = _B[3*i+k] / a0;
+            a[3*i+k] = _A[3*i+k] / a0;
+        }
+    }
+
+    // L-infinity scaling: compute cumulative peak gain after each
+    // section and scale feed-forward coefficients so that it is unity
+    float complex Hc[IIRFILTQ15_SCALE_NFFT];
+    for (k=0; k<IIRFILTQ15_SCALE_NFFT; k++)
+        Hc[k] = 1.0f;
+    float g_prev = 1.0f;
+    for (i=0; i<_nsos; i++) {
+        float g = 0.0f;
+        for (k=0; k<IIRFILTQ15_SCALE_NFFT; k++) {
+            // frequency in [0,0.5] (real coefficients)
+            float complex z1 = cexpf(-_Complex_I*M_PI*(float)k/(float)(IIRFILTQ15_SCALE_NFFT-1));
+            float complex z2 = z1*z1;
+            Hc[k] *= (b[3*i+0] + b[3*i+1]*z1 + b[3*i+2]*z2) /
+                     (1.0f     + a[3*i+1]*z1 + a[3*i+2]*z2);
+            float m = cabsf(Hc[k]);
+            g = m > g ? m : g;
+        }
+        if (g == 0.0f) {
+            fprintf(stderr,"error: iirfiltq15_create_sos(), section %u has zero gain\n", i);
+            exit(1);
+        }
+
+        // scale section so that cumulative peak gain is unity
+        for (k=0; k<3; k++)
+            b[3*i+k] *= g_prev / g;
+        g_prev = g;
+    }
+
+    // restore overall gain at output: g = g_mant * 2^-g_shift
+    q->g_shift = 30;
+    while (q->g_shift > 0 && ldexpf(g_prev, q->g_shift) >= 32767.0f)
+        q->g_shift--;
+    q->g_mant = (int32_t) lroundf(ldexpf(g_prev, q->g_shift));
+
+    // quantize coefficients
+    q->b       = (int16_t*)      malloc(3*q->nsos*sizeof(int16_t));
+    q->a       = (int16_t*)      malloc(3*q->nsos*sizeof(int16_t));
+    q->b_frac  = (unsigned int*) malloc(  q->nsos*sizeof(unsigned int));
+    for (i=0; i<q->nsos; i++) {
+        // feed-forward: largest number of fractional bits that fits
+        float bmax = fabsf(b[3*i+0]);
+        for (k=1; k<3; k++)
+            bmax = fabsf(b[3*i+k]) > bmax ? fabsf(b[3*i+k]) : bmax;
+        unsigned int nb = IIRFILTQ15_B_FRAC_MAX;
+        while (nb > 0 && ldexpf(bmax,nb) > (float)IIRFILTQ15_B_MAX)
+            nb--;
+        if (ldexpf(bmax,nb) > (float)IIRFILTQ15_B_MAX) {
+            fprintf(stderr,"error: iirfiltq15_create_sos(), feed-forward coefficients of section %u out of range\n", i);
+            exit(1);
+        }
+        for (k=0; k<3; k++)
+            q->b[3*i+k] = (int16_t) lroundf(ldexpf(b[3*i+k], nb));
+        q->b_frac[i] = nb;
+
+        // feed-back
+        q->a[3*i] = 1 << IIRFILTQ15_FRAC;
+        for (k=1; k<3; k++) {
+            float v = roundf(ldexpf(a[3*i+k], IIRFILTQ15_FRAC));
+            if (v > 32767.0f || v < -32768.0f) {
+                fprintf(stderr,"error: iirfiltq15_create_sos(), feed-back coefficient a[%u] of section %u out of range\n", k, i);
+                exit(1);
+            }
+            q->a[3*i+k] = (int16_t) v;
+        }
+    }
+
+    // allocate state
+    q->v = (int32_t*) malloc(4*q->nsos*q->num_channels*sizeof(int32_t));
+    q->e = (int32_t*) malloc(2*q->nsos*q->num_channels*sizeof(int32_t));
+
+    // reset filter state
+    iirfiltq15_reset(q);
+    return q;
+}
+
+// create Q15 multi-channel filter from design template
+//  _num_channels : number of channels, _num_channels > 0
+//  _ftype        : filter type (e.g. LIQUID_IIRDES_BUTTER)
+//  _btype        : band type (e.g. LIQUID_IIRDES_BANDPASS)
+//  _order        : filter order
+//  _fc           : low-pass prototype cut-off frequency
+//  _f0           : center frequency (band-pass, band-stop)
+//  _Ap           : pass-band ripple in dB
+//  _As           : stop-band ripple in dB
+iirfiltq15 iirfiltq15_create_prototype(unsigned int             _num_channels,
+                                       liquid_iirdes_filtertype _ftype,
+                                       liquid_iirdes_bandtype   _btype,
+                                       unsigned int             _order,
+                                       float                    _fc,
+                                       float                    _f0,
+                                       float                    _Ap,
+                                       float                    _As)
+{
+    // derived values : compute number of sections (see iirfilt.c)
+    unsigned int N = _order;
+    if (_btype == LIQUID_IIRDES_BANDPASS ||
+        _btype == LIQUID_IIRDES_BANDSTOP)
+    {
+        N *= 2;
+    }
+    unsigned int r = N%2;       // odd/even order
+    unsigned int L = (N-r)/2;   // filter semi-length
+    unsigned int nsos = L+r;
+
+    // design filter as second-order sections
+    float B[3*nsos];
+    float A[3*nsos];
+    liquid_iirdes(_ftype, _btype, LIQUID_IIRDES_SOS, _order, _fc, _f0, _Ap, _As, B, A);
+
+    return iirfiltq15_create_sos(_num_channels, B, A, nsos);
+}
+
+// create Q15 multi-channel DC-blocking filter with first-order error
+// feedback enabled (see iirfilt_xxxt_create_dc_blocker())
+//  _num_channels : number of channels, _num_channels > 0
+//  _alpha        : normalized filter bandwidth
+iirfiltq15 iirfiltq15_create_dc_blocker(unsigned int _num_channels,
+                                        float        _alpha)
+{
+    float B[3] = {1.0f, -1.0f,          0.0f};
+    float A[3] = {1.0f, -1.0f + _alpha, 0.0f};
+    iirfiltq15 q = iirfiltq15_create_sos(_num_channels, B, A, 1);
+    iirfiltq15_set_error_feedback(q, 1);
+    return q;
+}
+
+// destroy filter object and free all internal memory
+void iirfiltq15_destroy(iirfiltq15 _q)
+{
+    free(_q->b);
+    free(_q->a);
+    free(_q->b_frac);
+    free(_q->v);
+    free(_q->e);
+    free(_q);
+}
+
+// reset internal state of filter object
+void iirfiltq15_reset(iirfiltq15 _q)
+{
+    memset(_q->v, 0, 4*_q->nsos*_q->num_channels*sizeof(int32_t));
+    memset(_q->e, 0, 2*_q->nsos*_q->num_channels*sizeof(int32_t));
+}
+
+// print filter object internals
+void iirfiltq15_print(iirfiltq15 _q)
+{
+    printf("iirfiltq15: [%u channels, %u sections, error feedback order %u]\n",
+            _q->num_channels, _q->nsos, _q->ef_order);
+    unsigned int i;
+    for (i=0; i<_q->nsos; i++) {
+        float gb = ldexpf(1.0f, -(int)_q->b_frac[i]);
+        float ga = ldexpf(1.0f, -IIRFILTQ15_FRAC);
+        printf("  b[%2u] = %12.8f,%12.8f,%12.8f\n", i,
+                _q->b[3*i+0]*gb, _q->b[3*i+1]*gb, _q->b[3*i+2]*gb);
+        printf("  a[%2u] = %12.8f,%12.8f,%12.8f\n", i,
+                1.0f, _q->a[3*i+1]*ga, _q->a[3*i+2]*ga);
+    }
+    printf("  g     = %12.8f\n", ldexpf((float)_q->g_mant, -(int)_q->g_shift));
+}
+
+// set order of rounding error feedback in each section
+//  _q      : filter object
+//  _order  : 0 (none), 1 (first-order) or 2 (second-order)
+void iirfiltq15_set_error_feedback(iirfiltq15   _q,
+                                   unsigned int _order)
+{
+    if (_order > 2) {
+        fprintf(stderr,"error: iirfiltq15_set_error_feedback(), order must be 0, 1, or 2\n");
+        exit(1);
+    }
+    _q->ef_order = _order;
+    memset(_q->e, 0, 2*_q->nsos*_q->num_channels*sizeof(int32_t));
+}
+
+// get number of channels
+unsigned int iirfiltq15_get_num_channels(iirfiltq15 _q)
+{
+    return _q->num_channels;
+}
+
+// get number of second-order sections
+unsigned int iirfiltq15_get_num_sections(iirfiltq15 _q)
+{
+    return _q->nsos;
+}
+
+// execute the filter on one frame (one sample per channel); the
+// input and output frames may be the same
+//  _q      : filter object
+//  _x      : input frame  [size: num_channels x 1]
+//  _y      : output frame [size: num_channels x 1]
+void iirfiltq15_execute(iirfiltq15 _q,
+                        int16_t *  _x,
+                        int16_t *  _y)
+{
+    iirfiltq15_execute_block(_q, _x, 1, _y);
+}
+
+// run one section over a block for a group of _L adjacent channels
+// (_L is constant at each call site so that the lanes are unrolled,
+// giving independent recursions to interleave), in place
+static inline void iirfiltq15_section_block(iirfiltq15   _q,
+                                            unsigned int _i,
+                                            unsigned int _c,
+                                            unsigned int _L,
+                                            int16_t *    _y,
+                                            unsigned int _n)
+{
+    unsigned int C = _q->num_channels;
+    const int32_t half = 1 << (IIRFILTQ15_FRAC-1);
+    const int32_t mask = (1 << IIRFILTQ15_FRAC) - 1;
+    const int32_t k1 = _q->ef_order == 0 ? 0 : (_q->ef_order == 1 ? 1 : 2);
+    const int32_t k2 = _q->ef_order == 2 ? 1 : 0;
+
+    int32_t b0 = _q->b[3*_i+0], b1 = _q->b[3*_i+1], b2 = _q->b[3*_i+2];
+    int32_t a1 = _q->a[3*_i+1], a2 = _q->a[3*_i+2];
+    unsigned int nb = _q->b_frac[_i];
+    unsigned int sr = nb > IIRFILTQ15_FRAC ? nb - IIRFILTQ15_FRAC : 0;
+    int32_t      rb = sr > 0 ? 1 << (sr-1) : 0;
+    uint32_t     kl = nb < IIRFILTQ15_FRAC ? 1u << (IIRFILTQ15_FRAC - nb) : 1u;
+
+    // load state
+    int32_t * v = _q->v + 4*_i*C + _c;
+    int32_t * e = _q->e + 2*_i*C + _c;
+    int32_t x1[4], x2[4], y1[4], y2[4], e1[4], e2[4];
+    unsigned int j, k;
+    for (j=0; j<_L; j++) {
+        x1[j] = v[j]; x2[j] = v[C+j]; y1[j] = v[2*C+j]; y2[j] = v[3*C+j];
+        e1[j] = e[j]; e2[j] = e[C+j];
+    }
+
+    int16_t * p = _y + _c;
+    for (k=0; k<_n; k++) {
+        for (j=0; j<_L; j++) {
+            int32_t  x  = p[j];
+            int32_t  vb = b0*x + b1*x1[j] + b2*x2[j];
+            uint32_t s  = (uint32_t)((vb + rb) >> sr) * kl
+                        - (uint32_t)(a1*y1[j]) - (uint32_t)(a2*y2[j])
+                        + (uint32_t)(k1*e1[j] - k2*e2[j]);
+            int32_t r = (int32_t)(s + half);
+            int32_t y = iirfiltq15_sat16(r >> IIRFILTQ15_FRAC);
+            e2[j] = e1[j]; e1[j] = (r & mask) - half;
+            x2[j] = x1[j]; x1[j] = x;
+            y2[j] = y1[j]; y1[j] = y;
+            p[j] = (int16_t) y;
+        }
+        p += C;
+    }
+
+    // store state
+    for (j=0; j<_L; j++) {
+        v[j] = x1[j]; v[C+j] = x2[j]; v[2*C+j] = y1[j]; v[3*C+j] = y2[j];
+        e[j] = e1[j]; e[C+j] = e2[j];
+    }
+}
+
+// execute the filter on a block of interleaved samples (sample i
+// of channel c at index i*num_channels + c); the input and output
+// buffers may be the same
+//  _q      : filter object
+//  _x      : input array [size: _n*num_channels x 1]
+//  _n      : number of samples per channel
+//  _y      : output array [size: _n*num_channels x 1]
+void iirfiltq15_execute_block(iirfiltq15   _q,
+                              int16_t *    _x,
+                              unsigned int _n,
+                              int16_t *    _y)
+{
+    unsigned int C = _q->num_channels;
+    unsigned int i, c, k;
+
+    // section outputs are 16-bit, so the cascade is evaluated in place
+    // on the output buffer one section at a time over the whole block,
+    // keeping coefficients and state of each channel in registers
+    if (_y != _x)
+        memmove(_y, _x, _n*C*sizeof(int16_t));
+
+    for (i=0; i<_q->nsos; i++) {
+        // run channels in groups of 4, then pairs, then singly
+        for (c=0; c+4<=C; c+=4)
+            iirfiltq15_section_block(_q, i, c, 4, _y, _n);
+        for ( ; c+2<=C; c+=2)
+            iirfiltq15_section_block(_q, i, c, 2, _y, _n);
+        for ( ; c<C; c++)
+            iirfiltq15_section_block(_q, i, c, 1, _y, _n);
+    }
+
+    // apply output gain
+    int32_t g = _q->g_mant;
+    unsigned int gs = _q->g_shift;
+    if (g != (1 << gs)) {
+        int32_t gh = gs > 0 ? 1 << (gs-1) : 0;
+        for (k=0; k<_n*C; k++)
+            _y[k] = (int16_t) iirfiltq15_sat16((g*_y[k] + gh) >> gs);
+    }
+}
+
@@ -0,0 +1,432 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// iirfiltss.c
+//
+// Block state-space realization of a cascade of second-order
+// sections. Each direct-form II section
+//
+//      w[n] = x[n] - a1*w[n-1] - a2*w[n-2]
+//      y[n] = b0*w[n] + b1*w[n-1] + b2*w[n-2]
+//
+// has the state s[n] = [w[n-1], w[n-2]] and the realization
+//
+//      s[n+1] = A s[n] + B x[n],   A = [-a1 -a2; 1 0],  B = [1; 0]
+//      y[n]   = C s[n] + D x[n],   C = [b1-b0*a1, b2-b0*a2], D = b0
+//
+// Advancing by a block of L samples at once gives
+//
+//      y[n]   = C A^n s[0] + sum_{k<=n} h[n-k] x[k],  n = 0..L-1
+//      s[L]   = A^L s[0] + sum_k A^(L-1-k) B x[k]
+//
+// where h is the section's impulse response. The block matrices are
+// computed once (in double precision) so that the only recursion left
+// is the once-per-block state update; the bulk of the work is a
+// lower-triangular Toeplitz product and a few dot products with no
+// loop-carried dependency between outputs. The state may be kept in
+// single or double precision. Since every filter designed by iirdes
+// has its poles strictly inside the unit circle, A^n decays and the
+// block matrices are bounded, so the block form is as stable as the
+// sample-by-sample recursion.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// double-precision data and coefficient types
+#if TI_COMPLEX
+#  define IIRFILTSS_TD  double complex
+#else
+#  define IIRFILTSS_TD  double
+#endif
+#if TC_COMPLEX
+#  define IIRFILTSS_TCD double complex
+#else
+#  define IIRFILTSS_TCD double
+#endif
+
+struct IIRFILTSS(_s) {
+    unsigned int nsos;          // number of second-order sections
+    unsigned int L;             // block length
+    int double_state;           // keep state in double precision?
+
+    // section coefficients (normalized), [nsos x 3] each
+    TC * b;                     // feed-forward coefficients
+    TC * a;                     // feed-back coefficients
+
+    // block matrices for each section, single precision
+    TC * h;                     // impulse response,   [nsos x L]
+    TC * o;                     // state-to-output,    [nsos x 2 x L]
+    TC * g;                     // input-to-state,     [nsos x 2 x L]
+    TC * p;                     // state transition,   [nsos x 4]
+    T  * s;                     // state,              [nsos x 2]
+    T  * buf0;                  // block buffers       [L x 1]
+    T  * buf1;
+
+    // block matrices for each section, double precision
+    IIRFILTSS_TCD * hd;
+    IIRFILTSS_TCD * od;
+    IIRFILTSS_TCD * gd;
+    IIRFILTSS_TCD * pd;
+    IIRFILTSS_TD  * sd;
+    IIRFILTSS_TD  * bufd0;
+    IIRFILTSS_TD  * bufd1;
+};
+
+// create block state-space filter from second-order sections
+//  _B      : feed-forward coefficients [size: _nsos x 3]
+//  _A      : feed-back coefficients    [size: _nsos x 3]
+//  _nsos   : number of second-order sections, _nsos > 0
+//  _L      : block length, _L > 0
+//  _double_state : keep state and accumulate in double precision?
+IIRFILTSS() IIRFILTSS(_create)(TC *         _B,
+                               TC *         _A,
+                               unsigned int _nsos,
+                               unsigned int _L,
+                               int          _double_state)
+{
+    // validate input
+    if (_nsos == 0) {
+        fprintf(stderr,"error: iirfiltss_%s_create(), filter must have at least one section\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_L == 0) {
+        fprintf(stderr,"error: iirfiltss_%s_create(), block length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create object and initialize
+    IIRFILTSS() q = (IIRFILTSS()) malloc(sizeof(struct IIRFILTSS(_s)));
+    q->nsos         = _nsos;
+    q->L            = _L;
+    q->double_state = _double_state;
+
+    unsigned int L = q->L;
+    q->b    = (TC *) malloc(3*q->nsos*sizeof(TC));
+    q->a    = (TC *) malloc(3*q->nsos*sizeof(TC));
+    q->h    = (TC *) malloc(  q->nsos*L*sizeof(TC));
+    q->o    = (TC *) malloc(2*q->nsos*L*sizeof(TC));
+    q->g    = (TC *) malloc(2*q->nsos*L*sizeof(TC));
+    q->p    = (TC *) malloc(4*q->nsos*sizeof(TC));
+    q->s    = (T  *) malloc(2*q->nsos*sizeof(T));
+    q->buf0 = (T  *) malloc(L*sizeof(T));
+    q->buf1 = (T  *) malloc(L*sizeof(T));
+    q->hd    = (IIRFILTSS_TCD *) malloc(  q->nsos*L*sizeof(IIRFILTSS_TCD));
+    q->od    = (IIRFILTSS_TCD *) malloc(2*q->nsos*L*sizeof(IIRFILTSS_TCD));
+    q->gd    = (IIRFILTSS_TCD *) malloc(2*q->nsos*L*sizeof(IIRFILTSS_TCD));
+    q->pd    = (IIRFILTSS_TCD *) malloc(4*q->nsos*sizeof(IIRFILTSS_TCD));
+    q->sd    = (IIRFILTSS_TD  *) malloc(2*q->nsos*sizeof(IIRFILTSS_TD));
+    q->bufd0 = (IIRFILTSS_TD  *) malloc(L*sizeof(IIRFILTSS_TD));
+    q->bufd1 = (IIRFILTSS_TD  *) malloc(L*sizeof(IIRFILTSS_TD));
+
+    unsigned int i, k;
+    for (i=0; i<q->nsos; i++) {
+        // normalize coefficients by a0
+        TC a0 = _A[3*i];
+        if (a0 == 0) {
+            fprintf(stderr,"error: iirfiltss_%s_create(), a[0] of section %u must not be zero\n", EXTENSION_FULL, i);
+            exit(1);
+        }
+        for (k=0; k<3; k++) {
+            q->b[3*i+k] = _B[3*i+k] / a0;
+            q->a[3*i+k] = _A[3*i+k] / a0;
+        }
+
+        // state-space realization (double precision)
+        IIRFILTSS_TCD b0 = q->b[3*i+0], b1 = q->b[3*i+1], b2 = q->b[3*i+2];
+        IIRFILTSS_TCD a1 = q->a[3*i+1], a2 = q->a[3*i+2];
+        IIRFILTSS_TCD c0 = b1 - b0*a1;
+        IIRFILTSS_TCD c1 = b2 - b0*a2;
+
+        IIRFILTSS_TCD * h  = q->hd + i*L;
+        IIRFILTSS_TCD * o0 = q->od + 2*i*L;
+        IIRFILTSS_TCD * o1 = o0 + L;
+        IIRFILTSS_TCD * g0 = q->gd + 2*i*L;
+        IIRFILTSS_TCD * g1 = g0 + L;
+        IIRFILTSS_TCD * p  = q->pd + 4*i;
+
+        // u = A^k B: impulse response h[k+1] = C u and the input-to-
+        // state column g[L-1-k] = u
+        IIRFILTSS_TCD u0 = 1, u1 = 0, t;
+        h[0] = b0;
+        for (k=0; k<L; k++) {
+            if (k+1 < L)
+                h[k+1] = c0*u0 + c1*u1;
+            g0[L-1-k] = u0;
+            g1[L-1-k] = u1;
+            t  = -a1*u0 - a2*u1;
+            u1 = u0;
+            u0 = t;
+        }
+
+        // r = C A^n: state-to-output row o[n] = r
+        IIRFILTSS_TCD r0 = c0, r1 = c1;
+        for (k=0; k<L; k++) {
+            o0[k] = r0;
+            o1[k] = r1;
+            t  = -r0*a1 + r1;
+            r1 = -r0*a2;
+            r0 = t;
+        }
+
+        // P = A^L, computed by repeated multiplication
+        IIRFILTSS_TCD m00 = 1, m01 = 0, m10 = 0, m11 = 1;
+        for (k=0; k<L; k++) {
+            IIRFILTSS_TCD n00 = -a1*m00 - a2*m10;
+            IIRFILTSS_TCD n01 = -a1*m01 - a2*m11;
+            m10 = m00;
+            m11 = m01;
+            m00 = n00;
+            m01 = n01;
+        }
+        p[0] = m00; p[1] = m01;
+        p[2] = m10; p[3] = m11;
+    }
+
+    // single-precision copies
+    for (i=0; i<  q->nsos*L; i++) q->h[i] = (TC) q->hd[i];
+    for (i=0; i<2*q->nsos*L; i++) q->o[i] = (TC) q->od[i];
+    for (i=0; i<2*q->nsos*L; i++) q->g[i] = (TC) q->gd[i];
+    for (i=0; i<4*q->nsos;   i++) q->p[i] = (TC) q->pd[i];
+
+    IIRFILTSS(_reset)(q);
+    return q;
+}
+
+// destroy object, freeing all internal memory
+void IIRFILTSS(_destroy)(IIRFILTSS() _q)
+{
+    free(_q->b);
+    free(_q->a);
+    free(_q->h);
+    free(_q->o);
+    free(_q->g);
+    free(_q->p);
+    free(_q->s);
+    free(_q->buf0);
+    free(_q->buf1);
+    free(_q->hd);
+    free(_q->od);
+    free(_q->gd);
+    free(_q->pd);
+    free(_q->sd);
+    free(_q->bufd0);
+    free(_q->bufd1);
+    free(_q);
+}
+
+// reset internal state
+void IIRFILTSS(_reset)(IIRFILTSS() _q)
+{
+    unsigned int i;
+    for (i=0; i<2*_q->nsos; i++) {
+        _q->s[i]  = 0;
+        _q->sd[i] = 0;
+    }
+}
+
+// set internal state from direct-form II buffers
+//  _q      : filter object
+//  _v      : state [size: _nsos x 2], {w[n-1], w[n-2]} per section
+void IIRFILTSS(_set_state)(IIRFILTSS() _q,
+                           TO *        _v)
+{
+    unsigned int i;
+    for (i=0; i<2*_q->nsos; i++) {
+        _q->s[i]  = _v[i];
+        _q->sd[i] = _v[i];
+    }
+}
+
+// get internal state as direct-form II buffers
+//  _q      : filter object
+//  _v      : state [size: _nsos x 2], {w[n-1], w[n-2]} per section
+void IIRFILTSS(_get_state)(IIRFILTSS() _q,
+                           TO *        _v)
+{
+    unsigned int i;
+    for (i=0; i<2*_q->nsos; i++)
+        _v[i] = _q->double_state ? (TO) _q->sd[i] : _q->s[i];
+}
+
+// run one block of L samples through the cascade (single precision);
+// the block is read from and returned in buf0
+void IIRFILTSS(_execute_full_block)(IIRFILTSS() _q)
+{
+    unsigned int L = _q->L;
+    unsigned int i, n, k;
+    T * x = _q->buf0;
+    T * y = _q->buf1;
+    for (i=0; i<_q->nsos; i++) {
+        TC * h  = _q->h + i*L;
+        TC * o0 = _q->o + 2*i*L;
+        TC * o1 = o0 + L;
+        TC * g0 = _q->g + 2*i*L;
+        TC * g1 = g0 + L;
+        TC * p  = _q->p + 4*i;
+        T  * s  = _q->s + 2*i;
+        T s0 = s[0];
+        T s1 = s[1];
+
+        // zero-input response
+        for (n=0; n<L; n++)
+            y[n] = o0[n]*s0 + o1[n]*s1;
+
+        // zero-state response (lower-triangular Toeplitz product)
+        for (k=0; k<L; k++) {
+            T xk = x[k];
+            for (n=k; n<L; n++)
+                y[n] += h[n-k]*xk;
+        }
+
+        // advance state by L samples
+        T t0 = p[0]*s0 + p[1]*s1;
+        T t1 = p[2]*s0 + p[3]*s1;
+        for (k=0; k<L; k++) {
+            t0 += g0[k]*x[k];
+            t1 += g1[k]*x[k];
+        }
+        s[0] = t0;
+        s[1] = t1;
+
+        // output of this section is input to the next
+        T * tmp = x; x = y; y = tmp;
+    }
+
+    // result must end in buf0
+    if (x != _q->buf0)
+        memmove(_q->buf0, x, L*sizeof(T));
+}
+
+// run one block of L samples through the cascade (double precision);
+// the block is read from and returned in bufd0
+void IIRFILTSS(_execute_full_block_d)(IIRFILTSS() _q)
+{
+    unsigned int L = _q->L;
+    unsigned int i, n, k;
+    IIRFILTSS_TD * x = _q->bufd0;
+    IIRFILTSS_TD * y = _q->bufd1;
+    for (i=0; i<_q->nsos; i++) {
+        IIRFILTSS_TCD * h  = _q->hd + i*L;
+        IIRFILTSS_TCD * o0 = _q->od + 2*i*L;
+        IIRFILTSS_TCD * o1 = o0 + L;
+        IIRFILTSS_TCD * g0 = _q->gd + 2*i*L;
+        IIRFILTSS_TCD * g1 = g0 + L;
+        IIRFILTSS_TCD * p  = _q->pd + 4*i;
+        IIRFILTSS_TD  * s  = _q->sd + 2*i;
+        IIRFILTSS_TD s0 = s[0];
+        IIRFILTSS_TD s1 = s[1];
+
+        for (n=0; n<L; n++)
+            y[n] = o0[n]*s0 + o1[n]*s1;
+
+        for (k=0; k<L; k++) {
+            IIRFILTSS_TD xk = x[k];
+            for (n=k; n<L; n++)
+                y[n] += h[n-k]*xk;
+        }
+
+        IIRFILTSS_TD t0 = p[0]*s0 + p[1]*s1;
+        IIRFILTSS_TD t1 = p[2]*s0 + p[3]*s1;
+        for (k=0; k<L; k++) {
+            t0 += g0[k]*x[k];
+            t1 += g1[k]*x[k];
+        }
+        s[0] = t0;
+        s[1] = t1;
+
+        IIRFILTSS_TD * tmp = x; x = y; y = tmp;
+    }
+
+    if (x != _q->bufd0)
+        memmove(_q->bufd0, x, L*sizeof(IIRFILTSS_TD));
+}
+
+// run single sample through the cascade using the direct-form II
+// recursion on the block state (used for partial blocks)
+void IIRFILTSS(_execute_sample)(IIRFILTSS() _q,
+                                TI          _x,
+                                TO *        _y)
+{
+    unsigned int i;
+    if (_q->double_state) {
+        IIRFILTSS_TD v = _x;
+        for (i=0; i<_q->nsos; i++) {
+            IIRFILTSS_TD * s = _q->sd + 2*i;
+            IIRFILTSS_TCD b0 = _q->b[3*i+0], b1 = _q->b[3*i+1], b2 = _q->b[3*i+2];
+            IIRFILTSS_TCD a1 = _q->a[3*i+1], a2 = _q->a[3*i+2];
+            IIRFILTSS_TD w = v - a1*s[0] - a2*s[1];
+            v = b0*w + b1*s[0] + b2*s[1];
+            s[1] = s[0];
+            s[0] = w;
+        }
+        *_y = (TO) v;
+    } else {
+        T v = _x;
+        for (i=0; i<_q->nsos; i++) {
+            T * s = _q->s + 2*i;
+            TC * b = _q->b + 3*i;
+            TC * a = _q->a + 3*i;
+            T w = v - a[1]*s[0] - a[2]*s[1];
+            v = b[0]*w + b[1]*s[0] + b[2]*s[1];
+            s[1] = s[0];
+            s[0] = w;
+        }
+        *_y = v;
+    }
+}
+
+// execute filter on block of samples; full blocks of L samples use
+// the block state-space form and any remainder is computed one
+// sample at a time; the input and output buffers may be the same
+//  _q      : filter object
+//  _x      : input array [size: _n x 1]
+//  _n      : number of input, output samples
+//  _y      : output array [size: _n x 1]
+void IIRFILTSS(_execute_block)(IIRFILTSS()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    unsigned int L = _q->L;
+    unsigned int i = 0, k;
+
+    // full blocks
+    for ( ; i + L <= _n; i += L) {
+        if (_q->double_state) {
+            for (k=0; k<L; k++)
+                _q->bufd0[k] = _x[i+k];
+            IIRFILTSS(_execute_full_block_d)(_q);
+            for (k=0; k<L; k++)
+                _y[i+k] = (TO) _q->bufd0[k];
+        } else {
+            memmove(_q->buf0, &_x[i], L*sizeof(T));
+            IIRFILTSS(_execute_full_block)(_q);
+            memmove(&_y[i], _q->buf0, L*sizeof(T));
+        }
+    }
+
+    // remaining samples
+    for ( ; i<_n; i++)
+        IIRFILTSS(_execute_sample)(_q, _x[i], &_y[i]);
+}
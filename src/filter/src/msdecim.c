@@ -0,0 +1,338 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// msdecim.c
+//
+// multi-stage decimator: chain of half-band decimators followed by
+// a final decimating FIR filter, for a total decimation rate of
+// M = 2^num_stages * D.
+//
+// Samples are processed in blocks. Each stage owns a contiguous
+// buffer holding its filter history followed by the block of input
+// samples; the preceding stage writes its outputs directly into that
+// buffer so no intermediate copies are made. Only the outputs that
+// are kept are computed: the half-band stages evaluate the folded,
+// symmetric filter on the non-zero taps only (m multiplies per
+// output for a filter of length 4m+1) and the final stage evaluates
+// its dot product once every D samples.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// target number of input samples per internal block
+#define MSDECIM_BLOCK_LEN (2048)
+
+struct MSDECIM(_s) {
+    unsigned int num_stages;    // number of half-band stages
+    unsigned int D;             // final decimation rate
+    unsigned int M;             // total decimation rate
+    float        fc;            // pass-band edge (half-band output rate)
+    float        As;            // stop-band attenuation [dB]
+    unsigned int block_len;     // number of outputs per internal block
+
+    // half-band stages
+    unsigned int * m_stage;     // filter semi-length for each stage
+    TC **         g_stage;      // folded odd-indexed taps [size: m x 1]
+    T **          b_stage;      // buffer: 4m history + block [size: 4m + n]
+    unsigned int * n_stage;     // number of inputs per block
+
+    // final stage
+    TC *         h;             // filter coefficients (reversed)
+    unsigned int h_len;         // filter length
+    T *          b_final;       // buffer: h_len-1 history + block
+    unsigned int n_final;       // number of inputs per block
+};
+
+// run half-band decimator over buffer, writing n/2 outputs
+//  _g      : folded taps, [size: _m x 1]
+//  _m      : filter semi-length
+//  _x      : input buffer including 4*_m history samples
+//  _n      : number of new inputs (even)
+//  _y      : output array [size: _n/2 x 1]
+void MSDECIM(_halfband_execute)(TC *         _g,
+                                unsigned int _m,
+                                T *          _x,
+                                unsigned int _n,
+                                T *          _y)
+{
+    unsigned int ny = _n/2;
+    unsigned int n, j;
+
+    // t = 4*(floor(ny/4))
+    unsigned int t = (ny>>2)<<2;
+
+    // compute outputs in groups of 4 (a span of 8 inputs), keeping
+    // accumulators in registers; output n is centered on input 2n+2m
+    for (n=0; n<t; n+=4) {
+        T * p = _x + 2*n + 2*_m;
+        T y0 = 0.5f*p[0];
+        T y1 = 0.5f*p[2];
+        T y2 = 0.5f*p[4];
+        T y3 = 0.5f*p[6];
+        for (j=0; j<_m; j++) {
+            TC gj = _g[j];
+            unsigned int o = 2*j + 1;
+            y0 += gj*(p[  - (int)o] + p[  o]);
+            y1 += gj*(p[2 - (int)o] + p[2+o]);
+            y2 += gj*(p[4 - (int)o] + p[4+o]);
+            y3 += gj*(p[6 - (int)o] + p[6+o]);
+        }
+        _y[n  ] = y0;
+        _y[n+1] = y1;
+        _y[n+2] = y2;
+        _y[n+3] = y3;
+    }
+
+    // clean up remaining
+    for ( ; n<ny; n++) {
+        T * p = _x + 2*n + 2*_m;
+        T v = 0.5f*p[0];
+        for (j=0; j<_m; j++)
+            v += _g[j]*(p[-(int)(2*j+1)] + p[2*j+1]);
+        _y[n] = v;
+    }
+}
+
+// create multi-stage decimator
+//  _num_stages : number of half-band stages, _num_stages <= 16
+//  _fc         : pass-band edge relative to half-band chain
+//                output rate, 0 < _fc < 0.5
+//  _As         : half-band stop-band attenuation [dB]
+//  _D          : final decimation rate, _D > 0
+//  _h          : final filter coefficients [size: _h_len x 1]
+//  _h_len      : final filter length, _h_len > 0
+MSDECIM() MSDECIM(_create)(unsigned int _num_stages,
+                           float        _fc,
+                           float        _As,
+                           unsigned int _D,
+                           TC *         _h,
+                           unsigned int _h_len)
+{
+    // validate input
+    if (_num_stages > 16) {
+        fprintf(stderr,"error: msdecim_%s_create(), number of stages should not exceed 16\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_fc <= 0.0f || _fc >= 0.5f) {
+        fprintf(stderr,"error: msdecim_%s_create(), pass-band edge must be in (0,0.5)\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_As <= 0.0f) {
+        fprintf(stderr,"error: msdecim_%s_create(), stop-band attenuation must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_D == 0) {
+        fprintf(stderr,"error: msdecim_%s_create(), final decimation rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_h_len == 0) {
+        fprintf(stderr,"error: msdecim_%s_create(), filter length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create object and set internal properties
+    MSDECIM() q = (MSDECIM()) malloc(sizeof(struct MSDECIM(_s)));
+    q->num_stages = _num_stages;
+    q->fc         = _fc;
+    q->As         = _As;
+    q->D          = _D;
+    q->M          = (1 << q->num_stages) * q->D;
+    q->h_len      = _h_len;
+
+    // number of outputs per internal block
+    q->block_len = MSDECIM_BLOCK_LEN / q->M;
+    q->block_len = q->block_len == 0 ? 1 : q->block_len;
+
+    // design half-band stages; the pass-band edge at the input of
+    // stage s is fc / 2^(num_stages-s), and aliasing into it must be
+    // suppressed, leaving a transition band of 0.5 - 2*fp
+    unsigned int s, i;
+    q->m_stage = (unsigned int*) malloc(q->num_stages*sizeof(unsigned int));
+    q->g_stage = (TC **)         malloc(q->num_stages*sizeof(TC*));
+    q->b_stage = (T **)          malloc(q->num_stages*sizeof(T*));
+    q->n_stage = (unsigned int*) malloc(q->num_stages*sizeof(unsigned int));
+    float beta = kaiser_beta_As(q->As);
+    for (s=0; s<q->num_stages; s++) {
+        float fp = q->fc / (float)(1 << (q->num_stages - s));
+        float ft = 0.5f - 2.0f*fp;
+        unsigned int h_len = estimate_req_filter_len(ft, q->As);
+        unsigned int m = (unsigned int) ceilf( (float)(h_len-1) / 4.0f );
+        m = m < 2 ? 2 : m;
+        q->m_stage[s] = m;
+
+        // odd-indexed taps of half-band filter (even taps other than
+        // the center are zero), normalized for unity DC gain
+        q->g_stage[s] = (TC *) malloc(m*sizeof(TC));
+        float gsum = 0.0f;
+        float g[m];
+        for (i=0; i<m; i++) {
+            float t = (float)(2*i+1);
+            g[i] = sincf(0.5f*t) * kaiser(2*m + 2*i + 1, 4*m+1, beta, 0);
+            gsum += g[i];
+        }
+        for (i=0; i<m; i++)
+            q->g_stage[s][i] = 0.25f * g[i] / gsum;
+
+        // buffer
+        q->n_stage[s] = q->block_len * q->D * (1 << (q->num_stages - s));
+        q->b_stage[s] = (T *) malloc((4*m + q->n_stage[s])*sizeof(T));
+    }
+
+    // final stage: load filter in reverse order
+    q->h = (TC *) malloc(q->h_len*sizeof(TC));
+    for (i=0; i<q->h_len; i++)
+        q->h[i] = _h[q->h_len - i - 1];
+    q->n_final = q->block_len * q->D;
+    q->b_final = (T *) malloc((q->h_len - 1 + q->n_final)*sizeof(T));
+
+    // reset object
+    MSDECIM(_reset)(q);
+    return q;
+}
+
+// destroy object, freeing all internal memory
+void MSDECIM(_destroy)(MSDECIM() _q)
+{
+    unsigned int s;
+    for (s=0; s<_q->num_stages; s++) {
+        free(_q->g_stage[s]);
+        free(_q->b_stage[s]);
+    }
+    free(_q->m_stage);
+    free(_q->g_stage);
+    free(_q->b_stage);
+    free(_q->n_stage);
+    free(_q->h);
+    free(_q->b_final);
+    free(_q);
+}
+
+// print object internals
+void MSDECIM(_print)(MSDECIM() _q)
+{
+    printf("multi-stage decimator [%s]:\n", EXTENSION_FULL);
+    printf("    decimation rate         : %u (2^%u x %u)\n", _q->M, _q->num_stages, _q->D);
+    printf("    pass-band edge, fc      : %12.8f\n", _q->fc);
+    printf("    stop-band attenuation   : %.2f dB\n", _q->As);
+    unsigned int s;
+    for (s=0; s<_q->num_stages; s++)
+        printf("    stage[%2u]  {half-band, m=%3u}\n", s, _q->m_stage[s]);
+    printf("    final      {decim=%u, h_len=%u}\n", _q->D, _q->h_len);
+    printf("    group delay             : %.2f input samples\n", MSDECIM(_get_delay)(_q));
+}
+
+// reset object internals, clearing all buffers
+void MSDECIM(_reset)(MSDECIM() _q)
+{
+    unsigned int s;
+    for (s=0; s<_q->num_stages; s++)
+        memset(_q->b_stage[s], 0, 4*_q->m_stage[s]*sizeof(T));
+    memset(_q->b_final, 0, (_q->h_len-1)*sizeof(T));
+}
+
+// get total decimation rate
+unsigned int MSDECIM(_get_decim_rate)(MSDECIM() _q)
+{
+    return _q->M;
+}
+
+// get total group delay of cascade [input samples]
+float MSDECIM(_get_delay)(MSDECIM() _q)
+{
+    // each half-band stage delays by 2m samples at its input rate;
+    // the final filter delays by (h_len-1)/2 at its input rate
+    float delay = 0.0f;
+    unsigned int s;
+    for (s=0; s<_q->num_stages; s++)
+        delay += (float)(2*_q->m_stage[s]) * (float)(1 << s);
+    delay += 0.5f*(float)(_q->h_len-1) * (float)(1 << _q->num_stages);
+    return delay;
+}
+
+// run one internal block: input has already been written to the
+// first stage buffer (or final buffer if there are no stages)
+//  _q      : decimator object
+//  _n      : number of outputs, _n <= block_len
+//  _y      : output array [size: _n x 1]
+void MSDECIM(_execute_internal)(MSDECIM()    _q,
+                                unsigned int _n,
+                                TO *         _y)
+{
+    unsigned int s, i;
+    unsigned int nx = _n * _q->M;   // number of inputs to stage 0
+    for (s=0; s<_q->num_stages; s++) {
+        unsigned int m = _q->m_stage[s];
+        T * b = _q->b_stage[s];
+
+        // write outputs directly into next stage's buffer
+        T * y = (s+1 < _q->num_stages) ? _q->b_stage[s+1] + 4*_q->m_stage[s+1]
+                                       : _q->b_final + _q->h_len - 1;
+        MSDECIM(_halfband_execute)(_q->g_stage[s], m, b, nx, y);
+
+        // retain history
+        memmove(b, b + nx, 4*m*sizeof(T));
+        nx /= 2;
+    }
+
+    // final stage: compute only the outputs retained
+    for (i=0; i<_n; i++)
+        DOTPROD(_run4)(_q->h, _q->b_final + i*_q->D, _q->h_len, &_y[i]);
+    memmove(_q->b_final, _q->b_final + nx, (_q->h_len-1)*sizeof(T));
+}
+
+// execute on block of input samples
+//  _q      : decimator object
+//  _x      : input array [size: _n*M x 1]
+//  _n      : number of output samples
+//  _y      : output array [size: _n x 1]
+void MSDECIM(_execute_block)(MSDECIM()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+    while (_n > 0) {
+        unsigned int n = _n < _q->block_len ? _n : _q->block_len;
+
+        // copy input into first buffer
+        T * b = _q->num_stages > 0 ? _q->b_stage[0] + 4*_q->m_stage[0]
+                                   : _q->b_final + _q->h_len - 1;
+        memmove(b, _x, n*_q->M*sizeof(T));
+
+        // run cascade
+        MSDECIM(_execute_internal)(_q, n, _y);
+
+        _x += n*_q->M;
+        _y += n;
+        _n -= n;
+    }
+}
+
+// execute decimator on M input samples
+//  _q      : decimator object
+//  _x      : input array [size: M x 1]
+//  _y      : output sample pointer
+void MSDECIM(_execute)(MSDECIM() _q,
+                       TI *      _x,
+                       TO *      _y)
+{
+    MSDECIM(_execute_block)(_q, _x, 1, _y);
+}
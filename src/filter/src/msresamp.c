@@ -31,6 +31,9 @@
 
 #include "liquid.internal.h"
 
+// number of samples run through the arbitrary resampler at a time
+#define MSRESAMP_BLOCK_LEN  (64)
+
 // 
 // forward declaration of internal methods
 //
@@ -71,6 +74,10 @@ struct MSRESAMP(_s) {
     unsigned int buffer_len;            // length of each buffer
     T * buffer;                         // buffer[0]
     unsigned int buffer_index;          // index of buffer
+
+    // arbitrary resampler block buffer (interpolator output,
+    // decimator input)
+    T * buffer_resamp;                  // [size: 2*MSRESAMP_BLOCK_LEN+4]
 };
 
 // create msresamp object
@@ -122,6 +129,7 @@ MSRESAMP() MSRESAMP(_create)(float _r,
     // allocate memory for buffer
     q->buffer_len = 4 + (1 << q->num_halfband_stages);
     q->buffer = (T*) malloc( q->buffer_len*sizeof(T) );
+    q->buffer_resamp = (T*) malloc( (2*MSRESAMP_BLOCK_LEN+4)*sizeof(T) );
 
     // create single multi-stage half-band resampler object
     // TODO: compute appropriate cut-off frequency
@@ -143,8 +151,9 @@ MSRESAMP() MSRESAMP(_create)(float _r,
 // destroy msresamp object, freeing all internally-allocated memory
 void MSRESAMP(_destroy)(MSRESAMP() _q)
 {
-    // free buffer
+    // free buffers
     free(_q->buffer);
+    free(_q->buffer_resamp);
 
     // destroy arbitrary resampler
     RESAMP(_destroy)(_q->arbitrary_resamp);
@@ -284,16 +293,18 @@ void MSRESAMP(_interp_execute)(MSRESAMP()     _q,
     unsigned int nw;
     unsigned int ny = 0;
 
-    // operate one sample at a time so that we don't overflow the internal
-    // buffer
-    for (i=0; i<_nx; i++) {
+    // operate on blocks of input samples so that we don't overflow the
+    // internal buffer; the arbitrary rate is at most 2
+    for (i=0; i<_nx; i+=MSRESAMP_BLOCK_LEN) {
+        unsigned int n = (_nx - i) < MSRESAMP_BLOCK_LEN ? _nx - i : MSRESAMP_BLOCK_LEN;
+
         // run arbitrary resampler
-        RESAMP(_execute)(_q->arbitrary_resamp, _x[i], _q->buffer, &nw);
+        RESAMP(_execute_block)(_q->arbitrary_resamp, &_x[i], n, _q->buffer_resamp, &nw);
 
         // run multi-stage half-band resampler on each output sample
         unsigned int k;
         for (k=0; k<nw; k++) {
-            MSRESAMP2(_execute)(_q->halfband_resamp, &_q->buffer[k], &_y[ny]);
+            MSRESAMP2(_execute)(_q->halfband_resamp, &_q->buffer_resamp[k], &_y[ny]);
 
             // increase output counter by halfband interpolation rate
             ny += 1 << _q->num_halfband_stages;
@@ -319,10 +330,9 @@ void MSRESAMP(_decim_execute)(MSRESAMP()     _q,
     unsigned int M = 1 << _q->num_halfband_stages;
     unsigned int nw;        // number of samples written for arbitrary resamp
     unsigned int ny = 0;    // running counter of output samples
-    TO halfband_output;     // single half-band decimator output sample
+    unsigned int nh = 0;    // number of half-band decimator outputs
 
     // write samples to buffer until it contains 2^num_halfband_stages
-    // TODO: write block of samples
     for (i=0; i<_nx; i++) {
         // push sample into buffer
         _q->buffer[_q->buffer_index++] = _x[i];
@@ -330,20 +340,22 @@ void MSRESAMP(_decim_execute)(MSRESAMP()     _q,
         // check if buffer has 'M' elements
         if (_q->buffer_index == M) {
             // run half-band decimation, producing a single output
-            MSRESAMP2(_execute)(_q->halfband_resamp, _q->buffer, &halfband_output);
+            MSRESAMP2(_execute)(_q->halfband_resamp, _q->buffer, &_q->buffer_resamp[nh++]);
+
+            // reset buffer index
+            _q->buffer_index = 0;
+        }
 
-            // run resulting sample through arbitrary resampler
-            RESAMP(_execute)(_q->arbitrary_resamp, halfband_output, &_y[ny], &nw);
+        // run block of half-band outputs through arbitrary resampler
+        if (nh == MSRESAMP_BLOCK_LEN || (i == _nx-1 && nh > 0)) {
+            RESAMP(_execute_block)(_q->arbitrary_resamp, _q->buffer_resamp, nh, &_y[ny], &nw);
 
             // increment output counter
             ny += nw;
-
-            // reset buffer index
-            _q->buffer_index = 0;
+            nh = 0;
         }
     }
 
     // set return value for number of samples written
     *_ny = ny;
 }
-
@@ -35,6 +35,9 @@
 // forward declaration of internal methods
 //
 
+// minimum number of samples in internal stage buffers
+#define MSRESAMP2_BLOCK_LEN (2048)
+
 struct MSRESAMP2(_s) {
     // user-defined parameters
     liquid_resamp_type type;    // resampler type (e.g. LIQUID_RESAMP_INTERP)
@@ -54,25 +57,30 @@ struct MSRESAMP2(_s) {
     RESAMP2() * resamp2;        // array of half-band resamplers
     T * buffer0;                // buffer[0]
     T * buffer1;                // buffer[1]
+    unsigned int buffer_len;    // length of each buffer
     unsigned int buffer_index;  // index of buffer
     float zeta;                 // scaling factor
 };
 
 // execute multi-stage resampler as interpolator
 //  _q      : msresamp object
-//  _x      : input sample
-//  _y      : output sample array  [size:2^_num_stages x 1]
-void MSRESAMP2(_interp_execute)(MSRESAMP2() _q,
-                                TI          _x,
-                                TO *        _y);
+//  _x      : input sample array  [size: _n x 1]
+//  _n      : number of input samples
+//  _y      : output sample array  [size: _n*2^_num_stages x 1]
+void MSRESAMP2(_interp_execute)(MSRESAMP2()  _q,
+                                TI *         _x,
+                                unsigned int _n,
+                                TO *         _y);
 
 // execute multi-stage resampler as decimator
 //  _q      : msresamp object
-//  _x      : input sample array  [size: 2^_num_stages x 1]
-//  _y      : output sample pointer
-void MSRESAMP2(_decim_execute)(MSRESAMP2() _q,
-                               TI *        _x,
-                               TO *        _y);
+//  _x      : input sample array  [size: _n*2^_num_stages x 1]
+//  _n      : number of output samples
+//  _y      : output sample array [size: _n x 1]
+void MSRESAMP2(_decim_execute)(MSRESAMP2()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y);
 
 // create multi-stage half-band resampler
 //  _type       : resampler type (e.g. LIQUID_RESAMP_DECIM)
@@ -124,9 +132,11 @@ MSRESAMP2() MSRESAMP2(_create)(int          _type,
     q->M    = 1 << q->num_stages;
     q->zeta = 1.0f / (float)(q->M);
 
-    // allocate memory for buffers
-    q->buffer0 = (T*) malloc( q->M * sizeof(T) );
-    q->buffer1 = (T*) malloc( q->M * sizeof(T) );
+    // allocate memory for buffers; at least one full frame, but large
+    // enough that each stage runs over a long block
+    q->buffer_len = q->M > MSRESAMP2_BLOCK_LEN ? q->M : MSRESAMP2_BLOCK_LEN;
+    q->buffer0 = (T*) malloc( q->buffer_len * sizeof(T) );
+    q->buffer1 = (T*) malloc( q->buffer_len * sizeof(T) );
 
     // allocate arrays for half-band resampler parameters
     q->fc_stage = (float*)        malloc(q->num_stages*sizeof(float)       );
@@ -272,10 +282,47 @@ void MSRESAMP2(_execute)(MSRESAMP2() _q,
         return;
     } else if (_q->type == LIQUID_RESAMP_INTERP) {
         // execute multi-stage resampler as interpolator
-        MSRESAMP2(_interp_execute)(_q, _x[0], _y);
+        MSRESAMP2(_interp_execute)(_q, _x, 1, _y);
     } else {
         // execute multi-stage resampler as decimator
-        MSRESAMP2(_decim_execute)(_q, _x, _y);
+        MSRESAMP2(_decim_execute)(_q, _x, 1, _y);
+    }
+}
+
+// execute multi-stage resampler on block of frames
+//  _q      : msresamp object
+//  _x      : input array; _n samples (interpolator) or
+//            _n*2^_num_stages samples (decimator)
+//  _n      : number of frames
+//  _y      : output array; _n*2^_num_stages samples (interpolator)
+//            or _n samples (decimator)
+void MSRESAMP2(_execute_block)(MSRESAMP2()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    unsigned int i;
+    if (_q->num_stages == 0) {
+        // pass through
+        for (i=0; i<_n; i++)
+            _y[i] = _x[i];
+        return;
+    }
+
+    // number of frames that fit in internal buffers
+    unsigned int num_frames = _q->buffer_len / _q->M;
+    while (_n > 0) {
+        unsigned int n = _n < num_frames ? _n : num_frames;
+        if (_q->type == LIQUID_RESAMP_INTERP) {
+            MSRESAMP2(_interp_execute)(_q, _x, n, _y);
+            _x += n;
+            _y += n*_q->M;
+        } else {
+            MSRESAMP2(_decim_execute)(_q, _x, n, _y);
+            _x += n*_q->M;
+            _y += n;
+        }
+        _n -= n;
     }
 }
 
@@ -285,70 +332,66 @@ void MSRESAMP2(_execute)(MSRESAMP2() _q,
 
 // execute multi-stage resampler as interpolator            
 //  _q      : msresamp object                               
-//  _x      : input sample                                  
-//  _y      : output sample array  [size:2^_num_stages x 1] 
-void MSRESAMP2(_interp_execute)(MSRESAMP2() _q,
-                                TI          _x,
-                                TO *        _y)
+//  _x      : input sample array  [size: _n x 1]
+//  _n      : number of input samples
+//  _y      : output sample array  [size: _n*2^_num_stages x 1]
+void MSRESAMP2(_interp_execute)(MSRESAMP2()  _q,
+                                TI *         _x,
+                                unsigned int _n,
+                                TO *         _y)
 {
-    // buffer pointers (initialize BOTH to _q->buffer0);
-    T * b0 = _q->buffer0;   // input buffer pointer
-    T * b1 = _q->buffer1;   // output buffer pointer
-
-    // set input sample in first buffer
-    b0[0] = _x;
+    // buffer pointers
+    T * b0 = _x;            // input buffer pointer
+    T * b1 = _q->buffer0;   // output buffer pointer
 
-    unsigned int s;         // half-band decimator stage counter
-    unsigned int k;         // number of inputs for this stage
+    unsigned int s;         // half-band interpolator stage counter
+    unsigned int k = _n;    // number of inputs for this stage
     for (s=0; s<_q->num_stages; s++) {
-        // compute number of inputs for this stage
-        k = 1 << s;
-
         // set final stage output as supplied output pointer
         if (s == _q->num_stages-1)
             b1 = _y;
 
-        // run half-band stages as interpolators
-        unsigned int i;
+        // run half-band stage as interpolator over entire block
         unsigned int g = _q->num_stages-s-1;    // reversed resampler index
-        for (i=0; i<k; i++)
-            RESAMP2(_interp_execute)(_q->resamp2[g], b0[i], &b1[2*i]);
+        RESAMP2(_interp_execute_block)(_q->resamp2[g], b0, k, b1);
 
         // toggle output buffer pointers
-        b0 = (s % 2) == 0 ? _q->buffer1 : _q->buffer0;
-        b1 = (s % 2) == 0 ? _q->buffer0 : _q->buffer1;
+        b0 = (s % 2) == 0 ? _q->buffer0 : _q->buffer1;
+        b1 = (s % 2) == 0 ? _q->buffer1 : _q->buffer0;
+        k <<= 1;
     }
 }
 
 // execute multi-stage resampler as decimator               
 //  _q      : msresamp object                               
-//  _x      : input sample array  [size: 2^_num_stages x 1] 
-//  _y      : output sample pointer                         
-void MSRESAMP2(_decim_execute)(MSRESAMP2() _q,
-                               TI *        _x,
-                               TO *        _y)
+//  _x      : input sample array  [size: _n*2^_num_stages x 1]
+//  _n      : number of output samples
+//  _y      : output sample array [size: _n x 1]
+void MSRESAMP2(_decim_execute)(MSRESAMP2()  _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
 {
-    // buffer pointers (initialize BOTH to _q->buffer0);
+    // buffer pointers
     T * b0 = _x;            // input buffer pointer
-    T * b1 = _q->buffer1;   // output buffer pointer
+    T * b1 = _q->buffer0;   // output buffer pointer
 
     unsigned int s;         // half-band decimator stage counter
     unsigned int k;         // number of outputs for this stage
     for (s=0; s<_q->num_stages; s++) {
         // compute number of outputs for this stage
-        k = 1 << (_q->num_stages - s - 1);
+        k = _n << (_q->num_stages - s - 1);
 
-        // run half-band stages as decimators
-        unsigned int i;
-        for (i=0; i<k; i++)
-            RESAMP2(_decim_execute)(_q->resamp2[s], &b0[2*i], &b1[i]);
+        // run half-band stage as decimator over entire block
+        RESAMP2(_decim_execute_block)(_q->resamp2[s], b0, k, b1);
 
         // toggle output buffer pointers
-        b0 = (s % 2) == 0 ? _q->buffer1 : _q->buffer0;
-        b1 = (s % 2) == 0 ? _q->buffer0 : _q->buffer1;
+        b0 = (s % 2) == 0 ? _q->buffer0 : _q->buffer1;
+        b1 = (s % 2) == 0 ? _q->buffer1 : _q->buffer0;
     }
 
-    // set single output sample and scale appropriately
-    *_y = b0[0] * _q->zeta;
+    // set output samples and scale appropriately
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        _y[i] = b0[i] * _q->zeta;
 }
-
@@ -34,14 +34,25 @@
 //  TC          coefficient data type
 //  TI          input data type
 //  RESAMP()    name-mangling macro
-//  FIRPFB()    firpfb macro
+//  FIRBANK()   firbank macro
+//  WINDOW()    window macro
 
 // enable run-time debug printing of resampler
 #define DEBUG_RESAMP_PRINT              0
 
+// maximum number of input/output samples processed in each
+// sub-block of RESAMP(_execute_block)
+#define RESAMP_BLOCK_LEN                (256)
+
 // internal: update timing
 void RESAMP(_update_timing_state)(RESAMP() _q);
 
+// internal: compute output timing for a sub-block of input samples,
+// returning the number of input samples consumed
+unsigned int RESAMP(_block_timing)(RESAMP()       _q,
+                                   unsigned int   _nx,
+                                   unsigned int * _ny);
+
 struct RESAMP(_s) {
     // filter design parameters
     unsigned int m;     // filter semi-length, h_len = 2*m + 1
@@ -62,12 +73,21 @@ struct RESAMP(_s) {
 
     // polyphase filterbank properties/object
     unsigned int npfb;  // number of filters in the bank
-    FIRPFB() f;         // filterbank object (interpolator)
+    FIRBANK() bank;     // filterbank coefficients (interpolator)
+    unsigned int h_sub_len; // length of each filter in the bank
+    WINDOW() w;         // input buffer
 
     enum {
         RESAMP_STATE_BOUNDARY, // boundary between input samples
         RESAMP_STATE_INTERP,   // regular interpolation
     } state;
+
+    // block processing buffers (output timing for each sub-block)
+    TI *           blk_x;       // input history and sub-block      [size: h_sub_len + RESAMP_BLOCK_LEN]
+    unsigned int * blk_i;       // input sample index per output    [size: RESAMP_BLOCK_LEN]
+    unsigned int * blk_b;       // base filterbank index per output [size: RESAMP_BLOCK_LEN]
+    float *        blk_mu;      // interpolation value per output   [size: RESAMP_BLOCK_LEN]
+    TO *           blk_y1;      // filterbank output at b+1         [size: RESAMP_BLOCK_LEN]
 };
 
 // create arbitrary resampler
@@ -129,7 +149,16 @@ RESAMP() RESAMP(_create)(float        _rate,
     // copy to type-specific array, applying gain
     for (i=0; i<n; i++)
         h[i] = hf[i]*gain;
-    q->f = FIRPFB(_create)(q->npfb,h,n-1);
+    q->bank      = FIRBANK(_create)(q->npfb,h,n-1);
+    q->h_sub_len = FIRBANK(_get_sub_len)(q->bank);
+    q->w         = WINDOW(_create)(q->h_sub_len);
+
+    // allocate block processing buffers
+    q->blk_x  = (TI *)           malloc((q->h_sub_len+RESAMP_BLOCK_LEN)*sizeof(TI));
+    q->blk_i  = (unsigned int *) malloc(RESAMP_BLOCK_LEN*sizeof(unsigned int));
+    q->blk_b  = (unsigned int *) malloc(RESAMP_BLOCK_LEN*sizeof(unsigned int));
+    q->blk_mu = (float *)        malloc(RESAMP_BLOCK_LEN*sizeof(float));
+    q->blk_y1 = (TO *)           malloc(RESAMP_BLOCK_LEN*sizeof(TO));
 
     // reset object and return
     RESAMP(_reset)(q);
@@ -163,8 +192,16 @@ RESAMP() RESAMP(_create_default)(float _rate)
 // free arbitrary resampler object
 void RESAMP(_destroy)(RESAMP() _q)
 {
-    // free polyphase filterbank
-    FIRPFB(_destroy)(_q->f);
+    // free polyphase filterbank and input buffer
+    FIRBANK(_destroy)(_q->bank);
+    WINDOW(_destroy)(_q->w);
+
+    // free block processing buffers
+    free(_q->blk_x);
+    free(_q->blk_i);
+    free(_q->blk_b);
+    free(_q->blk_mu);
+    free(_q->blk_y1);
 
     // free main object memory
     free(_q);
@@ -174,14 +211,14 @@ void RESAMP(_destroy)(RESAMP() _q)
 void RESAMP(_print)(RESAMP() _q)
 {
     printf("resampler [rate: %f]\n", _q->rate);
-    FIRPFB(_print)(_q->f);
+    FIRBANK(_print)(_q->bank);
 }
 
 // reset resampler object
 void RESAMP(_reset)(RESAMP() _q)
 {
-    // clear filterbank
-    FIRPFB(_reset)(_q->f);
+    // clear input buffer
+    WINDOW(_clear)(_q->w);
 
     // reset states
     _q->state = RESAMP_STATE_INTERP;// input/output sample state
@@ -247,8 +284,10 @@ void RESAMP(_execute)(RESAMP()       _q,
                       TO *           _y,
                       unsigned int * _num_written)
 {
-    // push input sample into filterbank
-    FIRPFB(_push)(_q->f, _x);
+    // push input sample into buffer
+    TI * r;
+    WINDOW(_push)(_q->w, _x);
+    WINDOW(_read)(_q->w, &r);
     unsigned int n=0;
     
     while (_q->b < _q->npfb) {
@@ -259,7 +298,7 @@ void RESAMP(_execute)(RESAMP()       _q,
         switch (_q->state) {
         case RESAMP_STATE_BOUNDARY:
             // compute filterbank output
-            FIRPFB(_execute)(_q->f, 0, &_q->y1);
+            FIRBANK(_execute)(_q->bank, 0, r, &_q->y1);
 
             // interpolate
             _y[n++] = (1.0f - _q->mu)*_q->y0 + _q->mu*_q->y1;
@@ -272,7 +311,7 @@ void RESAMP(_execute)(RESAMP()       _q,
 
         case RESAMP_STATE_INTERP:
             // compute output at base index
-            FIRPFB(_execute)(_q->f, _q->b, &_q->y0);
+            FIRBANK(_execute)(_q->bank, _q->b, r, &_q->y0);
 
             // check to see if base index is last filter in the bank, in
             // which case the resampler needs an additional input sample
@@ -286,7 +325,7 @@ void RESAMP(_execute)(RESAMP()       _q,
             } else {
                 // do not need additional input sample; compute
                 // output at incremented base index
-                FIRPFB(_execute)(_q->f, _q->b+1, &_q->y1);
+                FIRBANK(_execute)(_q->bank, _q->b+1, r, &_q->y1);
 
                 // perform linear interpolation between filterbank outputs
                 _y[n++] = (1.0f - _q->mu)*_q->y0 + _q->mu*_q->y1;
@@ -316,6 +355,14 @@ void RESAMP(_execute)(RESAMP()       _q,
 //  _nx             :   input buffer
 //  _y              :   output sample array (pointer)
 //  _ny             :   number of samples written to _y
+//
+// The input is processed in sub-blocks: the output timing (input
+// sample, filterbank index and interpolation value of every output) is
+// first computed for the entire sub-block. The sub-block is placed
+// after the buffered input history so that the filter input for every
+// output is a contiguous slice of one array; both filterbank outputs
+// of every output are then computed in a single pass, and finally the
+// linear interpolation is applied across all outputs at once.
 void RESAMP(_execute_block)(RESAMP()       _q,
                             TI *           _x,
                             unsigned int   _nx,
@@ -325,24 +372,68 @@ void RESAMP(_execute_block)(RESAMP()       _q,
     // initialize number of output samples to zero
     unsigned int ny = 0;
 
-    // number of samples written for each individual iteration
-    unsigned int num_written;
+    // fall back to single-sample operation if the rate is so high that
+    // a single input could overflow the sub-block buffers
+    if (_q->rate + 2.0f > (float)RESAMP_BLOCK_LEN) {
+        unsigned int i, num_written;
+        for (i=0; i<_nx; i++) {
+            RESAMP(_execute)(_q, _x[i], &_y[ny], &num_written);
+            ny += num_written;
+        }
+        *_ny = ny;
+        return;
+    }
 
-    // iterate over each input sample
-    unsigned int i;
-    for (i=0; i<_nx; i++) {
-        // run resampler on single input
-        RESAMP(_execute)(_q, _x[i], &_y[ny], &num_written);
+    unsigned int j;
+    unsigned int L = _q->h_sub_len;
+    unsigned int nx = 0;    // number of inputs consumed
+    while (nx < _nx) {
+        // compute output timing for sub-block
+        unsigned int num_out = 0;
+        unsigned int num_in  = RESAMP(_block_timing)(_q, _nx - nx, &num_out);
+
+        // stage input: buffer contents followed by the sub-block, so
+        // that the filter input after pushing sample i is x + i + 1
+        TI * r;
+        WINDOW(_read)(_q->w, &r);
+        memmove(_q->blk_x,   r,       L*sizeof(TI));
+        memmove(_q->blk_x+L, &_x[nx], num_in*sizeof(TI));
+        WINDOW(_write)(_q->w, &_x[nx], num_in);
+
+        // compute filterbank outputs: y0 is written directly to the
+        // output array, y1 to the internal buffer
+        TO * y0 = &_y[ny];
+        for (j=0; j<num_out; j++) {
+            TI * xj = _q->blk_x + _q->blk_i[j] + 1;
+            unsigned int b = _q->blk_b[j];
+            if (b == _q->npfb-1) {
+                // boundary: interpolate between last filter at previous
+                // input and first filter at this input
+                FIRBANK(_execute)(_q->bank, b, xj-1, &y0[j]);
+                FIRBANK(_execute)(_q->bank, 0, xj,   &_q->blk_y1[j]);
+            } else {
+                FIRBANK(_execute)(_q->bank, b,   xj, &y0[j]);
+                FIRBANK(_execute)(_q->bank, b+1, xj, &_q->blk_y1[j]);
+            }
+        }
 
-        // update output counter
-        ny += num_written;
+        // perform linear interpolation between filterbank outputs
+        for (j=0; j<num_out; j++)
+            y0[j] = (1.0f - _q->blk_mu[j])*y0[j] + _q->blk_mu[j]*_q->blk_y1[j];
+
+        // keep output at last filter in the bank for single-sample
+        // execution to finish a pending interpolation
+        if (_q->state == RESAMP_STATE_BOUNDARY)
+            FIRBANK(_execute)(_q->bank, _q->npfb-1, _q->blk_x + num_in, &_q->y0);
+
+        nx += num_in;
+        ny += num_out;
     }
 
     // set return value for number of output samples written
     *_ny = ny;
 }
 
-
 //
 // internal methods
 // 
@@ -362,3 +453,52 @@ void RESAMP(_update_timing_state)(RESAMP() _q)
     _q->mu  = _q->bf - (float)(_q->b);  // fractional index
 }
 
+// compute output timing for a sub-block of input samples; runs the
+// same timing state machine as RESAMP(_execute) without computing
+// any filterbank outputs
+//  _q      :   resamp object
+//  _nx     :   number of input samples available
+//  _ny     :   number of output samples in sub-block
+unsigned int RESAMP(_block_timing)(RESAMP()       _q,
+                                   unsigned int   _nx,
+                                   unsigned int * _ny)
+{
+    // maximum number of outputs for a single input sample
+    unsigned int max_out = (unsigned int) ceilf(_q->rate) + 1;
+
+    unsigned int i;
+    unsigned int n = 0;
+    for (i=0; i<_nx && i<RESAMP_BLOCK_LEN && n+max_out<=RESAMP_BLOCK_LEN; i++) {
+        while (_q->b < _q->npfb) {
+            if (_q->state == RESAMP_STATE_BOUNDARY) {
+                // interpolate between last filter and first filter
+                // of the following input sample
+                _q->blk_i[n]  = i;
+                _q->blk_b[n]  = _q->npfb-1;
+                _q->blk_mu[n] = _q->mu;
+                n++;
+                RESAMP(_update_timing_state)(_q);
+                _q->state = RESAMP_STATE_INTERP;
+            } else if (_q->b == _q->npfb-1) {
+                // last filter: need additional input sample
+                _q->state = RESAMP_STATE_BOUNDARY;
+                _q->b = _q->npfb;
+            } else {
+                // regular interpolation
+                _q->blk_i[n]  = i;
+                _q->blk_b[n]  = _q->b;
+                _q->blk_mu[n] = _q->mu;
+                n++;
+                RESAMP(_update_timing_state)(_q);
+            }
+        }
+
+        // decrement timing phase by one sample
+        _q->tau -= 1.0f;
+        _q->bf  -= (float)(_q->npfb);
+        _q->b   -= _q->npfb;
+    }
+
+    *_ny = n;
+    return i;
+}
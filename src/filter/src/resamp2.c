@@ -38,6 +38,10 @@
 //  DOTPROD()       dotprod macro
 //  PRINTVAL()      print macro
 
+// maximum number of samples per branch processed at once by the
+// block methods
+#define RESAMP2_BLOCK_LEN (256)
+
 struct RESAMP2(_s) {
     TC * h;                 // filter prototype
     unsigned int m;         // primitive filter length
@@ -56,8 +60,24 @@ struct RESAMP2(_s) {
 
     // halfband filter operation
     unsigned int toggle;
+
+    // contiguous branch buffers for block methods: filter history
+    // (2m samples) followed by a block of new samples
+    T * b0;                 // delay branch
+    T * b1;                 // filter branch
 };
 
+// compute filter branch outputs from contiguous buffer (internal)
+void RESAMP2(_branch_execute)(RESAMP2()    _q,
+                              T *          _b,
+                              unsigned int _n,
+                              TO *         _y,
+                              unsigned int _stride);
+
+// push the newest block samples onto the window buffers (internal)
+void RESAMP2(_update_windows)(RESAMP2()    _q,
+                              unsigned int _n);
+
 // create a resamp2 object
 //  _m      :   filter semi-length (effective length: 4*_m+1)
 //  _f0     :   center frequency of half-band filter
@@ -117,6 +137,10 @@ RESAMP2() RESAMP2(_create)(unsigned int _m,
     q->w0 = WINDOW(_create)(2*(q->m));
     q->w1 = WINDOW(_create)(2*(q->m));
 
+    // create block buffers
+    q->b0 = (T*) malloc((2*q->m + RESAMP2_BLOCK_LEN)*sizeof(T));
+    q->b1 = (T*) malloc((2*q->m + RESAMP2_BLOCK_LEN)*sizeof(T));
+
     RESAMP2(_clear)(q);
 
     return q;
@@ -180,6 +204,8 @@ void RESAMP2(_destroy)(RESAMP2() _q)
     // free arrays
     free(_q->h);
     free(_q->h1);
+    free(_q->b0);
+    free(_q->b1);
 
     // free main object memory
     free(_q);
@@ -358,3 +384,152 @@ void RESAMP2(_interp_execute)(RESAMP2() _q,
     DOTPROD(_execute)(_q->dp, r, &_y[1]);
 }
 
+// compute filter branch outputs from contiguous buffer
+//  _q      :   resamp2 object
+//  _b      :   branch buffer; output i uses _b[i+1 .. i+2m]
+//  _n      :   number of outputs
+//  _y      :   output array
+//  _stride :   output stride
+void RESAMP2(_branch_execute)(RESAMP2()    _q,
+                              T *          _b,
+                              unsigned int _n,
+                              TO *         _y,
+                              unsigned int _stride)
+{
+    unsigned int i;
+#if TC_COMPLEX == 0
+    // real coefficients: the filter branch is symmetric, so fold the
+    // buffer about its center (m multiplies per output) and compute
+    // four adjacent outputs per pass to share coefficient loads and
+    // keep accumulators in registers
+    unsigned int m  = _q->m;
+    unsigned int n2 = 2*m;
+    unsigned int j;
+
+    // t = 4*(floor(_n/4))
+    unsigned int t = (_n>>2)<<2;
+    for (i=0; i<t; i+=4) {
+        T * p = _b + i + 1;
+        TO y0 = 0;
+        TO y1 = 0;
+        TO y2 = 0;
+        TO y3 = 0;
+        for (j=0; j<m; j++) {
+            TC h = _q->h1[j];
+            y0 += h*(p[j  ] + p[n2-1-j]);
+            y1 += h*(p[j+1] + p[n2  -j]);
+            y2 += h*(p[j+2] + p[n2+1-j]);
+            y3 += h*(p[j+3] + p[n2+2-j]);
+        }
+        _y[ i   *_stride] = y0;
+        _y[(i+1)*_stride] = y1;
+        _y[(i+2)*_stride] = y2;
+        _y[(i+3)*_stride] = y3;
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++) {
+        T * p = _b + i + 1;
+        TO y0 = 0;
+        for (j=0; j<m; j++)
+            y0 += _q->h1[j]*(p[j] + p[n2-1-j]);
+        _y[i*_stride] = y0;
+    }
+#else
+    // complex coefficients are not symmetric; use dot product
+    for (i=0; i<_n; i++)
+        DOTPROD(_execute)(_q->dp, _b + i + 1, &_y[i*_stride]);
+#endif
+}
+
+// push the newest block samples onto the window buffers; only the
+// last 2m samples matter, so longer blocks are truncated
+//  _q      :   resamp2 object
+//  _n      :   number of new samples in block buffers
+void RESAMP2(_update_windows)(RESAMP2()    _q,
+                              unsigned int _n)
+{
+    unsigned int n2 = 2*_q->m;
+    unsigned int k  = _n < n2 ? _n : n2;
+    WINDOW(_write)(_q->w0, _q->b0 + n2 + _n - k, k);
+    WINDOW(_write)(_q->w1, _q->b1 + n2 + _n - k, k);
+}
+
+// execute half-band decimation on block of samples
+//  _q      :   resamp2 object
+//  _x      :   input array [size: 2*_n x 1]
+//  _n      :   number of output samples
+//  _y      :   output array [size: _n x 1]
+void RESAMP2(_decim_execute_block)(RESAMP2()    _q,
+                                   TI *         _x,
+                                   unsigned int _n,
+                                   TO *         _y)
+{
+    unsigned int n2 = 2*_q->m;
+    unsigned int i;
+    TI * r;
+    while (_n > 0) {
+        unsigned int n = _n < RESAMP2_BLOCK_LEN ? _n : RESAMP2_BLOCK_LEN;
+
+        // de-interleave input after branch histories: even samples
+        // feed the filter branch, odd samples the delay branch
+        WINDOW(_read)(_q->w0, &r);
+        memmove(_q->b0, r, n2*sizeof(T));
+        WINDOW(_read)(_q->w1, &r);
+        memmove(_q->b1, r, n2*sizeof(T));
+        for (i=0; i<n; i++) {
+            _q->b1[n2+i] = _x[2*i  ];
+            _q->b0[n2+i] = _x[2*i+1];
+        }
+
+        // filter branch, then add delay branch
+        RESAMP2(_branch_execute)(_q, _q->b1, n, _y, 1);
+        for (i=0; i<n; i++)
+            _y[i] += _q->b0[i + _q->m];
+
+        // retain most recent samples in window buffers
+        RESAMP2(_update_windows)(_q, n);
+
+        _x += 2*n;
+        _y += n;
+        _n -= n;
+    }
+}
+
+// execute half-band interpolation on block of samples
+//  _q      :   resamp2 object
+//  _x      :   input array [size: _n x 1]
+//  _n      :   number of input samples
+//  _y      :   output array [size: 2*_n x 1]
+void RESAMP2(_interp_execute_block)(RESAMP2()    _q,
+                                    TI *         _x,
+                                    unsigned int _n,
+                                    TO *         _y)
+{
+    unsigned int n2 = 2*_q->m;
+    unsigned int i;
+    TI * r;
+    while (_n > 0) {
+        unsigned int n = _n < RESAMP2_BLOCK_LEN ? _n : RESAMP2_BLOCK_LEN;
+
+        // both branches see the same input
+        WINDOW(_read)(_q->w0, &r);
+        memmove(_q->b0, r, n2*sizeof(T));
+        WINDOW(_read)(_q->w1, &r);
+        memmove(_q->b1, r, n2*sizeof(T));
+        memmove(_q->b0 + n2, _x, n*sizeof(T));
+        memmove(_q->b1 + n2, _x, n*sizeof(T));
+
+        // even outputs: delay branch; odd outputs: filter branch
+        for (i=0; i<n; i++)
+            _y[2*i] = _q->b0[i + _q->m];
+        RESAMP2(_branch_execute)(_q, _q->b1, n, _y+1, 2);
+
+        // retain most recent samples in window buffers
+        RESAMP2(_update_windows)(_q, n);
+
+        _x += n;
+        _y += 2*n;
+        _n -= n;
+    }
+}
@@ -138,7 +138,7 @@ void liquid_firdes_arkaiser(unsigned int _k,
 #endif
 
     // compute filter coefficients
-    liquid_firdes_kaiser(n,fc,As,_dt,_h);
+    liquid_firdes_kaiser_internal(n,fc,As,_dt,_h);
 
     // normalize coefficients
     float e2 = 0.0f;
@@ -504,7 +504,7 @@ float liquid_firdes_rkaiser_internal_isi(unsigned int _k,
     float isi_rms;
 
     // compute filter
-    liquid_firdes_kaiser(n,fc,As,_dt,_h);
+    liquid_firdes_kaiser_internal(n,fc,As,_dt,_h);
 
     // compute filter ISI
     liquid_filter_isi(_h,_k,_m,&isi_rms,&isi_max);
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2007 - 2015 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+//
+// Rational-rate resampler
+//
+// Resamples by the rational factor P/Q using a polyphase
+// filterbank with P branches. Because the output timing is
+// periodic with every Q input samples (P output samples), the
+// filterbank branch and the number of input samples to push
+// before each output are computed once at creation and the
+// resampler simply steps through this schedule for each block;
+// no timing state or interpolation between branches is needed.
+//
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+// defined:
+//  TO          output data type
+//  TC          coefficient data type
+//  TI          input data type
+//  RRESAMP()   name-mangling macro
+//  FIRPFB()    firpfb macro
+
+struct RRESAMP(_s) {
+    // filter design parameters
+    unsigned int P;     // interpolation factor (reduced)
+    unsigned int Q;     // decimation factor (reduced)
+    unsigned int m;     // filter semi-length, h_len = 2*P*m + 1
+    float        bw;    // filter bandwidth
+    float        As;    // filter stop-band attenuation
+
+    // precomputed schedule for one block of Q inputs, P outputs
+    unsigned int * branch;  // filterbank index for each output [size: P x 1]
+    unsigned int * num_push;// inputs to push before each output [size: P+1 x 1]
+
+    // polyphase filterbank object (interpolator)
+    FIRPFB() f;
+};
+
+// create rational-rate resampler object
+//  _P      : interpolation factor (output block size)
+//  _Q      : decimation factor (input block size)
+//  _m      : filter semi-length (delay) in input samples
+//  _bw     : filter bandwidth relative to lower of input/output rates
+//  _As     : filter stop-band attenuation [dB]
+RRESAMP() RRESAMP(_create)(unsigned int _P,
+                           unsigned int _Q,
+                           unsigned int _m,
+                           float        _bw,
+                           float        _As)
+{
+    // validate input
+    if (_P == 0) {
+        fprintf(stderr,"error: rresamp_%s_create(), interpolation rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_Q == 0) {
+        fprintf(stderr,"error: rresamp_%s_create(), decimation rate must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m == 0) {
+        fprintf(stderr,"error: rresamp_%s_create(), filter semi-length must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_bw <= 0.0f || _bw >= 0.5f) {
+        fprintf(stderr,"error: rresamp_%s_create(), filter bandwidth must be in (0,0.5)\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_As <= 0.0f) {
+        fprintf(stderr,"error: rresamp_%s_create(), filter stop-band suppression must be greater than zero\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // allocate memory for resampler
+    RRESAMP() q = (RRESAMP()) malloc(sizeof(struct RRESAMP(_s)));
+
+    // reduce rate by greatest common divisor
+    unsigned int g = liquid_gcd(_P, _Q);
+    q->P  = _P / g;
+    q->Q  = _Q / g;
+    q->m  = _m;
+    q->bw = _bw;
+    q->As = _As;
+
+    // design prototype filter at interpolated rate P*fs_in; cut-off
+    // is relative to the lower of the input and output rates
+    unsigned int n = 2*q->P*q->m + 1;
+    float fc = q->bw * (q->P < q->Q ? (float)q->P / (float)q->Q : 1.0f) / (float)q->P;
+    float hf[n];
+    liquid_firdes_kaiser(n, fc, q->As, 0.0f, hf);
+
+    // normalize filter coefficients by DC gain
+    unsigned int i;
+    float gain=0.0f;
+    for (i=0; i<n; i++)
+        gain += hf[i];
+    gain = (float)(q->P) / gain;
+
+    // copy to type-specific array, applying gain
+    TC h[n];
+    for (i=0; i<n; i++)
+        h[i] = hf[i]*gain;
+    q->f = FIRPFB(_create)(q->P, h, n-1);
+
+    // compute schedule: output k of each block is taken from
+    // interpolated sample k*Q which uses filterbank branch
+    // (k*Q mod P) after input floor(k*Q/P) has been pushed
+    q->branch   = (unsigned int*) malloc( q->P   *sizeof(unsigned int));
+    q->num_push = (unsigned int*) malloc((q->P+1)*sizeof(unsigned int));
+    unsigned long int index_prev = 0;
+    for (i=0; i<q->P; i++) {
+        unsigned long int t     = (unsigned long int)i * (unsigned long int)q->Q;
+        unsigned long int index = t / q->P + 1;    // number of inputs consumed
+        q->branch[i]   = (unsigned int)(t % q->P);
+        q->num_push[i] = (unsigned int)(index - index_prev);
+        index_prev     = index;
+    }
+    // remaining inputs pushed after the last output of the block
+    q->num_push[q->P] = q->Q - (unsigned int)index_prev;
+
+    // reset object and return
+    RRESAMP(_reset)(q);
+    return q;
+}
+
+// create rational-rate resampler object with default filter
+// parameters
+//  _P      : interpolation factor
+//  _Q      : decimation factor
+RRESAMP() RRESAMP(_create_default)(unsigned int _P,
+                                   unsigned int _Q)
+{
+    // set default parameters
+    unsigned int m  = 12;
+    float        bw = 0.45f;
+    float        As = 60.0f;
+
+    // create and return resamp object
+    return RRESAMP(_create)(_P, _Q, m, bw, As);
+}
+
+// destroy rational-rate resampler object
+void RRESAMP(_destroy)(RRESAMP() _q)
+{
+    // free polyphase filterbank
+    FIRPFB(_destroy)(_q->f);
+
+    // free schedule arrays
+    free(_q->branch);
+    free(_q->num_push);
+
+    // free main object memory
+    free(_q);
+}
+
+// print rational-rate resampler object
+void RRESAMP(_print)(RRESAMP() _q)
+{
+    printf("rresamp [rate: %u/%u = %f, m=%u, bw=%.3f, As=%.1f dB]\n",
+            _q->P, _q->Q, RRESAMP(_get_rate)(_q), _q->m, _q->bw, _q->As);
+}
+
+// reset rational-rate resampler object
+void RRESAMP(_reset)(RRESAMP() _q)
+{
+    // clear filterbank
+    FIRPFB(_reset)(_q->f);
+}
+
+// get resampler filter delay (semi-length m, input samples)
+unsigned int RRESAMP(_get_delay)(RRESAMP() _q)
+{
+    return _q->m;
+}
+
+// get (reduced) interpolation factor
+unsigned int RRESAMP(_get_P)(RRESAMP() _q)
+{
+    return _q->P;
+}
+
+// get (reduced) decimation factor
+unsigned int RRESAMP(_get_Q)(RRESAMP() _q)
+{
+    return _q->Q;
+}
+
+// get resampling rate, P/Q
+float RRESAMP(_get_rate)(RRESAMP() _q)
+{
+    return (float)(_q->P) / (float)(_q->Q);
+}
+
+// execute rational-rate resampler on a single block
+//  _q      : rresamp object
+//  _x      : input sample array  [size: Q x 1]
+//  _y      : output sample array [size: P x 1]
+void RRESAMP(_execute)(RRESAMP() _q,
+                       TI *      _x,
+                       TO *      _y)
+{
+    unsigned int i, j;
+    for (i=0; i<_q->P; i++) {
+        // push new input samples into filterbank
+        for (j=0; j<_q->num_push[i]; j++)
+            FIRPFB(_push)(_q->f, *_x++);
+
+        // compute output on scheduled branch
+        FIRPFB(_execute)(_q->f, _q->branch[i], &_y[i]);
+    }
+
+    // push remaining input samples
+    for (j=0; j<_q->num_push[_q->P]; j++)
+        FIRPFB(_push)(_q->f, *_x++);
+}
+
+// execute rational-rate resampler on a number of blocks
+//  _q      : rresamp object
+//  _x      : input sample array  [size: Q*_n x 1]
+//  _n      : number of blocks
+//  _y      : output sample array [size: P*_n x 1]
+void RRESAMP(_execute_block)(RRESAMP()    _q,
+                             TI *         _x,
+                             unsigned int _n,
+                             TO *         _y)
+{
+    unsigned int i;
+    for (i=0; i<_n; i++)
+        RRESAMP(_execute)(_q, &_x[i*_q->Q], &_y[i*_q->P]);
+}
+
@@ -288,6 +288,35 @@ SYMSYNC() SYMSYNC(_create_kaiser)(unsigned int _k,
     return SYMSYNC(_create)(_k, _M, H, H_len);
 }
 
+// create symsync sharing filterbank coefficients of existing object;
+// loop filter and rate settings are copied, internal state is reset
+SYMSYNC() SYMSYNC(_create_shared)(SYMSYNC() _q)
+{
+    // create main object, copying parameters
+    SYMSYNC() q = (SYMSYNC()) malloc(sizeof(struct SYMSYNC(_s)));
+    memmove(q, _q, sizeof(struct SYMSYNC(_s)));
+
+    // share filterbank coefficients, keeping buffers private
+    q->mf  = FIRPFB(_create_shared)(_q->mf);
+    q->dmf = FIRPFB(_create_shared)(_q->dmf);
+
+    // create loop filter from existing coefficients
+    q->pll = iirfiltsos_rrrf_create(q->B, q->A);
+
+#if DEBUG_SYMSYNC
+    q->debug_rate  = windowf_create(DEBUG_BUFFER_LEN);
+    q->debug_del   = windowf_create(DEBUG_BUFFER_LEN);
+    q->debug_tau   = windowf_create(DEBUG_BUFFER_LEN);
+    q->debug_bsoft = windowf_create(DEBUG_BUFFER_LEN);
+    q->debug_b     = windowf_create(DEBUG_BUFFER_LEN);
+    q->debug_q_hat = windowf_create(DEBUG_BUFFER_LEN);
+#endif
+
+    // reset state and return
+    SYMSYNC(_reset)(q);
+    return q;
+}
+
 // destroy symsync object, freeing all internal memory
 void SYMSYNC(_destroy)(SYMSYNC() _q)
 {
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST : multi-lag running sums and batch transform should match
+//            single-lag auto-correlator at each lag
+//
+void autocorr_cccf_test_multilag(unsigned int _window_size,
+                                 unsigned int _num_lags,
+                                 unsigned int _num_samples)
+{
+    float tol = 1e-3f * _window_size;
+    unsigned int i, d;
+
+    // create multi-lag object and one single-lag object per lag
+    autocorr_cccf q = autocorr_cccf_create_multilag(_window_size, _num_lags);
+    autocorr_cccf r[_num_lags];
+    for (d=0; d<_num_lags; d++)
+        r[d] = autocorr_cccf_create(_window_size, d);
+    CONTEND_EQUALITY( autocorr_cccf_get_num_lags(q), _num_lags );
+
+    float complex rxx0[_num_lags];  // single-lag outputs
+    float complex rxx1[_num_lags];  // running sums
+    float complex rxx2[_num_lags];  // batch transform
+    float complex rxx3;             // single-lag output of multi-lag object
+    for (i=0; i<_num_samples; i++) {
+        float complex x = cexpf(_Complex_I*(0.013f*i*i + 0.7f*i)) * (1.0f + 0.5f*cosf(0.03f*i));
+        autocorr_cccf_push(q, x);
+        for (d=0; d<_num_lags; d++)
+            autocorr_cccf_push(r[d], x);
+
+        // compare periodically
+        if ( (i % 37) != 0 && i != _num_samples-1)
+            continue;
+
+        for (d=0; d<_num_lags; d++)
+            autocorr_cccf_execute(r[d], &rxx0[d]);
+        autocorr_cccf_execute_lags(q, rxx1);
+        autocorr_cccf_execute_lags_fft(q, rxx2);
+        autocorr_cccf_execute(q, &rxx3);
+
+        for (d=0; d<_num_lags; d++) {
+            CONTEND_DELTA( crealf(rxx1[d]), crealf(rxx0[d]), tol );
+            CONTEND_DELTA( cimagf(rxx1[d]), cimagf(rxx0[d]), tol );
+            CONTEND_DELTA( crealf(rxx2[d]), crealf(rxx0[d]), tol );
+            CONTEND_DELTA( cimagf(rxx2[d]), cimagf(rxx0[d]), tol );
+        }
+        CONTEND_DELTA( crealf(rxx3), crealf(rxx0[_num_lags-1]), tol );
+        CONTEND_DELTA( cimagf(rxx3), cimagf(rxx0[_num_lags-1]), tol );
+    }
+
+    // reset and ensure running sums are cleared
+    autocorr_cccf_reset(q);
+    autocorr_cccf_execute_lags(q, rxx1);
+    for (d=0; d<_num_lags; d++)
+        CONTEND_EQUALITY( cabsf(rxx1[d]), 0.0f );
+
+    // clean up objects
+    autocorr_cccf_destroy(q);
+    for (d=0; d<_num_lags; d++)
+        autocorr_cccf_destroy(r[d]);
+}
+
+void autotest_autocorr_cccf_multilag_w16_l1()   { autocorr_cccf_test_multilag(16,   1,  200); }
+void autotest_autocorr_cccf_multilag_w16_l8()   { autocorr_cccf_test_multilag(16,   8,  200); }
+void autotest_autocorr_cccf_multilag_w64_l33()  { autocorr_cccf_test_multilag(64,  33, 1000); }
+void autotest_autocorr_cccf_multilag_w20_l40()  { autocorr_cccf_test_multilag(20,  40,  500); }
+
+// long run crossing several re-computation intervals
+void autotest_autocorr_cccf_multilag_long()     { autocorr_cccf_test_multilag(32,   4, 10000); }
+
+//
+// AUTOTEST : real multi-lag auto-correlator
+//
+void autotest_autocorr_rrrf_multilag()
+{
+    unsigned int window_size = 24;
+    unsigned int num_lags    = 12;
+    unsigned int i, d;
+
+    autocorr_rrrf q = autocorr_rrrf_create_multilag(window_size, num_lags);
+
+    float x[300];
+    float rxx1[num_lags];
+    float rxx2[num_lags];
+    for (i=0; i<300; i++) {
+        x[i] = cosf(0.1f*i) + 0.3f*sinf(0.77f*i*i);
+        autocorr_rrrf_push(q, x[i]);
+    }
+    autocorr_rrrf_execute_lags(q, rxx1);
+    autocorr_rrrf_execute_lags_fft(q, rxx2);
+
+    // compute expected values directly
+    for (d=0; d<num_lags; d++) {
+        float rxx = 0.0f;
+        for (i=0; i<window_size; i++)
+            rxx += x[299-i] * x[299-i-d];
+        CONTEND_DELTA( rxx1[d], rxx, 1e-3f );
+        CONTEND_DELTA( rxx2[d], rxx, 1e-3f );
+    }
+
+    autocorr_rrrf_destroy(q);
+}
+
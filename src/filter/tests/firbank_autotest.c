@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST : coefficient bank reference counting
+//
+void autotest_firbank_refcount()
+{
+    float h[48];
+    unsigned int i;
+    for (i=0; i<48; i++)
+        h[i] = cosf(0.1f*i) * expf(-0.05f*i);
+
+    // create bank and filterbank objects
+    firbank_crcf bank = firbank_crcf_create(4, h, 48);
+    CONTEND_EQUALITY( firbank_crcf_get_num_filters(bank),  4 );
+    CONTEND_EQUALITY( firbank_crcf_get_sub_len(bank),     12 );
+    CONTEND_EQUALITY( firbank_crcf_get_num_refs(bank),     1 );
+
+    firpfb_crcf q0 = firpfb_crcf_create_bank(bank);
+    CONTEND_EQUALITY( firbank_crcf_get_num_refs(bank),     2 );
+    firpfb_crcf q1 = firpfb_crcf_create_shared(q0);
+    CONTEND_EQUALITY( firbank_crcf_get_num_refs(bank),     3 );
+    CONTEND_EXPRESSION( firpfb_crcf_get_bank(q1) == bank );
+
+    // release local reference; bank persists while objects hold it
+    firbank_crcf_destroy(bank);
+    CONTEND_EQUALITY( firbank_crcf_get_num_refs(firpfb_crcf_get_bank(q1)), 2 );
+    firpfb_crcf_destroy(q0);
+    CONTEND_EQUALITY( firbank_crcf_get_num_refs(firpfb_crcf_get_bank(q1)), 1 );
+
+    // recreating with the same dimensions must not alter shared bank
+    firpfb_crcf q2 = firpfb_crcf_create_shared(q1);
+    for (i=0; i<48; i++)
+        h[i] = -h[i];
+    q2 = firpfb_crcf_recreate(q2, 4, h, 48);
+    CONTEND_EQUALITY( firbank_crcf_get_num_refs(firpfb_crcf_get_bank(q1)), 1 );
+    CONTEND_EQUALITY( firbank_crcf_get_num_refs(firpfb_crcf_get_bank(q2)), 1 );
+
+    float complex y1, y2;
+    firpfb_crcf_push(q1, 1.0f);
+    firpfb_crcf_push(q2, 1.0f);
+    firpfb_crcf_execute(q1, 2, &y1);
+    firpfb_crcf_execute(q2, 2, &y2);
+    CONTEND_DELTA( crealf(y1), -crealf(y2), 1e-6f );
+
+    firpfb_crcf_destroy(q1);
+    firpfb_crcf_destroy(q2);
+}
+
+// 
+// AUTOTEST : objects sharing coefficients produce outputs identical
+//            to independently created objects
+//
+void autotest_firbank_shared()
+{
+    unsigned int k  = 4;    // samples/symbol, decimation/interpolation
+    unsigned int m  = 3;    // filter delay
+    unsigned int nx = 96;   // number of input samples
+    float tol = 1e-6f;
+
+    unsigned int i, j;
+    float complex x[nx];
+    for (i=0; i<nx; i++)
+        x[i] = cexpf(_Complex_I*0.013f*(float)(i*i)) * (1.0f + 0.3f*sinf(0.2f*i));
+
+    // interpolator: independent vs shared instance
+    firinterp_crcf interp0 = firinterp_crcf_create_prototype(LIQUID_FIRFILT_RRC,k,m,0.3f,0);
+    firinterp_crcf interp1 = firinterp_crcf_create_prototype(LIQUID_FIRFILT_RRC,k,m,0.3f,0);
+    firinterp_crcf interp2 = firinterp_crcf_create_shared(interp1);
+    float complex y0[k], y2[k];
+    firinterp_crcf_execute(interp1, x[0], y0);  // disturb original state
+    for (i=0; i<nx; i++) {
+        firinterp_crcf_execute(interp0, x[i], y0);
+        firinterp_crcf_execute(interp2, x[i], y2);
+        for (j=0; j<k; j++) {
+            CONTEND_DELTA( crealf(y2[j]), crealf(y0[j]), tol );
+            CONTEND_DELTA( cimagf(y2[j]), cimagf(y0[j]), tol );
+        }
+    }
+    firinterp_crcf_destroy(interp1);    // shared object outlives original
+    firinterp_crcf_execute(interp2, x[0], y2);
+    firinterp_crcf_destroy(interp0);
+    firinterp_crcf_destroy(interp2);
+
+    // decimator: independent vs shared instance
+    firdecim_crcf decim0 = firdecim_crcf_create_kaiser(k, m, 60.0f);
+    firdecim_crcf decim1 = firdecim_crcf_create_kaiser(k, m, 60.0f);
+    firdecim_crcf decim2 = firdecim_crcf_create_shared(decim1);
+    firdecim_crcf_destroy(decim1);
+    float complex v0, v2;
+    for (i=0; i<nx/k; i++) {
+        firdecim_crcf_execute(decim0, &x[i*k], &v0);
+        firdecim_crcf_execute(decim2, &x[i*k], &v2);
+        CONTEND_DELTA( crealf(v2), crealf(v0), tol );
+        CONTEND_DELTA( cimagf(v2), cimagf(v0), tol );
+    }
+    firdecim_crcf_destroy(decim0);
+    firdecim_crcf_destroy(decim2);
+
+    // symbol synchronizer: independent vs shared instance
+    symsync_crcf sync0 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_RRC,2,m,0.3f,16);
+    symsync_crcf sync1 = symsync_crcf_create_rnyquist(LIQUID_FIRFILT_RRC,2,m,0.3f,16);
+    symsync_crcf_set_lf_bw(sync0, 0.02f);
+    symsync_crcf_set_lf_bw(sync1, 0.02f);
+    symsync_crcf sync2 = symsync_crcf_create_shared(sync1);
+    symsync_crcf_destroy(sync1);
+    float complex s0[nx], s2[nx];
+    unsigned int n0, n2;
+    symsync_crcf_execute(sync0, x, nx, s0, &n0);
+    symsync_crcf_execute(sync2, x, nx, s2, &n2);
+    CONTEND_EQUALITY( n2, n0 );
+    for (i=0; i<n0 && i<n2; i++) {
+        CONTEND_DELTA( crealf(s2[i]), crealf(s0[i]), tol );
+        CONTEND_DELTA( cimagf(s2[i]), cimagf(s0[i]), tol );
+    }
+    symsync_crcf_destroy(sync0);
+    symsync_crcf_destroy(sync2);
+}
+
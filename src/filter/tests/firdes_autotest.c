@@ -118,3 +118,67 @@ void autotest_liquid_firdes_rkaiser()
 }
 
 
+
+// 
+// AUTOTEST: design cache returns shared designs identical to
+//           running the design directly
+//
+void autotest_liquid_firdes_cache()
+{
+    unsigned int k = 4;
+    unsigned int m = 9;
+    float beta = 0.3f;
+    unsigned int h_len = 2*k*m+1;
+    unsigned int i;
+
+    liquid_firdes_cache_clear();
+    CONTEND_EQUALITY( liquid_firdes_cache_get_num_entries(), 0 );
+    CONTEND_EQUALITY( liquid_firdes_cache_get_num_bytes(),   0 );
+
+    // prototype design: same parameters return same array
+    const float * h0 = liquid_firdes_cache_prototype(LIQUID_FIRFILT_RKAISER, k, m, beta, 0.0f);
+    const float * h1 = liquid_firdes_cache_prototype(LIQUID_FIRFILT_RKAISER, k, m, beta, 0.0f);
+    CONTEND_EXPRESSION( h0 != NULL );
+    CONTEND_EXPRESSION( h0 == h1 );
+
+    // different parameters return different design
+    const float * h2 = liquid_firdes_cache_prototype(LIQUID_FIRFILT_RKAISER, k, m, beta, 0.1f);
+    CONTEND_EXPRESSION( h2 != h0 );
+
+    // compare with direct design
+    float h[h_len];
+    liquid_firdes_rkaiser(k, m, beta, 0.0f, h);
+    for (i=0; i<h_len; i++)
+        CONTEND_EQUALITY( h0[i], h[i] );
+
+    // kaiser design through public method uses cache
+    float g[51];
+    liquid_firdes_kaiser(51, 0.2f, 60.0f, 0.0f, g);
+    const float * g0 = liquid_firdes_cache_kaiser(51, 0.2f, 60.0f, 0.0f);
+    for (i=0; i<51; i++)
+        CONTEND_EQUALITY( g0[i], g[i] );
+    CONTEND_EQUALITY( liquid_firdes_cache_get_num_entries(), 3 );
+    CONTEND_EQUALITY( liquid_firdes_cache_get_num_bytes(), (2*h_len + 51)*sizeof(float) );
+
+    // referenced arrays remain valid after the cache is cleared
+    liquid_firdes_cache_clear();
+    CONTEND_EQUALITY( liquid_firdes_cache_get_num_entries(), 0 );
+    for (i=0; i<h_len; i++)
+        CONTEND_EQUALITY( h0[i], h[i] );
+    liquid_firdes_cache_release(h0);
+    liquid_firdes_cache_release(h1);
+    liquid_firdes_cache_release(h2);
+    liquid_firdes_cache_release(g0);
+
+    // with caching disabled designs are returned but not stored
+    liquid_firdes_cache_set_max_bytes(0);
+    h0 = liquid_firdes_cache_prototype(LIQUID_FIRFILT_RKAISER, k, m, beta, 0.0f);
+    h1 = liquid_firdes_cache_prototype(LIQUID_FIRFILT_RKAISER, k, m, beta, 0.0f);
+    CONTEND_EXPRESSION( h0 != h1 );
+    CONTEND_EQUALITY( liquid_firdes_cache_get_num_entries(), 0 );
+    for (i=0; i<h_len; i++)
+        CONTEND_EQUALITY( h1[i], h[i] );
+    liquid_firdes_cache_release(h0);
+    liquid_firdes_cache_release(h1);
+    liquid_firdes_cache_set_max_bytes(1<<20);
+}
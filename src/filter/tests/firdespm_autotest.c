@@ -145,3 +145,45 @@ void autotest_firdespm_bandpass_n32()
         CONTEND_DELTA( h[i], h0[i], tol );
 }
 
+
+// 
+// AUTOTEST: long filter design (adaptive grid), single- and
+//           multi-threaded error evaluation should agree
+//
+void autotest_firdespm_long()
+{
+    // options
+    unsigned int n = 1201;  // filter length (grid large enough for 2 threads)
+    float ft = 4.0f / (float)n;
+    unsigned int num_bands = 2;
+    float bands[4]   = {0.0f, 0.2f - 0.5f*ft, 0.2f + 0.5f*ft, 0.5f};
+    float des[2]     = {1.0f, 0.0f};
+    float weights[2] = {1.0f, 1.0f};
+    liquid_firdespm_btype btype = LIQUID_FIRDESPM_BANDPASS;
+
+    float h0[n];
+    float h1[n];
+    firdespm q = firdespm_create(n,num_bands,bands,des,weights,NULL,btype);
+    firdespm_execute(q, h0);
+    firdespm_set_num_threads(q, 4);
+    firdespm_execute(q, h1);
+    firdespm_destroy(q);
+
+    // check stop-band attenuation at a few frequencies
+    unsigned int i;
+    float f;
+    float H_max = 0.0f;
+    for (f=bands[2]; f<=0.5f; f+=0.0037f) {
+        float complex H = 0.0f;
+        for (i=0; i<n; i++)
+            H += h0[i] * cexpf(-_Complex_I*2*M_PI*f*i);
+        H_max = cabsf(H) > H_max ? cabsf(H) : H_max;
+    }
+    if (liquid_autotest_verbose)
+        printf("  stop-band : %8.2f dB\n", 20*log10f(H_max));
+    CONTEND_LESS_THAN( 20*log10f(H_max), -60.0f );
+
+    // threaded design should be identical
+    for (i=0; i<n; i++)
+        CONTEND_EQUALITY( h1[i], h0[i] );
+}
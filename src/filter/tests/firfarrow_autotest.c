@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST : Farrow structure (sub-filters combined with Horner's
+//            rule) should match evaluating the taps for each delay
+//
+void firfarrow_crcf_test_farrow(unsigned int _h_len,
+                                unsigned int _Q)
+{
+    unsigned int n  = 200;      // number of samples
+    float        fc = 0.45f;    // filter cut-off
+    float        As = 60.0f;    // stop-band attenuation [dB]
+    unsigned int i;
+
+    firfarrow_crcf q0 = firfarrow_crcf_create(_h_len, _Q, fc, As);
+    firfarrow_crcf q1 = firfarrow_crcf_create(_h_len, _Q, fc, As);
+
+    for (i=0; i<n; i++) {
+        float complex x = cexpf(_Complex_I*0.0031f*i*i);
+        float mu = 0.95f*sinf(0.13f*i);
+
+        // evaluate taps, then filter
+        float complex y0;
+        firfarrow_crcf_push(q0, x);
+        firfarrow_crcf_set_delay(q0, mu);
+        firfarrow_crcf_execute(q0, &y0);
+
+        // Farrow structure
+        float complex y1;
+        firfarrow_crcf_push(q1, x);
+        firfarrow_crcf_execute_farrow(q1, mu, &y1);
+
+        CONTEND_DELTA( crealf(y1), crealf(y0), 1e-5f );
+        CONTEND_DELTA( cimagf(y1), cimagf(y0), 1e-5f );
+    }
+
+    firfarrow_crcf_destroy(q0);
+    firfarrow_crcf_destroy(q1);
+}
+
+void autotest_firfarrow_crcf_farrow_h19_Q5()  { firfarrow_crcf_test_farrow(19, 5); }
+void autotest_firfarrow_crcf_farrow_h32_Q3()  { firfarrow_crcf_test_farrow(32, 3); }
+
+// 
+// AUTOTEST : quantized delay cache should reproduce the evaluated
+//            taps at the nearest grid point
+//
+void autotest_firfarrow_rrrf_delay_cache()
+{
+    unsigned int h_len = 17;
+    unsigned int Q     = 4;
+    unsigned int n     = 65;    // number of cached delay values
+    unsigned int i, k;
+
+    firfarrow_rrrf q0 = firfarrow_rrrf_create(h_len, Q, 0.4f, 60.0f);
+    firfarrow_rrrf q1 = firfarrow_rrrf_create(h_len, Q, 0.4f, 60.0f);
+    firfarrow_rrrf_set_delay_cache(q1, n);
+
+    float h0[h_len];
+    float h1[h_len];
+    for (k=0; k<100; k++) {
+        float mu = -1.0f + 2.0f*k/99.0f;
+
+        // nearest grid point
+        float mu_q = -1.0f + 2.0f*roundf(0.5f*(mu+1.0f)*(n-1))/(float)(n-1);
+
+        firfarrow_rrrf_set_delay(q0, mu_q);
+        firfarrow_rrrf_set_delay(q1, mu);
+        firfarrow_rrrf_get_coefficients(q0, h0);
+        firfarrow_rrrf_get_coefficients(q1, h1);
+        for (i=0; i<h_len; i++)
+            CONTEND_DELTA( h1[i], h0[i], 1e-6f );
+    }
+
+    // disabling cache returns to evaluated taps
+    firfarrow_rrrf_set_delay_cache(q1, 0);
+    firfarrow_rrrf_set_delay(q0, 0.1234f);
+    firfarrow_rrrf_set_delay(q1, 0.1234f);
+    firfarrow_rrrf_get_coefficients(q0, h0);
+    firfarrow_rrrf_get_coefficients(q1, h1);
+    for (i=0; i<h_len; i++)
+        CONTEND_EQUALITY( h1[i], h0[i] );
+
+    firfarrow_rrrf_destroy(q0);
+    firfarrow_rrrf_destroy(q1);
+}
@@ -0,0 +1,187 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST : multi-channel filter should produce the same output as
+//            independent filters on each channel
+//
+void firfiltmc_crcf_test(unsigned int _num_channels,
+                         unsigned int _h_len,
+                         int          _planar)
+{
+    unsigned int C  = _num_channels;
+    unsigned int n  = 3*_h_len + 7;     // samples per channel
+    float        tol = 1e-5f;
+    unsigned int i, c;
+
+    // design filter
+    float h[_h_len];
+    for (i=0; i<_h_len; i++)
+        h[i] = cosf(0.3f*i) * (1.0f + 0.1f*i);
+
+    // generate input: interleaved or planar
+    float complex x[n*C];
+    float complex y[n*C];
+    for (i=0; i<n; i++) {
+        for (c=0; c<C; c++) {
+            unsigned int index = _planar ? c*n + i : i*C + c;
+            x[index] = cexpf(_Complex_I*(0.01f*(c+1)*i*i + 0.7f*c));
+        }
+    }
+
+    // run multi-channel filter
+    firfiltmc_crcf q = firfiltmc_crcf_create(C, h, _h_len);
+    firfiltmc_crcf_set_scale(q, 0.5f);
+    if (_planar)
+        firfiltmc_crcf_execute_block_planar(q, x, n, y);
+    else
+        firfiltmc_crcf_execute_block(q, x, n, y);
+    CONTEND_EQUALITY( firfiltmc_crcf_get_num_channels(q), C );
+    CONTEND_EQUALITY( firfiltmc_crcf_get_length(q), _h_len );
+    firfiltmc_crcf_destroy(q);
+
+    // compare to individual filters
+    for (c=0; c<C; c++) {
+        firfilt_crcf f = firfilt_crcf_create(h, _h_len);
+        firfilt_crcf_set_scale(f, 0.5f);
+        for (i=0; i<n; i++) {
+            unsigned int index = _planar ? c*n + i : i*C + c;
+            float complex y_test;
+            firfilt_crcf_push(f, x[index]);
+            firfilt_crcf_execute(f, &y_test);
+
+            CONTEND_DELTA( crealf(y[index]), crealf(y_test), tol );
+            CONTEND_DELTA( cimagf(y[index]), cimagf(y_test), tol );
+        }
+        firfilt_crcf_destroy(f);
+    }
+}
+
+// 
+// AUTOTEST : multi-channel decimator should produce the same output
+//            as independent decimators on each channel
+//
+void firdecimmc_crcf_test(unsigned int _num_channels,
+                          unsigned int _M,
+                          unsigned int _h_len,
+                          int          _planar)
+{
+    unsigned int C  = _num_channels;
+    unsigned int n  = 2*_h_len + 5;     // output samples per channel
+    unsigned int nx = n*_M;             // input samples per channel
+    float        tol = 1e-5f;
+    unsigned int i, c;
+
+    // design filter
+    float h[_h_len];
+    for (i=0; i<_h_len; i++)
+        h[i] = sinf(0.2f*i + 0.1f) / (1.0f + 0.05f*i);
+
+    // generate input: interleaved or planar
+    float complex x[nx*C];
+    float complex y[n*C];
+    for (i=0; i<nx; i++) {
+        for (c=0; c<C; c++) {
+            unsigned int index = _planar ? c*nx + i : i*C + c;
+            x[index] = cexpf(_Complex_I*(0.013f*(c+2)*i*i - 0.3f*c));
+        }
+    }
+
+    // run multi-channel decimator
+    firdecimmc_crcf q = firdecimmc_crcf_create(C, _M, h, _h_len);
+    if (_planar)
+        firdecimmc_crcf_execute_block_planar(q, x, n, y);
+    else
+        firdecimmc_crcf_execute_block(q, x, n, y);
+    firdecimmc_crcf_destroy(q);
+
+    // compare to individual decimators
+    float complex xc[_M];
+    for (c=0; c<C; c++) {
+        firdecim_crcf d = firdecim_crcf_create(_M, h, _h_len);
+        for (i=0; i<n; i++) {
+            unsigned int k;
+            for (k=0; k<_M; k++)
+                xc[k] = _planar ? x[c*nx + i*_M + k] : x[(i*_M + k)*C + c];
+
+            float complex y_test;
+            firdecim_crcf_execute(d, xc, &y_test);
+
+            unsigned int index = _planar ? c*n + i : i*C + c;
+            CONTEND_DELTA( crealf(y[index]), crealf(y_test), tol );
+            CONTEND_DELTA( cimagf(y[index]), cimagf(y_test), tol );
+        }
+        firdecim_crcf_destroy(d);
+    }
+}
+
+void autotest_firfiltmc_crcf_c1_h1()            { firfiltmc_crcf_test( 1,  1, 0); }
+void autotest_firfiltmc_crcf_c4_h7()            { firfiltmc_crcf_test( 4,  7, 0); }
+void autotest_firfiltmc_crcf_c16_h5()           { firfiltmc_crcf_test(16,  5, 0); }
+void autotest_firfiltmc_crcf_c5_h33()           { firfiltmc_crcf_test( 5, 33, 0); }
+void autotest_firfiltmc_crcf_c4_h7_planar()     { firfiltmc_crcf_test( 4,  7, 1); }
+void autotest_firfiltmc_crcf_c13_h21_planar()   { firfiltmc_crcf_test(13, 21, 1); }
+
+void autotest_firdecimmc_crcf_c4_M2_h9()        { firdecimmc_crcf_test( 4, 2,  9, 0); }
+void autotest_firdecimmc_crcf_c7_M5_h31()       { firdecimmc_crcf_test( 7, 5, 31, 0); }
+void autotest_firdecimmc_crcf_c4_M3_h12_planar(){ firdecimmc_crcf_test( 4, 3, 12, 1); }
+
+// 
+// AUTOTEST : multi-channel real filter with complex coefficients
+//            (cccf) against individual filters
+//
+void autotest_firfiltmc_cccf()
+{
+    unsigned int C = 3;
+    unsigned int h_len = 6;
+    unsigned int n = 20;
+    unsigned int i, c;
+
+    float complex h[h_len];
+    for (i=0; i<h_len; i++)
+        h[i] = cexpf(_Complex_I*0.4f*i) / (float)(i+1);
+
+    float complex x[n*C];
+    float complex y[n*C];
+    for (i=0; i<n*C; i++)
+        x[i] = cexpf(_Complex_I*0.0137f*i*i);
+
+    firfiltmc_cccf q = firfiltmc_cccf_create(C, h, h_len);
+    firfiltmc_cccf_execute_block(q, x, n, y);
+    firfiltmc_cccf_destroy(q);
+
+    for (c=0; c<C; c++) {
+        firfilt_cccf f = firfilt_cccf_create(h, h_len);
+        for (i=0; i<n; i++) {
+            float complex y_test;
+            firfilt_cccf_push(f, x[i*C+c]);
+            firfilt_cccf_execute(f, &y_test);
+            CONTEND_DELTA( crealf(y[i*C+c]), crealf(y_test), 1e-5f );
+            CONTEND_DELTA( cimagf(y[i*C+c]), cimagf(y_test), 1e-5f );
+        }
+        firfilt_cccf_destroy(f);
+    }
+}
+
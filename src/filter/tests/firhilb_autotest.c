@@ -115,3 +115,70 @@ void autotest_firhilbf_interp()
     firhilbf_destroy(ht);
 }
 
+// 
+// AUTOTEST: block methods (frequency-domain for long filters) should
+//           produce the same output as running one sample at a time
+//
+void firhilbf_test_block(unsigned int _m,
+                         unsigned int _block_len)
+{
+    unsigned int n   = 3000;    // number of real-valued samples
+    float        tol = 2e-5f;   // error tolerance
+    unsigned int i, j;
+
+    float x[n];
+    for (i=0; i<n; i++)
+        x[i] = cosf(0.0013f*i*i) + 0.5f*sinf(0.37f*i) + 0.1f*cosf(2.1f*i);
+
+    // real to complex
+    firhilbf q0 = firhilbf_create(_m, 60.0f);
+    firhilbf q1 = firhilbf_create(_m, 60.0f);
+    float complex y0[n], y1[n];
+    for (i=0; i<n; i++)
+        firhilbf_r2c_execute(q0, x[i], &y0[i]);
+    for (i=0; i<n; i+=_block_len) {
+        j = i + _block_len > n ? n - i : _block_len;
+        firhilbf_r2c_execute_block(q1, &x[i], j, &y1[i]);
+    }
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    // decimator
+    firhilbf_reset(q0);
+    firhilbf_reset(q1);
+    for (i=0; i<n/2; i++)
+        firhilbf_decim_execute(q0, &x[2*i], &y0[i]);
+    for (i=0; i<n/2; i+=_block_len) {
+        j = i + _block_len > n/2 ? n/2 - i : _block_len;
+        firhilbf_decim_execute_block(q1, &x[2*i], j, &y1[i]);
+    }
+    for (i=0; i<n/2; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    // interpolator (using decimator output as input)
+    firhilbf_reset(q0);
+    firhilbf_reset(q1);
+    float z0[n], z1[n];
+    for (i=0; i<n/2; i++)
+        firhilbf_interp_execute(q0, y0[i], &z0[2*i]);
+    for (i=0; i<n/2; i+=_block_len) {
+        j = i + _block_len > n/2 ? n/2 - i : _block_len;
+        firhilbf_interp_execute_block(q1, &y0[i], j, &z1[2*i]);
+    }
+    for (i=0; i<n; i++)
+        CONTEND_DELTA( z1[i], z0[i], tol );
+
+    firhilbf_destroy(q0);
+    firhilbf_destroy(q1);
+}
+
+void autotest_firhilbf_block_m5_n37()     { firhilbf_test_block(  5,   37); }
+void autotest_firhilbf_block_m90_n1()     { firhilbf_test_block( 90,    1); }
+void autotest_firhilbf_block_m90_n517()   { firhilbf_test_block( 90,  517); }
+void autotest_firhilbf_block_m90_n3000()  { firhilbf_test_block( 90, 3000); }
+void autotest_firhilbf_block_m120_n1201() { firhilbf_test_block(120, 1201); }
+
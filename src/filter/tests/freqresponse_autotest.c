@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare grid evaluation of FIR response against single-frequency
+// evaluation
+void freqresponse_test_fir_grid(unsigned int _h_len,
+                                float        _f0,
+                                float        _df,
+                                unsigned int _n)
+{
+    float tol = 2e-4f * _h_len;
+    unsigned int i;
+
+    float h[_h_len];
+    for (i=0; i<_h_len; i++)
+        h[i] = cosf(0.7f*i) * expf(-0.01f*i) + 0.1f*sinf(0.05f*i*i);
+
+    float complex H[_n];
+    liquid_freqrespf_grid(h, _h_len, _f0, _df, _n, H);
+
+    float complex H0;
+    for (i=0; i<_n; i++) {
+        liquid_freqrespf(h, _h_len, _f0 + i*_df, &H0);
+        CONTEND_DELTA( crealf(H[i]), crealf(H0), tol );
+        CONTEND_DELTA( cimagf(H[i]), cimagf(H0), tol );
+    }
+}
+
+// direct evaluation, DFT grids (zero-padded, time-aliased), chirp-z
+void autotest_freqresponse_fir_direct()   { freqresponse_test_fir_grid(  5, -0.5f,  1/256.0f, 256); }
+void autotest_freqresponse_fir_fft()      { freqresponse_test_fir_grid( 81, -0.5f,  1/512.0f, 512); }
+void autotest_freqresponse_fir_fft_part() { freqresponse_test_fir_grid( 81,  0.1f,  1/300.0f,  77); }
+void autotest_freqresponse_fir_alias()    { freqresponse_test_fir_grid(101,  0.0f,  1/ 16.0f,  16); }
+void autotest_freqresponse_fir_czt()      { freqresponse_test_fir_grid(121,  0.1f,  3e-4f,    300); }
+
+//
+// AUTOTEST : filter object grid methods
+//
+void autotest_freqresponse_objects()
+{
+    float tol = 1e-3f;
+    unsigned int n = 200;
+    float f0 = -0.45f;
+    float df = 0.9f / (float)n;
+    unsigned int i;
+    float complex H[n], H0;
+    float gd[n], gd0;
+
+    // FIR filter
+    firfilt_crcf qf = firfilt_crcf_create_kaiser(51, 0.2f, 60.0f, 0.3f);
+    firfilt_crcf_set_scale(qf, 2.0f);
+    firfilt_crcf_freqresponse_grid(qf, f0, df, n, H);
+    firfilt_crcf_groupdelay_grid  (qf, f0, df, n, gd);
+    for (i=0; i<n; i++) {
+        firfilt_crcf_freqresponse(qf, f0 + i*df, &H0);
+        CONTEND_DELTA( crealf(H[i]), crealf(H0), tol );
+        CONTEND_DELTA( cimagf(H[i]), cimagf(H0), tol );
+    }
+    for (i=0; i<n; i++) {
+        // compare away from stop-band nulls
+        firfilt_crcf_freqresponse(qf, f0 + i*df, &H0);
+        if (cabsf(H0) < 0.1f) continue;
+        gd0 = firfilt_crcf_groupdelay(qf, f0 + i*df);
+        CONTEND_DELTA( gd[i], gd0, 0.01f );
+    }
+    firfilt_crcf_destroy(qf);
+
+    // IIR filter (transfer function and second-order sections)
+    unsigned int order = 7;
+    float B[3*4], A[3*4];
+    float b[order+1], a[order+1];
+    liquid_iirdes(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS,
+                  order, 0.1f, 0.0f, 1.0f, 60.0f, B, A);
+    liquid_iirdes(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_TF,
+                  order, 0.1f, 0.0f, 1.0f, 60.0f, b, a);
+    iirfilt_crcf q[2];
+    q[0] = iirfilt_crcf_create(b, order+1, a, order+1);
+    q[1] = iirfilt_crcf_create_sos(B, A, 4);
+    unsigned int k;
+    for (k=0; k<2; k++) {
+        iirfilt_crcf_freqresponse_grid(q[k], f0, df, n, H);
+        iirfilt_crcf_groupdelay_grid  (q[k], f0, df, n, gd);
+        for (i=0; i<n; i++) {
+            iirfilt_crcf_freqresponse(q[k], f0 + i*df, &H0);
+            gd0 = iirfilt_crcf_groupdelay(q[k], f0 + i*df);
+            CONTEND_DELTA( crealf(H[i]), crealf(H0), tol );
+            CONTEND_DELTA( cimagf(H[i]), cimagf(H0), tol );
+            CONTEND_DELTA( gd[i], gd0, 0.01f*(1.0f + fabsf(gd0)) );
+        }
+        iirfilt_crcf_destroy(q[k]);
+    }
+
+    // functional forms match object methods
+    float complex Hsos[n];
+    liquid_freqrespf_iir_grid(b, order+1, a, order+1, f0, df, n, H);
+    liquid_freqrespf_sos_grid(B, A, 4, f0, df, n, Hsos);
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(H[i]), crealf(Hsos[i]), tol );
+        CONTEND_DELTA( cimagf(H[i]), cimagf(Hsos[i]), tol );
+    }
+}
+
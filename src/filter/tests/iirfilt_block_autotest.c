@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST : block state-space mode should match the sample-by-sample
+//            recursion for filters designed by iirdes; the input is
+//            processed in irregular block sizes (exercising partial
+//            blocks), interspersed with single-sample calls, and then
+//            left to ring down to verify that the block recursion
+//            remains stable
+//
+void iirfilt_crcf_test_block(liquid_iirdes_filtertype _ftype,
+                             liquid_iirdes_bandtype   _btype,
+                             unsigned int             _order,
+                             unsigned int             _block_len,
+                             int                      _double_state)
+{
+    unsigned int n   = 1200;    // number of samples with input
+    unsigned int nz  = 4000;    // number of zero-valued samples
+    float        fc  = 0.15f;   // cut-off frequency
+    float        f0  = 0.25f;   // center frequency (band-pass)
+    float        Ap  = 1.0f;    // pass-band ripple [dB]
+    float        As  = 60.0f;   // stop-band attenuation [dB]
+    float        tol = 2e-4f;
+    unsigned int i;
+
+    // create identical filters
+    iirfilt_crcf q0 = iirfilt_crcf_create_prototype(_ftype, _btype,
+            LIQUID_IIRDES_SOS, _order, fc, f0, Ap, As);
+    iirfilt_crcf q1 = iirfilt_crcf_create_prototype(_ftype, _btype,
+            LIQUID_IIRDES_SOS, _order, fc, f0, Ap, As);
+    iirfilt_crcf_set_block_mode(q1, _block_len, _double_state);
+
+    // generate input: chirp followed by zeros
+    unsigned int nx = n + nz;
+    float complex * x  = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(nx*sizeof(float complex));
+    for (i=0; i<nx; i++)
+        x[i] = i < n ? cexpf(_Complex_I*0.5f*M_PI*i*i/(float)n) : 0.0f;
+
+    // reference: run sample by sample
+    for (i=0; i<nx; i++)
+        iirfilt_crcf_execute(q0, x[i], &y0[i]);
+
+    // run in irregular blocks, with an occasional single sample
+    unsigned int block_sizes[] = {37, 1, 64, 0, 5, 129};
+    unsigned int k = 0;
+    i = 0;
+    while (i < nx) {
+        unsigned int b = block_sizes[k++ % 6];
+        if (b == 0) {
+            iirfilt_crcf_execute(q1, x[i], &y1[i]);
+            i++;
+            continue;
+        }
+        if (i + b > nx) b = nx - i;
+        iirfilt_crcf_execute_block(q1, &x[i], b, &y1[i]);
+        i += b;
+    }
+
+    // compare results, scaling tolerance by peak reference level
+    float rmax = 0.0f;
+    float emax = 0.0f;
+    for (i=0; i<nx; i++) {
+        float r = cabsf(y0[i]);
+        float e = cabsf(y1[i] - y0[i]);
+        rmax = r > rmax ? r : rmax;
+        emax = e > emax ? e : emax;
+    }
+    float tail = cabsf(y1[nx-1]);
+
+    if (liquid_autotest_verbose) {
+        printf("  iirfilt block, type=%d, band=%d, order=%u, L=%3u, %s : err=%12.4e, tail=%12.4e\n",
+                _ftype, _btype, _order, _block_len, _double_state ? "double" : "float ",
+                emax/rmax, tail);
+    }
+    CONTEND_LESS_THAN( emax, tol*rmax );
+
+    // filter must have rung down after long run of zeros
+    CONTEND_LESS_THAN( tail, 1e-3f*rmax );
+
+    // clean up allocated objects
+    iirfilt_crcf_destroy(q0);
+    iirfilt_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_iirfilt_crcf_block_butter_lp7_L8()    { iirfilt_crcf_test_block(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS,  7,  8, 0); }
+void autotest_iirfilt_crcf_block_butter_lp7_L16d()  { iirfilt_crcf_test_block(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS,  7, 16, 1); }
+void autotest_iirfilt_crcf_block_cheby1_lp6_L8()    { iirfilt_crcf_test_block(LIQUID_IIRDES_CHEBY1, LIQUID_IIRDES_LOWPASS,  6,  8, 0); }
+void autotest_iirfilt_crcf_block_cheby2_lp6_L32d()  { iirfilt_crcf_test_block(LIQUID_IIRDES_CHEBY2, LIQUID_IIRDES_LOWPASS,  6, 32, 1); }
+void autotest_iirfilt_crcf_block_ellip_lp7_L16()    { iirfilt_crcf_test_block(LIQUID_IIRDES_ELLIP,  LIQUID_IIRDES_LOWPASS,  7, 16, 0); }
+void autotest_iirfilt_crcf_block_ellip_lp7_L64d()   { iirfilt_crcf_test_block(LIQUID_IIRDES_ELLIP,  LIQUID_IIRDES_LOWPASS,  7, 64, 1); }
+void autotest_iirfilt_crcf_block_ellip_bp4_L8()     { iirfilt_crcf_test_block(LIQUID_IIRDES_ELLIP,  LIQUID_IIRDES_BANDPASS, 4,  8, 0); }
+void autotest_iirfilt_crcf_block_bessel_lp5_L16()   { iirfilt_crcf_test_block(LIQUID_IIRDES_BESSEL, LIQUID_IIRDES_LOWPASS,  5, 16, 0); }
+
+// 
+// AUTOTEST : block mode on normal-form DC blocker (real)
+//
+void autotest_iirfilt_rrrf_block_dc_blocker()
+{
+    unsigned int n = 300;
+    float alpha = 0.02f;
+    unsigned int i;
+
+    iirfilt_rrrf q0 = iirfilt_rrrf_create_dc_blocker(alpha);
+    iirfilt_rrrf q1 = iirfilt_rrrf_create_dc_blocker(alpha);
+    iirfilt_rrrf_set_block_mode(q1, 16, 0);
+
+    float x[n];
+    float y0[n];
+    float y1[n];
+    for (i=0; i<n; i++)
+        x[i] = 2.0f + cosf(0.37f*i);
+
+    for (i=0; i<n; i++)
+        iirfilt_rrrf_execute(q0, x[i], &y0[i]);
+    iirfilt_rrrf_execute_block(q1, x, 100, y1);
+    iirfilt_rrrf_execute_block(q1, &x[100], n-100, &y1[100]);
+
+    for (i=0; i<n; i++)
+        CONTEND_DELTA( y1[i], y0[i], 1e-4f );
+
+    iirfilt_rrrf_destroy(q0);
+    iirfilt_rrrf_destroy(q1);
+}
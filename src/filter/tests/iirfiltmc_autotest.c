@@ -0,0 +1,157 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST : multi-channel IIR filter should produce the same output
+//            as independent filters on each channel
+//
+void iirfiltmc_crcf_test(unsigned int             _num_channels,
+                         liquid_iirdes_filtertype _ftype,
+                         unsigned int             _order,
+                         int                      _planar)
+{
+    unsigned int C   = _num_channels;
+    unsigned int n   = 80;              // samples per channel
+    float        fc  = 0.1f;            // cut-off frequency
+    float        Ap  = 1.0f;            // pass-band ripple [dB]
+    float        As  = 60.0f;           // stop-band attenuation [dB]
+    float        tol = 1e-4f;
+    unsigned int i, c;
+
+    // generate input: interleaved or planar
+    float complex x[n*C];
+    float complex y[n*C];
+    for (i=0; i<n; i++) {
+        for (c=0; c<C; c++) {
+            unsigned int index = _planar ? c*n + i : i*C + c;
+            x[index] = cexpf(_Complex_I*(0.005f*(c+1)*i*i + 0.7f*c));
+        }
+    }
+
+    // run multi-channel filter
+    iirfiltmc_crcf q = iirfiltmc_crcf_create_prototype(C,
+            _ftype, LIQUID_IIRDES_LOWPASS, _order, fc, 0.0f, Ap, As);
+    if (_planar)
+        iirfiltmc_crcf_execute_block_planar(q, x, n, y);
+    else
+        iirfiltmc_crcf_execute_block(q, x, n, y);
+    CONTEND_EQUALITY( iirfiltmc_crcf_get_num_channels(q), C );
+    CONTEND_EQUALITY( iirfiltmc_crcf_get_num_sections(q), (_order+1)/2 );
+    iirfiltmc_crcf_destroy(q);
+
+    // compare to individual filters
+    for (c=0; c<C; c++) {
+        iirfilt_crcf f = iirfilt_crcf_create_prototype(
+                _ftype, LIQUID_IIRDES_LOWPASS, LIQUID_IIRDES_SOS,
+                _order, fc, 0.0f, Ap, As);
+        for (i=0; i<n; i++) {
+            unsigned int index = _planar ? c*n + i : i*C + c;
+            float complex y_test;
+            iirfilt_crcf_execute(f, x[index], &y_test);
+
+            CONTEND_DELTA( crealf(y[index]), crealf(y_test), tol );
+            CONTEND_DELTA( cimagf(y[index]), cimagf(y_test), tol );
+        }
+        iirfilt_crcf_destroy(f);
+    }
+}
+
+void autotest_iirfiltmc_crcf_c1_butter4()       { iirfiltmc_crcf_test( 1, LIQUID_IIRDES_BUTTER, 4, 0); }
+void autotest_iirfiltmc_crcf_c4_cheby1_5()      { iirfiltmc_crcf_test( 4, LIQUID_IIRDES_CHEBY1, 5, 0); }
+void autotest_iirfiltmc_crcf_c16_ellip6()       { iirfiltmc_crcf_test(16, LIQUID_IIRDES_ELLIP,  6, 0); }
+void autotest_iirfiltmc_crcf_c7_butter3_planar(){ iirfiltmc_crcf_test( 7, LIQUID_IIRDES_BUTTER, 3, 1); }
+
+// 
+// AUTOTEST : multi-channel DC blocker (real) against individual
+//            DC-blocking filters, running in place
+//
+void autotest_iirfiltmc_rrrf_dc_blocker()
+{
+    unsigned int C = 8;
+    unsigned int n = 64;
+    float alpha = 0.05f;
+    unsigned int i, c;
+
+    float x[n*C];
+    float y[n*C];
+    for (i=0; i<n; i++) {
+        for (c=0; c<C; c++)
+            x[i*C+c] = 1.0f + c + cosf(0.3f*i + c);
+    }
+    memmove(y, x, sizeof(x));
+
+    iirfiltmc_rrrf q = iirfiltmc_rrrf_create_dc_blocker(C, alpha);
+    iirfiltmc_rrrf_execute_block(q, y, n, y);
+    iirfiltmc_rrrf_destroy(q);
+
+    for (c=0; c<C; c++) {
+        iirfilt_rrrf f = iirfilt_rrrf_create_dc_blocker(alpha);
+        for (i=0; i<n; i++) {
+            float y_test;
+            iirfilt_rrrf_execute(f, x[i*C+c], &y_test);
+            CONTEND_DELTA( y[i*C+c], y_test, 1e-5f );
+        }
+        iirfilt_rrrf_destroy(f);
+    }
+}
+
+// 
+// AUTOTEST : multi-channel filter with complex coefficients (cccf)
+//            against individual filters
+//
+void autotest_iirfiltmc_cccf()
+{
+    unsigned int C = 3;
+    unsigned int nsos = 2;
+    unsigned int n = 40;
+    unsigned int i, c;
+
+    // two sections with complex poles well inside the unit circle
+    float complex B[6] = { 0.2f, 0.1f*_Complex_I, 0.05f,
+                           1.0f, -0.3f,           0.2f*_Complex_I };
+    float complex A[6] = { 1.0f, -0.5f*cexpf(_Complex_I*0.3f), 0.1f,
+                           2.0f, 0.4f*_Complex_I,              0.2f };
+
+    float complex x[n*C];
+    float complex y[n*C];
+    for (i=0; i<n*C; i++)
+        x[i] = cexpf(_Complex_I*0.0137f*i*i);
+
+    iirfiltmc_cccf q = iirfiltmc_cccf_create_sos(C, B, A, nsos);
+    iirfiltmc_cccf_execute_block(q, x, n, y);
+    iirfiltmc_cccf_destroy(q);
+
+    for (c=0; c<C; c++) {
+        iirfilt_cccf f = iirfilt_cccf_create_sos(B, A, nsos);
+        for (i=0; i<n; i++) {
+            float complex y_test;
+            iirfilt_cccf_execute(f, x[i*C+c], &y_test);
+            CONTEND_DELTA( crealf(y[i*C+c]), crealf(y_test), 1e-5f );
+            CONTEND_DELTA( cimagf(y[i*C+c]), cimagf(y_test), 1e-5f );
+        }
+        iirfilt_cccf_destroy(f);
+    }
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+//
+// AUTOTEST : fixed-point cascade should track floating-point filter
+//            to within a few least-significant bits
+//
+void iirfiltq15_test_prototype(liquid_iirdes_filtertype _ftype,
+                               liquid_iirdes_bandtype   _btype,
+                               unsigned int             _order,
+                               unsigned int             _ef_order)
+{
+    float fc = 0.1f;
+    float f0 = 0.25f;
+    float Ap = 0.5f;
+    float As = 60.0f;
+    unsigned int num_samples = 2000;
+
+    iirfiltq15   q = iirfiltq15_create_prototype(1,_ftype,_btype,_order,fc,f0,Ap,As);
+    iirfilt_rrrf f = iirfilt_rrrf_create_prototype(_ftype,_btype,LIQUID_IIRDES_SOS,_order,fc,f0,Ap,As);
+    iirfiltq15_set_error_feedback(q, _ef_order);
+
+    unsigned int i;
+    float rmse = 0.0f;
+    for (i=0; i<num_samples; i++) {
+        // multi-tone input well below full scale
+        float v = 6000.0f*cosf(0.05f*i) + 4000.0f*cosf(1.3f*i + 0.2f) + 3000.0f*sinf(0.7f*i);
+        int16_t x = (int16_t) lroundf(v);
+
+        int16_t y;
+        float   yf;
+        iirfiltq15_execute(q, &x, &y);
+        iirfilt_rrrf_execute(f, (float)x, &yf);
+
+        rmse += (y - yf)*(y - yf);
+    }
+    rmse = sqrtf(rmse / (float)num_samples);
+
+    if (liquid_autotest_verbose) {
+        iirfiltq15_print(q);
+        printf("  rms error : %12.6f LSB\n", rmse);
+    }
+    CONTEND_LESS_THAN( rmse, 4.0f );
+
+    iirfiltq15_destroy(q);
+    iirfilt_rrrf_destroy(f);
+}
+
+void autotest_iirfiltq15_butter_lowpass()   { iirfiltq15_test_prototype(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_LOWPASS,  4, 0); }
+void autotest_iirfiltq15_cheby1_lowpass()   { iirfiltq15_test_prototype(LIQUID_IIRDES_CHEBY1, LIQUID_IIRDES_LOWPASS,  5, 1); }
+void autotest_iirfiltq15_ellip_lowpass()    { iirfiltq15_test_prototype(LIQUID_IIRDES_ELLIP,  LIQUID_IIRDES_LOWPASS,  6, 2); }
+void autotest_iirfiltq15_butter_bandpass()  { iirfiltq15_test_prototype(LIQUID_IIRDES_BUTTER, LIQUID_IIRDES_BANDPASS, 3, 1); }
+
+//
+// AUTOTEST : DC blocker with error feedback removes DC entirely;
+//            without it, rounding leaves a dead band of up to
+//            0.5/alpha about zero
+//
+void autotest_iirfiltq15_dc_blocker()
+{
+    float alpha = 0.01f;
+    unsigned int num_samples = 4000;
+
+    // filters with and without error feedback
+    iirfiltq15 q0 = iirfiltq15_create_dc_blocker(1, alpha);
+    iirfiltq15 q1 = iirfiltq15_create_dc_blocker(1, alpha);
+    iirfiltq15_set_error_feedback(q0, 0);
+
+    // step input, measuring residual output once settled
+    unsigned int i;
+    float ymean0 = 0.0f;
+    float ymean1 = 0.0f;
+    for (i=0; i<num_samples; i++) {
+        int16_t x = 1000;
+        int16_t y0, y1;
+        iirfiltq15_execute(q0, &x, &y0);
+        iirfiltq15_execute(q1, &x, &y1);
+        if (i >= num_samples - 1000) {
+            ymean0 += y0;
+            ymean1 += y1;
+        }
+    }
+    ymean0 /= 1000.0f;
+    ymean1 /= 1000.0f;
+
+    if (liquid_autotest_verbose) {
+        printf("  dc blocker output mean (no feedback) : %12.6f\n", ymean0);
+        printf("  dc blocker output mean (feedback)    : %12.6f\n", ymean1);
+    }
+    CONTEND_LESS_THAN( fabsf(ymean1), 0.5f );
+    CONTEND_LESS_THAN( fabsf(ymean1), fabsf(ymean0) );
+
+    iirfiltq15_destroy(q0);
+    iirfiltq15_destroy(q1);
+}
+
+//
+// AUTOTEST : interleaved channels (e.g. cs16 I/Q) are filtered
+//            independently and identically
+//
+void autotest_iirfiltq15_channels()
+{
+    // seven channels run through groups of 4, 2 and 1 lanes
+    unsigned int num_channels = 7;
+    unsigned int num_samples  = 500;
+
+    iirfiltq15 q = iirfiltq15_create_prototype(num_channels,
+            LIQUID_IIRDES_CHEBY2, LIQUID_IIRDES_LOWPASS, 5, 0.2f, 0.0f, 1.0f, 60.0f);
+    iirfiltq15_set_error_feedback(q, 1);
+    CONTEND_EQUALITY( iirfiltq15_get_num_channels(q), num_channels );
+
+    // single-channel reference filters
+    iirfiltq15 qc[num_channels];
+    unsigned int i, c;
+    for (c=0; c<num_channels; c++) {
+        qc[c] = iirfiltq15_create_prototype(1,
+            LIQUID_IIRDES_CHEBY2, LIQUID_IIRDES_LOWPASS, 5, 0.2f, 0.0f, 1.0f, 60.0f);
+        iirfiltq15_set_error_feedback(qc[c], 1);
+    }
+
+    // interleaved chirps with a different phase on each channel
+    int16_t x[num_channels*num_samples];
+    int16_t y[num_channels*num_samples];
+    for (i=0; i<num_samples; i++) {
+        for (c=0; c<num_channels; c++)
+            x[num_channels*i+c] = (int16_t) lroundf(9000.0f*cosf(0.1f*i*i/(float)num_samples + 0.9f*c));
+    }
+    iirfiltq15_execute_block(q, x, num_samples, y);
+
+    for (i=0; i<num_samples; i++) {
+        for (c=0; c<num_channels; c++) {
+            int16_t yc;
+            iirfiltq15_execute(qc[c], &x[num_channels*i+c], &yc);
+            CONTEND_EQUALITY( y[num_channels*i+c], yc );
+        }
+    }
+
+    iirfiltq15_destroy(q);
+    for (c=0; c<num_channels; c++)
+        iirfiltq15_destroy(qc[c]);
+}
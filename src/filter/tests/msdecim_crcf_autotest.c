@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// design final-stage filter for tests (unity DC gain)
+void msdecim_crcf_test_design(unsigned int _D,
+                              unsigned int _h_len,
+                              float *      _h)
+{
+    liquid_firdes_kaiser(_h_len, 0.4f/(float)_D, 60.0f, 0.0f, _h);
+    float hsum = 0.0f;
+    unsigned int i;
+    for (i=0; i<_h_len; i++) hsum += _h[i];
+    for (i=0; i<_h_len; i++) _h[i] /= hsum;
+}
+
+// 
+// AUTOTEST : a tone in the pass band should emerge with unity gain
+//            and with phase consistent with the reported group delay;
+//            a tone aliasing into the pass band should be suppressed
+//
+void msdecim_crcf_test_tone(unsigned int _num_stages,
+                            unsigned int _D)
+{
+    unsigned int h_len = 12*_D + 1;
+    float h[h_len];
+    msdecim_crcf_test_design(_D, h_len, h);
+
+    msdecim_crcf q0 = msdecim_crcf_create(_num_stages, 0.4f, 60.0f, _D, h, h_len);
+    msdecim_crcf q1 = msdecim_crcf_create(_num_stages, 0.4f, 60.0f, _D, h, h_len);
+    unsigned int M = msdecim_crcf_get_decim_rate(q0);
+    float delay = msdecim_crcf_get_delay(q0);
+    CONTEND_EQUALITY( M, (1u<<_num_stages)*_D );
+
+    unsigned int ny = 40 + (unsigned int)(delay / M);
+    unsigned int nx = ny*M;
+    float complex * x0 = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * x1 = (float complex*) malloc(nx*sizeof(float complex));
+    float complex y0[ny];
+    float complex y1[ny];
+
+    // pass-band tone at 0.1 cycles/output sample; stop-band tone
+    // that aliases onto the same output frequency
+    float f0 = 0.1f / (float)M;
+    float f1 = 1.1f / (float)M;
+    unsigned int i;
+    for (i=0; i<nx; i++) {
+        x0[i] = cexpf(_Complex_I*2*M_PI*f0*i);
+        x1[i] = cexpf(_Complex_I*2*M_PI*f1*i);
+    }
+    msdecim_crcf_execute_block(q0, x0, ny, y0);
+    msdecim_crcf_execute_block(q1, x1, ny, y1);
+
+    // compare steady-state outputs
+    float emax = 0.0f;
+    float amax = 0.0f;
+    for (i=ny-32; i<ny; i++) {
+        float complex y_exp = cexpf(_Complex_I*2*M_PI*f0*((float)(i*M) - delay));
+        float e = cabsf(y0[i] - y_exp);
+        float a = cabsf(y1[i]);
+        emax = e > emax ? e : emax;
+        amax = a > amax ? a : amax;
+    }
+    if (liquid_autotest_verbose) {
+        printf("  msdecim stages=%u, D=%u, M=%u, delay=%.1f : error=%12.4e, alias=%8.2f dB\n",
+                _num_stages, _D, M, delay, emax, 20*log10f(amax));
+    }
+    CONTEND_LESS_THAN( emax, 0.02f );
+    CONTEND_LESS_THAN( amax, 0.003f );
+
+    msdecim_crcf_destroy(q0);
+    msdecim_crcf_destroy(q1);
+    free(x0);
+    free(x1);
+}
+
+void autotest_msdecim_crcf_tone_s1_D1()  { msdecim_crcf_test_tone(1, 1); }
+void autotest_msdecim_crcf_tone_s4_D3()  { msdecim_crcf_test_tone(4, 3); }
+void autotest_msdecim_crcf_tone_s6_D2()  { msdecim_crcf_test_tone(6, 2); }
+void autotest_msdecim_crcf_tone_s10_D1() { msdecim_crcf_test_tone(10, 1); }
+
+// 
+// AUTOTEST : block execution with irregular sizes should produce
+//            identical results to running one output at a time
+//
+void autotest_msdecim_crcf_block()
+{
+    unsigned int num_stages = 3;
+    unsigned int D = 5;
+    unsigned int h_len = 41;
+    float h[h_len];
+    msdecim_crcf_test_design(D, h_len, h);
+
+    msdecim_crcf q0 = msdecim_crcf_create(num_stages, 0.35f, 70.0f, D, h, h_len);
+    msdecim_crcf q1 = msdecim_crcf_create(num_stages, 0.35f, 70.0f, D, h, h_len);
+    unsigned int M = msdecim_crcf_get_decim_rate(q0);
+
+    unsigned int ny = 300;
+    unsigned int nx = ny*M;
+    float complex * x = (float complex*) malloc(nx*sizeof(float complex));
+    float complex y0[ny];
+    float complex y1[ny];
+    unsigned int i;
+    for (i=0; i<nx; i++)
+        x[i] = cexpf(_Complex_I*0.00003f*(float)i*(float)i);
+
+    for (i=0; i<ny; i++)
+        msdecim_crcf_execute(q0, &x[i*M], &y0[i]);
+
+    unsigned int sizes[] = {1, 7, 100, 3, 64};
+    unsigned int k = 0;
+    i = 0;
+    while (i < ny) {
+        unsigned int n = sizes[k++ % 5];
+        n = i + n > ny ? ny - i : n;
+        msdecim_crcf_execute_block(q1, &x[i*M], n, &y1[i]);
+        i += n;
+    }
+
+    for (i=0; i<ny; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), 1e-6f );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), 1e-6f );
+    }
+
+    msdecim_crcf_destroy(q0);
+    msdecim_crcf_destroy(q1);
+    free(x);
+}
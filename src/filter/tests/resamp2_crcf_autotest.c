@@ -173,3 +173,107 @@ void autotest_resamp2_synthesis()
     printf("results written to '%s'\n","resamp2_test.m");
 #endif
 }
+
+// 
+// AUTOTEST : block decimation/interpolation should match running
+//            the half-band resampler one sample at a time
+//
+void resamp2_crcf_test_block(unsigned int _m,
+                             float        _f0,
+                             unsigned int _block_len)
+{
+    unsigned int n = 600;   // number of output (decim) / input (interp) samples
+    float As = 60.0f;       // stop-band attenuation [dB]
+    float tol = 1e-5f;      // error tolerance
+
+    unsigned int i;
+
+    float complex x[2*n];   // input signal
+    float complex y0[2*n];  // single-sample output
+    float complex y1[2*n];  // block output
+    for (i=0; i<2*n; i++)
+        x[i] = cexpf(_Complex_I*0.0013f*(float)(i*i)) * (1.0f + 0.2f*cosf(0.1f*i));
+
+    // decimator
+    resamp2_crcf q0 = resamp2_crcf_create(_m,_f0,As);
+    resamp2_crcf q1 = resamp2_crcf_create(_m,_f0,As);
+    for (i=0; i<n; i++)
+        resamp2_crcf_decim_execute(q0, &x[2*i], &y0[i]);
+    for (i=0; i<n; i+=_block_len) {
+        unsigned int k = i + _block_len > n ? n - i : _block_len;
+        resamp2_crcf_decim_execute_block(q1, &x[2*i], k, &y1[i]);
+    }
+    for (i=0; i<n; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    // interpolator (continue using same objects after reset)
+    resamp2_crcf_clear(q0);
+    resamp2_crcf_clear(q1);
+    for (i=0; i<n; i++)
+        resamp2_crcf_interp_execute(q0, x[i], &y0[2*i]);
+    for (i=0; i<n; i+=_block_len) {
+        unsigned int k = i + _block_len > n ? n - i : _block_len;
+        resamp2_crcf_interp_execute_block(q1, &x[i], k, &y1[2*i]);
+    }
+    for (i=0; i<2*n; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    resamp2_crcf_destroy(q0);
+    resamp2_crcf_destroy(q1);
+}
+
+void autotest_resamp2_crcf_block_m2_n1()    { resamp2_crcf_test_block( 2, 0.0f,    1); }
+void autotest_resamp2_crcf_block_m5_n7()    { resamp2_crcf_test_block( 5, 0.0f,    7); }
+void autotest_resamp2_crcf_block_m7_n600()  { resamp2_crcf_test_block( 7, 0.0f,  600); }
+void autotest_resamp2_crcf_block_m12_n33()  { resamp2_crcf_test_block(12, 0.1f,   33); }
+
+// 
+// AUTOTEST : multi-stage half-band resampler, block execution
+//            should match frame-by-frame execution
+//
+void msresamp2_crcf_test_block(int          _type,
+                               unsigned int _num_stages,
+                               unsigned int _block_len)
+{
+    unsigned int num_frames = 100;
+    unsigned int M = 1 << _num_stages;
+    unsigned int nx = _type == LIQUID_RESAMP_INTERP ? num_frames : num_frames*M;
+    unsigned int ny = _type == LIQUID_RESAMP_INTERP ? num_frames*M : num_frames;
+    unsigned int mx = _type == LIQUID_RESAMP_INTERP ? 1 : M;    // input per frame
+    unsigned int my = _type == LIQUID_RESAMP_INTERP ? M : 1;    // output per frame
+    float tol = 1e-5f;
+
+    unsigned int i;
+    float complex x[nx];
+    float complex y0[ny];
+    float complex y1[ny];
+    for (i=0; i<nx; i++)
+        x[i] = cexpf(_Complex_I*0.0007f*(float)(i*i));
+
+    msresamp2_crcf q0 = msresamp2_crcf_create(_type, _num_stages, 0.4f, 0.0f, 60.0f);
+    msresamp2_crcf q1 = msresamp2_crcf_create(_type, _num_stages, 0.4f, 0.0f, 60.0f);
+
+    for (i=0; i<num_frames; i++)
+        msresamp2_crcf_execute(q0, &x[i*mx], &y0[i*my]);
+    for (i=0; i<num_frames; i+=_block_len) {
+        unsigned int k = i + _block_len > num_frames ? num_frames - i : _block_len;
+        msresamp2_crcf_execute_block(q1, &x[i*mx], k, &y1[i*my]);
+    }
+
+    for (i=0; i<ny; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), tol );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), tol );
+    }
+
+    msresamp2_crcf_destroy(q0);
+    msresamp2_crcf_destroy(q1);
+}
+
+void autotest_msresamp2_crcf_decim_block_s3()  { msresamp2_crcf_test_block(LIQUID_RESAMP_DECIM,  3, 17); }
+void autotest_msresamp2_crcf_decim_block_s6()  { msresamp2_crcf_test_block(LIQUID_RESAMP_DECIM,  6, 100); }
+void autotest_msresamp2_crcf_interp_block_s3() { msresamp2_crcf_test_block(LIQUID_RESAMP_INTERP, 3, 17); }
+void autotest_msresamp2_crcf_interp_block_s6() { msresamp2_crcf_test_block(LIQUID_RESAMP_INTERP, 6, 100); }
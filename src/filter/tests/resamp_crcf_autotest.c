@@ -165,3 +165,72 @@ void autotest_resamp_crcf()
     printf("results written to %s\n",filename);
 #endif
 }
+
+// 
+// AUTOTEST : block execution should produce identical results to
+//            running the resampler one sample at a time
+//
+void resamp_crcf_test_block(float        _r,
+                            unsigned int _block_len)
+{
+    // options
+    unsigned int m    = 7;      // filter semi-length
+    float        bw   = 0.4f;   // filter bandwidth
+    float        As   = 60.0f;  // filter stop-band attenuation [dB]
+    unsigned int npfb = 32;     // number of filters in bank
+    unsigned int nx   = 700;    // number of input samples
+
+    unsigned int i;
+
+    // buffers with extra padding
+    unsigned int y_len = (unsigned int) ceilf(1.1 * nx * _r) + 4;
+    float complex x[nx];
+    float complex y0[y_len];    // single-sample output
+    float complex y1[y_len];    // block output
+    for (i=0; i<nx; i++)
+        x[i] = cexpf(_Complex_I*0.0071f*(float)(i*i)) * (1.0f + 0.2f*cosf(0.1f*i));
+
+    // create resamplers
+    resamp_crcf q0 = resamp_crcf_create(_r,m,bw,As,npfb);
+    resamp_crcf q1 = resamp_crcf_create(_r,m,bw,As,npfb);
+
+    // run single-sample resampler
+    unsigned int n0 = 0;
+    unsigned int nw;
+    for (i=0; i<nx; i++) {
+        resamp_crcf_execute(q0, x[i], &y0[n0], &nw);
+        n0 += nw;
+    }
+
+    // run block resampler with varying block sizes
+    unsigned int n1 = 0;
+    unsigned int nx1 = 0;
+    while (nx1 < nx) {
+        unsigned int n = nx1 + _block_len > nx ? nx - nx1 : _block_len;
+        resamp_crcf_execute_block(q1, &x[nx1], n, &y1[n1], &nw);
+        nx1 += n;
+        n1  += nw;
+    }
+
+    // clean up allocated objects
+    resamp_crcf_destroy(q0);
+    resamp_crcf_destroy(q1);
+
+    if (liquid_autotest_verbose)
+        printf("  resamp block, r=%8.5f, block=%4u : %u/%u samples\n", _r, _block_len, n1, n0);
+
+    // compare results
+    CONTEND_EQUALITY( n1, n0 );
+    for (i=0; i<n0 && i<n1; i++) {
+        CONTEND_DELTA( crealf(y1[i]), crealf(y0[i]), 1e-6f );
+        CONTEND_DELTA( cimagf(y1[i]), cimagf(y0[i]), 1e-6f );
+    }
+}
+
+void autotest_resamp_crcf_block_r0p3_n1()   { resamp_crcf_test_block(0.3123f,   1); }
+void autotest_resamp_crcf_block_r0p3_n700() { resamp_crcf_test_block(0.3123f, 700); }
+void autotest_resamp_crcf_block_r1p0_n33()  { resamp_crcf_test_block(1.0f,     33); }
+void autotest_resamp_crcf_block_r1p3_n17()  { resamp_crcf_test_block(1.2711f,  17); }
+void autotest_resamp_crcf_block_r1p3_n700() { resamp_crcf_test_block(1.2711f, 700); }
+void autotest_resamp_crcf_block_r7p1_n64()  { resamp_crcf_test_block(7.1234f,  64); }
+
@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// 
+// AUTOTEST : test rational-rate resampler against direct evaluation
+//            of the up-sample, filter, down-sample chain
+//
+void rresamp_crcf_test(unsigned int _P,
+                       unsigned int _Q,
+                       unsigned int _m)
+{
+    // options
+    float        bw  = 0.4f;    // resampling filter bandwidth
+    float        As  = 60.0f;   // resampling filter stop-band attenuation [dB]
+    unsigned int num_blocks = 4;// number of blocks to run
+    float        tol = 1e-4f;   // error tolerance
+
+    unsigned int i, k;
+
+    // create resampler
+    rresamp_crcf q = rresamp_crcf_create(_P,_Q,_m,bw,As);
+    unsigned int P = rresamp_crcf_get_P(q);
+    unsigned int Q = rresamp_crcf_get_Q(q);
+
+    // design reference filter at interpolated rate
+    unsigned int h_len = 2*P*_m + 1;
+    float fc = bw * (P < Q ? (float)P / (float)Q : 1.0f) / (float)P;
+    float h[h_len];
+    liquid_firdes_kaiser(h_len, fc, As, 0.0f, h);
+    float gain = 0.0f;
+    for (i=0; i<h_len; i++)
+        gain += h[i];
+    for (i=0; i<h_len; i++)
+        h[i] *= (float)P / gain;
+
+    // generate input signal (chirp)
+    unsigned int nx = num_blocks*Q;
+    unsigned int ny = num_blocks*P;
+    float complex x[nx];
+    float complex y[ny];
+    for (i=0; i<nx; i++)
+        x[i] = cexpf(_Complex_I*0.0173f*(float)(i*i));
+
+    // run resampler: first block individually, remaining as a block
+    rresamp_crcf_execute(q, x, y);
+    rresamp_crcf_execute_block(q, &x[Q], num_blocks-1, &y[P]);
+    rresamp_crcf_destroy(q);
+
+    // compare to direct computation; output n is interpolated
+    // sample n*Q, ignoring the last tap which firpfb discards
+    for (i=0; i<ny; i++) {
+        float complex y_test = 0.0f;
+        unsigned int t = i*Q;
+        for (k=0; k<=t/P; k++) {
+            unsigned int index = t - k*P;
+            if (index < h_len-1)
+                y_test += h[index] * x[k];
+        }
+
+        if (liquid_autotest_verbose) {
+            printf("  y[%3u] = %12.8f + j%12.8f (expected %12.8f + j%12.8f)\n",
+                    i, crealf(y[i]), cimagf(y[i]), crealf(y_test), cimagf(y_test));
+        }
+        CONTEND_DELTA( crealf(y[i]), crealf(y_test), tol );
+        CONTEND_DELTA( cimagf(y[i]), cimagf(y_test), tol );
+    }
+}
+
+void autotest_rresamp_crcf_P1_Q1()      { rresamp_crcf_test(  1,  1, 7); }
+void autotest_rresamp_crcf_P3_Q1()      { rresamp_crcf_test(  3,  1, 7); }
+void autotest_rresamp_crcf_P1_Q4()      { rresamp_crcf_test(  1,  4, 7); }
+void autotest_rresamp_crcf_P6_Q4()      { rresamp_crcf_test(  6,  4, 5); }
+void autotest_rresamp_crcf_P5_Q7()      { rresamp_crcf_test(  5,  7, 9); }
+void autotest_rresamp_crcf_P147_Q160()  { rresamp_crcf_test(147,160, 4); }
+
@@ -215,3 +215,22 @@ unsigned int liquid_totient(unsigned int _n)
     return t;
 }
 
+
+// compute greatest common divisor of _p and _q using
+// Euclid's algorithm
+unsigned int liquid_gcd(unsigned int _p,
+                        unsigned int _q)
+{
+    // validate input
+    if (_p == 0 || _q == 0) {
+        fprintf(stderr,"error: liquid_gcd(%u,%u), input cannot be zero\n", _p, _q);
+        exit(1);
+    }
+
+    while (_q > 0) {
+        unsigned int r = _p % _q;
+        _p = _q;
+        _q = r;
+    }
+    return _p;
+}
@@ -20,6 +20,7 @@
  * THE SOFTWARE.
  */
 
+#include <stdlib.h>
 #include <sys/resource.h>
 #include "liquid.h"
 
@@ -66,6 +67,50 @@ void firpfbch2_crcf_execute_bench(struct rusage *     _start,
     firpfbch2_crcf_destroy(q);
 }
 
+#define FIRPFBCH2_BLOCK_BENCH_API(NUM_CHANNELS,M,K)         \
+(   struct rusage *_start,                                  \
+    struct rusage *_finish,                                 \
+    unsigned long int *_num_iterations)                     \
+{ firpfbch2_crcf_block_bench(_start, _finish, _num_iterations, NUM_CHANNELS, M, K); }
+
+// Helper function to benchmark analyzer block execution
+void firpfbch2_crcf_block_bench(struct rusage *     _start,
+                                struct rusage *     _finish,
+                                unsigned long int * _num_iterations,
+                                unsigned int        _num_channels,
+                                unsigned int        _m,
+                                unsigned int        _num_hops)
+{
+    // initialize channelizer
+    float As         = 60.0f;
+    firpfbch2_crcf q = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER,_num_channels,_m,As);
+
+    unsigned long int i;
+
+    unsigned int nx = _num_hops * _num_channels / 2;
+    unsigned int ny = _num_hops * _num_channels;
+    float complex * x = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * y = (float complex*) malloc(ny*sizeof(float complex));
+    for (i=0; i<nx; i++)
+        x[i] = 1.0f + _Complex_I*1.0f;
+
+    // scale number of iterations to keep execution time
+    // relatively linear; one trial per hop
+    *_num_iterations /= _num_channels * _num_hops;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        firpfbch2_crcf_execute_block(q, x, _num_hops, y);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= _num_hops;
+
+    firpfbch2_crcf_destroy(q);
+    free(x);
+    free(y);
+}
+
 // analysis
 void benchmark_firpfbch2_crcf_a4    FIRPFBCH2_EXECUTE_BENCH_API(4,    2,  LIQUID_ANALYZER)
 void benchmark_firpfbch2_crcf_a16   FIRPFBCH2_EXECUTE_BENCH_API(16,   2,  LIQUID_ANALYZER)
@@ -73,6 +118,12 @@ void benchmark_firpfbch2_crcf_a64   FIRPFBCH2_EXECUTE_BENCH_API(64,   2,  LIQUID
 void benchmark_firpfbch2_crcf_a256  FIRPFBCH2_EXECUTE_BENCH_API(256,  2,  LIQUID_ANALYZER)
 void benchmark_firpfbch2_crcf_a512  FIRPFBCH2_EXECUTE_BENCH_API(512,  2,  LIQUID_ANALYZER)
 void benchmark_firpfbch2_crcf_a1024 FIRPFBCH2_EXECUTE_BENCH_API(1024, 2,  LIQUID_ANALYZER)
+void benchmark_firpfbch2_crcf_a4096 FIRPFBCH2_EXECUTE_BENCH_API(4096, 2,  LIQUID_ANALYZER)
+
+// analysis, block of hops
+void benchmark_firpfbch2_crcf_a64_k32   FIRPFBCH2_BLOCK_BENCH_API(64,   2, 32)
+void benchmark_firpfbch2_crcf_a1024_k16 FIRPFBCH2_BLOCK_BENCH_API(1024, 2, 16)
+void benchmark_firpfbch2_crcf_a4096_k8  FIRPFBCH2_BLOCK_BENCH_API(4096, 2,  8)
 
 // synthesis
 void benchmark_firpfbch2_crcf_s4    FIRPFBCH2_EXECUTE_BENCH_API(4,    2,  LIQUID_SYNTHESIZER)
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define FIRPFBCH2MT_BENCH_API(NUM_CHANNELS,NUM_WORKERS)     \
+(   struct rusage *_start,                                  \
+    struct rusage *_finish,                                 \
+    unsigned long int *_num_iterations)                     \
+{ firpfbch2mt_crcf_bench(_start, _finish, _num_iterations, NUM_CHANNELS, NUM_WORKERS); }
+
+// per-channel downstream processing: matched filter
+void firpfbch2mt_crcf_bench_callback(unsigned int    _channel,
+                                     float complex * _y,
+                                     unsigned int    _n,
+                                     void *          _userdata)
+{
+    firfilt_crcf f = (firfilt_crcf) _userdata;
+    float complex v;
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        firfilt_crcf_push(f, _y[i]);
+        firfilt_crcf_execute(f, &v);
+    }
+}
+
+// Helper function to keep code base small; note that resource usage
+// accumulates over all threads, so this measures total cost per hop
+// rather than throughput
+void firpfbch2mt_crcf_bench(struct rusage *     _start,
+                            struct rusage *     _finish,
+                            unsigned long int * _num_iterations,
+                            unsigned int        _num_channels,
+                            unsigned int        _num_workers)
+{
+    unsigned int m        = 4;      // prototype filter semi-length
+    unsigned int num_hops = 64;     // hops per call
+
+    firpfbch2mt_crcf q = firpfbch2mt_crcf_create(_num_channels, m, 60.0f, _num_workers, 1024);
+
+    // every channel feeds its own filter
+    unsigned long int i;
+    firfilt_crcf f[_num_channels];
+    for (i=0; i<_num_channels; i++) {
+        f[i] = firfilt_crcf_create_rnyquist(LIQUID_FIRFILT_ARKAISER, 2, 7, 0.3f, 0.0f);
+        firpfbch2mt_crcf_set_callback(q, i, firpfbch2mt_crcf_bench_callback, f[i]);
+    }
+
+    unsigned int num_samples = num_hops * _num_channels / 2;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    for (i=0; i<num_samples; i++)
+        x[i] = cexpf(_Complex_I*0.1f*i);
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= num_hops * _num_channels;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++)
+        firpfbch2mt_crcf_execute(q, x, num_hops);
+    firpfbch2mt_crcf_flush(q);
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= num_hops;
+
+    firpfbch2mt_crcf_destroy(q);
+    for (i=0; i<_num_channels; i++)
+        firfilt_crcf_destroy(f[i]);
+    free(x);
+}
+
+//
+void benchmark_firpfbch2mt_crcf_m64_w0     FIRPFBCH2MT_BENCH_API(64,  0)
+void benchmark_firpfbch2mt_crcf_m64_w1     FIRPFBCH2MT_BENCH_API(64,  1)
+void benchmark_firpfbch2mt_crcf_m64_w2     FIRPFBCH2MT_BENCH_API(64,  2)
+void benchmark_firpfbch2mt_crcf_m64_w4     FIRPFBCH2MT_BENCH_API(64,  4)
+void benchmark_firpfbch2mt_crcf_m512_w4    FIRPFBCH2MT_BENCH_API(512, 4)
+
@@ -27,7 +27,13 @@
 (   struct rusage *_start,                              \
     struct rusage *_finish,                             \
     unsigned long int *_num_iterations)                 \
-{ firpfbch_crcf_execute_bench(_start, _finish, _num_iterations, NUM_CHANNELS, M, TYPE); }
+{ firpfbch_crcf_execute_bench(_start, _finish, _num_iterations, NUM_CHANNELS, M, TYPE, NUM_CHANNELS); }
+
+#define FIRPFBCH_SPARSE_BENCH_API(NUM_CHANNELS,M,TYPE,NUM_ACTIVE)   \
+(   struct rusage *_start,                              \
+    struct rusage *_finish,                             \
+    unsigned long int *_num_iterations)                 \
+{ firpfbch_crcf_execute_bench(_start, _finish, _num_iterations, NUM_CHANNELS, M, TYPE, NUM_ACTIVE); }
 
 // Helper function to keep code base small
 void firpfbch_crcf_execute_bench(
@@ -36,7 +42,8 @@ void firpfbch_crcf_execute_bench(
     unsigned long int *_num_iterations,
     unsigned int _num_channels,
     unsigned int _m,
-    int _type)
+    int _type,
+    unsigned int _num_active)
 {
     // initialize channelizer
     float As    = 60.0f;
@@ -44,6 +51,13 @@ void firpfbch_crcf_execute_bench(
 
     unsigned long int i;
 
+    // enable subset of channels, evenly spaced
+    if (_num_active < _num_channels) {
+        firpfbch_crcf_disable_all(c);
+        for (i=0; i<_num_active; i++)
+            firpfbch_crcf_enable_channel(c, (i*_num_channels)/_num_active);
+    }
+
     float complex x[_num_channels];
     float complex y[_num_channels];
     for (i=0; i<_num_channels; i++)
@@ -84,4 +98,10 @@ void benchmark_firpfbch_crcf_a256    FIRPFBCH_EXECUTE_BENCH_API(256,  2,  LIQUID
 void benchmark_firpfbch_crcf_a512    FIRPFBCH_EXECUTE_BENCH_API(512,  2,  LIQUID_ANALYZER)
 void benchmark_firpfbch_crcf_a1024   FIRPFBCH_EXECUTE_BENCH_API(1024, 2,  LIQUID_ANALYZER)
 
+// subset of channels enabled
+void benchmark_firpfbch_crcf_a1024_k1   FIRPFBCH_SPARSE_BENCH_API(1024, 2,  LIQUID_ANALYZER, 1)
+void benchmark_firpfbch_crcf_a1024_k5   FIRPFBCH_SPARSE_BENCH_API(1024, 2,  LIQUID_ANALYZER, 5)
+void benchmark_firpfbch_crcf_a1024_k9   FIRPFBCH_SPARSE_BENCH_API(1024, 2,  LIQUID_ANALYZER, 9)
+void benchmark_firpfbch_crcf_a1024_k16  FIRPFBCH_SPARSE_BENCH_API(1024, 2,  LIQUID_ANALYZER, 16)
+void benchmark_firpfbch_crcf_s1024_k5   FIRPFBCH_SPARSE_BENCH_API(1024, 2,  LIQUID_SYNTHESIZER, 5)
 
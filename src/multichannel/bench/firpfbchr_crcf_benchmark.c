@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define FIRPFBCHR_EXECUTE_BENCH_API(M,P,m,TYPE)             \
+(   struct rusage *_start,                                  \
+    struct rusage *_finish,                                 \
+    unsigned long int *_num_iterations)                     \
+{ firpfbchr_crcf_execute_bench(_start, _finish, _num_iterations, M, P, m, TYPE); }
+
+// Helper function to keep code base small
+void firpfbchr_crcf_execute_bench(struct rusage *     _start,
+                                  struct rusage *     _finish,
+                                  unsigned long int * _num_iterations,
+                                  unsigned int        _M,
+                                  unsigned int        _P,
+                                  unsigned int        _m,
+                                  int                 _type)
+{
+    // initialize channelizer
+    float As         = 60.0f;
+    firpfbchr_crcf q = firpfbchr_crcf_create_kaiser(_type,_M,_P,_m,As);
+
+    unsigned long int i;
+
+    float complex x[_M];
+    float complex y[_M];
+    for (i=0; i<_M; i++)
+        x[i] = 1.0f + _Complex_I*1.0f;
+
+    // scale number of iterations to keep execution time
+    // relatively linear
+    *_num_iterations /= _M;
+    if (*_num_iterations < 1) *_num_iterations = 1;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i++) {
+        firpfbchr_crcf_execute(q, x, y);
+        firpfbchr_crcf_execute(q, x, y);
+        firpfbchr_crcf_execute(q, x, y);
+        firpfbchr_crcf_execute(q, x, y);
+    }
+    getrusage(RUSAGE_SELF, _finish);
+    *_num_iterations *= 4;
+
+    firpfbchr_crcf_destroy(q);
+}
+
+// analysis
+void benchmark_firpfbchr_crcf_a64_p32     FIRPFBCHR_EXECUTE_BENCH_API(  64,  32, 2, LIQUID_ANALYZER)
+void benchmark_firpfbchr_crcf_a64_p48     FIRPFBCHR_EXECUTE_BENCH_API(  64,  48, 2, LIQUID_ANALYZER)
+void benchmark_firpfbchr_crcf_a1024_p768  FIRPFBCHR_EXECUTE_BENCH_API(1024, 768, 2, LIQUID_ANALYZER)
+
+// synthesis
+void benchmark_firpfbchr_crcf_s64_p48     FIRPFBCHR_EXECUTE_BENCH_API(  64,  48, 2, LIQUID_SYNTHESIZER)
+void benchmark_firpfbchr_crcf_s1024_p768  FIRPFBCHR_EXECUTE_BENCH_API(1024, 768, 2, LIQUID_SYNTHESIZER)
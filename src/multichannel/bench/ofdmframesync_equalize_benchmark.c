@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/resource.h>
+#include "liquid.h"
+
+#define OFDMFRAMESYNC_EQUALIZE_BENCH_API(M)         \
+(   struct rusage *_start,                          \
+    struct rusage *_finish,                         \
+    unsigned long int *_num_iterations)             \
+{ ofdmframesync_equalize_bench(_start, _finish, _num_iterations, M); }
+
+// Helper function to keep code base small; each trial receives one
+// payload symbol (transform, pilot tracking, equalization), so trials
+// per second is symbols per second
+void ofdmframesync_equalize_bench(struct rusage *     _start,
+                                  struct rusage *     _finish,
+                                  unsigned long int * _num_iterations,
+                                  unsigned int        _M)
+{
+    // options
+    unsigned int M          = _M;
+    unsigned int cp_len     = M / 8;
+    unsigned int num_frames = 8;            // distinct payload symbols
+    float        dphi       = 0.03f / M;    // carrier offset (tracked by pilots)
+
+    // create generator/synchronizer objects
+    ofdmframegen  fg = ofdmframegen_create(M, cp_len, 0, NULL);
+    ofdmframesync fs = ofdmframesync_create(M, cp_len, 0, NULL, NULL, NULL);
+
+    unsigned int i, j;
+    unsigned int symbol_len = M + cp_len;
+    float complex X[M];
+    float complex * x = (float complex*) malloc(symbol_len*num_frames*sizeof(float complex));
+
+    // acquire frame
+    ofdmframegen_write_S0a(fg, x); ofdmframesync_execute(fs, x, symbol_len);
+    ofdmframegen_write_S0b(fg, x); ofdmframesync_execute(fs, x, symbol_len);
+    ofdmframegen_write_S1 (fg, x); ofdmframesync_execute(fs, x, symbol_len);
+
+    // generate payload symbols (QPSK) with carrier offset and noise
+    for (j=0; j<num_frames; j++) {
+        for (i=0; i<M; i++)
+            X[i] = cexpf(_Complex_I*(0.25f + 0.5f*(rand() % 4))*M_PI);
+        ofdmframegen_writesymbol(fg, X, &x[j*symbol_len]);
+    }
+    for (i=0; i<symbol_len*num_frames; i++)
+        x[i] = x[i]*cexpf(_Complex_I*dphi*i) + 0.01f*randnf()*cexpf(_Complex_I*2*M_PI*randf());
+
+    // normalize number of iterations
+    *_num_iterations /= M;
+    if (*_num_iterations < num_frames) *_num_iterations = num_frames;
+    *_num_iterations -= *_num_iterations % num_frames;
+
+    // start trials
+    getrusage(RUSAGE_SELF, _start);
+    for (i=0; i<(*_num_iterations); i+=num_frames)
+        ofdmframesync_execute(fs, x, symbol_len*num_frames);
+    getrusage(RUSAGE_SELF, _finish);
+
+    // destroy objects
+    ofdmframegen_destroy(fg);
+    ofdmframesync_destroy(fs);
+    free(x);
+}
+
+//
+void benchmark_ofdmframesync_equalize_n64   OFDMFRAMESYNC_EQUALIZE_BENCH_API(64)
+void benchmark_ofdmframesync_equalize_n256  OFDMFRAMESYNC_EQUALIZE_BENCH_API(256)
+void benchmark_ofdmframesync_equalize_n1024 OFDMFRAMESYNC_EQUALIZE_BENCH_API(1024)
+void benchmark_ofdmframesync_equalize_n4096 OFDMFRAMESYNC_EQUALIZE_BENCH_API(4096)
+
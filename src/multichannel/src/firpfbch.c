@@ -52,6 +52,13 @@ struct FIRPFBCH(_s) {
     FFT_PLAN fft;               // fft|ifft object
     TO * x;                     // fft|ifft transform input array
     TO * X;                     // fft|ifft transform output array
+
+    // channel selection
+    unsigned char * enabled;    // channel enabled flags [size: num_channels x 1]
+    unsigned int *  active;     // list of enabled channels
+    unsigned int    num_active; // number of enabled channels
+    int             sparse;     // compute enabled channels directly (no transform)
+    TO *            twiddle;    // dft twiddle factors [size: num_channels x 1]
 };
 
 // 
@@ -64,6 +71,8 @@ void FIRPFBCH(_analyzer_run)(FIRPFBCH()   _q,
                              unsigned int _k,
                              TO *         _X);
 
+void FIRPFBCH(_update_active)(FIRPFBCH() _q);
+
 
 // create FIR polyphase filterbank channelizer object
 //  _type   : channelizer type (LIQUID_ANALYZER | LIQUID_SYNTHESIZER)
@@ -134,6 +143,19 @@ FIRPFBCH() FIRPFBCH(_create)(int          _type,
     else
         q->fft = FFT_CREATE_PLAN(q->num_channels, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
 
+    // compute twiddle factors for sparse transform, matching the
+    // sign convention of the full transform
+    q->twiddle = (TO*) malloc((q->num_channels)*sizeof(TO));
+    float dir = q->type == LIQUID_ANALYZER ? -1.0f : 1.0f;
+    for (i=0; i<q->num_channels; i++)
+        q->twiddle[i] = cexpf(_Complex_I*dir*2*M_PI*(float)i/(float)(q->num_channels));
+
+    // enable all channels
+    q->enabled = (unsigned char*) malloc((q->num_channels)*sizeof(unsigned char));
+    q->active  = (unsigned int*)  malloc((q->num_channels)*sizeof(unsigned int));
+    memset(q->enabled, 1, q->num_channels*sizeof(unsigned char));
+    FIRPFBCH(_update_active)(q);
+
     // reset filterbank object
     FIRPFBCH(_reset)(q);
 
@@ -275,6 +297,9 @@ void FIRPFBCH(_destroy)(FIRPFBCH() _q)
     free(_q->h);
     free(_q->x);
     free(_q->X);
+    free(_q->twiddle);
+    free(_q->enabled);
+    free(_q->active);
 
     // free main object memory
     free(_q);
@@ -296,13 +321,65 @@ void FIRPFBCH(_reset)(FIRPFBCH() _q)
 void FIRPFBCH(_print)(FIRPFBCH() _q)
 {
     unsigned int i;
-    printf("firpfbch (%s) [%u channels]:\n",
+    printf("firpfbch (%s) [%u channels, %u enabled%s]:\n",
             _q->type == LIQUID_ANALYZER ? "analyzer" : "synthesizer",
-            _q->num_channels);
+            _q->num_channels,
+            _q->num_active,
+            _q->sparse ? ", sparse" : "");
     for (i=0; i<_q->h_len; i++)
         printf("  h[%3u] = %12.8f + %12.8f*j\n", i, crealf(_q->h[i]), cimagf(_q->h[i]));
 }
 
+// enable channel; the filterbank state is shared by all channels
+// so a channel may be enabled at any time without a reset
+//  _q      :   filterbank channelizer object
+//  _k      :   channel index, _k < num_channels
+void FIRPFBCH(_enable_channel)(FIRPFBCH()   _q,
+                               unsigned int _k)
+{
+    if (_k >= _q->num_channels) {
+        fprintf(stderr,"error: firpfbch_%s_enable_channel(), channel index (%u) out of range\n", EXTENSION_FULL, _k);
+        exit(1);
+    }
+    _q->enabled[_k] = 1;
+    FIRPFBCH(_update_active)(_q);
+}
+
+// disable channel; the channel's output (analyzer) is set to zero
+// and its input (synthesizer) is ignored
+//  _q      :   filterbank channelizer object
+//  _k      :   channel index, _k < num_channels
+void FIRPFBCH(_disable_channel)(FIRPFBCH()   _q,
+                                unsigned int _k)
+{
+    if (_k >= _q->num_channels) {
+        fprintf(stderr,"error: firpfbch_%s_disable_channel(), channel index (%u) out of range\n", EXTENSION_FULL, _k);
+        exit(1);
+    }
+    _q->enabled[_k] = 0;
+    FIRPFBCH(_update_active)(_q);
+}
+
+// enable all channels (default)
+void FIRPFBCH(_enable_all)(FIRPFBCH() _q)
+{
+    memset(_q->enabled, 1, _q->num_channels*sizeof(unsigned char));
+    FIRPFBCH(_update_active)(_q);
+}
+
+// disable all channels
+void FIRPFBCH(_disable_all)(FIRPFBCH() _q)
+{
+    memset(_q->enabled, 0, _q->num_channels*sizeof(unsigned char));
+    FIRPFBCH(_update_active)(_q);
+}
+
+// get number of enabled channels
+unsigned int FIRPFBCH(_get_num_active)(FIRPFBCH() _q)
+{
+    return _q->num_active;
+}
+
 // 
 // SYNTHESIZER
 //
@@ -317,11 +394,37 @@ void FIRPFBCH(_synthesizer_execute)(FIRPFBCH() _q,
 {
     unsigned int i;
 
-    // copy channelized symbols to transform input
-    memmove(_q->X, _x, _q->num_channels*sizeof(TI));
+    if (_q->sparse) {
+        // compute inverse DFT directly from enabled channels
+        unsigned int n, k, t;
+        memset(_q->x, 0, _q->num_channels*sizeof(T));
+        for (n=0; n<_q->num_active; n++) {
+            k = _q->active[n];
+            t = 0;
+            float xr = crealf(_x[k]);
+            float xi = cimagf(_x[k]);
+            for (i=0; i<_q->num_channels; i++) {
+                float wr = crealf(_q->twiddle[t]), wi = cimagf(_q->twiddle[t]);
+                _q->x[i] += (xr*wr - xi*wi) + _Complex_I*(xr*wi + xi*wr);
+                t += k;
+                if (t >= _q->num_channels) t -= _q->num_channels;
+            }
+        }
+    } else {
+        // copy channelized symbols to transform input
+        memmove(_q->X, _x, _q->num_channels*sizeof(TI));
+
+        // ignore disabled channels
+        if (_q->num_active < _q->num_channels) {
+            for (i=0; i<_q->num_channels; i++) {
+                if (!_q->enabled[i])
+                    _q->X[i] = 0;
+            }
+        }
 
-    // execute inverse DFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->fft);
+        // execute inverse DFT, store result in buffer 'x'
+        FFT_EXECUTE(_q->fft);
+    }
 
     // push samples into filter bank and execute
     T * r;      // read pointer
@@ -401,11 +504,59 @@ void FIRPFBCH(_analyzer_run)(FIRPFBCH() _q,
         DOTPROD(_execute)(_q->dp[i], r, &_q->X[_q->num_channels-i-1]);
     }
 
+    if (_q->sparse) {
+        // compute DFT directly for enabled channels only
+        unsigned int n, k, t;
+        memset(_y, 0, _q->num_channels*sizeof(TO));
+        for (n=0; n<_q->num_active; n++) {
+            k = _q->active[n];
+            t = 0;
+            // accumulate real and imaginary parts separately to
+            // avoid overhead of full complex multiply
+            float vr = 0.0f;
+            float vi = 0.0f;
+            for (i=0; i<_q->num_channels; i++) {
+                float xr = crealf(_q->X[i]),       xi = cimagf(_q->X[i]);
+                float wr = crealf(_q->twiddle[t]), wi = cimagf(_q->twiddle[t]);
+                vr += xr*wr - xi*wi;
+                vi += xr*wi + xi*wr;
+                t += k;
+                if (t >= _q->num_channels) t -= _q->num_channels;
+            }
+            _y[k] = vr + _Complex_I*vi;
+        }
+        return;
+    }
+
     // execute DFT, store result in buffer 'x'
     FFT_EXECUTE(_q->fft);
 
     // move to output array
     memmove(_y, _q->x, _q->num_channels*sizeof(TO));
+
+    // clear disabled channels
+    if (_q->num_active < _q->num_channels) {
+        for (i=0; i<_q->num_channels; i++) {
+            if (!_q->enabled[i])
+                _y[i] = 0;
+        }
+    }
+}
+
+// rebuild list of enabled channels and select transform method;
+// each channel computed directly costs num_channels multiplies
+// which beats the full transform only while few are enabled
+void FIRPFBCH(_update_active)(FIRPFBCH() _q)
+{
+    unsigned int i;
+    _q->num_active = 0;
+    for (i=0; i<_q->num_channels; i++) {
+        if (_q->enabled[i])
+            _q->active[_q->num_active++] = i;
+    }
+
+    unsigned int log2M = liquid_nextpow2(_q->num_channels);
+    _q->sparse = (float)(_q->num_active) < FIRPFBCH_SPARSE_RATIO*(float)log2M;
 }
 
 
@@ -32,6 +32,10 @@
 #include <string.h>
 #include <math.h>
 
+// target number of elements in the analyzer's batch of transform
+// inputs; batches span as many hops as fit, but at least one
+#define FIRPFBCH2_BATCH_LEN (4096)
+
 // firpfbch2 object structure definition
 struct FIRPFBCH2(_s) {
     int type;           // synthesis/analysis
@@ -47,16 +51,34 @@ struct FIRPFBCH2(_s) {
 
     // inverse FFT plan
     FFT_PLAN ifft;      // inverse FFT object
-    TO * X;             // IFFT input array  [size: M x 1]
+    TO * X;             // IFFT input array  [size: num_batch*M x 1]
     TO * x;             // IFFT output array [size: M x 1]
+    unsigned int num_batch; // number of analyzer hops per transform batch
 
     // common data structures shared between analysis and
-    // synthesis algorithms
-    WINDOW() * w0;      // window buffer object array
-    WINDOW() * w1;      // window buffer object array (synthesizer only)
+    // synthesis algorithms: polyphase buffers stored contiguously,
+    // one row of 2*h_sub_len per channel; each sample is written at
+    // both w_index and w_index+h_sub_len so that the most recent
+    // h_sub_len samples are always contiguous starting at w_index
+    unsigned int h_sub_len; // polyphase filter length: 2*m
+    T * w0;             // buffer array [size: M x 2*h_sub_len]
+    T * w1;             // buffer array (synthesizer only)
+    unsigned int w_index[2]; // read index of rows written when flag is 0/1
     int flag;           // flag indicating filter/buffer alignment
 };
 
+// push one sample into each of _n buffer rows of the same alignment
+//  _q      :   firpfbch2 object
+//  _w      :   first buffer row
+//  _stride :   row step between successive samples (+/- 2*h_sub_len)
+//  _x      :   input samples [size: _n x 1]
+//  _n      :   number of rows
+void FIRPFBCH2(_push)(FIRPFBCH2() _q,
+                      T *         _w,
+                      int         _stride,
+                      T *         _x,
+                      unsigned int _n);
+
 // create firpfbch2 object
 //  _type   :   channelizer type (e.g. LIQUID_ANALYZER)
 //  _M      :   number of channels (must be even)
@@ -98,11 +120,15 @@ FIRPFBCH2() FIRPFBCH2(_create)(int          _type,
     unsigned int n;
     unsigned int h_sub_len = 2 * q->m;
     TC h_sub[h_sub_len];
+
+    // fold output scaling into the coefficients: 1/M for the
+    // analyzer (C transform), and (1/M)*(M/2) for the synthesizer
+    float g = (q->type == LIQUID_ANALYZER) ? 1.0f / (float)(q->M) : 0.5f;
     for (i=0; i<q->M; i++) {
         // sub-sample prototype filter, loading coefficients
         // in reverse order
         for (n=0; n<h_sub_len; n++)
-            h_sub[h_sub_len-n-1] = _h[i + n*(q->M)];
+            h_sub[h_sub_len-n-1] = _h[i + n*(q->M)] * g;
 
         // create dotprod object
         q->dp[i] = DOTPROD(_create)(h_sub,h_sub_len);
@@ -110,17 +136,17 @@ FIRPFBCH2() FIRPFBCH2(_create)(int          _type,
 
     // create FFT plan (inverse transform)
     // TODO : use fftw_malloc if HAVE_FFTW3_H
-    q->X = (T*) malloc((q->M)*sizeof(T));   // IFFT input
-    q->x = (T*) malloc((q->M)*sizeof(T));   // IFFT output
-    q->ifft = FFT_CREATE_PLAN(q->M, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD);
-
-    // create buffer objects
-    q->w0 = (WINDOW()*) malloc((q->M)*sizeof(WINDOW()));
-    q->w1 = (WINDOW()*) malloc((q->M)*sizeof(WINDOW()));
-    for (i=0; i<q->M; i++) {
-        q->w0[i] = WINDOW(_create)(h_sub_len);
-        q->w1[i] = WINDOW(_create)(h_sub_len);
-    }
+    q->num_batch = (q->type == LIQUID_ANALYZER && q->M < FIRPFBCH2_BATCH_LEN) ?
+                   FIRPFBCH2_BATCH_LEN / q->M : 1;
+    q->X = (T*) malloc((q->num_batch*q->M)*sizeof(T));  // IFFT input
+    q->x = (T*) malloc((q->M)*sizeof(T));               // IFFT output
+    q->ifft = FFT_CREATE_PLAN(q->M, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD_MANY);
+
+    // allocate polyphase buffers
+    q->h_sub_len = h_sub_len;
+    q->w0 = (T*) malloc((q->M*2*h_sub_len)*sizeof(T));
+    q->w1 = (q->type == LIQUID_SYNTHESIZER) ?
+            (T*) malloc((q->M*2*h_sub_len)*sizeof(T)) : NULL;
 
     // reset filterbank object and return
     FIRPFBCH2(_reset)(q);
@@ -197,13 +223,10 @@ void FIRPFBCH2(_destroy)(FIRPFBCH2() _q)
     free(_q->X);
     free(_q->x);
     
-    // free window objects (buffers)
-    for (i=0; i<_q->M; i++) {
-        WINDOW(_destroy)(_q->w0[i]);
-        WINDOW(_destroy)(_q->w1[i]);
-    }
+    // free buffers
     free(_q->w0);
-    free(_q->w1);
+    if (_q->w1 != NULL)
+        free(_q->w1);
 
     // free main object memory
     free(_q);
@@ -212,13 +235,13 @@ void FIRPFBCH2(_destroy)(FIRPFBCH2() _q)
 // reset firpfbch2 object internals
 void FIRPFBCH2(_reset)(FIRPFBCH2() _q)
 {
-    unsigned int i;
-
-    // clear window buffers
-    for (i=0; i<_q->M; i++) {
-        WINDOW(_clear)(_q->w0[i]);
-        WINDOW(_clear)(_q->w1[i]);
-    }
+    // clear buffers
+    unsigned int n = _q->M * 2 * _q->h_sub_len;
+    memset(_q->w0, 0, n*sizeof(T));
+    if (_q->w1 != NULL)
+        memset(_q->w1, 0, n*sizeof(T));
+    _q->w_index[0] = 0;
+    _q->w_index[1] = 0;
 
     // reset filter/buffer alignment flag
     _q->flag = 0;
@@ -238,47 +261,47 @@ void FIRPFBCH2(_print)(FIRPFBCH2() _q)
         DOTPROD(_print)(_q->dp[i]);
 }
 
-// execute filterbank channelizer (analyzer)
-//  _x      :   channelizer input,  [size: M/2 x 1]
-//  _y      :   channelizer output, [size: M   x 1]
+// execute filterbank channelizer (analyzer) over a batch of hops,
+// writing all transforms directly to the output
+//  _x      :   channelizer input,  [size: _n*M/2 x 1]
+//  _n      :   number of hops (at most num_batch)
+//  _y      :   channelizer output, [size: _n*M   x 1]
 void FIRPFBCH2(_execute_analyzer)(FIRPFBCH2() _q,
                                   TI *        _x,
+                                  unsigned int _n,
                                   TO *        _y)
 {
-    unsigned int i;
-
-    // load buffers in blocks of num_channels/2 starting
-    // in the middle of the filter bank and moving in the
-    // negative direction
-    unsigned int base_index = _q->flag ? _q->M : _q->M2;
-    for (i=0; i<_q->M2; i++) {
-        // push sample into buffer at filter index
-        WINDOW(_push)(_q->w0[base_index-i-1], _x[i]);
-    }
-
-    // execute filter outputs
-    unsigned int offset = _q->flag ? _q->M2 : 0;
-    TI * r;      // buffer read pointer
-    for (i=0; i<_q->M; i++) {
-        // compute buffer index
-        unsigned int buffer_index  = (offset+i)%(_q->M);
-
-        // read buffer at index
-        WINDOW(_read)(_q->w0[buffer_index], &r);
-
-        // run dot product storing result in IFFT input buffer
-        DOTPROD(_execute)(_q->dp[i], r, &_q->X[buffer_index]);
+    unsigned int i, k;
+    unsigned int row_len = 2*_q->h_sub_len;
+    for (k=0; k<_n; k++) {
+        // load buffers in blocks of num_channels/2 starting
+        // in the middle of the filter bank and moving in the
+        // negative direction
+        unsigned int base_index = _q->flag ? _q->M : _q->M2;
+        FIRPFBCH2(_push)(_q, _q->w0 + (base_index-1)*row_len, -(int)row_len,
+                         &_x[k*_q->M2], _q->M2);
+
+        // execute filter outputs; coefficients include 1/M scaling
+        unsigned int offset = _q->flag ? _q->M2 : 0;
+        TO * X = &_q->X[k*_q->M];
+        for (i=0; i<_q->M; i++) {
+            // compute buffer index
+            unsigned int buffer_index  = (offset+i)%(_q->M);
+
+            // read buffer at index
+            TI * r = _q->w0 + buffer_index*row_len +
+                     _q->w_index[buffer_index < _q->M2 ? 0 : 1];
+
+            // run dot product storing result in IFFT input buffer
+            DOTPROD(_execute)(_q->dp[i], r, &X[buffer_index]);
+        }
+
+        // update flag
+        _q->flag = 1 - _q->flag;
     }
 
-    // execute IFFT, store result in buffer 'x'
-    FFT_EXECUTE(_q->ifft);
-
-    // scale result by 1/num_channels (C transform)
-    for (i=0; i<_q->M; i++)
-        _y[i] = _q->x[i] / (float)(_q->M);
-
-    // update flag
-    _q->flag = 1 - _q->flag;
+    // execute IFFTs, storing results in output
+    FFT_EXECUTE_MANY(_q->ifft, _q->M, _q->X, _y, _n);
 }
 
 // execute filterbank channelizer (synthesizer)
@@ -293,21 +316,13 @@ void FIRPFBCH2(_execute_synthesizer)(FIRPFBCH2() _q,
     // copy input array to internal IFFT input buffer
     memmove(_q->X, _x, _q->M * sizeof(TI));
 
-    // execute IFFT, store result in buffer 'x'
+    // execute IFFT, store result in buffer 'x'; scaling by
+    // (1/M)*(M/2) is included in the filter coefficients
     FFT_EXECUTE(_q->ifft);
 
-    // TODO: ignore this scaling
-    // scale result by 1/num_channels (C transform)
-    for (i=0; i<_q->M; i++)
-        _q->x[i] *= 1.0f / (float)(_q->M);
-    // scale result by num_channels/2
-    for (i=0; i<_q->M; i++)
-        _q->x[i] *= (float)(_q->M2);
-
     // push samples into appropriate buffer
-    WINDOW() * buffer = (_q->flag == 0 ? _q->w1 : _q->w0);
-    for (i=0; i<_q->M; i++)
-        WINDOW(_push)(buffer[i], _q->x[i]);
+    unsigned int row_len = 2*_q->h_sub_len;
+    FIRPFBCH2(_push)(_q, _q->flag == 0 ? _q->w1 : _q->w0, row_len, _q->x, _q->M);
 
     // compute filter outputs
     TO * r0, * r1;  // buffer read pointers
@@ -316,9 +331,10 @@ void FIRPFBCH2(_execute_synthesizer)(FIRPFBCH2() _q,
         // buffer index
         unsigned int b = (_q->flag == 0) ? i : i+_q->M2;
 
-        // read buffer with index offset
-        WINDOW(_read)(_q->w0[b], &r0);
-        WINDOW(_read)(_q->w1[b], &r1);
+        // read buffer with index offset (w1 rows are written when
+        // the flag is 0, w0 rows when it is 1)
+        r0 = _q->w0 + b*row_len + _q->w_index[1];
+        r1 = _q->w1 + b*row_len + _q->w_index[0];
 
         // swap buffer outputs on alternating runs
         TO * p0 = _q->flag ? r0 : r1;
@@ -345,7 +361,7 @@ void FIRPFBCH2(_execute)(FIRPFBCH2() _q,
 {
     switch (_q->type) {
     case LIQUID_ANALYZER:
-        FIRPFBCH2(_execute_analyzer)(_q, _x, _y);
+        FIRPFBCH2(_execute_analyzer)(_q, _x, 1, _y);
         return;
     case LIQUID_SYNTHESIZER:
         FIRPFBCH2(_execute_synthesizer)(_q, _x, _y);
@@ -356,3 +372,55 @@ void FIRPFBCH2(_execute)(FIRPFBCH2() _q,
     }
 }
 
+
+// execute filterbank channelizer on a block of hops
+// LIQUID_ANALYZER:     input: _n*M/2, output: _n*M
+// LIQUID_SYNTHESIZER:  input: _n*M,   output: _n*M/2
+//  _x      :   channelizer input
+//  _n      :   number of hops
+//  _y      :   channelizer output
+void FIRPFBCH2(_execute_block)(FIRPFBCH2() _q,
+                               TI *         _x,
+                               unsigned int _n,
+                               TO *         _y)
+{
+    unsigned int k;
+    switch (_q->type) {
+    case LIQUID_ANALYZER:
+        // run hops in batches sharing one set of transforms
+        for (k=0; k<_n; k+=_q->num_batch) {
+            unsigned int n = _n - k < _q->num_batch ? _n - k : _q->num_batch;
+            FIRPFBCH2(_execute_analyzer)(_q, &_x[k*_q->M2], n, &_y[k*_q->M]);
+        }
+        return;
+    case LIQUID_SYNTHESIZER:
+        for (k=0; k<_n; k++)
+            FIRPFBCH2(_execute_synthesizer)(_q, &_x[k*_q->M], &_y[k*_q->M2]);
+        return;
+    default:
+        fprintf(stderr,"error: firpfbch2_%s_execute_block(), invalid type\n", EXTENSION_FULL);
+        exit(1);
+    }
+}
+
+//
+// internal methods
+//
+
+// push one sample into each of _n buffer rows of the same alignment
+void FIRPFBCH2(_push)(FIRPFBCH2() _q,
+                      T *         _w,
+                      int         _stride,
+                      T *         _x,
+                      unsigned int _n)
+{
+    unsigned int L = _q->h_sub_len;
+    unsigned int * index = &_q->w_index[_q->flag];
+    unsigned int i;
+    for (i=0; i<_n; i++) {
+        T * w = _w + (int)i*_stride + *index;
+        w[0] = _x[i];
+        w[L] = _x[i];
+    }
+    *index = (*index + 1) % L;
+}
@@ -0,0 +1,506 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// firpfbch2mt_crcf.c
+//
+// multi-threaded firpfbch2 analysis pipeline
+//
+// The caller's thread runs the firpfbch2 analyzer on blocks of hops and
+// scatters each active channel's output into its own bounded
+// single-producer/single-consumer queue. A pool of worker threads
+// drains the queues, each worker owning a fixed set of channels so that
+// the callbacks for a given channel always run in order on one thread.
+// The producer blocks when a queue is full, throttling the input
+// rather than dropping samples. Channel configuration is changed only
+// while the workers are stopped, so the data path is free of locks
+// except for waking a sleeping worker once per block.
+//
+
+#define _GNU_SOURCE
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "liquid.internal.h"
+
+#if HAVE_LIBPTHREAD && HAVE_PTHREAD_H
+#  include <pthread.h>
+#  if HAVE_PTHREAD_SETAFFINITY_NP
+#    include <sched.h>
+#  endif
+#  define FIRPFBCH2MT_THREADS 1
+#else
+#  define FIRPFBCH2MT_THREADS 0
+#endif
+
+// maximum number of analyzer output samples per block
+#define FIRPFBCH2MT_BLOCK_SIZE  (4096)
+
+// worker thread
+struct firpfbch2mt_crcf_worker_s {
+    firpfbch2mt_crcf q;         // parent object
+    int              cpu;       // processor to pin thread to, -1 for none
+    unsigned int *   channels;  // list of channels owned by this worker
+    unsigned int     num_channels;
+#if FIRPFBCH2MT_THREADS
+    pthread_t        thread;    // worker thread
+    pthread_mutex_t  lock;      // lock for sleeping only
+    pthread_cond_t   cond;      // signalled when data are dispatched
+#endif
+    unsigned int     seq;       // number of dispatches (protected by lock)
+    int              stop;      // stop request (protected by lock)
+};
+
+// main object definition
+struct firpfbch2mt_crcf_s {
+    unsigned int    M;              // number of channels
+    firpfbch2_crcf  ch;             // analysis filterbank
+    unsigned int    num_hops;       // number of hops per analyzer block
+    float complex * Y;              // analyzer output [size: num_hops*M x 1]
+    float complex * buf;            // channel output (inline dispatch)
+
+    // channels
+    firpfbch2mt_callback * callback;    // per-channel callback, NULL if disabled
+    void **         userdata;       // per-channel user data
+    unsigned int *  worker_index;   // worker assigned to each channel
+    spscbuffercf *  queue;          // per-channel output queue
+    unsigned int    queue_len;      // queue length [samples]
+
+    // worker pool
+    struct firpfbch2mt_crcf_worker_s * workers;
+    unsigned int    num_workers;    // number of worker threads
+    int             running;        // worker threads are running
+};
+
+// start and stop worker threads
+void firpfbch2mt_crcf_start(firpfbch2mt_crcf _q);
+void firpfbch2mt_crcf_stop(firpfbch2mt_crcf _q);
+
+// wake worker after dispatching data to its channels
+void firpfbch2mt_crcf_wake(firpfbch2mt_crcf _q, unsigned int _w);
+
+// write channel output to queue, blocking while queue is full
+void firpfbch2mt_crcf_dispatch(firpfbch2mt_crcf _q,
+                               unsigned int     _k,
+                               unsigned int     _n);
+
+// create multi-threaded analysis channelizer using Kaiser prototype
+//  _M              :   number of channels (must be even)
+//  _m              :   prototype filter semi-length, length=2*M*m+1
+//  _As             :   filter stop-band attenuation [dB]
+//  _num_workers    :   number of worker threads, 0 to run callbacks
+//                      in the caller's thread
+//  _queue_len      :   per-channel queue length [samples]
+firpfbch2mt_crcf firpfbch2mt_crcf_create(unsigned int _M,
+                                         unsigned int _m,
+                                         float        _As,
+                                         unsigned int _num_workers,
+                                         unsigned int _queue_len)
+{
+    // validate input
+    if (_queue_len == 0) {
+        fprintf(stderr,"error: firpfbch2mt_crcf_create(), queue length must be greater than zero\n");
+        exit(1);
+    }
+#if !FIRPFBCH2MT_THREADS
+    if (_num_workers > 0) {
+        fprintf(stderr,"warning: firpfbch2mt_crcf_create(), no thread support; running callbacks inline\n");
+        _num_workers = 0;
+    }
+#endif
+
+    // create main object
+    firpfbch2mt_crcf q = (firpfbch2mt_crcf) malloc(sizeof(struct firpfbch2mt_crcf_s));
+
+    // create analyzer (validates _M, _m)
+    q->ch = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, _M, _m, _As);
+    q->M  = _M;
+
+    // allocate block buffers
+    q->num_hops = FIRPFBCH2MT_BLOCK_SIZE / q->M;
+    if (q->num_hops == 0) q->num_hops = 1;
+    q->Y   = (float complex*) malloc(q->num_hops*q->M*sizeof(float complex));
+    q->buf = (float complex*) malloc(q->num_hops*sizeof(float complex));
+
+    // initialize channels, all disabled
+    q->queue_len    = _queue_len;
+    q->callback     = (firpfbch2mt_callback*) malloc(q->M*sizeof(firpfbch2mt_callback));
+    q->userdata     = (void**)                malloc(q->M*sizeof(void*));
+    q->worker_index = (unsigned int*)         malloc(q->M*sizeof(unsigned int));
+    q->queue        = (spscbuffercf*)         malloc(q->M*sizeof(spscbuffercf));
+    unsigned int k;
+    for (k=0; k<q->M; k++) {
+        q->callback[k]     = NULL;
+        q->userdata[k]     = NULL;
+        q->worker_index[k] = _num_workers > 0 ? k % _num_workers : 0;
+        q->queue[k]        = NULL;
+    }
+
+    // initialize workers
+    q->num_workers = _num_workers;
+    q->workers = (struct firpfbch2mt_crcf_worker_s*) malloc(q->num_workers*sizeof(struct firpfbch2mt_crcf_worker_s));
+    unsigned int w;
+    for (w=0; w<q->num_workers; w++) {
+        q->workers[w].q            = q;
+        q->workers[w].cpu          = -1;
+        q->workers[w].channels     = (unsigned int*) malloc(q->M*sizeof(unsigned int));
+        q->workers[w].num_channels = 0;
+    }
+    q->running = 0;
+
+    // return object
+    return q;
+}
+
+// destroy object, stopping worker threads once all queued
+// samples have been processed
+void firpfbch2mt_crcf_destroy(firpfbch2mt_crcf _q)
+{
+    firpfbch2mt_crcf_stop(_q);
+
+    unsigned int k;
+    for (k=0; k<_q->M; k++) {
+        if (_q->queue[k] != NULL)
+            spscbuffercf_destroy(_q->queue[k]);
+    }
+    unsigned int w;
+    for (w=0; w<_q->num_workers; w++)
+        free(_q->workers[w].channels);
+
+    free(_q->workers);
+    free(_q->callback);
+    free(_q->userdata);
+    free(_q->worker_index);
+    free(_q->queue);
+    free(_q->Y);
+    free(_q->buf);
+    firpfbch2_crcf_destroy(_q->ch);
+    free(_q);
+}
+
+// reset analyzer state, waiting for all queued samples to be processed
+void firpfbch2mt_crcf_reset(firpfbch2mt_crcf _q)
+{
+    firpfbch2mt_crcf_flush(_q);
+    firpfbch2_crcf_reset(_q->ch);
+}
+
+// print object internals
+void firpfbch2mt_crcf_print(firpfbch2mt_crcf _q)
+{
+    unsigned int k, num_active = 0;
+    for (k=0; k<_q->M; k++)
+        num_active += _q->callback[k] != NULL ? 1 : 0;
+    printf("firpfbch2mt_crcf:\n");
+    printf("    channels    :   %u (%u active)\n", _q->M, num_active);
+    printf("    workers     :   %u\n", _q->num_workers);
+    printf("    queue length:   %u\n", _q->queue_len);
+    unsigned int w;
+    for (w=0; w<_q->num_workers; w++) {
+        printf("    worker %-4u :   cpu ", w);
+        if (_q->workers[w].cpu < 0) printf("any");
+        else                        printf("%d", _q->workers[w].cpu);
+        printf(", channels");
+        for (k=0; k<_q->M; k++) {
+            if (_q->callback[k] != NULL && _q->worker_index[k] == w)
+                printf(" %u", k);
+        }
+        printf("\n");
+    }
+}
+
+// get number of worker threads
+unsigned int firpfbch2mt_crcf_get_num_workers(firpfbch2mt_crcf _q)
+{
+    return _q->num_workers;
+}
+
+// set callback for channel output; a NULL callback disables the
+// channel (default). Waits for queued samples to be processed.
+//  _q          :   channelizer object
+//  _k          :   channel index, _k < M
+//  _callback   :   callback function
+//  _userdata   :   user-defined data passed to callback
+void firpfbch2mt_crcf_set_callback(firpfbch2mt_crcf     _q,
+                                   unsigned int         _k,
+                                   firpfbch2mt_callback _callback,
+                                   void *               _userdata)
+{
+    if (_k >= _q->M) {
+        fprintf(stderr,"error: firpfbch2mt_crcf_set_callback(), channel index (%u) out of range\n", _k);
+        exit(1);
+    }
+    firpfbch2mt_crcf_stop(_q);
+    _q->callback[_k] = _callback;
+    _q->userdata[_k] = _userdata;
+    if (_callback != NULL && _q->num_workers > 0 && _q->queue[_k] == NULL)
+        _q->queue[_k] = spscbuffercf_create(_q->queue_len);
+}
+
+// assign channel to worker thread; callbacks for a channel are always
+// invoked from its worker, in order. Waits for queued samples to be
+// processed.
+//  _q          :   channelizer object
+//  _k          :   channel index, _k < M
+//  _worker     :   worker index, _worker < num_workers
+void firpfbch2mt_crcf_set_worker(firpfbch2mt_crcf _q,
+                                 unsigned int     _k,
+                                 unsigned int     _worker)
+{
+    if (_k >= _q->M) {
+        fprintf(stderr,"error: firpfbch2mt_crcf_set_worker(), channel index (%u) out of range\n", _k);
+        exit(1);
+    } else if (_worker >= _q->num_workers) {
+        fprintf(stderr,"error: firpfbch2mt_crcf_set_worker(), worker index (%u) out of range\n", _worker);
+        exit(1);
+    }
+    firpfbch2mt_crcf_stop(_q);
+    _q->worker_index[_k] = _worker;
+}
+
+// pin worker thread to processor; together with set_worker() this
+// sets channel-to-core affinity. Waits for queued samples to be
+// processed. Returns 0 on success, -1 if affinity is not supported.
+//  _q          :   channelizer object
+//  _worker     :   worker index, _worker < num_workers
+//  _cpu        :   processor index, -1 for any
+int firpfbch2mt_crcf_set_worker_cpu(firpfbch2mt_crcf _q,
+                                    unsigned int     _worker,
+                                    int              _cpu)
+{
+    if (_worker >= _q->num_workers) {
+        fprintf(stderr,"error: firpfbch2mt_crcf_set_worker_cpu(), worker index (%u) out of range\n", _worker);
+        exit(1);
+    }
+#if FIRPFBCH2MT_THREADS && HAVE_PTHREAD_SETAFFINITY_NP
+    if (_cpu >= CPU_SETSIZE) {
+        fprintf(stderr,"error: firpfbch2mt_crcf_set_worker_cpu(), processor index (%d) out of range\n", _cpu);
+        exit(1);
+    }
+    firpfbch2mt_crcf_stop(_q);
+    _q->workers[_worker].cpu = _cpu < 0 ? -1 : _cpu;
+    return 0;
+#else
+    return -1;
+#endif
+}
+
+// run analyzer on block of input, dispatching each active channel's
+// output to its callback
+//  _q      :   channelizer object
+//  _x      :   input samples, [size: _n*M/2 x 1]
+//  _n      :   number of hops
+void firpfbch2mt_crcf_execute(firpfbch2mt_crcf _q,
+                              float complex *  _x,
+                              unsigned int     _n)
+{
+    if (_q->num_workers > 0 && !_q->running)
+        firpfbch2mt_crcf_start(_q);
+
+    unsigned int h, k, w;
+    while (_n > 0) {
+        unsigned int num_hops = _n < _q->num_hops ? _n : _q->num_hops;
+        firpfbch2_crcf_execute_block(_q->ch, _x, num_hops, _q->Y);
+
+        for (k=0; k<_q->M; k++) {
+            if (_q->callback[k] == NULL)
+                continue;
+
+            if (_q->num_workers == 0) {
+                // run callback in this thread
+                for (h=0; h<num_hops; h++)
+                    _q->buf[h] = _q->Y[h*_q->M + k];
+                _q->callback[k](k, _q->buf, num_hops, _q->userdata[k]);
+            } else {
+                firpfbch2mt_crcf_dispatch(_q, k, num_hops);
+            }
+        }
+
+        // wake workers
+        for (w=0; w<_q->num_workers; w++) {
+            if (_q->workers[w].num_channels > 0)
+                firpfbch2mt_crcf_wake(_q, w);
+        }
+
+        _x += num_hops * _q->M / 2;
+        _n -= num_hops;
+    }
+}
+
+// wait until all queued samples have been processed
+void firpfbch2mt_crcf_flush(firpfbch2mt_crcf _q)
+{
+    if (!_q->running)
+        return;
+
+    // queue is released only once the callback returns, so an empty
+    // queue means its samples have been fully processed
+    unsigned int k;
+    for (k=0; k<_q->M; k++) {
+        if (_q->callback[k] != NULL)
+            spscbuffercf_wait_writable(_q->queue[k], _q->queue_len, -1);
+    }
+}
+
+//
+// internal methods
+//
+
+// write channel output to queue, blocking while queue is full
+void firpfbch2mt_crcf_dispatch(firpfbch2mt_crcf _q,
+                               unsigned int     _k,
+                               unsigned int     _n)
+{
+    spscbuffercf queue = _q->queue[_k];
+    float complex * v;
+    unsigned int h = 0;
+    while (h < _n) {
+        unsigned int n = spscbuffercf_write_reserve(queue, &v);
+        if (n == 0) {
+            // make sure worker is draining this queue before sleeping
+            firpfbch2mt_crcf_wake(_q, _q->worker_index[_k]);
+            spscbuffercf_wait_writable(queue, 1, -1);
+            continue;
+        }
+        if (n > _n - h)
+            n = _n - h;
+        unsigned int i;
+        for (i=0; i<n; i++)
+            v[i] = _q->Y[(h+i)*_q->M + _k];
+        spscbuffercf_write_commit(queue, n);
+        h += n;
+    }
+}
+
+#if FIRPFBCH2MT_THREADS
+// worker thread main loop
+void * firpfbch2mt_crcf_worker(void * _arg)
+{
+    struct firpfbch2mt_crcf_worker_s * worker = (struct firpfbch2mt_crcf_worker_s*) _arg;
+    firpfbch2mt_crcf q = worker->q;
+
+#if HAVE_PTHREAD_SETAFFINITY_NP
+    if (worker->cpu >= 0) {
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(worker->cpu, &cpuset);
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuset) != 0)
+            fprintf(stderr,"warning: firpfbch2mt_crcf_worker(), could not pin thread to cpu %d\n", worker->cpu);
+    }
+#endif
+
+    unsigned int seq = 0;
+    pthread_mutex_lock(&worker->lock);
+    while (1) {
+        while (worker->seq == seq && !worker->stop)
+            pthread_cond_wait(&worker->cond, &worker->lock);
+        if (worker->stop)
+            break;
+        seq = worker->seq;
+        pthread_mutex_unlock(&worker->lock);
+
+        // drain all owned queues
+        unsigned int i;
+        for (i=0; i<worker->num_channels; i++) {
+            unsigned int k = worker->channels[i];
+            float complex * v;
+            unsigned int n;
+            while ( (n = spscbuffercf_read_reserve(q->queue[k], &v)) > 0) {
+                q->callback[k](k, v, n, q->userdata[k]);
+                spscbuffercf_read_release(q->queue[k], n);
+            }
+        }
+
+        pthread_mutex_lock(&worker->lock);
+    }
+    pthread_mutex_unlock(&worker->lock);
+    return NULL;
+}
+#endif
+
+// start worker threads with current channel assignment
+void firpfbch2mt_crcf_start(firpfbch2mt_crcf _q)
+{
+#if FIRPFBCH2MT_THREADS
+    unsigned int k, w;
+    for (w=0; w<_q->num_workers; w++)
+        _q->workers[w].num_channels = 0;
+    for (k=0; k<_q->M; k++) {
+        if (_q->callback[k] == NULL)
+            continue;
+        struct firpfbch2mt_crcf_worker_s * worker = &_q->workers[_q->worker_index[k]];
+        worker->channels[worker->num_channels++] = k;
+    }
+
+    for (w=0; w<_q->num_workers; w++) {
+        struct firpfbch2mt_crcf_worker_s * worker = &_q->workers[w];
+        worker->seq  = 0;
+        worker->stop = 0;
+        pthread_mutex_init(&worker->lock, NULL);
+        pthread_cond_init(&worker->cond, NULL);
+        if (pthread_create(&worker->thread, NULL, firpfbch2mt_crcf_worker, worker) != 0) {
+            fprintf(stderr,"error: firpfbch2mt_crcf_start(), could not create worker thread\n");
+            exit(1);
+        }
+    }
+    _q->running = 1;
+#endif
+}
+
+// stop worker threads once all queued samples have been processed
+void firpfbch2mt_crcf_stop(firpfbch2mt_crcf _q)
+{
+#if FIRPFBCH2MT_THREADS
+    if (!_q->running)
+        return;
+
+    firpfbch2mt_crcf_flush(_q);
+
+    unsigned int w;
+    for (w=0; w<_q->num_workers; w++) {
+        struct firpfbch2mt_crcf_worker_s * worker = &_q->workers[w];
+        pthread_mutex_lock(&worker->lock);
+        worker->stop = 1;
+        pthread_cond_signal(&worker->cond);
+        pthread_mutex_unlock(&worker->lock);
+        pthread_join(worker->thread, NULL);
+        pthread_mutex_destroy(&worker->lock);
+        pthread_cond_destroy(&worker->cond);
+    }
+    _q->running = 0;
+#endif
+}
+
+// wake worker after dispatching data to its channels
+void firpfbch2mt_crcf_wake(firpfbch2mt_crcf _q,
+                           unsigned int     _w)
+{
+#if FIRPFBCH2MT_THREADS
+    struct firpfbch2mt_crcf_worker_s * worker = &_q->workers[_w];
+    pthread_mutex_lock(&worker->lock);
+    worker->seq++;
+    pthread_cond_signal(&worker->cond);
+    pthread_mutex_unlock(&worker->lock);
+#endif
+}
@@ -33,6 +33,7 @@
 // 
 #define FIRPFBCH(name)      LIQUID_CONCAT(firpfbch_crcf,name)
 #define FIRPFBCH2(name)     LIQUID_CONCAT(firpfbch2_crcf,name)
+#define FIRPFBCHR(name)     LIQUID_CONCAT(firpfbchr_crcf,name)
 
 #define T                   float complex   // general
 #define TO                  float complex   // output
@@ -52,4 +53,5 @@
 // source files
 #include "firpfbch.c"       // maximally-decimated polyphase filterbank
 #include "firpfbch2.c"      // polyphase filterbank w/ output rate 2 Fs / M
+#include "firpfbchr.c"      // polyphase filterbank w/ output rate Fs / P
 
@@ -0,0 +1,374 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+//
+// firpfbchr.c
+//
+// finite impulse response polyphase filterbank channelizer with M
+// channels and a hop of P <= M input samples, i.e. output rate Fs/P
+// and any rational oversampling ratio M/P
+//
+// Input samples are stored by absolute time residue t mod M so that
+// no sample moves between polyphase branches as the hop advances;
+// instead the branch-to-filter assignment rotates by P each hop,
+// which also applies the phase correction that keeps each channel
+// referenced to absolute time: a tone at the centre of channel k
+// yields a constant analyzer output. The synthesizer uses the same
+// time reference, so that an analyzer followed by a synthesizer
+// reproduces the input delayed by 2*M*m - P + 1 samples.
+//
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+
+// firpfbchr object structure definition
+struct FIRPFBCHR(_s) {
+    int type;               // synthesis/analysis
+    unsigned int M;         // number of channels
+    unsigned int P;         // hop size (decimation/interpolation rate)
+    unsigned int m;         // filter semi-length
+
+    // filter
+    unsigned int h_len;     // prototype filter length: 2*M*m
+    unsigned int h_sub_len; // polyphase filter length: 2*m
+    DOTPROD() * dp;         // polyphase dot products (analyzer only)
+    TC * h;                 // scaled prototype (synthesizer only)
+
+    // inverse FFT plan
+    FFT_PLAN ifft;          // inverse FFT object
+    T * X;                  // IFFT input array  [size: M x 1]
+    T * x;                  // IFFT output array [size: M x 1]
+
+    // analyzer: one row of 2*h_sub_len per time residue, each sample
+    // written at both w_index and w_index+h_sub_len so that the most
+    // recent h_sub_len samples are contiguous starting at w_index
+    T * w;                  // buffer array [size: M x 2*h_sub_len]
+    unsigned int * w_index; // read index for each row
+
+    // synthesizer: overlap-add accumulator
+    T * acc;                // [size: h_len x 1]
+
+    unsigned int base;      // number of samples processed, mod M
+};
+
+// execute analyzer/synthesizer (internal)
+void FIRPFBCHR(_execute_analyzer)(FIRPFBCHR() _q, TI * _x, TO * _y);
+void FIRPFBCHR(_execute_synthesizer)(FIRPFBCHR() _q, TI * _x, TO * _y);
+
+// create firpfbchr object
+//  _type   :   channelizer type (e.g. LIQUID_ANALYZER)
+//  _M      :   number of channels
+//  _P      :   hop size, 0 < _P <= _M
+//  _m      :   prototype filter semi-length, length=2*M*m
+//  _h      :   prototype filter coefficient array, DC gain M
+FIRPFBCHR() FIRPFBCHR(_create)(int          _type,
+                               unsigned int _M,
+                               unsigned int _P,
+                               unsigned int _m,
+                               TC *         _h)
+{
+    // validate input
+    if (_type != LIQUID_ANALYZER && _type != LIQUID_SYNTHESIZER) {
+        fprintf(stderr,"error: firpfbchr_%s_create(), invalid type %d\n", EXTENSION_FULL, _type);
+        exit(1);
+    } else if (_M < 2) {
+        fprintf(stderr,"error: firpfbchr_%s_create(), number of channels must be at least 2\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_P == 0 || _P > _M) {
+        fprintf(stderr,"error: firpfbchr_%s_create(), hop size must be in [1,M]\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m < 1) {
+        fprintf(stderr,"error: firpfbchr_%s_create(), filter semi-length must be at least 1\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // create object
+    FIRPFBCHR() q = (FIRPFBCHR()) malloc(sizeof(struct FIRPFBCHR(_s)));
+
+    // set input parameters
+    q->type      = _type;
+    q->M         = _M;
+    q->P         = _P;
+    q->m         = _m;
+    q->h_len     = 2*q->M*q->m;
+    q->h_sub_len = 2*q->m;
+
+    unsigned int i;
+    unsigned int n;
+    q->dp  = NULL;
+    q->h   = NULL;
+    q->w   = NULL;
+    q->w_index = NULL;
+    q->acc = NULL;
+    if (q->type == LIQUID_ANALYZER) {
+        // sub-sample prototype filter, loading coefficients in reverse
+        // order and folding in 1/M scaling of the transform
+        q->dp = (DOTPROD()*) malloc((q->M)*sizeof(DOTPROD()));
+        TC h_sub[q->h_sub_len];
+        for (i=0; i<q->M; i++) {
+            for (n=0; n<q->h_sub_len; n++)
+                h_sub[q->h_sub_len-n-1] = _h[i + n*(q->M)] / (float)(q->M);
+            q->dp[i] = DOTPROD(_create)(h_sub, q->h_sub_len);
+        }
+
+        // allocate buffers
+        q->w       = (T*) malloc((q->M*2*q->h_sub_len)*sizeof(T));
+        q->w_index = (unsigned int*) malloc((q->M)*sizeof(unsigned int));
+    } else {
+        // interpolating prototype with gain P
+        q->h = (TC*) malloc((q->h_len)*sizeof(TC));
+        for (i=0; i<q->h_len; i++)
+            q->h[i] = _h[i] * (float)(q->P) / (float)(q->M);
+
+        // allocate accumulator
+        q->acc = (T*) malloc((q->h_len)*sizeof(T));
+    }
+
+    // create FFT plan (inverse transform)
+    q->X = (T*) malloc((q->M)*sizeof(T));
+    q->x = (T*) malloc((q->M)*sizeof(T));
+    q->ifft = FFT_CREATE_PLAN(q->M, q->X, q->x, FFT_DIR_BACKWARD, FFT_METHOD_MANY);
+
+    // reset filterbank object and return
+    FIRPFBCHR(_reset)(q);
+    return q;
+}
+
+// create firpfbchr object using Kaiser window prototype
+//  _type   :   channelizer type (e.g. LIQUID_ANALYZER)
+//  _M      :   number of channels
+//  _P      :   hop size, 0 < _P <= _M
+//  _m      :   prototype filter semi-length, length=2*M*m+1
+//  _As     :   filter stop-band attenuation [dB]
+FIRPFBCHR() FIRPFBCHR(_create_kaiser)(int          _type,
+                                      unsigned int _M,
+                                      unsigned int _P,
+                                      unsigned int _m,
+                                      float        _As)
+{
+    // validate input
+    if (_type != LIQUID_ANALYZER && _type != LIQUID_SYNTHESIZER) {
+        fprintf(stderr,"error: firpfbchr_%s_create_kaiser(), invalid type %d\n", EXTENSION_FULL, _type);
+        exit(1);
+    } else if (_M < 2) {
+        fprintf(stderr,"error: firpfbchr_%s_create_kaiser(), number of channels must be at least 2\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_P == 0 || _P > _M) {
+        fprintf(stderr,"error: firpfbchr_%s_create_kaiser(), hop size must be in [1,M]\n", EXTENSION_FULL);
+        exit(1);
+    } else if (_m < 1) {
+        fprintf(stderr,"error: firpfbchr_%s_create_kaiser(), filter semi-length must be at least 1\n", EXTENSION_FULL);
+        exit(1);
+    }
+
+    // design prototype filter
+    unsigned int h_len = 2*_M*_m+1;
+    float * hf = (float*)malloc(h_len*sizeof(float));
+
+    // filter cut-off frequency: the synthesizer passes exactly one
+    // channel width; the analyzer is as wide as its output rate
+    // allows without aliasing onto the synthesizer's band, but no
+    // wider than twice the channel width
+    float fc = 0.5f / (float)_M;
+    if (_type == LIQUID_ANALYZER) {
+        fc = 0.5f / (float)_P;
+        if (fc > 1.0f / (float)_M)
+            fc = 1.0f / (float)_M;
+    }
+
+    // compute filter coefficients (floating point precision)
+    liquid_firdes_kaiser(h_len, fc, _As, 0.0f, hf);
+
+    // normalize to unit average and scale by number of channels
+    float hf_sum = 0.0f;
+    unsigned int i;
+    for (i=0; i<h_len; i++) hf_sum += hf[i];
+    for (i=0; i<h_len; i++) hf[i] = hf[i] * (float)_M / hf_sum;
+
+    // convert to type-specific array
+    TC * h = (TC*) malloc(h_len * sizeof(TC));
+    for (i=0; i<h_len; i++)
+        h[i] = (TC) hf[i];
+
+    // create filterbank channelizer object
+    FIRPFBCHR() q = FIRPFBCHR(_create)(_type, _M, _P, _m, h);
+
+    // free prototype filter coefficients
+    free(hf);
+    free(h);
+
+    // return object
+    return q;
+}
+
+// destroy firpfbchr object, freeing internal memory
+void FIRPFBCHR(_destroy)(FIRPFBCHR() _q)
+{
+    unsigned int i;
+    if (_q->type == LIQUID_ANALYZER) {
+        for (i=0; i<_q->M; i++)
+            DOTPROD(_destroy)(_q->dp[i]);
+        free(_q->dp);
+        free(_q->w);
+        free(_q->w_index);
+    } else {
+        free(_q->h);
+        free(_q->acc);
+    }
+
+    // free transform object and arrays
+    FFT_DESTROY_PLAN(_q->ifft);
+    free(_q->X);
+    free(_q->x);
+
+    // free main object memory
+    free(_q);
+}
+
+// reset firpfbchr object internals
+void FIRPFBCHR(_reset)(FIRPFBCHR() _q)
+{
+    if (_q->type == LIQUID_ANALYZER) {
+        memset(_q->w, 0, (_q->M*2*_q->h_sub_len)*sizeof(T));
+        memset(_q->w_index, 0, (_q->M)*sizeof(unsigned int));
+    } else {
+        memset(_q->acc, 0, (_q->h_len)*sizeof(T));
+    }
+    _q->base = 0;
+}
+
+// print firpfbchr object internals
+void FIRPFBCHR(_print)(FIRPFBCHR() _q)
+{
+    printf("firpfbchr_%s:\n", EXTENSION_FULL);
+    printf("    type        :   %s\n", _q->type == LIQUID_ANALYZER ? "analyzer" : "synthesizer");
+    printf("    channels    :   %u\n", _q->M);
+    printf("    hop size    :   %u\n", _q->P);
+    printf("    oversampling:   %.4f\n", (float)(_q->M) / (float)(_q->P));
+    printf("    h_len       :   %u\n", _q->h_len);
+    printf("    semi-length :   %u\n", _q->m);
+}
+
+// get number of channels
+unsigned int FIRPFBCHR(_get_M)(FIRPFBCHR() _q)
+{
+    return _q->M;
+}
+
+// get hop size
+unsigned int FIRPFBCHR(_get_P)(FIRPFBCHR() _q)
+{
+    return _q->P;
+}
+
+// execute filterbank channelizer
+// LIQUID_ANALYZER:     input: P, output: M
+// LIQUID_SYNTHESIZER:  input: M, output: P
+//  _x      :   channelizer input
+//  _y      :   channelizer output
+void FIRPFBCHR(_execute)(FIRPFBCHR() _q,
+                         TI *        _x,
+                         TO *        _y)
+{
+    switch (_q->type) {
+    case LIQUID_ANALYZER:
+        FIRPFBCHR(_execute_analyzer)(_q, _x, _y);
+        return;
+    case LIQUID_SYNTHESIZER:
+        FIRPFBCHR(_execute_synthesizer)(_q, _x, _y);
+        return;
+    default:
+        fprintf(stderr,"error: firpfbchr_%s_execute(), invalid type\n", EXTENSION_FULL);
+        exit(1);
+    }
+}
+
+//
+// internal methods
+//
+
+// execute filterbank channelizer (analyzer)
+//  _x      :   channelizer input,  [size: P x 1]
+//  _y      :   channelizer output, [size: M x 1]
+void FIRPFBCHR(_execute_analyzer)(FIRPFBCHR() _q,
+                                  TI *        _x,
+                                  TO *        _y)
+{
+    unsigned int i;
+    unsigned int L       = _q->h_sub_len;
+    unsigned int row_len = 2*L;
+
+    // push samples into the rows of their time residue
+    for (i=0; i<_q->P; i++) {
+        T * w = _q->w + _q->base*row_len + _q->w_index[_q->base];
+        w[0] = _x[i];
+        w[L] = _x[i];
+        _q->w_index[_q->base] = (_q->w_index[_q->base] + 1) % L;
+        _q->base = (_q->base + 1) % _q->M;
+    }
+
+    // residue of the newest sample
+    unsigned int t = (_q->base + _q->M - 1) % _q->M;
+
+    // transform input i holds the branch of residue -i, filtered with
+    // polyphase component (i + t) mod M; the rotation by t aligns each
+    // channel's phase to absolute time
+    for (i=0; i<_q->M; i++) {
+        unsigned int s = (_q->M - i) % _q->M;
+        unsigned int r = (i + t) % _q->M;
+        T * w = _q->w + s*row_len + _q->w_index[s];
+        DOTPROD(_execute)(_q->dp[r], w, &_q->X[i]);
+    }
+
+    // execute IFFT, storing result in output
+    FFT_EXECUTE_MANY(_q->ifft, _q->M, _q->X, _y, 1);
+}
+
+// execute filterbank channelizer (synthesizer)
+//  _x      :   channelizer input,  [size: M x 1]
+//  _y      :   channelizer output, [size: P x 1]
+void FIRPFBCHR(_execute_synthesizer)(FIRPFBCHR() _q,
+                                     TI *        _x,
+                                     TO *        _y)
+{
+    unsigned int i;
+
+    // modulate channels: x[k] holds the sum of channels at times k mod M
+    memmove(_q->X, _x, _q->M*sizeof(TI));
+    FFT_EXECUTE(_q->ifft);
+
+    // overlap-add interpolated, modulated output starting at the time
+    // residue of the analyzer's newest sample for the same hop
+    unsigned int k = (_q->base + _q->P - 1) % _q->M;
+    for (i=0; i<_q->h_len; i++) {
+        _q->acc[i] += _q->h[i] * _q->x[k];
+        k = (k + 1 == _q->M) ? 0 : k + 1;
+    }
+
+    // emit completed samples and shift accumulator
+    memmove(_y, _q->acc, _q->P*sizeof(TO));
+    memmove(_q->acc, _q->acc + _q->P, (_q->h_len - _q->P)*sizeof(T));
+    memset(_q->acc + _q->h_len - _q->P, 0, _q->P*sizeof(T));
+    _q->base = (_q->base + _q->P) % _q->M;
+}
@@ -64,6 +64,7 @@ struct ofdmframesync_s {
     float complex * X;      // frequency-domain buffer
     float complex * x;      // time-domain buffer
     windowcf input_buffer;  // input sequence buffer
+    float complex * buf;    // mixed input block, [size: M+cp_len x 1]
 
     // PLCP sequences
     float complex * S0;     // short sequence (freq)
@@ -77,7 +78,14 @@ struct ofdmframesync_s {
     float complex * G1;     // complex subcarrier gain estimate, S0[1]
     float complex * G;      // complex subcarrier gain estimate
     float complex * B;      // subcarrier phase rotation due to backoff
-    float complex * R;      // 
+    float complex * R;      // composite gain, zero on null subcarriers
+
+    // pilot tracking
+    unsigned int * pilot_index; // pilot subcarrier indices (fftshift order)
+    float * pilot_x;            // pilot subcarrier frequency offsets
+    float pilot_sx;             // sum{ pilot_x }
+    float pilot_det;            // M_pilot*sum{ pilot_x^2 } - sum{ pilot_x }^2
+    float complex * ramp;       // phase correction, [size: M x 1]
 
     // receiver state
     enum {
@@ -190,6 +198,7 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
  
     // create input buffer the length of the transform
     q->input_buffer = windowcf_create(q->M + q->cp_len);
+    q->buf = (float complex*) malloc((q->M + q->cp_len)*sizeof(float complex));
 
     // allocate memory for PLCP arrays
     q->S0 = (float complex*) malloc((q->M)*sizeof(float complex));
@@ -226,6 +235,27 @@ ofdmframesync ofdmframesync_create(unsigned int           _M,
     for (i=0; i<q->M; i++)
         q->B[i] = liquid_cexpjf(i*phi);
 
+    // pilot subcarrier locations and linear fit constants; the
+    // frequency offsets are fixed, so only the phases vary per symbol
+    q->pilot_index = (unsigned int*) malloc((q->M_pilot)*sizeof(unsigned int));
+    q->pilot_x     = (float*)        malloc((q->M_pilot)*sizeof(float));
+    q->ramp        = (float complex*) malloc((q->M)*sizeof(float complex));
+    unsigned int n = 0;
+    float sxx = 0.0f;
+    q->pilot_sx = 0.0f;
+    for (i=0; i<q->M; i++) {
+        // start at mid-point (effective fftshift)
+        unsigned int k = (i + q->M2) % q->M;
+        if (q->p[k] != OFDMFRAME_SCTYPE_PILOT)
+            continue;
+        q->pilot_index[n] = k;
+        q->pilot_x[n]     = (k > q->M2) ? (float)k - (float)(q->M) : (float)k;
+        q->pilot_sx      += q->pilot_x[n];
+        sxx              += q->pilot_x[n] * q->pilot_x[n];
+        n++;
+    }
+    q->pilot_det = (float)(q->M_pilot)*sxx - q->pilot_sx*q->pilot_sx;
+
     // set callback data
     q->callback = _callback;
     q->userdata = _userdata;
@@ -288,6 +318,7 @@ void ofdmframesync_destroy(ofdmframesync _q)
 
     // free transform object
     windowcf_destroy(_q->input_buffer);
+    free(_q->buf);
     free(_q->X);
     free(_q->x);
     FFT_DESTROY_PLAN(_q->fft);
@@ -305,6 +336,11 @@ void ofdmframesync_destroy(ofdmframesync _q)
     free(_q->B);
     free(_q->R);
 
+    // free pilot tracking arrays
+    free(_q->pilot_index);
+    free(_q->pilot_x);
+    free(_q->ramp);
+
     // destroy synchronizer objects
     nco_crcf_destroy(_q->nco_rx);           // numerically-controlled oscillator
     msequence_destroy(_q->ms_pilot);
@@ -354,27 +390,57 @@ void ofdmframesync_execute(ofdmframesync _q,
                            float complex * _x,
                            unsigned int _n)
 {
-    unsigned int i;
-    float complex x;
-    for (i=0; i<_n; i++) {
-        x = _x[i];
+    unsigned int i = 0;
+    while (i < _n) {
+        // receive whole payload symbols directly while aligned to
+        // a symbol boundary
+        i += ofdmframesync_execute_rxsymbols_block(_q, &_x[i], _n - i);
+        if (i == _n)
+            break;
+
+        // Each state only does work once its sample timer expires;
+        // every sample before that is simply buffered. Ingest the run
+        // of samples up to and including the next such event as a
+        // single block.
+        unsigned int n = ofdmframesync_get_block_len(_q);
+        if (n > _n - i)
+            n = _n - i;
 
         // correct for carrier frequency offset
+        float complex * x = &_x[i];
         if (_q->state != OFDMFRAMESYNC_STATE_SEEKPLCP) {
-            nco_crcf_mix_down(_q->nco_rx, x, &x);
-            nco_crcf_step(_q->nco_rx);
+            nco_crcf_mix_block_down(_q->nco_rx, x, _q->buf, n);
+            x = _q->buf;
         }
 
-        // save input sample to buffer
-        windowcf_push(_q->input_buffer,x);
+        // save input samples to buffer
+        windowcf_write(_q->input_buffer, x, n);
+        i += n;
 
 #if DEBUG_OFDMFRAMESYNC
         if (_q->debug_enabled) {
-            windowcf_push(_q->debug_x, x);
-            windowf_push(_q->debug_rssi, crealf(x)*crealf(x) + cimagf(x)*cimagf(x));
+            unsigned int j;
+            windowcf_write(_q->debug_x, x, n);
+            for (j=0; j<n; j++)
+                windowf_push(_q->debug_rssi, crealf(x[j])*crealf(x[j]) + cimagf(x[j])*cimagf(x[j]));
         }
 #endif
 
+        // advance timer over all but the last sample of the block,
+        // which is handled by the state method below
+        switch (_q->state) {
+        case OFDMFRAMESYNC_STATE_SEEKPLCP:
+        case OFDMFRAMESYNC_STATE_PLCPSHORT0:
+        case OFDMFRAMESYNC_STATE_PLCPSHORT1:
+            _q->timer += n - 1;
+            break;
+        case OFDMFRAMESYNC_STATE_PLCPLONG:
+        case OFDMFRAMESYNC_STATE_RXSYMBOLS:
+            _q->timer -= n - 1;
+            break;
+        default:;
+        }
+
         switch (_q->state) {
         case OFDMFRAMESYNC_STATE_SEEKPLCP:
             ofdmframesync_execute_seekplcp(_q);
@@ -394,7 +460,7 @@ void ofdmframesync_execute(ofdmframesync _q,
         default:;
         }
 
-    } // for (i=0; i<_n; i++)
+    } // while (i < _n)
 } // ofdmframesync_execute()
 
 // get receiver RSSI
@@ -414,6 +480,31 @@ float ofdmframesync_get_cfo(ofdmframesync _q)
 // internal methods
 //
 
+// number of input samples up to and including the next one on which
+// the current state's timer expires (never more than the block buffer)
+unsigned int ofdmframesync_get_block_len(ofdmframesync _q)
+{
+    unsigned int n = 1;
+    switch (_q->state) {
+    case OFDMFRAMESYNC_STATE_SEEKPLCP:
+        // timer counts up to M
+        n = _q->timer + 1 < _q->M ? _q->M - _q->timer : 1;
+        break;
+    case OFDMFRAMESYNC_STATE_PLCPSHORT0:
+    case OFDMFRAMESYNC_STATE_PLCPSHORT1:
+        // timer counts up to M/2
+        n = _q->timer + 1 < _q->M2 ? _q->M2 - _q->timer : 1;
+        break;
+    case OFDMFRAMESYNC_STATE_PLCPLONG:
+    case OFDMFRAMESYNC_STATE_RXSYMBOLS:
+        // timer counts down to zero
+        n = _q->timer > 1 ? _q->timer : 1;
+        break;
+    default:;
+    }
+    return n < _q->M + _q->cp_len ? n : _q->M + _q->cp_len;
+}
+
 // frame detection
 void ofdmframesync_execute_seekplcp(ofdmframesync _q)
 {
@@ -688,7 +779,7 @@ void ofdmframesync_execute_S1(ofdmframesync _q)
         // compute composite gain
         unsigned int i;
         for (i=0; i<_q->M; i++)
-            _q->R[i] = _q->B[i] / _q->G[i];
+            _q->R[i] = _q->p[i] == OFDMFRAME_SCTYPE_NULL ? 0.0f : _q->B[i] / _q->G[i];
 #endif
 
         return;
@@ -718,36 +809,94 @@ void ofdmframesync_execute_rxsymbols(ofdmframesync _q)
 
     if (_q->timer == 0) {
 
-        // run fft
+        // copy symbol (skipping cyclic prefix) to transform input
         float complex * rc;
         windowcf_read(_q->input_buffer, &rc);
         memmove(_q->x, &rc[_q->cp_len-_q->backoff], (_q->M)*sizeof(float complex));
-        FFT_EXECUTE(_q->fft);
 
-        // recover symbol in internal _q->X buffer
-        ofdmframesync_rxsymbol(_q);
+        // demodulate symbol and invoke callback
+        ofdmframesync_rxsymbols_demod(_q);
+
+        // reset timer
+        _q->timer = _q->M + _q->cp_len;
+    }
+
+}
+
+// receive whole payload symbols directly from the input, bypassing
+// the input buffer; applies only while in the RXSYMBOLS state at a
+// symbol boundary. Returns the number of samples consumed.
+//  _q      :   ofdmframesync object
+//  _x      :   input samples, [size: _n x 1]
+//  _n      :   number of input samples
+unsigned int ofdmframesync_execute_rxsymbols_block(ofdmframesync   _q,
+                                                   float complex * _x,
+                                                   unsigned int    _n)
+{
+    unsigned int symbol_len = _q->M + _q->cp_len;
+    unsigned int i = 0;
+    while (_q->state == OFDMFRAMESYNC_STATE_RXSYMBOLS &&
+           _q->timer == symbol_len &&
+           _n - i >= symbol_len)
+    {
+        // correct for carrier frequency offset
+        nco_crcf_mix_block_down(_q->nco_rx, &_x[i], _q->buf, symbol_len);
+        i += symbol_len;
 
 #if DEBUG_OFDMFRAMESYNC
         if (_q->debug_enabled) {
-            unsigned int i;
-            for (i=0; i<_q->M; i++) {
-                if (_q->p[i] == OFDMFRAME_SCTYPE_DATA)
-                    windowcf_push(_q->debug_framesyms, _q->X[i]);
-            }
+            unsigned int j;
+            windowcf_write(_q->debug_x, _q->buf, symbol_len);
+            for (j=0; j<symbol_len; j++)
+                windowf_push(_q->debug_rssi, crealf(_q->buf[j])*crealf(_q->buf[j]) + cimagf(_q->buf[j])*cimagf(_q->buf[j]));
         }
 #endif
-        // invoke callback
-        if (_q->callback != NULL) {
-            int retval = _q->callback(_q->X, _q->p, _q->M, _q->userdata);
 
-            if (retval != 0)
-                ofdmframesync_reset(_q);
-        }
+        // copy symbol (skipping cyclic prefix) to transform input
+        memmove(_q->x, &_q->buf[_q->cp_len-_q->backoff], (_q->M)*sizeof(float complex));
+
+        // demodulate symbol and invoke callback (which may reset
+        // the synchronizer, ending the loop)
+        ofdmframesync_rxsymbols_demod(_q);
 
         // reset timer
-        _q->timer = _q->M + _q->cp_len;
+        _q->timer = symbol_len;
     }
 
+    // input buffer spans exactly one symbol, so writing only the last
+    // one leaves it as if every sample had been pushed
+    if (i > 0)
+        windowcf_write(_q->input_buffer, _q->buf, symbol_len);
+
+    return i;
+}
+
+// demodulate payload symbol in transform input buffer '_q->x' and
+// invoke callback
+void ofdmframesync_rxsymbols_demod(ofdmframesync _q)
+{
+    // run fft
+    FFT_EXECUTE(_q->fft);
+
+    // recover symbol in internal _q->X buffer
+    ofdmframesync_rxsymbol(_q);
+
+#if DEBUG_OFDMFRAMESYNC
+    if (_q->debug_enabled) {
+        unsigned int i;
+        for (i=0; i<_q->M; i++) {
+            if (_q->p[i] == OFDMFRAME_SCTYPE_DATA)
+                windowcf_push(_q->debug_framesyms, _q->X[i]);
+        }
+    }
+#endif
+    // invoke callback
+    if (_q->callback != NULL) {
+        int retval = _q->callback(_q->X, _q->p, _q->M, _q->userdata);
+
+        if (retval != 0)
+            ofdmframesync_reset(_q);
+    }
 }
 
 // compute S0 metrics
@@ -988,49 +1137,15 @@ void ofdmframesync_estimate_eqgain_poly(ofdmframesync _q,
 // recover symbol, correcting for gain, pilot phase, etc.
 void ofdmframesync_rxsymbol(ofdmframesync _q)
 {
-    // apply gain
     unsigned int i;
-    for (i=0; i<_q->M; i++)
-        _q->X[i] *= _q->R[i];
 
-    // polynomial curve-fit
-    float x_phase[_q->M_pilot];
+    // extract pilots with gain applied, removing pilot sequence
     float y_phase[_q->M_pilot];
-    float p_phase[2];
-
-    unsigned int n=0;
-    unsigned int k;
-    float complex pilot = 1.0f;
-    for (i=0; i<_q->M; i++) {
-
-        // start at mid-point (effective fftshift)
-        k = (i + _q->M2) % _q->M;
-
-        if (_q->p[k]==OFDMFRAME_SCTYPE_PILOT) {
-            if (n == _q->M_pilot) {
-                fprintf(stderr,"warning: ofdmframesync_rxsymbol(), pilot subcarrier mismatch\n");
-                return;
-            }
-            pilot = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f);
-#if 0
-            printf("pilot[%3u] = %12.4e + j*%12.4e (expected %12.4e + j*%12.4e)\n",
-                    k,
-                    crealf(_q->X[k]), cimagf(_q->X[k]),
-                    crealf(pilot),    cimagf(pilot));
-#endif
-            // store resulting...
-            x_phase[n] = (k > _q->M2) ? (float)k - (float)(_q->M) : (float)k;
-            y_phase[n] = cargf(_q->X[k]*conjf(pilot));
-
-            // update counter
-            n++;
-
-        }
-    }
-
-    if (n != _q->M_pilot) {
-        fprintf(stderr,"warning: ofdmframesync_rxsymbol(), pilot subcarrier mismatch\n");
-        return;
+    float pilot;
+    for (i=0; i<_q->M_pilot; i++) {
+        unsigned int k = _q->pilot_index[i];
+        pilot = (msequence_advance(_q->ms_pilot) ? 1.0f : -1.0f);
+        y_phase[i] = cargf(_q->X[k]*_q->R[k]*pilot);
     }
 
     // try to unwrap phase
@@ -1041,8 +1156,18 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
             y_phase[i] += 2*M_PI;
     }
 
-    // fit phase to 1st-order polynomial (2 coefficients)
-    polyf_fit(x_phase, y_phase, _q->M_pilot, p_phase, 2);
+    // fit phase to 1st-order polynomial (2 coefficients) using
+    // closed-form least-squares solution; sums over the fixed pilot
+    // locations are computed once at creation
+    float sy  = 0.0f;
+    float sxy = 0.0f;
+    for (i=0; i<_q->M_pilot; i++) {
+        sy  += y_phase[i];
+        sxy += _q->pilot_x[i] * y_phase[i];
+    }
+    float p_phase[2];
+    p_phase[1] = ((float)(_q->M_pilot)*sxy - _q->pilot_sx*sy) / _q->pilot_det;
+    p_phase[0] = (sy - p_phase[1]*_q->pilot_sx) / (float)(_q->M_pilot);
 
     // filter slope estimate (timing offset)
     float alpha = 0.3f;
@@ -1052,8 +1177,8 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
 #if DEBUG_OFDMFRAMESYNC
     if (_q->debug_enabled) {
         // save pilots
-        memmove(_q->px, x_phase, _q->M_pilot*sizeof(float));
-        memmove(_q->py, y_phase, _q->M_pilot*sizeof(float));
+        memmove(_q->px, _q->pilot_x, _q->M_pilot*sizeof(float));
+        memmove(_q->py, y_phase,     _q->M_pilot*sizeof(float));
 
         // NOTE : swapping values for octave
         _q->p_phase[0] = p_phase[1];
@@ -1064,18 +1189,15 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
     }
 #endif
 
-    // compensate for phase offset
-    // TODO : find more computationally efficient way to do this
-    for (i=0; i<_q->M; i++) {
-        // only apply to data/pilot subcarriers
-        if (_q->p[i] == OFDMFRAME_SCTYPE_NULL) {
-            _q->X[i] = 0.0f;
-        } else {
-            float fx    = (i > _q->M2) ? (float)i - (float)(_q->M) : (float)i;
-            float theta = polyf_val(p_phase, 2, fx);
-            _q->X[i] *= liquid_cexpjf(-theta);
-        }
-    }
+    // apply gain and compensate for phase offset: the composite gain
+    // is zero on null subcarriers and the phase correction is a
+    // linear ramp across subcarriers -M/2+1, ..., M/2, stored in
+    // natural (unshifted) order
+    ofdmframesync_gen_ramp(&_q->ramp[0],      _q->M2+1, -p_phase[0], -p_phase[1]);
+    ofdmframesync_gen_ramp(&_q->ramp[_q->M2+1], _q->M2-1,
+                           -p_phase[0] + p_phase[1]*(float)(_q->M2-1), -p_phase[1]);
+    liquid_vectorcf_mul(_q->X, _q->R,    _q->M, _q->X);
+    liquid_vectorcf_mul(_q->X, _q->ramp, _q->M, _q->X);
 
     // adjust NCO frequency based on differential phase
     if (_q->num_symbols > 0) {
@@ -1093,12 +1215,38 @@ void ofdmframesync_rxsymbol(ofdmframesync _q)
     
     // increment symbol counter
     _q->num_symbols++;
+}
 
-#if 0
-    for (i=0; i<_q->M_pilot; i++)
-        printf("x_phase(%3u) = %12.8f; y_phase(%3u) = %12.8f;\n", i+1, x_phase[i], i+1, y_phase[i]);
-    printf("poly : p0=%12.8f, p1=%12.8f\n", p_phase[0], p_phase[1]);
-#endif
+// generate complex phase ramp: y[i] = exp(j*(theta + i*dtheta)),
+// using a short recursion for the first block and extending it a
+// block at a time with vector multiplication
+//  _y      :   output array, [size: _n x 1]
+//  _n      :   number of elements
+//  _theta  :   initial phase
+//  _dtheta :   phase step
+void ofdmframesync_gen_ramp(float complex * _y,
+                            unsigned int    _n,
+                            float           _theta,
+                            float           _dtheta)
+{
+    unsigned int L = 8; // block length
+    if (_n == 0)
+        return;
+
+    // first block
+    float complex step = liquid_cexpjf(_dtheta);
+    unsigned int i;
+    _y[0] = liquid_cexpjf(_theta);
+    for (i=1; i<L && i<_n; i++)
+        _y[i] = _y[i-1] * step;
+
+    // remaining blocks; each element is reached in n/L steps so the
+    // accumulated error stays at the level of float precision
+    float complex block_step = liquid_cexpjf(_dtheta*(float)L);
+    for ( ; i<_n; i+=L) {
+        unsigned int n = _n - i < L ? _n - i : L;
+        liquid_vectorcf_mulscalar(&_y[i-L], n, block_step, &_y[i]);
+    }
 }
 
 // enable debugging
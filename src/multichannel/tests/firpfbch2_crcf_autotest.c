@@ -21,6 +21,7 @@
  */
 
 #include <assert.h>
+#include <stdlib.h>
 #include "autotest/autotest.h"
 #include "liquid.h"
 
@@ -97,3 +98,55 @@ void autotest_firpfbch2_crcf_n16()   { firpfbch2_crcf_runtest(  16, 5, 60.0f); }
 void autotest_firpfbch2_crcf_n32()   { firpfbch2_crcf_runtest(  32, 5, 60.0f); }
 void autotest_firpfbch2_crcf_n64()   { firpfbch2_crcf_runtest(  64, 5, 60.0f); }
 
+
+// block execution should match running one hop at a time
+//  _type   : channelizer type (e.g. LIQUID_ANALYZER)
+//  _M      : number of channels
+//  _K      : number of hops per block
+void firpfbch2_crcf_test_block(int          _type,
+                               unsigned int _M,
+                               unsigned int _K)
+{
+    unsigned int i;
+    unsigned int num_hops = 3*_K + 1;
+    unsigned int nx = (_type == LIQUID_ANALYZER ? _M/2 : _M) * num_hops;
+    unsigned int ny = (_type == LIQUID_ANALYZER ? _M : _M/2) * num_hops;
+    float complex * x  = (float complex*) malloc(nx*sizeof(float complex));
+    float complex * y0 = (float complex*) malloc(ny*sizeof(float complex));
+    float complex * y1 = (float complex*) malloc(ny*sizeof(float complex));
+    for (i=0; i<nx; i++)
+        x[i] = cexpf(_Complex_I*0.0013f*(float)(i*i)) * (0.5f + 0.01f*(float)(i % 37));
+
+    firpfbch2_crcf q0 = firpfbch2_crcf_create_kaiser(_type, _M, 4, 60.0f);
+    firpfbch2_crcf q1 = firpfbch2_crcf_create_kaiser(_type, _M, 4, 60.0f);
+
+    // one hop at a time
+    unsigned int hx = nx / num_hops;
+    unsigned int hy = ny / num_hops;
+    for (i=0; i<num_hops; i++)
+        firpfbch2_crcf_execute(q0, &x[i*hx], &y0[i*hy]);
+
+    // blocks of _K hops followed by a single hop
+    for (i=0; i<3; i++)
+        firpfbch2_crcf_execute_block(q1, &x[i*_K*hx], _K, &y1[i*_K*hy]);
+    firpfbch2_crcf_execute_block(q1, &x[3*_K*hx], 1, &y1[3*_K*hy]);
+
+    float rmse = 0.0f;
+    for (i=0; i<ny; i++)
+        rmse += crealf((y1[i]-y0[i])*conjf(y1[i]-y0[i]));
+    rmse = sqrtf(rmse / (float)ny);
+    if (liquid_autotest_verbose)
+        printf("firpfbch2 block: type=%d, M=%4u, K=%2u, rmse=%12.4e\n", _type, _M, _K, rmse);
+    CONTEND_LESS_THAN( rmse, 1e-6f );
+
+    firpfbch2_crcf_destroy(q0);
+    firpfbch2_crcf_destroy(q1);
+    free(x);
+    free(y0);
+    free(y1);
+}
+
+void autotest_firpfbch2_crcf_block_a8()    { firpfbch2_crcf_test_block(LIQUID_ANALYZER,       8,  5); }
+void autotest_firpfbch2_crcf_block_a64()   { firpfbch2_crcf_test_block(LIQUID_ANALYZER,      64, 70); }
+void autotest_firpfbch2_crcf_block_a1024() { firpfbch2_crcf_test_block(LIQUID_ANALYZER,    1024,  9); }
+void autotest_firpfbch2_crcf_block_s64()   { firpfbch2_crcf_test_block(LIQUID_SYNTHESIZER,   64,  7); }
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// channel output collected by callback
+struct firpfbch2mt_crcf_test_s {
+    float complex * y;      // received samples
+    unsigned int    n;      // number of samples received
+    unsigned int    n_max;  // buffer size
+    unsigned int    errors; // number of callbacks for wrong channel
+    unsigned int    k;      // expected channel index
+};
+
+void firpfbch2mt_crcf_test_callback(unsigned int    _channel,
+                                    float complex * _y,
+                                    unsigned int    _n,
+                                    void *          _userdata)
+{
+    struct firpfbch2mt_crcf_test_s * t = (struct firpfbch2mt_crcf_test_s*) _userdata;
+    if (_channel != t->k || t->n + _n > t->n_max) {
+        t->errors++;
+        return;
+    }
+    memmove(&t->y[t->n], _y, _n*sizeof(float complex));
+    t->n += _n;
+}
+
+// compare channel outputs delivered by callbacks against firpfbch2
+// analyzer, reassigning channels to workers part way through
+void firpfbch2mt_crcf_test(unsigned int _M,
+                           unsigned int _num_workers,
+                           unsigned int _queue_len)
+{
+    float        tol      = 1e-6f;  // error tolerance
+    unsigned int m        = 4;      // prototype filter semi-length
+    float        As       = 60.0f;  // stop-band attenuation
+    unsigned int num_hops = 300;    // total number of hops
+
+    unsigned int i, k;
+
+    // reference analyzer
+    firpfbch2_crcf ch = firpfbch2_crcf_create_kaiser(LIQUID_ANALYZER, _M, m, As);
+    firpfbch2mt_crcf q = firpfbch2mt_crcf_create(_M, m, As, _num_workers, _queue_len);
+
+    // enable every third channel
+    struct firpfbch2mt_crcf_test_s t[_M];
+    for (k=0; k<_M; k++) {
+        t[k].y      = (float complex*) malloc(num_hops*sizeof(float complex));
+        t[k].n      = 0;
+        t[k].n_max  = num_hops;
+        t[k].errors = 0;
+        t[k].k      = k;
+        if ((k % 3) == 0)
+            firpfbch2mt_crcf_set_callback(q, k, firpfbch2mt_crcf_test_callback, &t[k]);
+    }
+
+    // pin first worker to first processor, if supported
+    if (_num_workers > 0) {
+        int rc = firpfbch2mt_crcf_set_worker_cpu(q, 0, 0);
+        CONTEND_EXPRESSION( rc == 0 || rc == -1 );
+    }
+
+    // generate input
+    unsigned int num_samples = num_hops * _M / 2;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    unsigned int s = 1;
+    for (i=0; i<num_samples; i++) {
+        s = 1103515245u*s + 12345u;
+        x[i] = cexpf(_Complex_I*(0.013f*i + 1e-5f*i*i)) + 0.1f*((float)(s >> 16 & 0xff) - 127.5f)/128.0f;
+    }
+
+    // run in irregular blocks, moving channels between workers
+    unsigned int h = 0, n = 1;
+    while (h < num_hops) {
+        unsigned int b = h + n > num_hops ? num_hops - h : n;
+        firpfbch2mt_crcf_execute(q, &x[h*_M/2], b);
+        h += b;
+        n = (n * 7) % 23 + 1;
+        if (_num_workers > 1 && h > num_hops/2 && h - b <= num_hops/2) {
+            for (k=0; k<_M; k+=3)
+                firpfbch2mt_crcf_set_worker(q, k, (k/3 + 1) % _num_workers);
+        }
+    }
+    firpfbch2mt_crcf_flush(q);
+
+    // run reference analyzer and compare
+    float complex y[_M];
+    for (h=0; h<num_hops; h++) {
+        firpfbch2_crcf_execute(ch, &x[h*_M/2], y);
+        for (k=0; k<_M; k+=3) {
+            if (h >= t[k].n)
+                continue;
+            CONTEND_DELTA( crealf(t[k].y[h]), crealf(y[k]), tol );
+            CONTEND_DELTA( cimagf(t[k].y[h]), cimagf(y[k]), tol );
+        }
+    }
+
+    // check that exactly enabled channels were delivered in full
+    for (k=0; k<_M; k++) {
+        CONTEND_EQUALITY( t[k].n,      (k % 3) == 0 ? num_hops : 0 );
+        CONTEND_EQUALITY( t[k].errors, 0 );
+        free(t[k].y);
+    }
+
+    free(x);
+    firpfbch2_crcf_destroy(ch);
+    firpfbch2mt_crcf_destroy(q);
+}
+
+void autotest_firpfbch2mt_crcf_inline()     { firpfbch2mt_crcf_test(16, 0, 64); }
+void autotest_firpfbch2mt_crcf_w1()         { firpfbch2mt_crcf_test(16, 1, 64); }
+void autotest_firpfbch2mt_crcf_w3()         { firpfbch2mt_crcf_test(64, 3, 256); }
+void autotest_firpfbch2mt_crcf_w4_q3()      { firpfbch2mt_crcf_test(32, 4, 3); }
+
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare analyzer with a subset of channels enabled against the full
+// analyzer, enabling channels while running (no reset)
+void autotest_firpfbch_crcf_sparse_analyzer()
+{
+    float        tol          = 1e-4f;  // error tolerance
+    unsigned int num_channels = 64;     // number of channels
+    unsigned int m            = 4;      // filter delay (symbols)
+    unsigned int num_symbols  = 60;     // number of symbols
+
+    unsigned int i, j;
+
+    // create filterbank objects
+    firpfbch_crcf q0 = firpfbch_crcf_create_kaiser(LIQUID_ANALYZER, num_channels, m, 60.0f);
+    firpfbch_crcf q1 = firpfbch_crcf_create_kaiser(LIQUID_ANALYZER, num_channels, m, 60.0f);
+
+    // start with two channels enabled
+    firpfbch_crcf_disable_all(q1);
+    firpfbch_crcf_enable_channel(q1,  3);
+    firpfbch_crcf_enable_channel(q1, 40);
+    CONTEND_EQUALITY( firpfbch_crcf_get_num_active(q1), 2 );
+
+    float complex x[num_channels];
+    float complex y0[num_channels];
+    float complex y1[num_channels];
+    unsigned int n = 0;
+    for (i=0; i<num_symbols; i++) {
+        // hot-add channels part way through: first a single channel
+        // (still sparse), then enough to switch to the full transform
+        if (i == 20) firpfbch_crcf_enable_channel(q1, 63);
+        if (i == 40) {
+            for (j=0; j<num_channels; j+=4)
+                firpfbch_crcf_enable_channel(q1, j);
+        }
+
+        // generate input: tones near a few channels plus chirp
+        for (j=0; j<num_channels; j++) {
+            x[j] = cexpf(_Complex_I*2*M_PI*(3.1f/num_channels)*n) +
+                   cexpf(_Complex_I*2*M_PI*(39.8f/num_channels)*n) +
+                   0.3f*cexpf(_Complex_I*1e-4f*n*n);
+            n++;
+        }
+
+        firpfbch_crcf_analyzer_execute(q0, x, y0);
+        firpfbch_crcf_analyzer_execute(q1, x, y1);
+
+        for (j=0; j<num_channels; j++) {
+            int enabled = j==3 || j==40 || (i>=20 && j==63) || (i>=40 && (j%4)==0);
+            float complex v = enabled ? y0[j] : 0.0f;
+            CONTEND_DELTA( crealf(y1[j]), crealf(v), tol );
+            CONTEND_DELTA( cimagf(y1[j]), cimagf(v), tol );
+        }
+    }
+
+    // disabling channels should return to the sparse path
+    firpfbch_crcf_disable_all(q1);
+    firpfbch_crcf_enable_channel(q1, 40);
+    CONTEND_EQUALITY( firpfbch_crcf_get_num_active(q1), 1 );
+    firpfbch_crcf_analyzer_execute(q0, x, y0);
+    firpfbch_crcf_analyzer_execute(q1, x, y1);
+    CONTEND_DELTA( crealf(y1[40]), crealf(y0[40]), tol );
+    CONTEND_DELTA( cimagf(y1[40]), cimagf(y0[40]), tol );
+    CONTEND_EQUALITY( y1[3], 0.0f );
+
+    firpfbch_crcf_destroy(q0);
+    firpfbch_crcf_destroy(q1);
+}
+
+// compare synthesizer with a subset of channels enabled against the
+// full synthesizer with disabled channel inputs set to zero
+void autotest_firpfbch_crcf_sparse_synthesizer()
+{
+    float        tol          = 1e-4f;  // error tolerance
+    unsigned int num_channels = 32;     // number of channels
+    unsigned int m            = 3;      // filter delay (symbols)
+    unsigned int num_symbols  = 40;     // number of symbols
+
+    unsigned int i, j;
+
+    firpfbch_crcf q0 = firpfbch_crcf_create_kaiser(LIQUID_SYNTHESIZER, num_channels, m, 60.0f);
+    firpfbch_crcf q1 = firpfbch_crcf_create_kaiser(LIQUID_SYNTHESIZER, num_channels, m, 60.0f);
+    firpfbch_crcf_disable_all(q1);
+    firpfbch_crcf_enable_channel(q1,  0);
+    firpfbch_crcf_enable_channel(q1, 17);
+
+    float complex x0[num_channels];
+    float complex x1[num_channels];
+    float complex y0[num_channels];
+    float complex y1[num_channels];
+    for (i=0; i<num_symbols; i++) {
+        if (i == 25) firpfbch_crcf_enable_channel(q1, 30);
+
+        for (j=0; j<num_channels; j++) {
+            // full input to sparse synthesizer; disabled channels ignored
+            x1[j] = cexpf(_Complex_I*(0.7f*i + 1.3f*j));
+            int enabled = j==0 || j==17 || (i>=25 && j==30);
+            x0[j] = enabled ? x1[j] : 0.0f;
+        }
+
+        firpfbch_crcf_synthesizer_execute(q0, x0, y0);
+        firpfbch_crcf_synthesizer_execute(q1, x1, y1);
+
+        for (j=0; j<num_channels; j++) {
+            CONTEND_DELTA( crealf(y1[j]), crealf(y0[j]), tol );
+            CONTEND_DELTA( cimagf(y1[j]), cimagf(y0[j]), tol );
+        }
+    }
+
+    firpfbch_crcf_destroy(q0);
+    firpfbch_crcf_destroy(q1);
+}
+
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// analyzer: a tone at the centre of a channel should appear in that
+// channel as a constant (phase-aligned) output
+//  _M      : number of channels
+//  _P      : hop size
+//  _m      : filter semi-length
+//  _k      : channel index of tone
+void firpfbchr_crcf_test_tone(unsigned int _M,
+                              unsigned int _P,
+                              unsigned int _m,
+                              unsigned int _k)
+{
+    float tol = 2e-3f;
+    unsigned int i, j, n;
+    unsigned int num_hops = 8*_m*_M/_P + 8;
+
+    firpfbchr_crcf q = firpfbchr_crcf_create_kaiser(LIQUID_ANALYZER, _M, _P, _m, 60.0f);
+    CONTEND_EQUALITY( firpfbchr_crcf_get_M(q), _M );
+    CONTEND_EQUALITY( firpfbchr_crcf_get_P(q), _P );
+
+    float complex x[_P];
+    float complex y[_M];
+    float complex phasor = 0.7f*cexpf(_Complex_I*0.3f);
+    unsigned int t = 0;
+    for (n=0; n<num_hops; n++) {
+        for (i=0; i<_P; i++, t++)
+            x[i] = phasor * cexpf(_Complex_I*2*M_PI*(float)((_k*t) % _M)/(float)_M);
+        firpfbchr_crcf_execute(q, x, y);
+
+        // skip transient
+        if (t < 2*_M*_m)
+            continue;
+
+        // tone channel
+        CONTEND_DELTA( crealf(y[_k]), crealf(phasor), tol );
+        CONTEND_DELTA( cimagf(y[_k]), cimagf(phasor), tol );
+
+        // channels not adjacent to the tone
+        for (j=0; j<_M; j++) {
+            unsigned int d = (j + _M - _k) % _M;
+            if (d > 1 && d < _M-1)
+                CONTEND_LESS_THAN( cabsf(y[j]), tol );
+        }
+    }
+    firpfbchr_crcf_destroy(q);
+}
+
+void autotest_firpfbchr_crcf_tone_M8_P4()   { firpfbchr_crcf_test_tone(  8,  4, 4, 3); }
+void autotest_firpfbchr_crcf_tone_M12_P9()  { firpfbchr_crcf_test_tone( 12,  9, 8, 5); }
+void autotest_firpfbchr_crcf_tone_M16_P16() { firpfbchr_crcf_test_tone( 16, 16, 6, 1); }
+void autotest_firpfbchr_crcf_tone_M64_P48() { firpfbchr_crcf_test_tone( 64, 48, 8, 0); }
+
+// analyzer followed by synthesizer reproduces the delayed input
+//  _M      : number of channels
+//  _P      : hop size
+//  _m      : filter semi-length
+//  _tol    : tolerance
+void firpfbchr_crcf_test_reconstruct(unsigned int _M,
+                                     unsigned int _P,
+                                     unsigned int _m,
+                                     float        _tol)
+{
+    unsigned int i;
+    unsigned int num_hops    = 12*_m*_M/_P;
+    unsigned int num_samples = num_hops * _P;
+    float complex * x = (float complex*) malloc(num_samples*sizeof(float complex));
+    float complex * y = (float complex*) malloc(num_samples*sizeof(float complex));
+
+    // band-limited pseudo-random input
+    unsigned int s = 1;
+    float complex v = 0.0f;
+    for (i=0; i<num_samples; i++) {
+        s = (s * 524287) % 1031;
+        float complex u = ((float)s / 1031.0f - 0.5f) * cexpf(_Complex_I*0.1f*(float)s);
+        v = 0.8f*v + 0.2f*u;
+        x[i] = v;
+    }
+
+    firpfbchr_crcf qa = firpfbchr_crcf_create_kaiser(LIQUID_ANALYZER,    _M, _P, _m, 80.0f);
+    firpfbchr_crcf qs = firpfbchr_crcf_create_kaiser(LIQUID_SYNTHESIZER, _M, _P, _m, 80.0f);
+    float complex Y[_M];
+    for (i=0; i<num_samples; i+=_P) {
+        firpfbchr_crcf_execute(qa, &x[i], Y);
+        firpfbchr_crcf_execute(qs, Y, &y[i]);
+    }
+    firpfbchr_crcf_destroy(qa);
+    firpfbchr_crcf_destroy(qs);
+
+    // compare to delayed input
+    unsigned int delay = 2*_M*_m - _P + 1;
+    float rmse = 0.0f;
+    float max_error = 0.0f;
+    for (i=delay; i<num_samples; i++) {
+        float e = cabsf(y[i] - x[i-delay]);
+        rmse += e*e;
+        max_error = e > max_error ? e : max_error;
+    }
+    rmse = sqrtf(rmse / (float)(num_samples - delay));
+    if (liquid_autotest_verbose)
+        printf("firpfbchr: M=%3u, P=%3u, m=%2u, rmse=%12.4e, max error=%12.4e\n",
+                _M, _P, _m, rmse, max_error);
+    CONTEND_LESS_THAN( max_error, _tol );
+
+    free(x);
+    free(y);
+}
+
+void autotest_firpfbchr_crcf_reconstruct_M8_P4()   { firpfbchr_crcf_test_reconstruct(  8,  4,  6, 2e-3f); }
+void autotest_firpfbchr_crcf_reconstruct_M12_P8()  { firpfbchr_crcf_test_reconstruct( 12,  8, 10, 2e-3f); }
+void autotest_firpfbchr_crcf_reconstruct_M16_P12() { firpfbchr_crcf_test_reconstruct( 16, 12, 16, 2e-3f); }
+void autotest_firpfbchr_crcf_reconstruct_M32_P8()  { firpfbchr_crcf_test_reconstruct( 32,  8,  6, 2e-3f); }
@@ -143,3 +143,102 @@ void autotest_ofdmframesync_acquire_n128()  { ofdmframesync_acquire_test(128, 16
 void autotest_ofdmframesync_acquire_n256()  { ofdmframesync_acquire_test(256, 32, 0); }
 void autotest_ofdmframesync_acquire_n512()  { ofdmframesync_acquire_test(512, 64, 0); }
 
+// received symbols, collected by callback
+struct ofdmframesync_block_test_s {
+    float complex * X;              // received symbols
+    unsigned int    num_symbols;    // number of symbols received
+    unsigned int    max_symbols;    // buffer size [symbols]
+    unsigned int    reset_after;    // reset after this many symbols
+};
+
+int ofdmframesync_block_test_callback(float complex * _X,
+                                      unsigned char * _p,
+                                      unsigned int    _M,
+                                      void *          _userdata)
+{
+    struct ofdmframesync_block_test_s * t = (struct ofdmframesync_block_test_s*) _userdata;
+    if (t->num_symbols < t->max_symbols)
+        memmove(&t->X[t->num_symbols*_M], _X, _M*sizeof(float complex));
+    t->num_symbols++;
+    return (t->num_symbols % t->reset_after) == 0 ? 1 : 0;
+}
+
+// Compare receiving two frames one sample at a time against receiving
+// them in a single block; the callback resets the synchronizer after
+// the first frame's payload.
+//  _num_subcarriers    :   number of subcarriers
+//  _cp_len             :   cyclic prefix length
+void ofdmframesync_block_test(unsigned int _num_subcarriers,
+                              unsigned int _cp_len)
+{
+    unsigned int M           = _num_subcarriers;
+    unsigned int cp_len      = _cp_len;
+    unsigned int num_payload = 6;       // payload symbols per frame
+    float        dphi        = 0.7f / (float)M; // carrier frequency offset
+
+    unsigned int i, j, f;
+
+    // generate two frames separated by some silence
+    unsigned int frame_len   = (3 + num_payload)*(M + cp_len);
+    unsigned int num_samples = 2*(frame_len + 3*M);
+    float complex * y = (float complex*) malloc(num_samples*sizeof(float complex));
+    memset(y, 0, num_samples*sizeof(float complex));
+
+    ofdmframegen fg = ofdmframegen_create(M, cp_len, 0, NULL);
+    float complex X[M];
+    unsigned int n = 0, s = 1;
+    for (f=0; f<2; f++) {
+        n += 3*M;
+        ofdmframegen_reset(fg);
+        ofdmframegen_write_S0a(fg, &y[n]); n += M + cp_len;
+        ofdmframegen_write_S0b(fg, &y[n]); n += M + cp_len;
+        ofdmframegen_write_S1( fg, &y[n]); n += M + cp_len;
+        for (i=0; i<num_payload; i++) {
+            for (j=0; j<M; j++) {
+                s = 1103515245u*s + 12345u;
+                X[j] = cexpf(_Complex_I*0.5f*M_PI*(float)((s >> 16) & 3));
+            }
+            ofdmframegen_writesymbol(fg, X, &y[n]);
+            n += M + cp_len;
+        }
+    }
+    assert(n == num_samples);
+    for (i=0; i<num_samples; i++)
+        y[i] *= cexpf(_Complex_I*dphi*i);
+
+    // run receivers
+    struct ofdmframesync_block_test_s t[2];
+    ofdmframesync fs[2];
+    for (f=0; f<2; f++) {
+        t[f].max_symbols = 2*num_payload;
+        t[f].X           = (float complex*) malloc(t[f].max_symbols*M*sizeof(float complex));
+        t[f].num_symbols = 0;
+        t[f].reset_after = num_payload;
+        fs[f] = ofdmframesync_create(M, cp_len, 0, NULL, ofdmframesync_block_test_callback, &t[f]);
+    }
+    for (i=0; i<num_samples; i++)
+        ofdmframesync_execute(fs[0], &y[i], 1);
+    ofdmframesync_execute(fs[1], y, num_samples);
+
+    if (liquid_autotest_verbose)
+        printf("  ofdmframesync block, M=%u : %u/%u symbols\n", M, t[1].num_symbols, t[0].num_symbols);
+
+    // compare results
+    CONTEND_EQUALITY( t[0].num_symbols, 2*num_payload );
+    CONTEND_EQUALITY( t[1].num_symbols, t[0].num_symbols );
+    for (i=0; i<t[0].max_symbols*M; i++) {
+        CONTEND_DELTA( crealf(t[1].X[i]), crealf(t[0].X[i]), 1e-4f );
+        CONTEND_DELTA( cimagf(t[1].X[i]), cimagf(t[0].X[i]), 1e-4f );
+    }
+
+    for (f=0; f<2; f++) {
+        ofdmframesync_destroy(fs[f]);
+        free(t[f].X);
+    }
+    ofdmframegen_destroy(fg);
+    free(y);
+}
+
+void autotest_ofdmframesync_block_n64()     { ofdmframesync_block_test(64,  8); }
+void autotest_ofdmframesync_block_n256()    { ofdmframesync_block_test(256, 32); }
+
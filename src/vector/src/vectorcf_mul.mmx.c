@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+// 
+// Complex vector multiplication (MMX/SSE)
+//
+
+#include "liquid.internal.h"
+
+// include proper SIMD extensions for x86 platforms
+// NOTE: these pre-processor macros are defined in config.h
+
+#if HAVE_XMMINTRIN_H
+#include <xmmintrin.h>  // SSE
+#endif
+
+#if HAVE_EMMINTRIN_H
+#include <emmintrin.h>  // SSE2
+#endif
+
+#if HAVE_PMMINTRIN_H
+#include <pmmintrin.h>  // SSE3
+#endif
+
+// multiply two complex pairs packed as {x[0].real, x[0].imag,
+// x[1].real, x[1].imag}:
+//   ci = v * {y.real, y.real}, cq = swap(v) * {y.imag, y.imag}
+//   z  = {ci.real - cq.real, ci.imag + cq.imag}
+static inline __m128 liquid_vectorcf_mul_sse(__m128 _v,
+                                             __m128 _y)
+{
+    __m128 yi = _mm_shuffle_ps(_y, _y, _MM_SHUFFLE(2,2,0,0));
+    __m128 yq = _mm_shuffle_ps(_y, _y, _MM_SHUFFLE(3,3,1,1));
+    __m128 ci = _mm_mul_ps(_v, yi);
+    __m128 cq = _mm_mul_ps(_mm_shuffle_ps(_v, _v, _MM_SHUFFLE(2,3,0,1)), yq);
+#if HAVE_PMMINTRIN_H
+    // SSE3: combine using addsub_ps()
+    return _mm_addsub_ps(ci, cq);
+#else
+    // no SSE3: negate even elements and add
+    const __m128 sign = _mm_castsi128_ps(_mm_set_epi32(0, 0x80000000, 0, 0x80000000));
+    return _mm_add_ps(ci, _mm_xor_ps(cq, sign));
+#endif
+}
+
+// basic vector multiplication, two complex elements at a time
+//  _x      :   first array  [size: _n x 1]
+//  _y      :   second array [size: _n x 1]
+//  _n      :   array lengths
+//  _z      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_mul(float complex * _x,
+                         float complex * _y,
+                         unsigned int    _n,
+                         float complex * _z)
+{
+    // type cast as floating point arrays
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+    float * z = (float*) _z;
+
+    // t = 2*(floor(_n/2))
+    unsigned int t = (_n >> 1) << 1;
+
+    // compute in groups of 2 (unaligned)
+    unsigned int i;
+    for (i=0; i<t; i+=2) {
+        __m128 v = _mm_loadu_ps(&x[2*i]);
+        __m128 w = _mm_loadu_ps(&y[2*i]);
+        _mm_storeu_ps(&z[2*i], liquid_vectorcf_mul_sse(v, w));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _z[i] = _x[i] * _y[i];
+}
+
+// basic vector scalar multiplication, two complex elements at a time
+//  _x      :   input array  [size: _n x 1]
+//  _n      :   array length
+//  _v      :   scalar
+//  _y      :   output array pointer [size: _n x 1]
+void liquid_vectorcf_mulscalar(float complex * _x,
+                               unsigned int    _n,
+                               float complex   _v,
+                               float complex * _y)
+{
+    // type cast as floating point arrays
+    float * x = (float*) _x;
+    float * y = (float*) _y;
+
+    // load scalar into both halves of register
+    __m128 w = _mm_setr_ps(crealf(_v), cimagf(_v), crealf(_v), cimagf(_v));
+
+    // t = 2*(floor(_n/2))
+    unsigned int t = (_n >> 1) << 1;
+
+    // compute in groups of 2 (unaligned)
+    unsigned int i;
+    for (i=0; i<t; i+=2) {
+        __m128 v = _mm_loadu_ps(&x[2*i]);
+        _mm_storeu_ps(&y[2*i], liquid_vectorcf_mul_sse(v, w));
+    }
+
+    // clean up remaining
+    for ( ; i<_n; i++)
+        _y[i] = _x[i] * _v;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2007 - 2016 Joseph Gaeddert
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+ * THE SOFTWARE.
+ */
+
+#include <string.h>
+#include "autotest/autotest.h"
+#include "liquid.h"
+
+// compare vector multiplication against element-wise result, in place
+// and out of place
+void vectorcf_mul_test(unsigned int _n)
+{
+    float tol = 1e-6f;
+    unsigned int i;
+
+    float complex x[_n], y[_n], z[_n], w[_n];
+    for (i=0; i<_n; i++) {
+        x[i] = cosf(0.3f*i) + _Complex_I*sinf(1.7f*i+0.1f);
+        y[i] = 0.5f*cosf(2.1f*i-0.4f) - _Complex_I*cosf(0.9f*i);
+    }
+    float complex v = 0.7f - 1.2f*_Complex_I;
+
+    // out of place
+    liquid_vectorcf_mul(x, y, _n, z);
+    for (i=0; i<_n; i++) {
+        float complex r = x[i]*y[i];
+        CONTEND_DELTA( crealf(z[i]), crealf(r), tol );
+        CONTEND_DELTA( cimagf(z[i]), cimagf(r), tol );
+    }
+
+    liquid_vectorcf_mulscalar(x, _n, v, z);
+    for (i=0; i<_n; i++) {
+        float complex r = x[i]*v;
+        CONTEND_DELTA( crealf(z[i]), crealf(r), tol );
+        CONTEND_DELTA( cimagf(z[i]), cimagf(r), tol );
+    }
+
+    // in place
+    memmove(w, x, _n*sizeof(float complex));
+    liquid_vectorcf_mul(w, y, _n, w);
+    liquid_vectorcf_mulscalar(w, _n, v, w);
+    for (i=0; i<_n; i++) {
+        float complex r = x[i]*y[i]*v;
+        CONTEND_DELTA( crealf(w[i]), crealf(r), tol );
+        CONTEND_DELTA( cimagf(w[i]), cimagf(r), tol );
+    }
+}
+
+void autotest_vectorcf_mul_n1()     { vectorcf_mul_test(1);   }
+void autotest_vectorcf_mul_n2()     { vectorcf_mul_test(2);   }
+void autotest_vectorcf_mul_n7()     { vectorcf_mul_test(7);   }
+void autotest_vectorcf_mul_n64()    { vectorcf_mul_test(64);  }
+void autotest_vectorcf_mul_n203()   { vectorcf_mul_test(203); }
+